@@ -59,6 +59,7 @@ extern int32_t tsNumOfRpcThreads;
 extern int32_t tsNumOfRpcSessions;
 extern int32_t tsTimeToGetAvailableConn;
 extern int32_t tsKeepAliveIdle;
+extern bool    tsRpcLocalSock;
 extern int32_t tsNumOfCommitThreads;
 extern int32_t tsNumOfTaskQueueThreads;
 extern int32_t tsNumOfMnodeQueryThreads;
@@ -126,9 +127,13 @@ extern int32_t tsCacheLazyLoadThreshold;  // cost threshold for last/last_row lo
 // query client
 extern int32_t tsQueryPolicy;
 extern int32_t tsQueryRspPolicy;
+extern int32_t tsQueryYieldRows;
+extern int32_t tsQueryYieldMs;
 extern int64_t tsQueryMaxConcurrentTables;
 extern int32_t tsQuerySmaOptimize;
 extern int32_t tsQueryRsmaTolerance;
+extern int32_t tsQueryFilesetPrefetch;
+extern int32_t tsQueryReadAheadSize;
 extern bool    tsQueryPlannerTrace;
 extern int32_t tsQueryNodeChunkSize;
 extern bool    tsQueryUseNodeAllocator;
@@ -189,6 +194,7 @@ extern int32_t tmqMaxTopicNum;
 
 // wal
 extern int64_t tsWalFsyncDataSizeLimit;
+extern int32_t tsWalGroupCommitUs;
 
 // internal
 extern int32_t tsTransPullupInterval;
@@ -206,6 +212,10 @@ extern int32_t tsUptimeInterval;
 extern bool    tsDisableStream;
 extern int64_t tsStreamBufferSize;
 extern bool    tsFilterScalarMode;
+extern bool    tsMemColumnarAppend;
+extern int32_t tsCommitFilesetParallel;
+extern bool    tsTagColumnarCache;
+extern int32_t tsTagColumnarCacheSize;
 extern int32_t tsMaxStreamBackendCache;
 extern int32_t tsPQSortMemThreshold;
 extern int32_t tsResolveFQDNRetryTime;
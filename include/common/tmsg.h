@@ -2177,6 +2177,7 @@ typedef struct {
   uint64_t queryId;
   uint64_t taskId;
   int32_t  execId;
+  int8_t   yielded;  // the task gave up its worker on the yield budget, not continued by a fetch
 } SQueryContinueReq;
 
 typedef struct {
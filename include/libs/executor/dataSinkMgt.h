@@ -115,6 +115,15 @@ void dsGetDataLength(DataSinkHandle handle, int64_t* pLen, bool* pQueryEnd);
  */
 int32_t dsGetDataBlock(DataSinkHandle handle, SOutputData* pOutput);
 
+/**
+ * Get data without copying it, the caller takes the buffer of the datasinker holding it and frees it by taosMemoryFree.
+ * @param handle
+ * @param pOutput output, pData points to the data in the buffer
+ * @param ppBuf output, the buffer, NULL if there is no data
+ * @return error code, TSDB_CODE_OPS_NOT_SUPPORT if the datasinker does not hand out its buffers
+ */
+int32_t dsGetDataBlockRef(DataSinkHandle handle, SOutputData* pOutput, void** ppBuf);
+
 int32_t dsGetCacheSize(DataSinkHandle handle, uint64_t* pSize);
 
 /**
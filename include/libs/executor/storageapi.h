@@ -261,6 +261,8 @@ typedef struct SStoreMeta {
 
   int32_t (*getTableTags)(void* pVnode, uint64_t suid, SArray* uidList);
   int32_t (*getTableTagsByUid)(void* pVnode, int64_t suid, SArray* uidList);
+  int32_t (*getTableTagBlock)(void* pVnode, uint64_t suid, SArray* pColList, SArray* pUidTagList,
+                              SSDataBlock** ppBlock);
   const void* (*extractTagVal)(const void* tag, int16_t type, STagVal* tagVal);  // todo remove it
 
   int32_t (*getTableUidByName)(void* pVnode, char* tbName, uint64_t* uid);
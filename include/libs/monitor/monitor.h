@@ -20,6 +20,7 @@
 #include "tdef.h"
 #include "tlog.h"
 #include "tmsg.h"
+#include "trpc.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -88,6 +89,7 @@ typedef struct {
   SMonBasicInfo basic;
   SMonDnodeInfo dnode;
   SMonSysInfo   sys;
+  SRpcBufStat   rpcBuf;
 } SMonDmInfo;
 
 typedef struct {
@@ -142,6 +142,14 @@ typedef struct {
   void (*freeFunc)(const void *arg);
 } SRpcCtx;
 
+typedef struct {
+  int64_t numOfAllocs;     // msg buffers allocated
+  int64_t numOfPoolHits;   // of them reused from the pools
+  int64_t numOfBigAllocs;  // of them too big for any size class
+  int64_t memInUse;        // bytes of the msg buffers not freed yet
+  int64_t memInPool;       // bytes kept in the pools for reuse
+} SRpcBufStat;
+
 int32_t rpcInit();
 void    rpcCleanup();
 
@@ -151,6 +159,11 @@ void  rpcCloseImpl(void *);
 void *rpcMallocCont(int64_t contLen);
 void  rpcFreeCont(void *pCont);
 void *rpcReallocCont(void *ptr, int64_t contLen);
+void  rpcGetBufStat(SRpcBufStat *pStat);
+
+// attach len bytes at pData to the end of a response body, they are sent without being copied into pCont, contLen of
+// the response counts them, and freeFp(pOwner) is called when pCont is freed
+int32_t rpcAddContRef(void *pCont, void *pData, int32_t len, void *pOwner, void (*freeFp)(void *));
 
 // Because taosd supports multi-process mode
 // These functions should not be used on the server side
@@ -120,6 +120,14 @@ typedef struct SWal {
   SHashObj *pRefHash;  // refId -> SWalRef
   // path
   char path[WAL_PATH_LEN];
+  // group commit
+  int64_t       appendSeq;    // number of appends, guarded by mutex
+  TdThreadMutex fsyncMutex;   // held by the group fsync in flight on pLogFile, taken with mutex held
+  TdThreadMutex groupMutex;
+  TdThreadCond  groupCond;
+  int64_t       fsyncedSeq;   // appends known durable, guarded by groupMutex
+  int8_t        fsyncing;     // a caller is leading the group fsync, guarded by groupMutex
+  int64_t       groupFsyncs;  // number of group fsyncs done, guarded by groupMutex
   // reusable write head
   SWalCkHead writeHead;
 } SWal;
@@ -178,6 +186,9 @@ int32_t walWriteWithSyncInfo(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo
 int64_t walAppendLog(SWal *, int64_t index, tmsg_t msgType, SWalSyncInfo syncMeta, const void *body, int32_t bodyLen);
 
 void walFsync(SWal *, bool force);
+// when true, the concurrent callers of walFsync share the fsync led by one of them, so a caller may append a batch of
+// logs and fsync once to make them all durable
+bool walGroupCommit(SWal *);
 
 // apis for lifecycle management
 int32_t walCommit(SWal *, int64_t ver);
@@ -54,6 +54,12 @@ extern "C" {
 
 typedef struct TdFile *TdFilePtr;
 
+#define TD_FILE_IOV_MAX 16
+typedef struct {
+  const void *pBuf;
+  int64_t     len;
+} TdFileIoVec;
+
 #define TD_FILE_CREATE   0x0001
 #define TD_FILE_WRITE    0x0002
 #define TD_FILE_READ     0x0004
@@ -89,6 +95,8 @@ int64_t taosReadFile(TdFilePtr pFile, void *buf, int64_t count);
 int64_t taosPReadFile(TdFilePtr pFile, void *buf, int64_t count, int64_t offset);
 int64_t taosWriteFile(TdFilePtr pFile, const void *buf, int64_t count);
 int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t offset);
+// write the buffers in order with one call, at most TD_FILE_IOV_MAX of them
+int64_t taosWritevFile(TdFilePtr pFile, const TdFileIoVec *aVec, int32_t nVec);
 void    taosFprintfFile(TdFilePtr pFile, const char *format, ...);
 
 int64_t taosGetLineFile(TdFilePtr pFile, char **__restrict ptrBuf);
@@ -106,6 +114,10 @@ void taosGetTmpfilePath(const char *inputTmpDir, const char *fileNamePrefix, cha
 
 int64_t taosFSendFile(TdFilePtr pFileOut, TdFilePtr pFileIn, int64_t *offset, int64_t size);
 
+// map the first length bytes of the file read-only and shared with its writers, NULL if mapping is not supported
+void   *taosMmapReadOnlyFile(TdFilePtr pFile, int64_t length);
+int32_t taosMunmapFile(void *ptr, int64_t length);
+
 bool taosValidFile(TdFilePtr pFile);
 
 int32_t taosGetErrorFile(TdFilePtr pFile);
@@ -51,6 +51,14 @@ extern "C" {
 #define HEAD_MODE(x) x % 2
 #define HEAD_ALGO(x) x / 2
 
+// adaptive codecs, chosen per block by sampling and saved in the first byte in place of the fixed codec mode
+#define ADAPT_CODEC_RLE   0x10  // run length
+#define ADAPT_CODEC_DICT  0x11  // dictionary with bit-packed indices
+#define ADAPT_CODEC_BP    0x12  // delta with frame of reference bit-packing
+#define IS_ADAPT_CODEC(x) ((uint8_t)(x) >= ADAPT_CODEC_RLE && (uint8_t)(x) <= ADAPT_CODEC_BP)
+
+extern bool tsCompressAdaptive;
+
 #ifdef TD_TSZ
 extern bool lossyFloat;
 extern bool lossyDouble;
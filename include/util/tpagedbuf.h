@@ -39,6 +39,10 @@ typedef struct SDiskbasedBufStatis {
   int32_t getPages;
   int32_t releasePages;
   int32_t flushPages;
+  int64_t flushElapsed;   // accumulated time of writing pages to disk, in microseconds
+  int64_t loadElapsed;    // accumulated time of waiting pages loaded from disk, in microseconds
+  int32_t prefetchPages;  // pages read ahead of the request
+  int32_t prefetchHits;   // loaded pages served by the read ahead buffer
 } SDiskbasedBufStatis;
 
 /**
@@ -184,6 +188,12 @@ void dBufPrintStatis(const SDiskbasedBuf* pBuf);
  */
 void clearDiskbasedBuf(SDiskbasedBuf* pBuf);
 
+/**
+ * Stop the spill threads shared by all paged buffers, called at module cleanup when all buffers are destroyed.
+ * Pages of the buffers created afterwards are flushed synchronously.
+ */
+void dBufStopSpillWorker();
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,12 @@ Notes:
 1: taosOpenQueue/taosCloseQueue, taosOpenQset/taosCloseQset is NOT multi-thread safe
 2: after taosCloseQueue/taosCloseQset is called, read/write operation APIs are not safe.
 3: read/write operation APIs are multi-thread safe
+4: reading from a queue set takes no lock of the set. Each queue in the set owns a slot, and the bit of the slot in
+   the ready map is kept set under the queue mutex while the queue has items. A reader scans the map from where it
+   stopped last time, so that the queues are served in turn, and skips to the next ready queue when one is locked by
+   another thread. Removing a queue waits for the readers which may still see its slot.
+5: an item marked low priority before written, such as the continuation of a long task, is read after the other items
+   of its queue, yet one is read at least once in QUEUE_LOW_PRI_INTERVAL items so that none of them starves.
 
 To remove the limitation and make this set of queue APIs multi-thread safe, REF(tref.c)
 shall be used to set up the protection.
@@ -68,16 +74,20 @@ struct STaosQnode {
   int64_t     dataSize;
   int32_t     size;
   int8_t      itype;
-  int8_t      reserved[3];
+  int8_t      lowPri;
+  int8_t      reserved[2];
   char        item[];
 };
 
 struct STaosQueue {
   STaosQnode   *head;
   STaosQnode   *tail;
+  STaosQnode   *lowHead;  // items of low priority
+  STaosQnode   *lowTail;
   STaosQueue   *next;     // for queue set
   STaosQset    *qset;     // for queue set
   void         *ahandle;  // for queue set
+  int32_t       slot;     // for queue set
   FItem         itemFp;
   FItems        itemsFp;
   TdThreadMutex mutex;
@@ -86,15 +96,29 @@ struct STaosQueue {
   int64_t       threadId;
   int64_t       memLimit;
   int64_t       itemLimit;
+  int32_t       numOfHighRead;  // items read in a row while low priority ones wait
 };
 
+#define QUEUE_LOW_PRI_INTERVAL 8
+
+#define QSET_MAX_QUEUES    8192
+#define QSET_READER_GROUPS 64
+
+typedef struct {
+  int32_t numOfReaders;
+  char    padding[60];
+} SQsetReaders;
+
 struct STaosQset {
   STaosQueue   *head;
-  STaosQueue   *current;
-  TdThreadMutex mutex;
+  TdThreadMutex mutex;  // for adding and removing queues
   tsem_t        sem;
   int32_t       numOfQueues;
   int32_t       numOfItems;
+  int32_t       numOfSlots;  // slots ever used
+  STaosQueue  **slots;       // slot -> queue
+  int64_t      *readyMap;    // bit of a slot is set while the queue has items to read
+  SQsetReaders *readers;     // readers scanning the slots, grouped by worker id
 };
 
 struct STaosQall {
@@ -108,6 +132,7 @@ void        taosCloseQueue(STaosQueue *queue);
 void        taosSetQueueFp(STaosQueue *queue, FItem itemFp, FItems itemsFp);
 void       *taosAllocateQitem(int32_t size, EQItype itype, int64_t dataSize);
 void        taosFreeQitem(void *pItem);
+void        taosSetQitemLowPriority(void *pItem);
 int32_t     taosWriteQitem(STaosQueue *queue, void *pItem);
 int32_t     taosReadQitem(STaosQueue *queue, void **ppItem);
 bool        taosQueueEmpty(STaosQueue *queue);
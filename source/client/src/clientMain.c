@@ -24,6 +24,7 @@
 #include "tdatablock.h"
 #include "tglobal.h"
 #include "tmsg.h"
+#include "tpagedbuf.h"
 #include "tref.h"
 #include "trpc.h"
 #include "version.h"
@@ -78,6 +79,7 @@ void taos_cleanup(void) {
   tscDebug("rpc cleanup");
 
   cleanupTaskQueue();
+  dBufStopSpillWorker();
 
   taosConvDestroy();
 
@@ -16,6 +16,7 @@
 #define _DEFAULT_SOURCE
 #include "tglobal.h"
 #include "os.h"
+#include "tcompression.h"
 #include "tconfig.h"
 #include "tgrant.h"
 #include "tlog.h"
@@ -51,6 +52,7 @@ int32_t tsNumOfRpcThreads = 1;
 int32_t tsNumOfRpcSessions = 30000;
 int32_t tsTimeToGetAvailableConn = 500000;
 int32_t tsKeepAliveIdle = 60;
+bool    tsRpcLocalSock = true;  // reach a server on this host through a unix domain socket
 
 int32_t tsNumOfCommitThreads = 2;
 int32_t tsNumOfTaskQueueThreads = 4;
@@ -128,11 +130,15 @@ int32_t tmqMaxTopicNum = 20;
 // query
 int32_t tsQueryPolicy = 1;
 int32_t tsQueryRspPolicy = 0;
+int32_t tsQueryYieldRows = 0;  // a query task gives up its worker after putting so many rows into the sink, 0 for never
+int32_t tsQueryYieldMs = 0;    // or after running so long on it, 0 for never
 int64_t tsQueryMaxConcurrentTables = 200;  // unit is TSDB_TABLE_NUM_UNIT
 bool    tsEnableQueryHb = true;
 bool    tsEnableScience = false;  // on taos-cli show float and doulbe with scientific notation if true
 int32_t tsQuerySmaOptimize = 0;
 int32_t tsQueryRsmaTolerance = 1000;  // the tolerance time (ms) to judge from which level to query rsma data.
+int32_t tsQueryFilesetPrefetch = 0;   // number of file sets loaded ahead in the vnode read threads, 0 means disabled
+int32_t tsQueryReadAheadSize = 0;     // size (KB) of data blocks read ahead in the vnode read threads, 0 means disabled
 bool    tsQueryPlannerTrace = false;
 int32_t tsQueryNodeChunkSize = 32 * 1024;
 bool    tsQueryUseNodeAllocator = true;
@@ -233,6 +239,7 @@ bool    tsStartUdfd = true;
 
 // wal
 int64_t tsWalFsyncDataSizeLimit = (100 * 1024 * 1024L);
+int32_t tsWalGroupCommitUs = -1;  // -1: fsync per call, >= 0: group commit, waiting so long for more logs to join
 
 // ttl
 bool    tsTtlChangeOnWrite = false;  // if true, ttl delete time changes on last write
@@ -257,6 +264,10 @@ char    tsUdfdLdLibPath[512] = "";
 bool    tsDisableStream = false;
 int64_t tsStreamBufferSize = 128 * 1024 * 1024;
 bool    tsFilterScalarMode = false;
+bool    tsMemColumnarAppend = true;  // append in-order column data to the memtable as columnar chunks
+int32_t tsCommitFilesetParallel = 4;  // max number of file sets committed in parallel by a vnode, 1 means serially
+bool    tsTagColumnarCache = true;    // filter tags on columnar copies of the tags of super tables kept in the meta
+int32_t tsTagColumnarCacheSize = 64;  // MB, memory of the columnar tag copies of each vnode, the least used are evicted
 int     tsResolveFQDNRetryTime = 100;  // seconds
 
 char   tsS3Endpoint[TSDB_FQDN_LEN] = "<endpoint>";
@@ -468,6 +479,7 @@ static int32_t taosAddClientCfg(SConfig *pCfg) {
 
   tsKeepAliveIdle = TRANGE(tsKeepAliveIdle, 1, 72000);
   if (cfgAddInt32(pCfg, "keepAliveIdle", tsKeepAliveIdle, 1, 7200000, CFG_SCOPE_BOTH) != 0) return -1;
+  if (cfgAddBool(pCfg, "rpcLocalSock", tsRpcLocalSock, CFG_SCOPE_BOTH) != 0) return -1;
 
   tsNumOfTaskQueueThreads = tsNumOfCores / 2;
   tsNumOfTaskQueueThreads = TMAX(tsNumOfTaskQueueThreads, 4);
@@ -534,6 +546,8 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "queryBufferSize", tsQueryBufferSize, -1, 500000000000, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddBool(pCfg, "printAuth", tsPrintAuth, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddInt32(pCfg, "queryRspPolicy", tsQueryRspPolicy, 0, 1, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "queryYieldRows", tsQueryYieldRows, 0, INT32_MAX, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "queryYieldMs", tsQueryYieldMs, 0, 3600000, CFG_SCOPE_SERVER) != 0) return -1;
 
   tsNumOfRpcThreads = tsNumOfCores / 2;
   tsNumOfRpcThreads = TRANGE(tsNumOfRpcThreads, 2, TSDB_MAX_RPC_THREADS);
@@ -547,6 +561,7 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
 
   tsKeepAliveIdle = TRANGE(tsKeepAliveIdle, 1, 72000);
   if (cfgAddInt32(pCfg, "keepAliveIdle", tsKeepAliveIdle, 1, 7200000, CFG_SCOPE_BOTH) != 0) return -1;
+  if (cfgAddBool(pCfg, "rpcLocalSock", tsRpcLocalSock, CFG_SCOPE_BOTH) != 0) return -1;
 
   tsNumOfCommitThreads = tsNumOfCores / 2;
   tsNumOfCommitThreads = TRANGE(tsNumOfCommitThreads, 2, 4);
@@ -637,11 +652,14 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "trimVDbIntervalSec", tsTrimVDbIntervalSec, 1, 100000, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddInt32(pCfg, "uptimeInterval", tsUptimeInterval, 1, 100000, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddInt32(pCfg, "queryRsmaTolerance", tsQueryRsmaTolerance, 0, 900000, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "queryFilesetPrefetch", tsQueryFilesetPrefetch, 0, 16, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "queryReadAheadSize", tsQueryReadAheadSize, 0, 65536, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddInt32(pCfg, "timeseriesThreshold", tsTimeSeriesThreshold, 0, 2000, CFG_SCOPE_SERVER) != 0) return -1;
 
   if (cfgAddInt64(pCfg, "walFsyncDataSizeLimit", tsWalFsyncDataSizeLimit, 100 * 1024 * 1024, INT64_MAX,
                   CFG_SCOPE_SERVER) != 0)
     return -1;
+  if (cfgAddInt32(pCfg, "walGroupCommitUs", tsWalGroupCommitUs, -1, 1000000, CFG_SCOPE_SERVER) != 0) return -1;
 
   if (cfgAddBool(pCfg, "udf", tsStartUdfd, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddString(pCfg, "udfdResFuncs", tsUdfdResFuncs, CFG_SCOPE_SERVER) != 0) return -1;
@@ -661,8 +679,13 @@ static int32_t taosAddServerCfg(SConfig *pCfg) {
   if (cfgAddInt32(pCfg, "curRange", tsCurRange, 0, 65536, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddBool(pCfg, "ifAdtFse", tsIfAdtFse, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddString(pCfg, "compressor", tsCompressor, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddBool(pCfg, "compressAdaptive", tsCompressAdaptive, CFG_SCOPE_SERVER) != 0) return -1;
 
   if (cfgAddBool(pCfg, "filterScalarMode", tsFilterScalarMode, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddBool(pCfg, "memColumnarAppend", tsMemColumnarAppend, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "commitFilesetParallel", tsCommitFilesetParallel, 1, 64, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddBool(pCfg, "tagColumnarCache", tsTagColumnarCache, CFG_SCOPE_SERVER) != 0) return -1;
+  if (cfgAddInt32(pCfg, "tagColumnarCacheSize", tsTagColumnarCacheSize, 1, 65536, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddInt32(pCfg, "maxStreamBackendCache", tsMaxStreamBackendCache, 16, 1024, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddInt32(pCfg, "pqSortMemThreshold", tsPQSortMemThreshold, 1, 10240, CFG_SCOPE_SERVER) != 0) return -1;
   if (cfgAddInt32(pCfg, "resolveFQDNRetryTime", tsResolveFQDNRetryTime, 1, 10240, 0) != 0) return -1;
@@ -968,6 +991,7 @@ static int32_t taosSetClientCfg(SConfig *pCfg) {
   tsTimeToGetAvailableConn = cfgGetItem(pCfg, "timeToGetAvailableConn")->i32;
 
   tsKeepAliveIdle = cfgGetItem(pCfg, "keepAliveIdle")->i32;
+  tsRpcLocalSock = cfgGetItem(pCfg, "rpcLocalSock")->bval;
   return 0;
 }
 
@@ -1008,6 +1032,7 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsTimeToGetAvailableConn = cfgGetItem(pCfg, "timeToGetAvailableConn")->i32;
 
   tsKeepAliveIdle = cfgGetItem(pCfg, "keepAliveIdle")->i32;
+  tsRpcLocalSock = cfgGetItem(pCfg, "rpcLocalSock")->bval;
 
   tsNumOfCommitThreads = cfgGetItem(pCfg, "numOfCommitThreads")->i32;
   tsNumOfMnodeReadThreads = cfgGetItem(pCfg, "numOfMnodeReadThreads")->i32;
@@ -1031,6 +1056,8 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsMonitorMaxLogs = cfgGetItem(pCfg, "monitorMaxLogs")->i32;
   tsMonitorComp = cfgGetItem(pCfg, "monitorComp")->bval;
   tsQueryRspPolicy = cfgGetItem(pCfg, "queryRspPolicy")->i32;
+  tsQueryYieldRows = cfgGetItem(pCfg, "queryYieldRows")->i32;
+  tsQueryYieldMs = cfgGetItem(pCfg, "queryYieldMs")->i32;
 
   tsEnableAudit = cfgGetItem(pCfg, "audit")->bval;
   tstrncpy(tsAuditFqdn, cfgGetItem(pCfg, "auditFqdn")->str, TSDB_FQDN_LEN);
@@ -1054,9 +1081,12 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsTrimVDbIntervalSec = cfgGetItem(pCfg, "trimVDbIntervalSec")->i32;
   tsUptimeInterval = cfgGetItem(pCfg, "uptimeInterval")->i32;
   tsQueryRsmaTolerance = cfgGetItem(pCfg, "queryRsmaTolerance")->i32;
+  tsQueryFilesetPrefetch = cfgGetItem(pCfg, "queryFilesetPrefetch")->i32;
+  tsQueryReadAheadSize = cfgGetItem(pCfg, "queryReadAheadSize")->i32;
   tsTimeSeriesThreshold = cfgGetItem(pCfg, "timeseriesThreshold")->i32;
 
   tsWalFsyncDataSizeLimit = cfgGetItem(pCfg, "walFsyncDataSizeLimit")->i64;
+  tsWalGroupCommitUs = cfgGetItem(pCfg, "walGroupCommitUs")->i32;
 
   tsElectInterval = cfgGetItem(pCfg, "syncElectInterval")->i32;
   tsHeartbeatInterval = cfgGetItem(pCfg, "syncHeartbeatInterval")->i32;
@@ -1086,6 +1116,7 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsCurRange = cfgGetItem(pCfg, "curRange")->i32;
   tsIfAdtFse = cfgGetItem(pCfg, "ifAdtFse")->bval;
   tstrncpy(tsCompressor, cfgGetItem(pCfg, "compressor")->str, sizeof(tsCompressor));
+  tsCompressAdaptive = cfgGetItem(pCfg, "compressAdaptive")->bval;
 
   tsDisableStream = cfgGetItem(pCfg, "disableStream")->bval;
   tsStreamBufferSize = cfgGetItem(pCfg, "streamBufferSize")->i64;
@@ -1093,6 +1124,10 @@ static int32_t taosSetServerCfg(SConfig *pCfg) {
   tsSinkDataRate = cfgGetItem(pCfg, "streamSinkDataRate")->fval;
 
   tsFilterScalarMode = cfgGetItem(pCfg, "filterScalarMode")->bval;
+  tsMemColumnarAppend = cfgGetItem(pCfg, "memColumnarAppend")->bval;
+  tsCommitFilesetParallel = cfgGetItem(pCfg, "commitFilesetParallel")->i32;
+  tsTagColumnarCache = cfgGetItem(pCfg, "tagColumnarCache")->bval;
+  tsTagColumnarCacheSize = cfgGetItem(pCfg, "tagColumnarCacheSize")->i32;
   tsMaxStreamBackendCache = cfgGetItem(pCfg, "maxStreamBackendCache")->i32;
   tsPQSortMemThreshold = cfgGetItem(pCfg, "pqSortMemThreshold")->i32;
   tsResolveFQDNRetryTime = cfgGetItem(pCfg, "resolveFQDNRetryTime")->i32;
@@ -1149,12 +1184,16 @@ int32_t taosApplyLocalCfg(SConfig *pCfg, char *name) {
         tsCompressMsgSize = cfgGetItem(pCfg, "compressMsgSize")->i32;
       } else if (strcasecmp("compressColData", name) == 0) {
         tsCompressColData = cfgGetItem(pCfg, "compressColData")->i32;
+      } else if (strcasecmp("compressAdaptive", name) == 0) {
+        tsCompressAdaptive = cfgGetItem(pCfg, "compressAdaptive")->bval;
       } else if (strcasecmp("countAlwaysReturnValue", name) == 0) {
         tsCountAlwaysReturnValue = cfgGetItem(pCfg, "countAlwaysReturnValue")->i32;
       } else if (strcasecmp("cDebugFlag", name) == 0) {
         cDebugFlag = cfgGetItem(pCfg, "cDebugFlag")->i32;
       } else if (strcasecmp("crashReporting", name) == 0) {
         tsEnableCrashReport = cfgGetItem(pCfg, "crashReporting")->bval;
+      } else if (strcasecmp("commitFilesetParallel", name) == 0) {
+        tsCommitFilesetParallel = cfgGetItem(pCfg, "commitFilesetParallel")->i32;
       }
       break;
     }
@@ -1265,6 +1304,8 @@ int32_t taosApplyLocalCfg(SConfig *pCfg, char *name) {
         case 'e': {
           if (strcasecmp("metaCacheMaxSize", name) == 0) {
             atomic_store_32(&tsMetaCacheMaxSize, cfgGetItem(pCfg, "metaCacheMaxSize")->i32);
+          } else if (strcasecmp("memColumnarAppend", name) == 0) {
+            tsMemColumnarAppend = cfgGetItem(pCfg, "memColumnarAppend")->bval;
           }
           break;
         }
@@ -1376,6 +1417,10 @@ int32_t taosApplyLocalCfg(SConfig *pCfg, char *name) {
         tsQueryUseNodeAllocator = cfgGetItem(pCfg, "queryUseNodeAllocator")->bval;
       } else if (strcasecmp("queryRsmaTolerance", name) == 0) {
         tsQueryRsmaTolerance = cfgGetItem(pCfg, "queryRsmaTolerance")->i32;
+      } else if (strcasecmp("queryFilesetPrefetch", name) == 0) {
+        tsQueryFilesetPrefetch = cfgGetItem(pCfg, "queryFilesetPrefetch")->i32;
+      } else if (strcasecmp("queryReadAheadSize", name) == 0) {
+        tsQueryReadAheadSize = cfgGetItem(pCfg, "queryReadAheadSize")->i32;
       }
       break;
     }
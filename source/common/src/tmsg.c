@@ -8266,12 +8266,17 @@ static int32_t tEncodeSSubmitTbData(SEncoder *pCoder, const SSubmitTbData *pSubm
 static int32_t tDecodeSSubmitTbData(SDecoder *pCoder, SSubmitTbData *pSubmitTbData) {
   int32_t code = 0;
 
+  memset(pSubmitTbData, 0, sizeof(*pSubmitTbData));
+
   if (tStartDecode(pCoder) < 0) {
     code = TSDB_CODE_INVALID_MSG;
     goto _exit;
   }
 
-  if (tDecodeI32v(pCoder, &pSubmitTbData->flags) < 0) return -1;
+  if (tDecodeI32v(pCoder, &pSubmitTbData->flags) < 0) {
+    code = TSDB_CODE_INVALID_MSG;
+    goto _exit;
+  }
 
   if (pSubmitTbData->flags & SUBMIT_REQ_AUTO_CREATE_TABLE) {
     pSubmitTbData->pCreateTbReq = taosMemoryCalloc(1, sizeof(SVCreateTbReq));
@@ -8300,10 +8305,12 @@ static int32_t tDecodeSSubmitTbData(SDecoder *pCoder, SSubmitTbData *pSubmitTbDa
     goto _exit;
   }
 
+  // rows and columns are not copied, they refer to the message buffer, which should live until the request is
+  // destroyed. The tsdb copies them into the buffer pool of the memtable directly.
   if (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
     uint64_t nColData;
 
-    if (tDecodeU64v(pCoder, &nColData) < 0) {
+    if (tDecodeU64v(pCoder, &nColData) < 0 || nColData > pCoder->size - pCoder->pos) {
       code = TSDB_CODE_INVALID_MSG;
       goto _exit;
     }
@@ -8314,12 +8321,19 @@ static int32_t tDecodeSSubmitTbData(SDecoder *pCoder, SSubmitTbData *pSubmitTbDa
       goto _exit;
     }
 
+    SColData *aColData = (SColData *)TARRAY_DATA(pSubmitTbData->aCol);
     for (int32_t i = 0; i < nColData; ++i) {
-      pCoder->pos += tGetColData(pCoder->data + pCoder->pos, taosArrayReserve(pSubmitTbData->aCol, 1));
+      memset(&aColData[i], 0, sizeof(SColData));
+      pCoder->pos += tGetColData(pCoder->data + pCoder->pos, &aColData[i]);
+      if (pCoder->pos > pCoder->size) {
+        code = TSDB_CODE_INVALID_MSG;
+        goto _exit;
+      }
     }
+    TARRAY_SIZE(pSubmitTbData->aCol) = nColData;
   } else {
     uint64_t nRow;
-    if (tDecodeU64v(pCoder, &nRow) < 0) {
+    if (tDecodeU64v(pCoder, &nRow) < 0 || nRow > (pCoder->size - pCoder->pos) / sizeof(SRow)) {
       code = TSDB_CODE_INVALID_MSG;
       goto _exit;
     }
@@ -8330,12 +8344,20 @@ static int32_t tDecodeSSubmitTbData(SDecoder *pCoder, SSubmitTbData *pSubmitTbDa
       goto _exit;
     }
 
+    SRow **aRow = (SRow **)TARRAY_DATA(pSubmitTbData->aRowP);
     for (int32_t iRow = 0; iRow < nRow; ++iRow) {
-      SRow **ppRow = taosArrayReserve(pSubmitTbData->aRowP, 1);
+      SRow *pRow = (SRow *)(pCoder->data + pCoder->pos);
 
-      *ppRow = (SRow *)(pCoder->data + pCoder->pos);
-      pCoder->pos += (*ppRow)->len;
+      if (pCoder->size - pCoder->pos < sizeof(SRow) || pRow->len < sizeof(SRow) ||
+          pRow->len > pCoder->size - pCoder->pos) {
+        code = TSDB_CODE_INVALID_MSG;
+        goto _exit;
+      }
+
+      aRow[iRow] = pRow;
+      pCoder->pos += pRow->len;
     }
+    TARRAY_SIZE(pSubmitTbData->aRowP) = nRow;
   }
 
   pSubmitTbData->ctimeMs = 0;
@@ -8350,9 +8372,10 @@ static int32_t tDecodeSSubmitTbData(SDecoder *pCoder, SSubmitTbData *pSubmitTbDa
 
 _exit:
   if (code) {
-    // TODO: clear
+    tDestroySubmitTbData(pSubmitTbData, TSDB_MSG_FLG_DECODE);
+    memset(pSubmitTbData, 0, sizeof(*pSubmitTbData));
   }
-  return 0;
+  return code;
 }
 
 int32_t tEncodeSubmitReq(SEncoder *pCoder, const SSubmitReq2 *pReq) {
@@ -8379,7 +8402,7 @@ int32_t tDecodeSubmitReq(SDecoder *pCoder, SSubmitReq2 *pReq) {
   }
 
   uint64_t nSubmitTbData;
-  if (tDecodeU64v(pCoder, &nSubmitTbData) < 0) {
+  if (tDecodeU64v(pCoder, &nSubmitTbData) < 0 || nSubmitTbData > pCoder->size - pCoder->pos) {
     code = TSDB_CODE_INVALID_MSG;
     goto _exit;
   }
@@ -8391,8 +8414,9 @@ int32_t tDecodeSubmitReq(SDecoder *pCoder, SSubmitReq2 *pReq) {
   }
 
   for (uint64_t i = 0; i < nSubmitTbData; i++) {
-    if (tDecodeSSubmitTbData(pCoder, taosArrayReserve(pReq->aSubmitTbData, 1)) < 0) {
-      code = TSDB_CODE_INVALID_MSG;
+    code = tDecodeSSubmitTbData(pCoder, taosArrayReserve(pReq->aSubmitTbData, 1));
+    if (code) {
+      taosArrayPop(pReq->aSubmitTbData);
       goto _exit;
     }
   }
@@ -8401,11 +8425,7 @@ int32_t tDecodeSubmitReq(SDecoder *pCoder, SSubmitReq2 *pReq) {
 
 _exit:
   if (code) {
-    if (pReq->aSubmitTbData) {
-      // todo
-      taosArrayDestroy(pReq->aSubmitTbData);
-      pReq->aSubmitTbData = NULL;
-    }
+    tDestroySubmitReq(pReq, TSDB_MSG_FLG_DECODE);
   }
   return code;
 }
@@ -201,6 +201,11 @@ static int32_t vmPutMsgToQueue(SVnodeMgmt *pMgmt, SRpcMsg *pMsg, EQueueType qtyp
         dError("vgId:%d, msg:%p preprocess query msg failed since %s", pVnode->vgId, pMsg, terrstr(code));
       } else {
         dGTrace("vgId:%d, msg:%p put into vnode-query queue", pVnode->vgId, pMsg);
+        // a task continued after yielding waits behind the newly arrived queries, a fetch driven one does not
+        if (pMsg->msgType == TDMT_SCH_QUERY_CONTINUE && pMsg->contLen >= sizeof(SQueryContinueReq) &&
+            ((SQueryContinueReq *)pMsg->pCont)->yielded) {
+          taosSetQitemLowPriority(pMsg);
+        }
         taosWriteQitem(pVnode->pQueryQ, pMsg);
       }
       break;
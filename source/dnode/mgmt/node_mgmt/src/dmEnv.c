@@ -17,6 +17,7 @@
 #include "dmMgmt.h"
 #include "audit.h"
 #include "libs/function/tudf.h"
+#include "tpagedbuf.h"
 
 #define DM_INIT_AUDIT()                 \
   do {                                  \
@@ -180,6 +181,7 @@ void dmCleanup() {
   udfcClose();
   udfStopUdfd();
   taosStopCacheRefreshWorker();
+  dBufStopSpillWorker();
   dmDiskClose();
   dInfo("dnode env is cleaned up");
 
@@ -40,6 +40,7 @@ static void dmGetDmMonitorInfo(SDnode *pDnode) {
   dmGetMonitorBasicInfo(pDnode, &dmInfo.basic);
   dmGetMonitorDnodeInfo(pDnode, &dmInfo.dnode);
   dmGetMonitorSystemInfo(&dmInfo.sys);
+  rpcGetBufStat(&dmInfo.rpcBuf);
   monSetDmInfo(&dmInfo);
 }
 
@@ -74,6 +74,11 @@ int32_t metaStatsCacheGet(SMeta* pMeta, int64_t uid, SMetaStbStats* pInfo);
 void    metaUpdateStbStats(SMeta* pMeta, int64_t uid, int64_t deltaCtb, int32_t deltaCol);
 int32_t metaUidFilterCacheGet(SMeta* pMeta, uint64_t suid, const void* pKey, int32_t keyLen, LRUHandle** pHandle);
 
+void metaTagStoreUpsert(SMeta* pMeta, tb_uid_t suid, tb_uid_t uid, const STag* pTag);
+void metaTagStoreDrop(SMeta* pMeta, tb_uid_t suid, tb_uid_t uid);
+void metaTagStoreClear(SMeta* pMeta, tb_uid_t suid);
+void metaTagStoreGetStat(SMeta* pMeta, int32_t* pNum, int64_t* pSize);
+
 struct SMeta {
   TdThreadRwlock lock;
 
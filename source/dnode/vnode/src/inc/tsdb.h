@@ -74,6 +74,7 @@ typedef struct SDiskDataBuilder SDiskDataBuilder;
 typedef struct SBlkInfo         SBlkInfo;
 typedef struct STsdbDataIter2   STsdbDataIter2;
 typedef struct STsdbFilterInfo  STsdbFilterInfo;
+typedef struct SLastIdx         SLastIdx;
 
 #define TSDBROW_ROW_FMT ((int8_t)0x0)
 #define TSDBROW_COL_FMT ((int8_t)0x1)
@@ -227,6 +228,7 @@ int32_t tsdbTbDataIterCreate(STbData *pTbData, TSDBKEY *pFrom, int8_t backward,
 void   *tsdbTbDataIterDestroy(STbDataIter *pIter);
 void    tsdbTbDataIterOpen(STbData *pTbData, TSDBKEY *pFrom, int8_t backward, STbDataIter *pIter);
 bool    tsdbTbDataIterNext(STbDataIter *pIter);
+TSDBROW *tsdbTbDataIterGetMerge(STbDataIter *pIter);
 void    tsdbMemTableCountRows(SMemTable *pMemTable, SSHashObj *pTableMap, int64_t *rowsNum);
 
 // STbData
@@ -377,6 +379,7 @@ struct STsdb {
   SLRUCache           *lruCache;
   SCacheFlushState     flushState;
   TdThreadMutex        lruMutex;
+  SLastIdx            *pLastIdx;  // read index of the last values in lruCache
   SLRUCache           *biCache;
   TdThreadMutex        biMutex;
   SLRUCache           *bCache;
@@ -409,16 +412,29 @@ typedef struct SMemSkipList {
   SMemSkipListNode *pTail;
 } SMemSkipList;
 
+// rows [iStart, iStart + nRow) of a block appended in order, chunks of a table are in ascending key order
+typedef struct SMemColChunk SMemColChunk;
+struct SMemColChunk {
+  SBlockData   *pBlockData;
+  int32_t       iStart;
+  int32_t       nRow;
+  SMemColChunk *pPrev;
+  SMemColChunk *pNext;
+};
+
 struct STbData {
-  tb_uid_t     suid;
-  tb_uid_t     uid;
-  TSKEY        minKey;
-  TSKEY        maxKey;
-  SDelData    *pHead;
-  SDelData    *pTail;
-  SMemSkipList sl;
-  STbData     *next;
-  SRBTreeNode  rbtn[1];
+  tb_uid_t      suid;
+  tb_uid_t      uid;
+  TSKEY         minKey;
+  TSKEY         maxKey;
+  SDelData     *pHead;
+  SDelData     *pTail;
+  SMemSkipList  sl;
+  SMemColChunk  chunk;  // sentinel of the columnar chunk list
+  SMemColChunk *pChunkTail;
+  int64_t       nChunkRow;
+  STbData      *next;
+  SRBTreeNode   rbtn[1];
 };
 
 struct SMemTable {
@@ -547,7 +563,10 @@ struct TABLEID {
 struct STbDataIter {
   STbData          *pTbData;
   int8_t            backward;
+  int8_t            inChunk;  // if the current row is from pChunk
   SMemSkipListNode *pNode;
+  SMemColChunk     *pChunk;  // NULL if no more columnar chunk rows
+  int32_t           iChunkRow;
   TSDBROW          *pRow;
   TSDBROW           row;
 };
@@ -657,6 +676,10 @@ typedef struct {
   int32_t     fid;
   int64_t     cid;
   int64_t     blkno;
+  // read-ahead window of the logical range [raOffset, raOffset + raSize), which is owned by the caller
+  uint8_t    *pRaBuf;
+  int64_t     raOffset;
+  int64_t     raSize;
 } STsdbFD;
 
 struct SDelFWriter {
@@ -861,7 +884,7 @@ typedef struct {
 
 int32_t tsdbOpenCache(STsdb *pTsdb);
 void    tsdbCloseCache(STsdb *pTsdb);
-int32_t tsdbCacheUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSDBROW *row);
+int32_t tsdbCacheUpdateBatch(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, SSubmitTbData *pSubmitTbData);
 int32_t tsdbCacheDel(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSKEY sKey, TSKEY eKey);
 
 int32_t tsdbCacheInsertLast(SLRUCache *pCache, tb_uid_t uid, TSDBROW *row, STsdb *pTsdb);
@@ -908,6 +931,11 @@ static FORCE_INLINE TSDBROW *tsdbTbDataIterGet(STbDataIter *pIter) {
     return pIter->pRow;
   }
 
+  if (pIter->pChunk) {
+    return tsdbTbDataIterGetMerge(pIter);
+  }
+
+  pIter->inChunk = 0;
   if (pIter->backward) {
     if (pIter->pNode == pIter->pTbData->sl.pHead) {
       return NULL;
@@ -49,6 +49,12 @@ int32_t vnodeEncodeConfig(const void* pObj, SJson* pJson);
 int32_t vnodeDecodeConfig(const SJson* pJson, void* pObj);
 
 // vnodeModule.c
+#define VNODE_COMMIT_THREAD_POOL 0
+#define VNODE_MERGE_THREAD_POOL  1
+#define VNODE_READ_THREAD_POOL   2  // load file sets and data blocks of queries ahead
+#define VNODE_FSET_THREAD_POOL   3  // commit file sets in parallel
+#define VNODE_THREAD_POOLS       4
+
 int vnodeScheduleTask(int (*execute)(void*), void* arg);
 int vnodeScheduleTaskEx(int tpid, int (*execute)(void*), void* arg);
 
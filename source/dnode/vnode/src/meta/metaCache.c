@@ -39,6 +39,18 @@ typedef struct SMetaStbStatsEntry {
   SMetaStbStats              info;
 } SMetaStbStatsEntry;
 
+// columnar copy of the tags of all child tables of a super table
+typedef struct SMetaTagStore {
+  tb_uid_t     suid;
+  int64_t      size;     // bytes of memory taken by the store
+  int32_t      nDirty;   // rows of dropped tables or with updated tags, the store is rebuilt when there are too many
+  SArray*      aUid;     // uid of each row, 0 for a dropped table
+  SHashObj*    pUidIdx;  // uid -> row
+  SSDataBlock* pBlock;   // one column for each tag, in the order of the tag schema
+  uint8_t*     pBuf;
+  TD_DLIST_NODE(SMetaTagStore) node;
+} SMetaTagStore;
+
 typedef struct STagFilterResEntry {
   SList    list;      // the linked list of md5 digest, extracted from the serialized tag query condition
   uint32_t hitTimes;  // queried times for current super table
@@ -78,6 +90,14 @@ struct SMetaCache {
     SHashObj* pStb;
     SHashObj* pStbName;
   } STbFilterCache;
+
+  // tag columns of super tables, built when the tags are filtered for the first time
+  struct STagColStore {
+    TdThreadMutex lock;
+    int64_t       size;  // bytes of memory taken by all stores, bounded by tsTagColumnarCacheSize
+    SHashObj*     pStb;  // suid -> SMetaTagStore*
+    TD_DLIST(SMetaTagStore) lru;  // the most recently used store first, evicted from the tail
+  } sTagColStore;
 };
 
 static void entryCacheClose(SMeta* pMeta) {
@@ -110,6 +130,18 @@ static void statsCacheClose(SMeta* pMeta) {
   }
 }
 
+static void metaTagStoreDestroy(SMetaTagStore* pStore) {
+  if (pStore) {
+    taosArrayDestroy(pStore->aUid);
+    taosHashCleanup(pStore->pUidIdx);
+    blockDataDestroy(pStore->pBlock);
+    tFree(pStore->pBuf);
+    taosMemoryFree(pStore);
+  }
+}
+
+static void freeTagStoreFp(void* param) { metaTagStoreDestroy(*(SMetaTagStore**)param); }
+
 static void freeCacheEntryFp(void* param) {
   STagFilterResEntry** p = param;
   tdListEmpty(&(*p)->list);
@@ -193,6 +225,16 @@ int32_t metaCacheOpen(SMeta* pMeta) {
     goto _err2;
   }
 
+  pCache->sTagColStore.pStb = taosHashInit(0, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false, HASH_NO_LOCK);
+  if (pCache->sTagColStore.pStb == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _err2;
+  }
+
+  taosHashSetFreeFp(pCache->sTagColStore.pStb, freeTagStoreFp);
+  taosThreadMutexInit(&pCache->sTagColStore.lock, NULL);
+  TD_DLIST_INIT(&pCache->sTagColStore.lru);
+
   pMeta->pCache = pCache;
   return code;
 
@@ -221,6 +263,9 @@ void metaCacheClose(SMeta* pMeta) {
     taosHashCleanup(pMeta->pCache->STbFilterCache.pStb);
     taosHashCleanup(pMeta->pCache->STbFilterCache.pStbName);
 
+    taosThreadMutexDestroy(&pMeta->pCache->sTagColStore.lock);
+    taosHashCleanup(pMeta->pCache->sTagColStore.pStb);
+
     taosMemoryFree(pMeta->pCache);
     pMeta->pCache = NULL;
   }
@@ -965,3 +1010,392 @@ int32_t metaInitTbFilterCache(SMeta* pMeta) {
 #endif
   return 0;
 }
+
+// tag column store ====================
+#define META_TAG_STORE_MIN_ROWS 1024
+
+static int32_t metaTagStorePut(SMetaTagStore* pStore, int32_t iRow, const STag* pTag) {
+  int32_t code = 0;
+  int32_t nCol = taosArrayGetSize(pStore->pBlock->pDataBlock);
+
+  for (int32_t iCol = 0; iCol < nCol; iCol++) {
+    SColumnInfoData* pCol = taosArrayGet(pStore->pBlock->pDataBlock, iCol);
+    STagVal          tagVal = {.cid = pCol->info.colId};
+
+    if (pTag == NULL || !tTagGet(pTag, &tagVal)) {
+      colDataSetNULL(pCol, iRow);
+    } else if (IS_VAR_DATA_TYPE(pCol->info.type)) {
+      code = tRealloc(&pStore->pBuf, tagVal.nData + VARSTR_HEADER_SIZE);
+      if (code) return code;
+
+      varDataSetLen(pStore->pBuf, tagVal.nData);
+      memcpy(varDataVal(pStore->pBuf), tagVal.pData, tagVal.nData);
+      code = colDataSetVal(pCol, iRow, (const char*)pStore->pBuf, false);
+      if (code) return code;
+    } else {
+      colDataSetVal(pCol, iRow, (const char*)&tagVal.i64, false);
+    }
+  }
+
+  return code;
+}
+
+static int32_t metaTagStoreAppend(SMetaTagStore* pStore, tb_uid_t uid, const STag* pTag) {
+  SSDataBlock* pBlock = pStore->pBlock;
+  int32_t      iRow = pBlock->info.rows;
+  int32_t      code = 0;
+
+  if (iRow >= pBlock->info.capacity) {
+    code = blockDataEnsureCapacity(pBlock, TMAX(META_TAG_STORE_MIN_ROWS, pBlock->info.capacity * 2));
+    if (code) return code;
+  }
+
+  code = metaTagStorePut(pStore, iRow, pTag);
+  if (code) return code;
+
+  if (taosArrayPush(pStore->aUid, &uid) == NULL) return TSDB_CODE_OUT_OF_MEMORY;
+  if (taosHashPut(pStore->pUidIdx, &uid, sizeof(uid), &iRow, sizeof(iRow))) {
+    taosArrayPop(pStore->aUid);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  pBlock->info.rows++;
+  return code;
+}
+
+static int32_t metaTagStoreBuild(SMeta* pMeta, tb_uid_t suid, SMetaTagStore** ppStore) {
+  int32_t        code = 0;
+  SMetaReader    mr = {0};
+  SMCtbCursor*   pCur = NULL;
+  SMetaTagStore* pStore = NULL;
+
+  metaReaderDoInit(&mr, pMeta, META_READER_NOLOCK);
+  if (metaReaderGetTableEntryByUid(&mr, suid) < 0 || mr.me.type != TSDB_SUPER_TABLE) {
+    code = TSDB_CODE_NOT_FOUND;
+    goto _exit;
+  }
+
+  pStore = taosMemoryCalloc(1, sizeof(SMetaTagStore));
+  if (pStore == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  pStore->aUid = taosArrayInit(META_TAG_STORE_MIN_ROWS, sizeof(tb_uid_t));
+  pStore->pUidIdx = taosHashInit(META_TAG_STORE_MIN_ROWS, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false,
+                                 HASH_NO_LOCK);
+  pStore->pBlock = createDataBlock();
+  if (pStore->aUid == NULL || pStore->pUidIdx == NULL || pStore->pBlock == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  // the json tag is kept as a whole, filtering on it is left to the query
+  SSchemaWrapper* pTagSchema = &mr.me.stbEntry.schemaTag;
+  for (int32_t i = 0; i < pTagSchema->nCols; i++) {
+    SSchema* pSchema = &pTagSchema->pSchema[i];
+    if (pSchema->type == TSDB_DATA_TYPE_JSON) {
+      code = TSDB_CODE_OPS_NOT_SUPPORT;
+      goto _exit;
+    }
+
+    SColumnInfoData colInfo = createColumnInfoData(pSchema->type, pSchema->bytes, pSchema->colId);
+    code = blockDataAppendColInfo(pStore->pBlock, &colInfo);
+    if (code) goto _exit;
+  }
+
+  pCur = metaOpenCtbCursor(pMeta->pVnode, suid, 0);
+  if (pCur == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  for (tb_uid_t uid; (uid = metaCtbCursorNext(pCur)) != 0;) {
+    code = metaTagStoreAppend(pStore, uid, (const STag*)pCur->pVal);
+    if (code) goto _exit;
+  }
+
+  metaDebug("vgId:%d, suid:%" PRId64 " tag column store built, tables:%" PRId64, TD_VID(pMeta->pVnode), suid,
+            pStore->pBlock->info.rows);
+
+_exit:
+  metaCloseCtbCursor(pCur);
+  metaReaderClear(&mr);
+  if (code) {
+    metaTagStoreDestroy(pStore);
+    pStore = NULL;
+  }
+  *ppStore = pStore;
+  return code;
+}
+
+static FORCE_INLINE bool metaTagStoreTooDirty(const SMetaTagStore* pStore) {
+  return pStore->nDirty > META_TAG_STORE_MIN_ROWS && pStore->nDirty > pStore->pBlock->info.rows / 2;
+}
+
+static int64_t metaTagStoreCalcSize(const SMetaTagStore* pStore) {
+  const SSDataBlock* pBlock = pStore->pBlock;
+  int32_t            nCol = taosArrayGetSize(pBlock->pDataBlock);
+  int64_t            capacity = pBlock->info.capacity;
+  int64_t            size = sizeof(SMetaTagStore) + sizeof(tb_uid_t) * pStore->aUid->capacity +
+                 taosHashGetMemSize(pStore->pUidIdx) +
+                 (sizeof(tb_uid_t) + sizeof(int32_t)) * taosHashGetSize(pStore->pUidIdx);
+
+  for (int32_t iCol = 0; iCol < nCol; iCol++) {
+    const SColumnInfoData* pCol = taosArrayGet(pBlock->pDataBlock, iCol);
+    if (IS_VAR_DATA_TYPE(pCol->info.type)) {
+      size += sizeof(int32_t) * capacity + pCol->varmeta.allocLen;
+    } else {
+      size += pCol->info.bytes * capacity + BitmapLen(capacity);
+    }
+  }
+
+  return size;
+}
+
+static void metaTagStoreResize(SMetaCache* pCache, SMetaTagStore* pStore) {
+  int64_t size = metaTagStoreCalcSize(pStore);
+  pCache->sTagColStore.size += size - pStore->size;
+  pStore->size = size;
+}
+
+static void metaTagStoreRemove(SMetaCache* pCache, SMetaTagStore* pStore) {
+  tb_uid_t suid = pStore->suid;
+
+  TD_DLIST_POP_WITH_FIELD(&pCache->sTagColStore.lru, pStore, node);
+  pCache->sTagColStore.size -= pStore->size;
+  taosHashRemove(pCache->sTagColStore.pStb, &suid, sizeof(suid));
+}
+
+// evict the least recently used stores until they take no more than tsTagColumnarCacheSize, they are built again by the
+// next query asking for them
+static void metaTagStoreEvict(SMeta* pMeta) {
+  SMetaCache* pCache = pMeta->pCache;
+  int64_t     limit = (int64_t)tsTagColumnarCacheSize * 1024 * 1024;
+
+  while (pCache->sTagColStore.size > limit && TD_DLIST_TAIL(&pCache->sTagColStore.lru) != NULL) {
+    SMetaTagStore* pStore = TD_DLIST_TAIL(&pCache->sTagColStore.lru);
+    metaDebug("vgId:%d, suid:%" PRId64 " tag column store evicted, size:%" PRId64 ", total size:%" PRId64,
+              TD_VID(pMeta->pVnode), pStore->suid, pStore->size, pCache->sTagColStore.size);
+    metaTagStoreRemove(pCache, pStore);
+  }
+}
+
+void metaTagStoreGetStat(SMeta* pMeta, int32_t* pNum, int64_t* pSize) {
+  taosThreadMutexLock(&pMeta->pCache->sTagColStore.lock);
+  *pNum = TD_DLIST_NELES(&pMeta->pCache->sTagColStore.lru);
+  *pSize = pMeta->pCache->sTagColStore.size;
+  taosThreadMutexUnlock(&pMeta->pCache->sTagColStore.lock);
+}
+
+// the writers update the tag column stores with the meta write lock held, so the readers holding the read lock see
+// them consistent with the tdb tables
+void metaTagStoreUpsert(SMeta* pMeta, tb_uid_t suid, tb_uid_t uid, const STag* pTag) {
+  TdThreadMutex* pLock = &pMeta->pCache->sTagColStore.lock;
+
+  taosThreadMutexLock(pLock);
+  SMetaTagStore** ppStore = taosHashGet(pMeta->pCache->sTagColStore.pStb, &suid, sizeof(suid));
+  if (ppStore) {
+    SMetaTagStore* pStore = *ppStore;
+    int32_t*       pRow = taosHashGet(pStore->pUidIdx, &uid, sizeof(uid));
+    int32_t        code = 0;
+
+    if (pRow) {
+      pStore->nDirty++;
+      code = metaTagStorePut(pStore, *pRow, pTag);
+    } else {
+      code = metaTagStoreAppend(pStore, uid, pTag);
+    }
+
+    // dropped to be rebuilt by the next query, rather than left inconsistent
+    if (code || metaTagStoreTooDirty(pStore)) {
+      metaTagStoreRemove(pMeta->pCache, pStore);
+    } else {
+      metaTagStoreResize(pMeta->pCache, pStore);
+      metaTagStoreEvict(pMeta);
+    }
+  }
+  taosThreadMutexUnlock(pLock);
+}
+
+void metaTagStoreDrop(SMeta* pMeta, tb_uid_t suid, tb_uid_t uid) {
+  TdThreadMutex* pLock = &pMeta->pCache->sTagColStore.lock;
+
+  taosThreadMutexLock(pLock);
+  SMetaTagStore** ppStore = taosHashGet(pMeta->pCache->sTagColStore.pStb, &suid, sizeof(suid));
+  if (ppStore) {
+    SMetaTagStore* pStore = *ppStore;
+    int32_t*       pRow = taosHashGet(pStore->pUidIdx, &uid, sizeof(uid));
+
+    if (pRow) {
+      *(tb_uid_t*)taosArrayGet(pStore->aUid, *pRow) = 0;
+      taosHashRemove(pStore->pUidIdx, &uid, sizeof(uid));
+      pStore->nDirty++;
+    }
+
+    if (metaTagStoreTooDirty(pStore)) {
+      metaTagStoreRemove(pMeta->pCache, pStore);
+    }
+  }
+  taosThreadMutexUnlock(pLock);
+}
+
+void metaTagStoreClear(SMeta* pMeta, tb_uid_t suid) {
+  taosThreadMutexLock(&pMeta->pCache->sTagColStore.lock);
+  SMetaTagStore** ppStore = taosHashGet(pMeta->pCache->sTagColStore.pStb, &suid, sizeof(suid));
+  if (ppStore) {
+    metaTagStoreRemove(pMeta->pCache, *ppStore);
+  }
+  taosThreadMutexUnlock(&pMeta->pCache->sTagColStore.lock);
+}
+
+static int32_t metaTagStoreCopyRow(SColumnInfoData* pDst, int32_t iDst, const SColumnInfoData* pSrc, int32_t iSrc) {
+  if (colDataIsNull_s(pSrc, iSrc)) {
+    colDataSetNULL(pDst, iDst);
+    return TSDB_CODE_SUCCESS;
+  }
+
+  return colDataSetVal(pDst, iDst, colDataGetData(pSrc, iSrc), false);
+}
+
+/*
+ * Get the tag columns in pColList of the child tables of a super table from the tag column store, which is built
+ * when it is asked for the first time. If pUidTagList is empty, all child tables are added to it, otherwise the rows
+ * of the block are the tags of the tables in it. *ppBlock is set to NULL if the columns can not be got from the
+ * store, for the table name or json tags, and the tags should be got from tdb then.
+ */
+int32_t metaGetTableTagBlock(void* pVnode, uint64_t suid, SArray* pColList, SArray* pUidTagList,
+                             SSDataBlock** ppBlock) {
+  SMeta*         pMeta = ((SVnode*)pVnode)->pMeta;
+  TdThreadMutex* pLock = &pMeta->pCache->sTagColStore.lock;
+  int32_t        nCol = taosArrayGetSize(pColList);
+  int32_t        nReq = taosArrayGetSize(pUidTagList);
+  int32_t        aSrcCol[TSDB_MAX_TAGS];
+  SSDataBlock*   pBlock = NULL;
+  int32_t        code = 0;
+
+  *ppBlock = NULL;
+  if (!tsTagColumnarCache || nCol == 0 || nCol > TSDB_MAX_TAGS) return code;
+
+  metaRLock(pMeta);
+  taosThreadMutexLock(pLock);
+
+  SMetaCache*     pCache = pMeta->pCache;
+  SMetaTagStore*  pStore = NULL;
+  SMetaTagStore** ppStore = taosHashGet(pCache->sTagColStore.pStb, &suid, sizeof(suid));
+  if (ppStore) {
+    pStore = *ppStore;
+    TD_DLIST_POP_WITH_FIELD(&pCache->sTagColStore.lru, pStore, node);
+    TD_DLIST_PREPEND_WITH_FIELD(&pCache->sTagColStore.lru, pStore, node);
+  } else {
+    if (metaTagStoreBuild(pMeta, suid, &pStore)) goto _exit;
+
+    pStore->suid = suid;
+    if (taosHashPut(pCache->sTagColStore.pStb, &suid, sizeof(suid), &pStore, POINTER_BYTES)) {
+      metaTagStoreDestroy(pStore);
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      goto _exit;
+    }
+    TD_DLIST_PREPEND_WITH_FIELD(&pCache->sTagColStore.lru, pStore, node);
+    metaTagStoreResize(pCache, pStore);
+  }
+
+  // the columns should match the tag schema of the store, or the query is planned with another one
+  int32_t nStoreCol = taosArrayGetSize(pStore->pBlock->pDataBlock);
+  for (int32_t i = 0; i < nCol; i++) {
+    SColumnInfo* pInfo = taosArrayGet(pColList, i);
+
+    aSrcCol[i] = -1;
+    for (int32_t j = 0; j < nStoreCol; j++) {
+      SColumnInfoData* pSrc = taosArrayGet(pStore->pBlock->pDataBlock, j);
+      if (pSrc->info.colId == pInfo->colId && pSrc->info.type == pInfo->type && pSrc->info.bytes == pInfo->bytes) {
+        aSrcCol[i] = j;
+        break;
+      }
+    }
+    if (aSrcCol[i] < 0) goto _exit;
+  }
+
+  pBlock = createDataBlock();
+  if (pBlock == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  for (int32_t i = 0; i < nCol; i++) {
+    SColumnInfoData colInfo = {.info = *(SColumnInfo*)taosArrayGet(pColList, i)};
+    code = blockDataAppendColInfo(pBlock, &colInfo);
+    if (code) goto _exit;
+  }
+
+  int32_t nStoreRow = pStore->pBlock->info.rows;
+  code = blockDataEnsureCapacity(pBlock, nReq > 0 ? nReq : nStoreRow);
+  if (code) goto _exit;
+
+  if (nReq == 0 && taosHashGetSize(pStore->pUidIdx) == nStoreRow) {
+    // no table is dropped, copy the columns as a whole
+    for (int32_t i = 0; i < nCol; i++) {
+      SColumnInfoData* pDst = taosArrayGet(pBlock->pDataBlock, i);
+      SColumnInfo      info = pDst->info;
+
+      code = colDataAssign(pDst, taosArrayGet(pStore->pBlock->pDataBlock, aSrcCol[i]), nStoreRow, &pBlock->info);
+      if (code) goto _exit;
+      pDst->info = info;
+    }
+
+    for (int32_t iRow = 0; iRow < nStoreRow; iRow++) {
+      STUidTagInfo info = {.uid = *(tb_uid_t*)taosArrayGet(pStore->aUid, iRow)};
+      if (taosArrayPush(pUidTagList, &info) == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
+      }
+    }
+    pBlock->info.rows = nStoreRow;
+  } else if (nReq == 0) {
+    for (int32_t iRow = 0; iRow < nStoreRow; iRow++) {
+      STUidTagInfo info = {.uid = *(tb_uid_t*)taosArrayGet(pStore->aUid, iRow)};
+      if (info.uid == 0) continue;
+
+      for (int32_t i = 0; i < nCol; i++) {
+        code = metaTagStoreCopyRow(taosArrayGet(pBlock->pDataBlock, i),
+                                   pBlock->info.rows, taosArrayGet(pStore->pBlock->pDataBlock, aSrcCol[i]), iRow);
+        if (code) goto _exit;
+      }
+      if (taosArrayPush(pUidTagList, &info) == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
+      }
+      pBlock->info.rows++;
+    }
+  } else {
+    for (int32_t iReq = 0; iReq < nReq; iReq++) {
+      STUidTagInfo* pInfo = taosArrayGet(pUidTagList, iReq);
+      int32_t*      pRow = taosHashGet(pStore->pUidIdx, &pInfo->uid, sizeof(pInfo->uid));
+
+      for (int32_t i = 0; i < nCol; i++) {
+        SColumnInfoData* pDst = taosArrayGet(pBlock->pDataBlock, i);
+        if (pRow == NULL) {
+          colDataSetNULL(pDst, iReq);
+        } else {
+          code = metaTagStoreCopyRow(pDst, iReq, taosArrayGet(pStore->pBlock->pDataBlock, aSrcCol[i]), *pRow);
+          if (code) goto _exit;
+        }
+      }
+    }
+    pBlock->info.rows = nReq;
+  }
+
+  *ppBlock = pBlock;
+  pBlock = NULL;
+
+_exit:
+  // the store just used is evicted too if it alone is larger than the limit, after its columns are copied
+  metaTagStoreEvict(pMeta);
+  taosThreadMutexUnlock(pLock);
+  metaULock(pMeta);
+  if (code && nReq == 0) {
+    taosArrayClear(pUidTagList);
+  }
+  blockDataDestroy(pBlock);
+  return code;
+}
@@ -424,9 +424,113 @@ static void reallocVarData(SColVal *pColVal) {
   }
 }
 
+static void tsdbCacheDeleter(const void *key, size_t klen, void *value, void *ud);
+
+// last value index ==============================================================================================
+// The index maps the keys of the last values in the lru cache to the values owned by the cache, so that readers can
+// copy the last values of a table under the read lock of a single shard, instead of going through the mutexes of the
+// lru cache for each column. A value is added to the index while it is pinned in the lru cache and removed by the
+// deleter of the cache before it is freed, and the writers update values in place under the write lock of the shard.
+#define TSDB_LAST_IDX_SHARDS 64
+
+typedef struct {
+  TdThreadRwlock lock;
+  SHashObj      *pHash;  // SLastKey -> SLastCol *
+} SLastIdxShard;
+
+struct SLastIdx {
+  SLastIdxShard aShard[TSDB_LAST_IDX_SHARDS];
+};
+
+static int32_t tsdbLastIdxOpen(SLastIdx **ppIdx) {
+  SLastIdx *pIdx = taosMemoryCalloc(1, sizeof(*pIdx));
+  if (pIdx == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < TSDB_LAST_IDX_SHARDS; i++) {
+    SLastIdxShard *pShard = &pIdx->aShard[i];
+
+    taosThreadRwlockInit(&pShard->lock, NULL);
+    pShard->pHash = taosHashInit(256, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+    if (pShard->pHash == NULL) {
+      for (int32_t j = 0; j <= i; j++) {
+        taosHashCleanup(pIdx->aShard[j].pHash);
+        taosThreadRwlockDestroy(&pIdx->aShard[j].lock);
+      }
+      taosMemoryFree(pIdx);
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+
+  *ppIdx = pIdx;
+  return 0;
+}
+
+static void tsdbLastIdxClose(SLastIdx **ppIdx) {
+  SLastIdx *pIdx = *ppIdx;
+  if (pIdx == NULL) return;
+
+  for (int32_t i = 0; i < TSDB_LAST_IDX_SHARDS; i++) {
+    taosHashCleanup(pIdx->aShard[i].pHash);
+    taosThreadRwlockDestroy(&pIdx->aShard[i].lock);
+  }
+  taosMemoryFree(pIdx);
+  *ppIdx = NULL;
+}
+
+static FORCE_INLINE SLastIdxShard *tsdbLastIdxShard(STsdb *pTsdb, tb_uid_t uid) {
+  uint64_t h = (uint64_t)uid * 0x9E3779B97F4A7C15ULL;
+  return &pTsdb->pLastIdx->aShard[(h >> 32) % TSDB_LAST_IDX_SHARDS];
+}
+
+static void tsdbLastIdxPut(STsdb *pTsdb, const SLastKey *pKey, SLastCol *pLastCol) {
+  if (pTsdb->pLastIdx == NULL) return;
+
+  SLastIdxShard *pShard = tsdbLastIdxShard(pTsdb, pKey->uid);
+
+  taosThreadRwlockWrlock(&pShard->lock);
+  taosHashPut(pShard->pHash, pKey, ROCKS_KEY_LEN, &pLastCol, POINTER_BYTES);
+  taosThreadRwlockUnlock(&pShard->lock);
+}
+
+static void tsdbLastIdxRemove(STsdb *pTsdb, const SLastKey *pKey, SLastCol *pLastCol) {
+  if (pTsdb->pLastIdx == NULL) return;
+
+  SLastIdxShard *pShard = tsdbLastIdxShard(pTsdb, pKey->uid);
+
+  taosThreadRwlockWrlock(&pShard->lock);
+  SLastCol **ppLastCol = taosHashGet(pShard->pHash, pKey, ROCKS_KEY_LEN);
+  if (ppLastCol && *ppLastCol == pLastCol) {
+    taosHashRemove(pShard->pHash, pKey, ROCKS_KEY_LEN);
+  }
+  taosThreadRwlockUnlock(&pShard->lock);
+}
+
+// insert a last value into the lru cache, which takes the ownership, and index it
+static LRUStatus tsdbCacheInsertLastCol(STsdb *pTsdb, SLastKey *pKey, SLastCol *pLastCol) {
+  size_t charge = sizeof(*pLastCol);
+  if (IS_VAR_DATA_TYPE(pLastCol->colVal.type)) {
+    charge += pLastCol->colVal.value.nData;
+  }
+
+  // pin the value, or it may be evicted at once if the cache is full
+  LRUHandle *h = NULL;
+  LRUStatus  status = taosLRUCacheInsert(pTsdb->lruCache, pKey, ROCKS_KEY_LEN, pLastCol, charge, tsdbCacheDeleter, &h,
+                                         TAOS_LRU_PRIORITY_LOW, &pTsdb->flushState);
+  if (h) {
+    tsdbLastIdxPut(pTsdb, pKey, pLastCol);
+    taosLRUCacheRelease(pTsdb->lruCache, h, false);
+  }
+
+  return status;
+}
+
 static void tsdbCacheDeleter(const void *key, size_t klen, void *value, void *ud) {
   SLastCol *pLastCol = (SLastCol *)value;
 
+  tsdbLastIdxRemove(((SCacheFlushState *)ud)->pTsdb, key, pLastCol);
+
   if (pLastCol->dirty) {
     tsdbCachePutBatch(pLastCol, key, klen, (SCacheFlushState *)ud);
   }
@@ -443,119 +547,74 @@ typedef struct {
   SLastKey key;
 } SIdxKey;
 
-int32_t tsdbCacheUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSDBROW *pRow) {
-  int32_t code = 0;
+// update a last value in the lru cache in place, it is written back to rocks when flushed or evicted
+static void tsdbCacheUpdateLastCol(STsdb *pTsdb, tb_uid_t uid, SLastCol *pLastCol, TSKEY keyTs, SColVal *pColVal) {
+  if (pLastCol->ts > keyTs) return;
 
-  // 1, fetch schema
-  STSchema *pTSchema = NULL;
-  int32_t   sver = TSDBROW_SVERSION(pRow);
+  SLastIdxShard *pShard = pTsdb->pLastIdx ? tsdbLastIdxShard(pTsdb, uid) : NULL;
+  if (pShard) taosThreadRwlockWrlock(&pShard->lock);
 
-  code = metaGetTbTSchemaEx(pTsdb->pVnode->pMeta, suid, uid, sver, &pTSchema);
-  if (code != TSDB_CODE_SUCCESS) {
-    terrno = code;
-    return -1;
+  uint8_t *pVal = NULL;
+  int      nData = pLastCol->colVal.value.nData;
+  if (IS_VAR_DATA_TYPE(pColVal->type)) {
+    pVal = pLastCol->colVal.value.pData;
+  }
+  pLastCol->ts = keyTs;
+  pLastCol->colVal = *pColVal;
+  if (IS_VAR_DATA_TYPE(pColVal->type)) {
+    if (nData < pColVal->value.nData) {
+      taosMemoryFree(pVal);
+      pLastCol->colVal.value.pData = taosMemoryCalloc(1, pColVal->value.nData);
+    } else {
+      pLastCol->colVal.value.pData = pVal;
+    }
+    if (pColVal->value.nData) {
+      memcpy(pLastCol->colVal.value.pData, pColVal->value.pData, pColVal->value.nData);
+    }
   }
 
-  // 2, iterate col values into array
-  SArray *aColVal = taosArrayInit(32, sizeof(SColVal));
+  if (!pLastCol->dirty) {
+    pLastCol->dirty = 1;
+  }
 
-  STSDBRowIter iter = {0};
-  tsdbRowIterOpen(&iter, pRow, pTSchema);
+  if (pShard) taosThreadRwlockUnlock(&pShard->lock);
+}
 
-  for (SColVal *pColVal = tsdbRowIterNext(&iter); pColVal; pColVal = tsdbRowIterNext(&iter)) {
-    taosArrayPush(aColVal, pColVal);
-  }
+typedef struct {
+  SLastKey key;
+  TSKEY    ts;
+  SColVal  colVal;
+} SLastUpdCol;
 
-  tsdbRowClose(&iter);
+static void tsdbCacheAddUpdCol(SArray *aUpdCol, tb_uid_t uid, int8_t ltype, TSKEY ts, const SColVal *pColVal) {
+  SLastUpdCol updCol = {.key = {.ltype = ltype, .uid = uid, .cid = pColVal->cid}, .ts = ts, .colVal = *pColVal};
+  taosArrayPush(aUpdCol, &updCol);
+}
 
-  // 3, build keys & multi get from rocks
-  int        num_keys = TARRAY_SIZE(aColVal);
-  TSKEY      keyTs = TSDBROW_TS(pRow);
+// merge the new last values of a table into the cache, the ones missed in the cache are checked against rocks and
+// cached as dirty, to be written back to rocks in batch when flushed or evicted
+static int32_t tsdbCacheUpdateLastCols(STsdb *pTsdb, tb_uid_t uid, SArray *aUpdCol) {
+  int32_t    code = 0;
+  int        num_keys = TARRAY_SIZE(aUpdCol);
   SArray    *remainCols = NULL;
   SLRUCache *pCache = pTsdb->lruCache;
 
   taosThreadMutexLock(&pTsdb->lruMutex);
   for (int i = 0; i < num_keys; ++i) {
-    SColVal *pColVal = (SColVal *)taosArrayGet(aColVal, i);
-    int16_t  cid = pColVal->cid;
+    SLastUpdCol *pUpdCol = (SLastUpdCol *)TARRAY_DATA(aUpdCol) + i;
 
-    SLastKey  *key = &(SLastKey){.ltype = 0, .uid = uid, .cid = cid};
-    size_t     klen = ROCKS_KEY_LEN;
-    LRUHandle *h = taosLRUCacheLookup(pCache, key, klen);
+    LRUHandle *h = taosLRUCacheLookup(pCache, &pUpdCol->key, ROCKS_KEY_LEN);
     if (h) {
       SLastCol *pLastCol = (SLastCol *)taosLRUCacheValue(pCache, h);
 
-      if (pLastCol->ts <= keyTs) {
-        uint8_t *pVal = NULL;
-        int      nData = pLastCol->colVal.value.nData;
-        if (IS_VAR_DATA_TYPE(pColVal->type)) {
-          pVal = pLastCol->colVal.value.pData;
-        }
-        pLastCol->ts = keyTs;
-        pLastCol->colVal = *pColVal;
-        if (IS_VAR_DATA_TYPE(pColVal->type)) {
-          if (nData < pColVal->value.nData) {
-            taosMemoryFree(pVal);
-            pLastCol->colVal.value.pData = taosMemoryCalloc(1, pColVal->value.nData);
-          } else {
-            pLastCol->colVal.value.pData = pVal;
-          }
-          if (pColVal->value.nData) {
-            memcpy(pLastCol->colVal.value.pData, pColVal->value.pData, pColVal->value.nData);
-          }
-        }
-
-        if (!pLastCol->dirty) {
-          pLastCol->dirty = 1;
-        }
-      }
+      tsdbCacheUpdateLastCol(pTsdb, uid, pLastCol, pUpdCol->ts, &pUpdCol->colVal);
 
       taosLRUCacheRelease(pCache, h, false);
     } else {
       if (!remainCols) {
-        remainCols = taosArrayInit(num_keys * 2, sizeof(SIdxKey));
-      }
-      taosArrayPush(remainCols, &(SIdxKey){i, *key});
-    }
-
-    if (COL_VAL_IS_VALUE(pColVal)) {
-      key->ltype = 1;
-      LRUHandle *h = taosLRUCacheLookup(pCache, key, klen);
-      if (h) {
-        SLastCol *pLastCol = (SLastCol *)taosLRUCacheValue(pCache, h);
-
-        if (pLastCol->ts <= keyTs) {
-          uint8_t *pVal = NULL;
-          int      nData = pLastCol->colVal.value.nData;
-          if (IS_VAR_DATA_TYPE(pColVal->type)) {
-            pVal = pLastCol->colVal.value.pData;
-          }
-          pLastCol->ts = keyTs;
-          pLastCol->colVal = *pColVal;
-          if (IS_VAR_DATA_TYPE(pColVal->type)) {
-            if (nData < pColVal->value.nData) {
-              taosMemoryFree(pVal);
-              pLastCol->colVal.value.pData = taosMemoryCalloc(1, pColVal->value.nData);
-            } else {
-              pLastCol->colVal.value.pData = pVal;
-            }
-            if (pColVal->value.nData) {
-              memcpy(pLastCol->colVal.value.pData, pColVal->value.pData, pColVal->value.nData);
-            }
-          }
-
-          if (!pLastCol->dirty) {
-            pLastCol->dirty = 1;
-          }
-        }
-
-        taosLRUCacheRelease(pCache, h, false);
-      } else {
-        if (!remainCols) {
-          remainCols = taosArrayInit(num_keys * 2, sizeof(SIdxKey));
-        }
-        taosArrayPush(remainCols, &(SIdxKey){i, *key});
+        remainCols = taosArrayInit(num_keys, sizeof(int32_t));
       }
+      taosArrayPush(remainCols, &i);
     }
   }
 
@@ -566,14 +625,15 @@ int32_t tsdbCacheUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSDBROW *pRow
     char  **keys_list = taosMemoryCalloc(num_keys, sizeof(char *));
     size_t *keys_list_sizes = taosMemoryCalloc(num_keys, sizeof(size_t));
     for (int i = 0; i < num_keys; ++i) {
-      SIdxKey *idxKey = &((SIdxKey *)TARRAY_DATA(remainCols))[i];
+      SLastUpdCol *pUpdCol = (SLastUpdCol *)TARRAY_DATA(aUpdCol) + ((int32_t *)TARRAY_DATA(remainCols))[i];
 
-      keys_list[i] = (char *)&idxKey->key;
+      keys_list[i] = (char *)&pUpdCol->key;
       keys_list_sizes[i] = ROCKS_KEY_LEN;
     }
     char  **values_list = taosMemoryCalloc(num_keys, sizeof(char *));
     size_t *values_list_sizes = taosMemoryCalloc(num_keys, sizeof(size_t));
     char  **errs = taosMemoryCalloc(num_keys, sizeof(char *));
+    rocksMayWrite(pTsdb, true, false, true);
     rocksdb_multi_get(pTsdb->rCache.db, pTsdb->rCache.readoptions, num_keys, (const char *const *)keys_list,
                       keys_list_sizes, values_list, values_list_sizes, errs);
     for (int i = 0; i < num_keys; ++i) {
@@ -584,94 +644,106 @@ int32_t tsdbCacheUpdate(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSDBROW *pRow
     taosMemoryFree(keys_list_sizes);
     taosMemoryFree(values_list_sizes);
 
-    rocksdb_writebatch_t *wb = pTsdb->rCache.writebatch;
     for (int i = 0; i < num_keys; ++i) {
-      SIdxKey *idxKey = &((SIdxKey *)TARRAY_DATA(remainCols))[i];
-      SColVal *pColVal = (SColVal *)TARRAY_DATA(aColVal) + idxKey->idx;
-      // SColVal *pColVal = (SColVal *)taosArrayGet(aColVal, idxKey->idx);
+      SLastUpdCol *pUpdCol = (SLastUpdCol *)TARRAY_DATA(aUpdCol) + ((int32_t *)TARRAY_DATA(remainCols))[i];
+      SLastCol    *pLastCol = tsdbCacheDeserialize(values_list[i]);
 
-      SLastCol *pLastCol = tsdbCacheDeserialize(values_list[i]);
+      if (NULL == pLastCol || pLastCol->ts <= pUpdCol->ts) {
+        SLastCol *pNewLastCol = taosMemoryCalloc(1, sizeof(SLastCol));
+        if (pNewLastCol == NULL) {
+          code = -1;
+        } else {
+          *pNewLastCol = (SLastCol){.ts = pUpdCol->ts, .dirty = 1, .colVal = pUpdCol->colVal};
+          reallocVarData(&pNewLastCol->colVal);
 
-      if (idxKey->key.ltype == 0) {
-        if (NULL == pLastCol || pLastCol->ts <= keyTs) {
-          char  *value = NULL;
-          size_t vlen = 0;
-          tsdbCacheSerialize(&(SLastCol){.ts = keyTs, .colVal = *pColVal}, &value, &vlen);
-          // SLastKey key = (SLastKey){.ltype = 0, .uid = uid, .cid = pColVal->cid};
-          taosThreadMutexLock(&pTsdb->rCache.rMutex);
+          LRUStatus status = tsdbCacheInsertLastCol(pTsdb, &pUpdCol->key, pNewLastCol);
+          if (status != TAOS_LRU_STATUS_OK && status != TAOS_LRU_STATUS_OK_OVERWRITTEN) {
+            code = -1;
+          }
+        }
+      }
 
-          rocksdb_writebatch_put(wb, (char *)&idxKey->key, ROCKS_KEY_LEN, value, vlen);
+      rocksdb_free(values_list[i]);
+    }
 
-          taosThreadMutexUnlock(&pTsdb->rCache.rMutex);
+    taosMemoryFree(values_list);
 
-          pLastCol = (SLastCol *)value;
-          SLastCol *pTmpLastCol = taosMemoryCalloc(1, sizeof(SLastCol));
-          *pTmpLastCol = *pLastCol;
-          pLastCol = pTmpLastCol;
+    taosArrayDestroy(remainCols);
+  }
 
-          reallocVarData(&pLastCol->colVal);
-          size_t charge = sizeof(*pLastCol);
-          if (IS_VAR_DATA_TYPE(pLastCol->colVal.type)) {
-            charge += pLastCol->colVal.value.nData;
-          }
+  taosThreadMutexUnlock(&pTsdb->lruMutex);
 
-          LRUStatus status = taosLRUCacheInsert(pTsdb->lruCache, &idxKey->key, ROCKS_KEY_LEN, pLastCol, charge,
-                                                tsdbCacheDeleter, NULL, TAOS_LRU_PRIORITY_LOW, &pTsdb->flushState);
-          if (status != TAOS_LRU_STATUS_OK) {
-            code = -1;
-          }
+  return code;
+}
 
-          taosMemoryFree(value);
-        }
-      } else {
-        if (COL_VAL_IS_VALUE(pColVal)) {
-          if (NULL == pLastCol || pLastCol->ts <= keyTs) {
-            char  *value = NULL;
-            size_t vlen = 0;
-            tsdbCacheSerialize(&(SLastCol){.ts = keyTs, .colVal = *pColVal}, &value, &vlen);
-            // SLastKey key = (SLastKey){.ltype = 1, .uid = uid, .cid = pColVal->cid};
-            taosThreadMutexLock(&pTsdb->rCache.rMutex);
-
-            rocksdb_writebatch_put(wb, (char *)&idxKey->key, ROCKS_KEY_LEN, value, vlen);
-
-            taosThreadMutexUnlock(&pTsdb->rCache.rMutex);
-
-            pLastCol = (SLastCol *)value;
-            SLastCol *pTmpLastCol = taosMemoryCalloc(1, sizeof(SLastCol));
-            *pTmpLastCol = *pLastCol;
-            pLastCol = pTmpLastCol;
-
-            reallocVarData(&pLastCol->colVal);
-            size_t charge = sizeof(*pLastCol);
-            if (IS_VAR_DATA_TYPE(pLastCol->colVal.type)) {
-              charge += pLastCol->colVal.value.nData;
-            }
+int32_t tsdbCacheUpdateBatch(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, SSubmitTbData *pSubmitTbData) {
+  int32_t   code = 0;
+  STSchema *pTSchema = NULL;
+  SArray   *aUpdCol = taosArrayInit(64, sizeof(SLastUpdCol));
+  SColVal   cv;
 
-            LRUStatus status = taosLRUCacheInsert(pTsdb->lruCache, &idxKey->key, ROCKS_KEY_LEN, pLastCol, charge,
-                                                  tsdbCacheDeleter, NULL, TAOS_LRU_PRIORITY_LOW, &pTsdb->flushState);
-            if (status != TAOS_LRU_STATUS_OK) {
-              code = -1;
-            }
+  if (aUpdCol == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
 
-            taosMemoryFree(value);
-          }
+  if (pSubmitTbData->flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
+    int32_t   nColData = TARRAY_SIZE(pSubmitTbData->aCol);
+    SColData *aColData = (SColData *)TARRAY_DATA(pSubmitTbData->aCol);
+    int32_t   nRow = aColData[0].nVal;
+    TSKEY    *aKey = (TSKEY *)aColData[0].pData;
+    TSKEY     lastTs = aKey[nRow - 1];
+
+    cv = COL_VAL_VALUE(PRIMARYKEY_TIMESTAMP_COL_ID, TSDB_DATA_TYPE_TIMESTAMP, (SValue){.val = lastTs});
+    tsdbCacheAddUpdCol(aUpdCol, uid, 0, lastTs, &cv);
+    tsdbCacheAddUpdCol(aUpdCol, uid, 1, lastTs, &cv);
+
+    // take the last row of each column, and the last value column by column
+    for (int32_t iColData = 1; iColData < nColData; iColData++) {
+      SColData *pColData = &aColData[iColData];
+
+      tColDataGetValue(pColData, nRow - 1, &cv);
+      tsdbCacheAddUpdCol(aUpdCol, uid, 0, lastTs, &cv);
+
+      if (!(pColData->flag & HAS_VALUE)) continue;
+
+      for (int32_t iRow = nRow - 1; iRow >= 0; iRow--) {
+        if (iRow < nRow - 1) tColDataGetValue(pColData, iRow, &cv);
+        if (COL_VAL_IS_VALUE(&cv)) {
+          tsdbCacheAddUpdCol(aUpdCol, uid, 1, aKey[iRow], &cv);
+          break;
         }
       }
-
-      rocksdb_free(values_list[i]);
     }
+  } else {
+    int32_t nRow = TARRAY_SIZE(pSubmitTbData->aRowP);
+    SRow  **aRow = (SRow **)TARRAY_DATA(pSubmitTbData->aRowP);
+    TSKEY   lastTs = aRow[nRow - 1]->ts;
 
-    rocksMayWrite(pTsdb, true, false, true);
+    code = metaGetTbTSchemaEx(pTsdb->pVnode->pMeta, suid, uid, pSubmitTbData->sver, &pTSchema);
+    if (code) goto _exit;
 
-    taosMemoryFree(values_list);
+    for (int32_t iCol = 0; iCol < pTSchema->numOfCols; iCol++) {
+      tRowGet(aRow[nRow - 1], pTSchema, iCol, &cv);
+      tsdbCacheAddUpdCol(aUpdCol, uid, 0, lastTs, &cv);
 
-    taosArrayDestroy(remainCols);
+      for (int32_t iRow = nRow - 1; iRow >= 0; iRow--) {
+        if (iRow < nRow - 1) tRowGet(aRow[iRow], pTSchema, iCol, &cv);
+        if (COL_VAL_IS_VALUE(&cv)) {
+          tsdbCacheAddUpdCol(aUpdCol, uid, 1, aRow[iRow]->ts, &cv);
+          break;
+        }
+      }
+    }
   }
 
-  taosThreadMutexUnlock(&pTsdb->lruMutex);
+  code = tsdbCacheUpdateLastCols(pTsdb, uid, aUpdCol);
 
 _exit:
-  taosArrayDestroy(aColVal);
+  if (code) {
+    terrno = code;
+  }
+  taosArrayDestroy(aUpdCol);
   taosMemoryFree(pTSchema);
   return code;
 }
@@ -864,7 +936,6 @@ static int32_t tsdbCacheLoadFromRaw(STsdb *pTsdb, tb_uid_t uid, SArray *pLastArr
     mergeLastRowCid(uid, pTsdb, &pTmpColArray, pr, aCols, num_keys, slotIds);
   }
 
-  SLRUCache *pCache = pTsdb->lruCache;
   for (int i = 0; i < num_keys; ++i) {
     SIdxKey  *idxKey = taosArrayGet(remainCols, i);
     SLastCol *pLastCol = NULL;
@@ -888,22 +959,6 @@ static int32_t tsdbCacheLoadFromRaw(STsdb *pTsdb, tb_uid_t uid, SArray *pLastArr
       continue;
     }
 
-    SLastCol *pTmpLastCol = taosMemoryCalloc(1, sizeof(SLastCol));
-    *pTmpLastCol = *pLastCol;
-    pLastCol = pTmpLastCol;
-
-    reallocVarData(&pLastCol->colVal);
-    size_t charge = sizeof(*pLastCol);
-    if (IS_VAR_DATA_TYPE(pLastCol->colVal.type)) {
-      charge += pLastCol->colVal.value.nData;
-    }
-
-    LRUStatus status = taosLRUCacheInsert(pCache, &idxKey->key, ROCKS_KEY_LEN, pLastCol, charge, tsdbCacheDeleter, NULL,
-                                          TAOS_LRU_PRIORITY_LOW, &pTsdb->flushState);
-    if (status != TAOS_LRU_STATUS_OK) {
-      code = -1;
-    }
-
     // store result back to rocks cache
     wb = pTsdb->rCache.rwritebatch;
     char  *value = NULL;
@@ -914,6 +969,16 @@ static int32_t tsdbCacheLoadFromRaw(STsdb *pTsdb, tb_uid_t uid, SArray *pLastArr
     size_t    klen = ROCKS_KEY_LEN;
     rocksdb_writebatch_put(wb, (char *)key, klen, value, vlen);
     taosMemoryFree(value);
+
+    SLastCol *pTmpLastCol = taosMemoryCalloc(1, sizeof(SLastCol));
+    *pTmpLastCol = *pLastCol;
+    pLastCol = pTmpLastCol;
+
+    reallocVarData(&pLastCol->colVal);
+    LRUStatus status = tsdbCacheInsertLastCol(pTsdb, &idxKey->key, pLastCol);
+    if (status != TAOS_LRU_STATUS_OK && status != TAOS_LRU_STATUS_OK_OVERWRITTEN) {
+      code = -1;
+    }
   }
 
   if (wb) {
@@ -932,6 +997,10 @@ static int32_t tsdbCacheLoadFromRocks(STsdb *pTsdb, tb_uid_t uid, SArray *pLastA
                                       SCacheRowsReader *pr, int8_t ltype) {
   int32_t code = 0;
   int     num_keys = TARRAY_SIZE(remainCols);
+
+  // values evicted from the lru cache may still be pending in the write batch
+  rocksMayWrite(pTsdb, true, false, true);
+
   char  **keys_list = taosMemoryMalloc(num_keys * sizeof(char *));
   size_t *keys_list_sizes = taosMemoryMalloc(num_keys * sizeof(size_t));
   char   *key_list = taosMemoryMalloc(num_keys * ROCKS_KEY_LEN);
@@ -958,30 +1027,23 @@ static int32_t tsdbCacheLoadFromRocks(STsdb *pTsdb, tb_uid_t uid, SArray *pLastA
   taosMemoryFree(keys_list_sizes);
   taosMemoryFree(errs);
 
-  SLRUCache *pCache = pTsdb->lruCache;
   for (int i = 0, j = 0; i < num_keys && j < TARRAY_SIZE(remainCols); ++i) {
     SLastCol *pLastCol = tsdbCacheDeserialize(values_list[i]);
     SIdxKey  *idxKey = &((SIdxKey *)TARRAY_DATA(remainCols))[j];
     if (pLastCol) {
+      SLastCol lastCol = *pLastCol;
+      reallocVarData(&lastCol.colVal);
+      taosArraySet(pLastArray, idxKey->idx, &lastCol);
+
       SLastCol *pTmpLastCol = taosMemoryCalloc(1, sizeof(SLastCol));
       *pTmpLastCol = *pLastCol;
       pLastCol = pTmpLastCol;
 
       reallocVarData(&pLastCol->colVal);
-      size_t charge = sizeof(*pLastCol);
-      if (IS_VAR_DATA_TYPE(pLastCol->colVal.type)) {
-        charge += pLastCol->colVal.value.nData;
-      }
-
-      LRUStatus status = taosLRUCacheInsert(pCache, &idxKey->key, ROCKS_KEY_LEN, pLastCol, charge, tsdbCacheDeleter,
-                                            NULL, TAOS_LRU_PRIORITY_LOW, &pTsdb->flushState);
-      if (status != TAOS_LRU_STATUS_OK) {
+      LRUStatus status = tsdbCacheInsertLastCol(pTsdb, &idxKey->key, pLastCol);
+      if (status != TAOS_LRU_STATUS_OK && status != TAOS_LRU_STATUS_OK_OVERWRITTEN) {
         code = -1;
       }
-
-      SLastCol lastCol = *pLastCol;
-      reallocVarData(&lastCol.colVal);
-      taosArraySet(pLastArray, idxKey->idx, &lastCol);
       taosArrayRemove(remainCols, j);
 
       taosMemoryFree(values_list[i]);
@@ -1006,32 +1068,53 @@ int32_t tsdbCacheGetBatch(STsdb *pTsdb, tb_uid_t uid, SArray *pLastArray, SCache
   SLRUCache *pCache = pTsdb->lruCache;
   SArray    *pCidList = pr->pCidList;
   int        num_keys = TARRAY_SIZE(pCidList);
+  SArray    *missCols = NULL;
 
+  // copy the columns from the last value index under the read lock of the table's shard, without touching the lru
+  // cache, the missed ones are then looked up in the lru cache
+  SLastIdxShard *pShard = pTsdb->pLastIdx ? tsdbLastIdxShard(pTsdb, uid) : NULL;
+  if (pShard) taosThreadRwlockRdlock(&pShard->lock);
   for (int i = 0; i < num_keys; ++i) {
     int16_t cid = ((int16_t *)TARRAY_DATA(pCidList))[i];
 
-    SLastKey *key = &(SLastKey){.ltype = ltype, .uid = uid, .cid = cid};
+    SLastKey  *key = &(SLastKey){.ltype = ltype, .uid = uid, .cid = cid};
+    SLastCol **ppLastCol = pShard ? taosHashGet(pShard->pHash, key, ROCKS_KEY_LEN) : NULL;
+    if (ppLastCol) {
+      SLastCol lastCol = **ppLastCol;
+      reallocVarData(&lastCol.colVal);
+      taosArrayPush(pLastArray, &lastCol);
+    } else {
+      SLastCol noneCol = {.ts = TSKEY_MIN, .colVal = COL_VAL_NONE(cid, pr->pSchema->columns[pr->pSlotIds[i]].type)};
+
+      taosArrayPush(pLastArray, &noneCol);
 
-    LRUHandle *h = taosLRUCacheLookup(pCache, key, ROCKS_KEY_LEN);
+      if (!missCols) {
+        missCols = taosArrayInit(num_keys, sizeof(SIdxKey));
+      }
+      taosArrayPush(missCols, &(SIdxKey){i, *key});
+    }
+  }
+  if (pShard) taosThreadRwlockUnlock(&pShard->lock);
+
+  for (int i = 0; i < taosArrayGetSize(missCols); ++i) {
+    SIdxKey   *idxKey = taosArrayGet(missCols, i);
+    LRUHandle *h = taosLRUCacheLookup(pCache, &idxKey->key, ROCKS_KEY_LEN);
     if (h) {
       SLastCol *pLastCol = (SLastCol *)taosLRUCacheValue(pCache, h);
 
       SLastCol lastCol = *pLastCol;
       reallocVarData(&lastCol.colVal);
-      taosArrayPush(pLastArray, &lastCol);
+      taosArraySet(pLastArray, idxKey->idx, &lastCol);
 
       taosLRUCacheRelease(pCache, h, false);
     } else {
-      SLastCol noneCol = {.ts = TSKEY_MIN, .colVal = COL_VAL_NONE(cid, pr->pSchema->columns[pr->pSlotIds[i]].type)};
-
-      taosArrayPush(pLastArray, &noneCol);
-
       if (!remainCols) {
         remainCols = taosArrayInit(num_keys, sizeof(SIdxKey));
       }
-      taosArrayPush(remainCols, &(SIdxKey){i, *key});
+      taosArrayPush(remainCols, idxKey);
     }
   }
+  taosArrayDestroy(missCols);
 
   if (remainCols && TARRAY_SIZE(remainCols) > 0) {
     taosThreadMutexLock(&pTsdb->lruMutex);
@@ -1065,6 +1148,30 @@ int32_t tsdbCacheGetBatch(STsdb *pTsdb, tb_uid_t uid, SArray *pLastArray, SCache
   return code;
 }
 
+// Drop a cached last value deleted by [sKey, eKey] and its rocks value, which may be older than the cached one. The
+// values out of the range are still the last ones and are kept, the dirty ones are written back when flushed.
+static void tsdbCacheDelLastCol(STsdb *pTsdb, const char *key, size_t klen, TSKEY sKey, TSKEY eKey) {
+  LRUHandle *h = taosLRUCacheLookup(pTsdb->lruCache, key, klen);
+  if (!h) {
+    return;
+  }
+
+  SLastCol *pLastCol = (SLastCol *)taosLRUCacheValue(pTsdb->lruCache, h);
+  bool      deleted = (pLastCol->ts <= eKey && pLastCol->ts >= sKey);
+  if (deleted) {
+    pLastCol->dirty = 0;
+
+    taosThreadMutexLock(&pTsdb->rCache.rMutex);
+    rocksdb_writebatch_delete(pTsdb->rCache.writebatch, key, klen);
+    taosThreadMutexUnlock(&pTsdb->rCache.rMutex);
+  }
+  taosLRUCacheRelease(pTsdb->lruCache, h, deleted);
+
+  if (deleted) {
+    taosLRUCacheErase(pTsdb->lruCache, key, klen);
+  }
+}
+
 int32_t tsdbCacheDel(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSKEY sKey, TSKEY eKey) {
   int32_t code = 0;
   // fetch schema
@@ -1126,29 +1233,8 @@ int32_t tsdbCacheDel(STsdb *pTsdb, tb_uid_t suid, tb_uid_t uid, TSKEY sKey, TSKE
     rocksdb_free(values_list[i]);
     rocksdb_free(values_list[i + num_keys]);
 
-    // taosThreadMutexLock(&pTsdb->lruMutex);
-
-    LRUHandle *h = taosLRUCacheLookup(pTsdb->lruCache, keys_list[i], klen);
-    if (h) {
-      SLastCol *pLastCol = (SLastCol *)taosLRUCacheValue(pTsdb->lruCache, h);
-      if (pLastCol->dirty) {
-        pLastCol->dirty = 0;
-      }
-      taosLRUCacheRelease(pTsdb->lruCache, h, true);
-    }
-    taosLRUCacheErase(pTsdb->lruCache, keys_list[i], klen);
-
-    h = taosLRUCacheLookup(pTsdb->lruCache, keys_list[num_keys + i], klen);
-    if (h) {
-      SLastCol *pLastCol = (SLastCol *)taosLRUCacheValue(pTsdb->lruCache, h);
-      if (pLastCol->dirty) {
-        pLastCol->dirty = 0;
-      }
-      taosLRUCacheRelease(pTsdb->lruCache, h, true);
-    }
-    taosLRUCacheErase(pTsdb->lruCache, keys_list[num_keys + i], klen);
-
-    // taosThreadMutexUnlock(&pTsdb->lruMutex);
+    tsdbCacheDelLastCol(pTsdb, keys_list[i], klen, sKey, eKey);
+    tsdbCacheDelLastCol(pTsdb, keys_list[num_keys + i], klen, sKey, eKey);
   }
   for (int i = 0; i < num_keys; ++i) {
     taosMemoryFree(keys_list[i]);
@@ -1199,6 +1285,11 @@ int32_t tsdbOpenCache(STsdb *pTsdb) {
 
   taosLRUCacheSetStrictCapacity(pCache, false);
 
+  code = tsdbLastIdxOpen(&pTsdb->pLastIdx);
+  if (code != TSDB_CODE_SUCCESS) {
+    goto _err;
+  }
+
   taosThreadMutexInit(&pTsdb->lruMutex, NULL);
 
   pTsdb->flushState.pTsdb = pTsdb;
@@ -1219,6 +1310,8 @@ void tsdbCloseCache(STsdb *pTsdb) {
     taosThreadMutexDestroy(&pTsdb->lruMutex);
   }
 
+  tsdbLastIdxClose(&pTsdb->pLastIdx);
+
   tsdbCloseBICache(pTsdb);
   tsdbCloseBCache(pTsdb);
   tsdbCloseRocksCache(pTsdb);
@@ -14,9 +14,11 @@
  */
 
 #include "tsdbCommit2.h"
+#include "vnd.h"
 
 // extern dependencies
-typedef struct {
+typedef struct SCommitter2 SCommitter2;
+struct SCommitter2 {
   STsdb         *tsdb;
   TFileSetArray *fsetArr;
   TFileOpArray   fopArray[1];
@@ -59,7 +61,29 @@ typedef struct {
 
   // writer
   SFSetWriter *writer;
-} SCommitter2;
+
+  // file sets committed in parallel
+  TdThreadMutex mutex;
+  TdThreadCond  cond;
+  int32_t       numOfRunning;
+  int32_t       taskCode;
+
+  // elapsed time (us) of each phase, the ones of file sets are summed over all file sets
+  struct {
+    int64_t plan;
+    int64_t fset;
+    int64_t open;
+    int64_t tsData;
+    int64_t tombData;
+    int64_t close;
+    int64_t edit;
+  } cost[1];
+};
+
+typedef struct {
+  SCommitter2 *parent;
+  SCommitter2  committer[1];
+} SFSetCommitTask;
 
 static int32_t tsdbCommitOpenWriter(SCommitter2 *committer) {
   int32_t code = 0;
@@ -419,22 +443,38 @@ _exit:
 static int32_t tsdbCommitFileSet(SCommitter2 *committer) {
   int32_t code = 0;
   int32_t lino = 0;
+  int64_t st = taosGetTimestampUs();
+  int64_t et;
 
   // fset commit start
   code = tsdbCommitFileSetBegin(committer);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  et = taosGetTimestampUs();
+  committer->cost->open += et - st;
+  st = et;
+
   // commit fset
   code = tsdbCommitTSData(committer);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  et = taosGetTimestampUs();
+  committer->cost->tsData += et - st;
+  st = et;
+
   code = tsdbCommitTombData(committer);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  et = taosGetTimestampUs();
+  committer->cost->tombData += et - st;
+  st = et;
+
   // fset commit end
   code = tsdbCommitFileSetEnd(committer);
   TSDB_CHECK_CODE(code, lino, _exit);
 
+  committer->cost->close += taosGetTimestampUs() - st;
+
 _exit:
   if (code) {
     TSDB_ERROR_LOG(TD_VID(committer->tsdb->pVnode), lino, code);
@@ -444,6 +484,179 @@ _exit:
   return code;
 }
 
+// file sets with rows in the memtable, or on disk and covered by deletions in the memtable
+static int32_t tsdbCommitPlanFileSets(SCommitter2 *committer, SArray *fidArr) {
+  int32_t     code = 0;
+  int32_t     lino = 0;
+  SRBTreeIter iter[1] = {tRBTreeIterCreate(committer->tsdb->imem->tbDataTree, 1)};
+  TSKEY       minKey;
+  TSKEY       maxKey;
+
+  for (SRBTreeNode *node = tRBTreeIterNext(iter); node; node = tRBTreeIterNext(iter)) {
+    STbData *tbData = TCONTAINER_OF(node, STbData, rbtn);
+
+    // seek from one file set to the next one with rows of the table
+    if (tsdbGetNRowsInTbData(tbData) > 0) {
+      for (TSKEY key = tbData->minKey;;) {
+        int32_t fid = tsdbKeyFid(key, committer->minutes, committer->precision);
+        if (taosArrayPush(fidArr, &fid) == NULL) {
+          code = TSDB_CODE_OUT_OF_MEMORY;
+          TSDB_CHECK_CODE(code, lino, _exit);
+        }
+
+        tsdbFidKeyRange(fid, committer->minutes, committer->precision, &minKey, &maxKey);
+        if (maxKey >= tbData->maxKey) break;
+
+        STbDataIter tbIter[1];
+        TSDBKEY     from = {.version = VERSION_MIN, .ts = maxKey + 1};
+        tsdbTbDataIterOpen(tbData, &from, 0, tbIter);
+
+        TSDBROW *row = tsdbTbDataIterGet(tbIter);
+        if (row == NULL) break;
+        key = TSDBROW_TS(row);
+      }
+    }
+
+    for (SDelData *delData = tbData->pHead; delData; delData = delData->pNext) {
+      STFileSet *fset;
+      TARRAY2_FOREACH(committer->fsetArr, fset) {
+        tsdbFidKeyRange(fset->fid, committer->minutes, committer->precision, &minKey, &maxKey);
+        if (delData->sKey <= maxKey && delData->eKey >= minKey && taosArrayPush(fidArr, &fset->fid) == NULL) {
+          code = TSDB_CODE_OUT_OF_MEMORY;
+          TSDB_CHECK_CODE(code, lino, _exit);
+        }
+      }
+    }
+  }
+
+  taosArraySort(fidArr, compareInt32Val);
+  taosArrayRemoveDuplicate(fidArr, compareInt32Val, NULL);
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(committer->tsdb->pVnode), lino, code);
+  }
+  return code;
+}
+
+static int32_t tsdbCommitFileSetTask(void *arg) {
+  SFSetCommitTask *task = (SFSetCommitTask *)arg;
+  SCommitter2     *parent = task->parent;
+
+  int32_t code = tsdbCommitFileSet(task->committer);
+
+  taosThreadMutexLock(&parent->mutex);
+  if (code && parent->taskCode == 0) {
+    parent->taskCode = code;
+  }
+  parent->numOfRunning--;
+  taosThreadCondSignal(&parent->cond);
+  taosThreadMutexUnlock(&parent->mutex);
+  return 0;
+}
+
+static void tsdbInitFileSetTask(SCommitter2 *committer, int32_t fid, SFSetCommitTask *task) {
+  SCommitter2 *fsetCommitter = task->committer;
+  TSKEY        maxKey;
+
+  task->parent = committer;
+  fsetCommitter->tsdb = committer->tsdb;
+  fsetCommitter->fsetArr = committer->fsetArr;
+  fsetCommitter->minutes = committer->minutes;
+  fsetCommitter->precision = committer->precision;
+  fsetCommitter->minRow = committer->minRow;
+  fsetCommitter->maxRow = committer->maxRow;
+  fsetCommitter->cmprAlg = committer->cmprAlg;
+  fsetCommitter->sttTrigger = committer->sttTrigger;
+  fsetCommitter->szPage = committer->szPage;
+  fsetCommitter->compactVersion = committer->compactVersion;
+  fsetCommitter->ctx->cid = committer->ctx->cid;
+  fsetCommitter->ctx->now = committer->ctx->now;
+  fsetCommitter->ctx->maxDelKey = committer->ctx->maxDelKey;
+  tsdbFidKeyRange(fid, committer->minutes, committer->precision, &fsetCommitter->ctx->nextKey, &maxKey);
+}
+
+/*
+ * Each file set is committed by a committer of its own in the file set thread pool, file operations of all file sets
+ * are collected in fid order and applied by a single edit when the committer is closed.
+ */
+static int32_t tsdbCommitFileSetsParallel(SCommitter2 *committer, SArray *fidArr) {
+  int32_t          code = 0;
+  int32_t          lino = 0;
+  int32_t          nFid = taosArrayGetSize(fidArr);
+  int32_t          nTask = 0;
+  SFSetCommitTask *tasks = taosMemoryCalloc(nFid, sizeof(SFSetCommitTask));
+  if (tasks == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    TSDB_CHECK_CODE(code, lino, _exit);
+  }
+
+  taosThreadMutexInit(&committer->mutex, NULL);
+  taosThreadCondInit(&committer->cond, NULL);
+
+  for (; nTask < nFid; nTask++) {
+    SFSetCommitTask *task = &tasks[nTask];
+    tsdbInitFileSetTask(committer, *(int32_t *)taosArrayGet(fidArr, nTask), task);
+
+    taosThreadMutexLock(&committer->mutex);
+    while (committer->numOfRunning >= TMAX(tsCommitFilesetParallel, 1)) {
+      taosThreadCondWait(&committer->cond, &committer->mutex);
+    }
+    code = committer->taskCode;
+    if (code == 0) committer->numOfRunning++;
+    taosThreadMutexUnlock(&committer->mutex);
+    if (code) break;
+
+    if (vnodeScheduleTaskEx(VNODE_FSET_THREAD_POOL, tsdbCommitFileSetTask, task) != 0) {
+      code = terrno;
+      taosThreadMutexLock(&committer->mutex);
+      committer->numOfRunning--;
+      taosThreadMutexUnlock(&committer->mutex);
+      break;
+    }
+  }
+
+  // wait for all scheduled ones
+  taosThreadMutexLock(&committer->mutex);
+  while (committer->numOfRunning > 0) {
+    taosThreadCondWait(&committer->cond, &committer->mutex);
+  }
+  if (code == 0) code = committer->taskCode;
+  taosThreadMutexUnlock(&committer->mutex);
+
+  taosThreadCondDestroy(&committer->cond);
+  taosThreadMutexDestroy(&committer->mutex);
+
+  for (int32_t i = 0; i < nTask; i++) {
+    SCommitter2 *fsetCommitter = tasks[i].committer;
+
+    if (code == 0) {
+      code = TARRAY2_APPEND_BATCH(committer->fopArray, TARRAY2_DATA(fsetCommitter->fopArray),
+                                  TARRAY2_SIZE(fsetCommitter->fopArray));
+
+      committer->cost->open += fsetCommitter->cost->open;
+      committer->cost->tsData += fsetCommitter->cost->tsData;
+      committer->cost->tombData += fsetCommitter->cost->tombData;
+      committer->cost->close += fsetCommitter->cost->close;
+    }
+
+    TARRAY2_DESTROY(fsetCommitter->dataIterArray, NULL);
+    TARRAY2_DESTROY(fsetCommitter->tombIterArray, NULL);
+    TARRAY2_DESTROY(fsetCommitter->sttReaderArray, NULL);
+    TARRAY2_DESTROY(fsetCommitter->fopArray, NULL);
+  }
+  TSDB_CHECK_CODE(code, lino, _exit);
+
+_exit:
+  if (code) {
+    TSDB_ERROR_LOG(TD_VID(committer->tsdb->pVnode), lino, code);
+  } else {
+    tsdbDebug("vgId:%d %s done, %d file sets", TD_VID(committer->tsdb->pVnode), __func__, nFid);
+  }
+  taosMemoryFree(tasks);
+  return code;
+}
+
 static int32_t tsdbOpenCommitter(STsdb *tsdb, SCommitInfo *info, SCommitter2 *committer) {
   int32_t code = 0;
   int32_t lino = 0;
@@ -508,8 +721,10 @@ static int32_t tsdbCloseCommitter(SCommitter2 *committer, int32_t eno) {
   int32_t lino = 0;
 
   if (eno == 0) {
+    int64_t st = taosGetTimestampUs();
     code = tsdbFSEditBegin(committer->tsdb->pFS, committer->fopArray, TSDB_FEDIT_COMMIT);
     TSDB_CHECK_CODE(code, lino, _exit);
+    committer->cost->edit = taosGetTimestampUs() - st;
   } else {
     // TODO
     ASSERT(0);
@@ -567,13 +782,39 @@ int32_t tsdbCommitBegin(STsdb *tsdb, SCommitInfo *info) {
     code = tsdbOpenCommitter(tsdb, info, committer);
     TSDB_CHECK_CODE(code, lino, _exit);
 
-    while (committer->ctx->nextKey != TSKEY_MAX) {
-      code = tsdbCommitFileSet(committer);
+    if (tsCommitFilesetParallel > 1) {
+      int64_t st = taosGetTimestampUs();
+      SArray *fidArr = taosArrayInit(16, sizeof(int32_t));
+      if (fidArr == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        TSDB_CHECK_CODE(code, lino, _exit);
+      }
+
+      code = tsdbCommitPlanFileSets(committer, fidArr);
+      if (code == 0) {
+        committer->cost->plan = taosGetTimestampUs() - st;
+        st = taosGetTimestampUs();
+        code = tsdbCommitFileSetsParallel(committer, fidArr);
+        committer->cost->fset = taosGetTimestampUs() - st;
+      }
+      taosArrayDestroy(fidArr);
       TSDB_CHECK_CODE(code, lino, _exit);
+    } else {
+      int64_t st = taosGetTimestampUs();
+      while (committer->ctx->nextKey != TSKEY_MAX) {
+        code = tsdbCommitFileSet(committer);
+        TSDB_CHECK_CODE(code, lino, _exit);
+      }
+      committer->cost->fset = taosGetTimestampUs() - st;
     }
 
     code = tsdbCloseCommitter(committer, code);
     TSDB_CHECK_CODE(code, lino, _exit);
+
+    tsdbInfo("vgId:%d %s cost, plan:%" PRId64 "us fset:%" PRId64 "us open:%" PRId64 "us tsdata:%" PRId64
+             "us tombdata:%" PRId64 "us close:%" PRId64 "us edit:%" PRId64 "us",
+             TD_VID(tsdb->pVnode), __func__, committer->cost->plan, committer->cost->fset, committer->cost->open,
+             committer->cost->tsData, committer->cost->tombData, committer->cost->close, committer->cost->edit);
   }
 
 _exit:
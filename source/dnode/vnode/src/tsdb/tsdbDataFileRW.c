@@ -360,6 +360,23 @@ _exit:
   return code;
 }
 
+int32_t tsdbDataFilePrepareReadAhead(SDataFileReader *reader) {
+  if (reader->fd[TSDB_FTYPE_DATA] == NULL) return TSDB_CODE_OPS_NOT_SUPPORT;
+  return tsdbPrepareReadAhead(reader->fd[TSDB_FTYPE_DATA]);
+}
+
+// thread safe once tsdbDataFilePrepareReadAhead succeeds, a coalesced range of data blocks is read in one I/O
+int32_t tsdbDataFileReadAhead(SDataFileReader *reader, int64_t offset, int64_t size, uint8_t *buf) {
+  return tsdbReadFileAhead(reader->fd[TSDB_FTYPE_DATA], offset, buf, size);
+}
+
+// the data blocks in [offset, offset + size) are read from buf instead of the .data file, until it is reset by a NULL buf
+void tsdbDataFileSetReadAhead(SDataFileReader *reader, int64_t offset, int64_t size, uint8_t *buf) {
+  if (reader->fd[TSDB_FTYPE_DATA]) {
+    tsdbSetReadAheadWindow(reader->fd[TSDB_FTYPE_DATA], offset, size, buf);
+  }
+}
+
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
                                  TColumnDataAggArray *columnDataAggArray) {
   int32_t code = 0;
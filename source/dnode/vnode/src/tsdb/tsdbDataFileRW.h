@@ -61,6 +61,9 @@ int32_t tsdbDataFileReadBrinBlock(SDataFileReader *reader, const SBrinBlk *brinB
 int32_t tsdbDataFileReadBlockData(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData);
 int32_t tsdbDataFileReadBlockDataByColumn(SDataFileReader *reader, const SBrinRecord *record, SBlockData *bData,
                                           STSchema *pTSchema, int16_t cids[], int32_t ncid);
+int32_t tsdbDataFilePrepareReadAhead(SDataFileReader *reader);
+int32_t tsdbDataFileReadAhead(SDataFileReader *reader, int64_t offset, int64_t size, uint8_t *buf);
+void    tsdbDataFileSetReadAhead(SDataFileReader *reader, int64_t offset, int64_t size, uint8_t *buf);
 // .sma
 int32_t tsdbDataFileReadBlockSma(SDataFileReader *reader, const SBrinRecord *record,
                                  TColumnDataAggArray *columnDataAggArray);
@@ -36,6 +36,9 @@ extern void    tsdbCloseFile(STsdbFD **ppFD);
 extern int32_t tsdbWriteFile(STsdbFD *pFD, int64_t offset, const uint8_t *pBuf, int64_t size);
 extern int32_t tsdbReadFile(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int64_t size);
 extern int32_t tsdbFsyncFile(STsdbFD *pFD);
+extern int32_t tsdbPrepareReadAhead(STsdbFD *pFD);
+extern int32_t tsdbReadFileAhead(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int64_t size);
+extern void    tsdbSetReadAheadWindow(STsdbFD *pFD, int64_t offset, int64_t size, uint8_t *pBuf);
 
 #ifdef __cplusplus
 }
@@ -30,6 +30,14 @@
 
 #define SL_MOVE_BACKWARD 0x1
 #define SL_MOVE_FROM_POS 0x2
+#define SL_MOVE_TO_PREV  0x4  // with SL_MOVE_BACKWARD, return the predecessors of the found positions
+
+/*
+ * Skiplist writers do not take any lock: a node is linked level by level from the bottom with a CAS on the forward
+ * pointer of its predecessor, so it becomes visible to readers once linked at level 0. Forward pointers are always
+ * exact, backward pointers are only hints which point to some node before, readers walk forward from the hint to
+ * find the real predecessor (see tbDataGetPrev).
+ */
 
 static void    tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, TSDBKEY *pKey, int32_t flags);
 static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid_t uid, STbData **ppTbData);
@@ -38,6 +46,46 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
 static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData, int64_t version,
                                         SSubmitTbData *pSubmitTbData, int32_t *affectedRows);
 
+static FORCE_INLINE void tbDataNodeKey(SMemSkipListNode *pNode, TSDBKEY *pKey) {
+  if (pNode->flag == TSDBROW_ROW_FMT) {
+    pKey->version = pNode->version;
+    pKey->ts = ((SRow *)pNode->pData)->ts;
+  } else if (pNode->flag == TSDBROW_COL_FMT) {
+    pKey->version = ((SBlockData *)pNode->pData)->aVersion[pNode->iRow];
+    pKey->ts = ((SBlockData *)pNode->pData)->aTSKEY[pNode->iRow];
+  }
+}
+
+static FORCE_INLINE SMemSkipListNode *tbDataGetPrev(SMemSkipListNode *pNode, int8_t iLevel) {
+  SMemSkipListNode *px = SL_GET_NODE_BACKWARD(pNode, iLevel);
+  SMemSkipListNode *pn;
+
+  // nodes linked after the hint was set lie between the hint and pNode
+  while ((pn = SL_GET_NODE_FORWARD(px, iLevel)) != pNode) {
+    px = pn;
+  }
+
+  return px;
+}
+
+static FORCE_INLINE void tsdbAtomicMin64(int64_t *ptr, int64_t val) {
+  int64_t old = atomic_load_64(ptr);
+  while (val < old) {
+    int64_t cur = atomic_val_compare_exchange_64(ptr, old, val);
+    if (cur == old) break;
+    old = cur;
+  }
+}
+
+static FORCE_INLINE void tsdbAtomicMax64(int64_t *ptr, int64_t val) {
+  int64_t old = atomic_load_64(ptr);
+  while (val > old) {
+    int64_t cur = atomic_val_compare_exchange_64(ptr, old, val);
+    if (cur == old) break;
+    old = cur;
+  }
+}
+
 static int32_t tTbDataCmprFn(const SRBTreeNode *n1, const SRBTreeNode *n2) {
   STbData *tbData1 = TCONTAINER_OF(n1, STbData, rbtn);
   STbData *tbData2 = TCONTAINER_OF(n2, STbData, rbtn);
@@ -137,8 +185,8 @@ int32_t tsdbInsertTableData(STsdb *pTsdb, int64_t version, SSubmitTbData *pSubmi
   if (code) goto _err;
 
   // update
-  pMemTable->minVer = TMIN(pMemTable->minVer, version);
-  pMemTable->maxVer = TMAX(pMemTable->maxVer, version);
+  tsdbAtomicMin64(&pMemTable->minVer, version);
+  tsdbAtomicMax64(&pMemTable->maxVer, version);
 
   return code;
 
@@ -239,6 +287,134 @@ void *tsdbTbDataIterDestroy(STbDataIter *pIter) {
   return NULL;
 }
 
+static FORCE_INLINE void tbDataChunkKey(SMemColChunk *pChunk, int32_t iRow, TSDBKEY *pKey) {
+  pKey->version = pChunk->pBlockData->aVersion[iRow];
+  pKey->ts = pChunk->pBlockData->aTSKEY[iRow];
+}
+
+// first row of the chunk with key >= pKey (forward) or last row with key <= pKey (backward)
+static int32_t tbDataChunkSeek(SMemColChunk *pChunk, TSDBKEY *pKey, int8_t backward) {
+  int32_t lidx = pChunk->iStart;
+  int32_t ridx = pChunk->iStart + pChunk->nRow - 1;
+  TSDBKEY tKey;
+
+  while (lidx <= ridx) {
+    int32_t midx = (lidx + ridx) >> 1;
+    tbDataChunkKey(pChunk, midx, &tKey);
+
+    int32_t c = tsdbKeyCmprFn(&tKey, pKey);
+    if (c == 0) {
+      return midx;
+    } else if (c < 0) {
+      lidx = midx + 1;
+    } else {
+      ridx = midx - 1;
+    }
+  }
+
+  return backward ? ridx : lidx;
+}
+
+static void tbDataIterSeekChunk(STbData *pTbData, TSDBKEY *pFrom, STbDataIter *pIter) {
+  SMemColChunk *pChunk = NULL;
+  TSDBKEY       tKey;
+
+  if (pIter->backward) {
+    // the tail pointer may fall behind the last chunk
+    SMemColChunk *pNext;
+    pChunk = atomic_load_ptr(&pTbData->pChunkTail);
+    while ((pNext = atomic_load_ptr(&pChunk->pNext)) != NULL) {
+      pChunk = pNext;
+    }
+
+    for (; pChunk != &pTbData->chunk; pChunk = pChunk->pPrev) {
+      if (pFrom == NULL) {
+        pIter->iChunkRow = pChunk->iStart + pChunk->nRow - 1;
+        break;
+      }
+
+      tbDataChunkKey(pChunk, pChunk->iStart, &tKey);
+      if (tsdbKeyCmprFn(&tKey, pFrom) <= 0) {
+        pIter->iChunkRow = tbDataChunkSeek(pChunk, pFrom, 1);
+        break;
+      }
+    }
+    if (pChunk == &pTbData->chunk) pChunk = NULL;
+  } else {
+    for (pChunk = atomic_load_ptr(&pTbData->chunk.pNext); pChunk; pChunk = atomic_load_ptr(&pChunk->pNext)) {
+      if (pFrom == NULL) {
+        pIter->iChunkRow = pChunk->iStart;
+        break;
+      }
+
+      tbDataChunkKey(pChunk, pChunk->iStart + pChunk->nRow - 1, &tKey);
+      if (tsdbKeyCmprFn(&tKey, pFrom) >= 0) {
+        pIter->iChunkRow = tbDataChunkSeek(pChunk, pFrom, 0);
+        break;
+      }
+    }
+  }
+
+  pIter->pChunk = pChunk;
+}
+
+static void tbDataIterMoveChunk(STbDataIter *pIter) {
+  SMemColChunk *pChunk = pIter->pChunk;
+
+  if (pIter->backward) {
+    if (--pIter->iChunkRow >= pChunk->iStart) return;
+
+    pChunk = pChunk->pPrev;
+    if (pChunk == &pIter->pTbData->chunk) {
+      pIter->pChunk = NULL;
+    } else {
+      pIter->pChunk = pChunk;
+      pIter->iChunkRow = pChunk->iStart + pChunk->nRow - 1;
+    }
+  } else {
+    if (++pIter->iChunkRow < pChunk->iStart + pChunk->nRow) return;
+
+    pIter->pChunk = atomic_load_ptr(&pChunk->pNext);
+    if (pIter->pChunk) pIter->iChunkRow = pIter->pChunk->iStart;
+  }
+}
+
+TSDBROW *tsdbTbDataIterGetMerge(STbDataIter *pIter) {
+  SMemSkipListNode *pNode = pIter->pNode;
+  bool              hasNode;
+
+  if (pIter->backward) {
+    hasNode = (pNode != pIter->pTbData->sl.pHead);
+  } else {
+    hasNode = (pNode != pIter->pTbData->sl.pTail);
+  }
+
+  pIter->inChunk = 1;
+  if (hasNode) {
+    TSDBKEY nKey = {0};
+    TSDBKEY cKey;
+
+    tbDataNodeKey(pNode, &nKey);
+    tbDataChunkKey(pIter->pChunk, pIter->iChunkRow, &cKey);
+
+    int32_t c = tsdbKeyCmprFn(&cKey, &nKey);
+    pIter->inChunk = pIter->backward ? (c > 0) : (c < 0);
+  }
+
+  pIter->pRow = &pIter->row;
+  if (pIter->inChunk) {
+    pIter->row = tsdbRowFromBlockData(pIter->pChunk->pBlockData, pIter->iChunkRow);
+  } else if (pNode->flag == TSDBROW_ROW_FMT) {
+    pIter->row = tsdbRowFromTSRow(pNode->version, pNode->pData);
+  } else if (pNode->flag == TSDBROW_COL_FMT) {
+    pIter->row = tsdbRowFromBlockData(pNode->pData, pNode->iRow);
+  } else {
+    ASSERT(0);
+  }
+
+  return pIter->pRow;
+}
+
 void tsdbTbDataIterOpen(STbData *pTbData, TSDBKEY *pFrom, int8_t backward, STbDataIter *pIter) {
   SMemSkipListNode *pos[SL_MAX_LEVEL];
   SMemSkipListNode *pHead;
@@ -248,19 +424,21 @@ void tsdbTbDataIterOpen(STbData *pTbData, TSDBKEY *pFrom, int8_t backward, STbDa
   pTail = pTbData->sl.pTail;
   pIter->pTbData = pTbData;
   pIter->backward = backward;
+  pIter->inChunk = 0;
   pIter->pRow = NULL;
+  tbDataIterSeekChunk(pTbData, pFrom, pIter);
   if (pFrom == NULL) {
     // create from head or tail
     if (backward) {
-      pIter->pNode = SL_GET_NODE_BACKWARD(pTbData->sl.pTail, 0);
+      pIter->pNode = tbDataGetPrev(pTbData->sl.pTail, 0);
     } else {
       pIter->pNode = SL_GET_NODE_FORWARD(pTbData->sl.pHead, 0);
     }
   } else {
     // create from a key
     if (backward) {
-      tbDataMovePosTo(pTbData, pos, pFrom, SL_MOVE_BACKWARD);
-      pIter->pNode = SL_GET_NODE_BACKWARD(pos[0], 0);
+      tbDataMovePosTo(pTbData, pos, pFrom, SL_MOVE_BACKWARD | SL_MOVE_TO_PREV);
+      pIter->pNode = pos[0];
     } else {
       tbDataMovePosTo(pTbData, pos, pFrom, 0);
       pIter->pNode = SL_GET_NODE_FORWARD(pos[0], 0);
@@ -269,6 +447,22 @@ void tsdbTbDataIterOpen(STbData *pTbData, TSDBKEY *pFrom, int8_t backward, STbDa
 }
 
 bool tsdbTbDataIterNext(STbDataIter *pIter) {
+  if (pIter->pChunk) {
+    // merge rows of the skiplist and the columnar chunks
+    if (tsdbTbDataIterGet(pIter) == NULL) return false;
+
+    pIter->pRow = NULL;
+    if (pIter->inChunk) {
+      tbDataIterMoveChunk(pIter);
+    } else if (pIter->backward) {
+      pIter->pNode = tbDataGetPrev(pIter->pNode, 0);
+    } else {
+      pIter->pNode = SL_GET_NODE_FORWARD(pIter->pNode, 0);
+    }
+
+    return tsdbTbDataIterGet(pIter) != NULL;
+  }
+
   pIter->pRow = NULL;
   if (pIter->backward) {
     ASSERT(pIter->pNode != pIter->pTbData->sl.pTail);
@@ -277,7 +471,7 @@ bool tsdbTbDataIterNext(STbDataIter *pIter) {
       return false;
     }
 
-    pIter->pNode = SL_GET_NODE_BACKWARD(pIter->pNode, 0);
+    pIter->pNode = tbDataGetPrev(pIter->pNode, 0);
     if (pIter->pNode == pIter->pTbData->sl.pHead) {
       return false;
     }
@@ -304,13 +498,13 @@ int64_t tsdbCountTbDataRows(STbData *pTbData) {
   while (NULL != pNode) {
     pNode = SL_GET_NODE_FORWARD(pNode, 0);
     if (pNode == pTbData->sl.pTail) {
-      return rowsNum;
+      return rowsNum + atomic_load_64(&pTbData->nChunkRow);
     }
 
     rowsNum++;
   }
 
-  return rowsNum;
+  return rowsNum + atomic_load_64(&pTbData->nChunkRow);
 }
 
 void tsdbMemTableCountRows(SMemTable *pMemTable, SSHashObj *pTableMap, int64_t *rowsNum) {
@@ -367,7 +561,7 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
   int32_t code = 0;
 
   // get
-  STbData *pTbData = tsdbGetTbDataFromMemTableImpl(pMemTable, suid, uid);
+  STbData *pTbData = tsdbGetTbDataFromMemTable(pMemTable, suid, uid);
   if (pTbData) goto _exit;
 
   // create
@@ -392,6 +586,9 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
   pTbData->sl.level = 0;
   pTbData->sl.pHead = (SMemSkipListNode *)&pTbData[1];
   pTbData->sl.pTail = (SMemSkipListNode *)POINTER_SHIFT(pTbData->sl.pHead, SL_NODE_SIZE(maxLevel));
+  memset(&pTbData->chunk, 0, sizeof(pTbData->chunk));
+  pTbData->pChunkTail = &pTbData->chunk;
+  pTbData->nChunkRow = 0;
   pTbData->sl.pHead->level = maxLevel;
   pTbData->sl.pTail->level = maxLevel;
   for (int8_t iLevel = 0; iLevel < maxLevel; iLevel++) {
@@ -404,6 +601,14 @@ static int32_t tsdbGetOrCreateTbData(SMemTable *pMemTable, tb_uid_t suid, tb_uid
 
   taosWLockLatch(&pMemTable->latch);
 
+  // another writer may have created it meanwhile, the allocated one is left to the buffer pool
+  STbData *pExist = tsdbGetTbDataFromMemTableImpl(pMemTable, suid, uid);
+  if (pExist) {
+    taosWUnLockLatch(&pMemTable->latch);
+    pTbData = pExist;
+    goto _exit;
+  }
+
   if (pMemTable->nTbData >= pMemTable->nBucket) {
     code = tsdbMemTableRehash(pMemTable);
     if (code) {
@@ -436,64 +641,54 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, TSDBKEY *p
   TSDBKEY           tKey = {0};
   int32_t           backward = flags & SL_MOVE_BACKWARD;
   int32_t           fromPos = flags & SL_MOVE_FROM_POS;
+  int32_t           toPrev = flags & SL_MOVE_TO_PREV;
+  int8_t            level = atomic_load_8(&pTbData->sl.level);
 
   if (backward) {
     px = pTbData->sl.pTail;
 
     if (!fromPos) {
-      for (int8_t iLevel = pTbData->sl.level; iLevel < pTbData->sl.maxLevel; iLevel++) {
-        pos[iLevel] = px;
+      for (int8_t iLevel = level; iLevel < pTbData->sl.maxLevel; iLevel++) {
+        pos[iLevel] = toPrev ? pTbData->sl.pHead : px;
       }
     }
 
-    if (pTbData->sl.level) {
-      if (fromPos) px = pos[pTbData->sl.level - 1];
+    if (level) {
+      if (fromPos) px = pos[level - 1];
 
-      for (int8_t iLevel = pTbData->sl.level - 1; iLevel >= 0; iLevel--) {
-        pn = SL_GET_NODE_BACKWARD(px, iLevel);
+      for (int8_t iLevel = level - 1; iLevel >= 0; iLevel--) {
+        pn = tbDataGetPrev(px, iLevel);
         while (pn != pTbData->sl.pHead) {
-          if (pn->flag == TSDBROW_ROW_FMT) {
-            tKey.version = pn->version;
-            tKey.ts = ((SRow *)pn->pData)->ts;
-          } else if (pn->flag == TSDBROW_COL_FMT) {
-            tKey.version = ((SBlockData *)pn->pData)->aVersion[pn->iRow];
-            tKey.ts = ((SBlockData *)pn->pData)->aTSKEY[pn->iRow];
-          }
+          tbDataNodeKey(pn, &tKey);
 
           int32_t c = tsdbKeyCmprFn(&tKey, pKey);
           if (c <= 0) {
             break;
           } else {
             px = pn;
-            pn = SL_GET_NODE_BACKWARD(px, iLevel);
+            pn = tbDataGetPrev(px, iLevel);
           }
         }
 
-        pos[iLevel] = px;
+        pos[iLevel] = toPrev ? pn : px;
       }
     }
   } else {
     px = pTbData->sl.pHead;
 
     if (!fromPos) {
-      for (int8_t iLevel = pTbData->sl.level; iLevel < pTbData->sl.maxLevel; iLevel++) {
+      for (int8_t iLevel = level; iLevel < pTbData->sl.maxLevel; iLevel++) {
         pos[iLevel] = px;
       }
     }
 
-    if (pTbData->sl.level) {
-      if (fromPos) px = pos[pTbData->sl.level - 1];
+    if (level) {
+      if (fromPos) px = pos[level - 1];
 
-      for (int8_t iLevel = pTbData->sl.level - 1; iLevel >= 0; iLevel--) {
+      for (int8_t iLevel = level - 1; iLevel >= 0; iLevel--) {
         pn = SL_GET_NODE_FORWARD(px, iLevel);
         while (pn != pTbData->sl.pTail) {
-          if (pn->flag == TSDBROW_ROW_FMT) {
-            tKey.version = pn->version;
-            tKey.ts = ((SRow *)pn->pData)->ts;
-          } else if (pn->flag == TSDBROW_COL_FMT) {
-            tKey.version = ((SBlockData *)pn->pData)->aVersion[pn->iRow];
-            tKey.ts = ((SBlockData *)pn->pData)->aTSKEY[pn->iRow];
-          }
+          tbDataNodeKey(pn, &tKey);
 
           int32_t c = tsdbKeyCmprFn(&tKey, pKey);
           if (c >= 0) {
@@ -512,7 +707,7 @@ static void tbDataMovePosTo(STbData *pTbData, SMemSkipListNode **pos, TSDBKEY *p
 
 static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
   int8_t level = 1;
-  int8_t tlevel = TMIN(pSl->maxLevel, pSl->level + 1);
+  int8_t tlevel = TMIN(pSl->maxLevel, atomic_load_8(&pSl->level) + 1);
 
   while ((taosRandR(&pSl->seed) & 0x3) == 0 && level < tlevel) {
     level++;
@@ -520,13 +715,20 @@ static FORCE_INLINE int8_t tsdbMemSkipListRandLevel(SMemSkipList *pSl) {
 
   return level;
 }
-static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListNode **pos, TSDBROW *pRow,
-                           int8_t forward) {
+
+/*
+ * Put a row after pos[], which holds a predecessor at each level. Rows with the same key are kept in insertion order.
+ * On return, pos[] holds the new node at each level it is linked on, so that rows in ascending order can be put one
+ * after another.
+ */
+static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListNode **pos, TSDBROW *pRow) {
   int32_t           code = 0;
   int8_t            level;
   SMemSkipListNode *pNode = NULL;
   SVBufPool        *pPool = pMemTable->pTsdb->pVnode->inUse;
   int64_t           nSize;
+  TSDBKEY           key;
+  TSDBKEY           tKey = {0};
 
   // create node
   level = tsdbMemSkipListRandLevel(&pTbData->sl);
@@ -555,45 +757,93 @@ static int32_t tbDataDoPut(SMemTable *pMemTable, STbData *pTbData, SMemSkipListN
   } else {
     ASSERT(0);
   }
+  tbDataNodeKey(pNode, &key);
+
+  // link from the bottom level, the node is visible once linked at level 0
+  for (int8_t iLevel = 0; iLevel < level; iLevel++) {
+    SMemSkipListNode *pPrev = pos[iLevel];
+    SMemSkipListNode *pNext;
+
+    for (;;) {
+      // skip nodes put by other writers since pos[] was located
+      pNext = SL_GET_NODE_FORWARD(pPrev, iLevel);
+      while (pNext != pTbData->sl.pTail) {
+        tbDataNodeKey(pNext, &tKey);
+        if (tsdbKeyCmprFn(&tKey, &key) > 0) break;
+
+        pPrev = pNext;
+        pNext = SL_GET_NODE_FORWARD(pPrev, iLevel);
+      }
 
-  // set node
-  if (forward) {
-    for (int8_t iLevel = 0; iLevel < level; iLevel++) {
-      SL_NODE_FORWARD(pNode, iLevel) = SL_NODE_FORWARD(pos[iLevel], iLevel);
-      SL_NODE_BACKWARD(pNode, iLevel) = pos[iLevel];
-    }
-  } else {
-    for (int8_t iLevel = 0; iLevel < level; iLevel++) {
-      SL_NODE_FORWARD(pNode, iLevel) = pos[iLevel];
-      SL_NODE_BACKWARD(pNode, iLevel) = SL_NODE_BACKWARD(pos[iLevel], iLevel);
+      SL_SET_NODE_FORWARD(pNode, iLevel, pNext);
+      SL_SET_NODE_BACKWARD(pNode, iLevel, pPrev);
+      if (atomic_val_compare_exchange_ptr(&SL_NODE_FORWARD(pPrev, iLevel), pNext, pNode) == pNext) break;
     }
+
+    SL_SET_NODE_BACKWARD(pNext, iLevel, pNode);
+    pos[iLevel] = pNode;
   }
 
-  // set forward and backward
-  if (forward) {
-    for (int8_t iLevel = level - 1; iLevel >= 0; iLevel--) {
-      SMemSkipListNode *pNext = pos[iLevel]->forwards[iLevel];
+  atomic_add_fetch_64(&pTbData->sl.size, 1);
+  for (int8_t sLevel = atomic_load_8(&pTbData->sl.level); sLevel < level;) {
+    int8_t oLevel = atomic_val_compare_exchange_8(&pTbData->sl.level, sLevel, level);
+    if (oLevel == sLevel) break;
+    sLevel = oLevel;
+  }
 
-      SL_SET_NODE_FORWARD(pos[iLevel], iLevel, pNode);
-      SL_SET_NODE_BACKWARD(pNext, iLevel, pNode);
+_exit:
+  return code;
+}
 
-      pos[iLevel] = pNode;
+static int32_t tbDataAppendChunk(SMemTable *pMemTable, STbData *pTbData, SBlockData *pBlockData, int32_t *nSlRow) {
+  int32_t       code = 0;
+  SVBufPool    *pPool = pMemTable->pTsdb->pVnode->inUse;
+  SMemColChunk  bChunk = {.pBlockData = pBlockData, .iStart = 0, .nRow = pBlockData->nRow};
+  SMemColChunk *pChunk = NULL;
+  int32_t       iStart;
+
+  for (;;) {
+    SMemColChunk *pTail = atomic_load_ptr(&pTbData->pChunkTail);
+    SMemColChunk *pNext = atomic_load_ptr(&pTail->pNext);
+    if (pNext) {
+      // the tail falls behind, help to move it forward
+      atomic_val_compare_exchange_ptr(&pTbData->pChunkTail, pTail, pNext);
+      continue;
     }
-  } else {
-    for (int8_t iLevel = level - 1; iLevel >= 0; iLevel--) {
-      SMemSkipListNode *pPrev = pos[iLevel]->forwards[pos[iLevel]->level + iLevel];
 
-      SL_SET_NODE_FORWARD(pPrev, iLevel, pNode);
-      SL_SET_NODE_BACKWARD(pos[iLevel], iLevel, pNode);
+    // rows not after the last chunk are out of order
+    iStart = 0;
+    if (pTail != &pTbData->chunk) {
+      TSDBKEY lastKey;
+      tbDataChunkKey(pTail, pTail->iStart + pTail->nRow - 1, &lastKey);
+      iStart = tbDataChunkSeek(&bChunk, &lastKey, 1) + 1;
+    }
+    if (iStart >= pBlockData->nRow) {
+      *nSlRow = pBlockData->nRow;
+      goto _exit;
+    }
 
-      pos[iLevel] = pNode;
+    if (pChunk == NULL) {
+      pChunk = (SMemColChunk *)vnodeBufPoolMalloc(pPool, sizeof(*pChunk));
+      if (pChunk == NULL) {
+        code = TSDB_CODE_OUT_OF_MEMORY;
+        goto _exit;
+      }
+      pChunk->pBlockData = pBlockData;
+    }
+    pChunk->iStart = iStart;
+    pChunk->nRow = pBlockData->nRow - iStart;
+    pChunk->pPrev = pTail;
+    pChunk->pNext = NULL;
+
+    if (atomic_val_compare_exchange_ptr(&pTail->pNext, NULL, pChunk) == NULL) {
+      atomic_val_compare_exchange_ptr(&pTbData->pChunkTail, pTail, pChunk);
+      break;
     }
   }
 
-  pTbData->sl.size++;
-  if (pTbData->sl.level < pNode->level) {
-    pTbData->sl.level = pNode->level;
-  }
+  atomic_add_fetch_64(&pTbData->nChunkRow, pChunk->nRow);
+  *nSlRow = iStart;
 
 _exit:
   return code;
@@ -650,51 +900,48 @@ static int32_t tsdbInsertColDataToTable(SMemTable *pMemTable, STbData *pTbData,
     if (code) goto _exit;
   }
 
+  // rows after the last columnar chunk are appended as a new chunk, only the ones before go to the skiplist
+  int32_t nSlRow = pBlockData->nRow;
+  if (tsMemColumnarAppend) {
+    if ((code = tbDataAppendChunk(pMemTable, pTbData, pBlockData, &nSlRow))) goto _exit;
+  }
+
   // loop to add each row to the skiplist
   SMemSkipListNode *pos[SL_MAX_LEVEL];
   TSDBROW           tRow = tsdbRowFromBlockData(pBlockData, 0);
   TSDBKEY           key = {.version = version, .ts = pBlockData->aTSKEY[0]};
-  TSDBROW           lRow;  // last row
-
-  // first row
-  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0))) goto _exit;
-  pTbData->minKey = TMIN(pTbData->minKey, key.ts);
-  lRow = tRow;
-
-  // remain row
-  ++tRow.iRow;
-  if (tRow.iRow < pBlockData->nRow) {
-    for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
-      pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
-    }
 
-    while (tRow.iRow < pBlockData->nRow) {
+  if (nSlRow > 0) {
+    // first row
+    tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD | SL_MOVE_TO_PREV);
+    if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow))) goto _exit;
+
+    // remain row
+    ++tRow.iRow;
+    while (tRow.iRow < nSlRow) {
       key.ts = pBlockData->aTSKEY[tRow.iRow];
 
-      if (SL_NODE_FORWARD(pos[0], 0) != pTbData->sl.pTail) {
+      if (SL_GET_NODE_FORWARD(pos[0], 0) != pTbData->sl.pTail) {
         tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
       }
 
-      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1))) goto _exit;
-      lRow = tRow;
+      if ((code = tbDataDoPut(pMemTable, pTbData, pos, &tRow))) goto _exit;
 
       ++tRow.iRow;
     }
   }
 
-  if (key.ts >= pTbData->maxKey) {
-    pTbData->maxKey = key.ts;
-  }
+  tsdbAtomicMin64(&pTbData->minKey, pBlockData->aTSKEY[0]);
+  tsdbAtomicMax64(&pTbData->maxKey, pBlockData->aTSKEY[pBlockData->nRow - 1]);
 
   if (!TSDB_CACHE_NO(pMemTable->pTsdb->pVnode->config)) {
-    tsdbCacheUpdate(pMemTable->pTsdb, pTbData->suid, pTbData->uid, &lRow);
+    tsdbCacheUpdateBatch(pMemTable->pTsdb, pTbData->suid, pTbData->uid, pSubmitTbData);
   }
 
   // SMemTable
-  pMemTable->minKey = TMIN(pMemTable->minKey, pTbData->minKey);
-  pMemTable->maxKey = TMAX(pMemTable->maxKey, pTbData->maxKey);
-  pMemTable->nRow += pBlockData->nRow;
+  tsdbAtomicMin64(&pMemTable->minKey, atomic_load_64(&pTbData->minKey));
+  tsdbAtomicMax64(&pMemTable->maxKey, atomic_load_64(&pTbData->maxKey));
+  atomic_add_fetch_64(&pMemTable->nRow, pBlockData->nRow);
 
   if (affectedRows) *affectedRows = pBlockData->nRow;
 
@@ -712,52 +959,40 @@ static int32_t tsdbInsertRowDataToTable(SMemTable *pMemTable, STbData *pTbData,
   SMemSkipListNode *pos[SL_MAX_LEVEL];
   TSDBROW           tRow = {.type = TSDBROW_ROW_FMT, .version = version};
   int32_t           iRow = 0;
-  TSDBROW           lRow;
 
   // backward put first data
   tRow.pTSRow = aRow[iRow++];
   key.ts = tRow.pTSRow->ts;
-  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD);
-  code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 0);
+  tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_BACKWARD | SL_MOVE_TO_PREV);
+  code = tbDataDoPut(pMemTable, pTbData, pos, &tRow);
   if (code) goto _exit;
-  lRow = tRow;
 
-  pTbData->minKey = TMIN(pTbData->minKey, key.ts);
+  tsdbAtomicMin64(&pTbData->minKey, key.ts);
 
   // forward put rest data
-  if (iRow < nRow) {
-    for (int8_t iLevel = pos[0]->level; iLevel < pTbData->sl.maxLevel; iLevel++) {
-      pos[iLevel] = SL_NODE_BACKWARD(pos[iLevel], iLevel);
-    }
-
-    while (iRow < nRow) {
-      tRow.pTSRow = aRow[iRow];
-      key.ts = tRow.pTSRow->ts;
+  while (iRow < nRow) {
+    tRow.pTSRow = aRow[iRow];
+    key.ts = tRow.pTSRow->ts;
 
-      if (SL_NODE_FORWARD(pos[0], 0) != pTbData->sl.pTail) {
-        tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
-      }
-
-      code = tbDataDoPut(pMemTable, pTbData, pos, &tRow, 1);
-      if (code) goto _exit;
+    if (SL_GET_NODE_FORWARD(pos[0], 0) != pTbData->sl.pTail) {
+      tbDataMovePosTo(pTbData, pos, &key, SL_MOVE_FROM_POS);
+    }
 
-      lRow = tRow;
+    code = tbDataDoPut(pMemTable, pTbData, pos, &tRow);
+    if (code) goto _exit;
 
-      iRow++;
-    }
+    iRow++;
   }
 
-  if (key.ts >= pTbData->maxKey) {
-    pTbData->maxKey = key.ts;
-  }
+  tsdbAtomicMax64(&pTbData->maxKey, key.ts);
   if (!TSDB_CACHE_NO(pMemTable->pTsdb->pVnode->config)) {
-    tsdbCacheUpdate(pMemTable->pTsdb, pTbData->suid, pTbData->uid, &lRow);
+    tsdbCacheUpdateBatch(pMemTable->pTsdb, pTbData->suid, pTbData->uid, pSubmitTbData);
   }
 
   // SMemTable
-  pMemTable->minKey = TMIN(pMemTable->minKey, pTbData->minKey);
-  pMemTable->maxKey = TMAX(pMemTable->maxKey, pTbData->maxKey);
-  pMemTable->nRow += nRow;
+  tsdbAtomicMin64(&pMemTable->minKey, atomic_load_64(&pTbData->minKey));
+  tsdbAtomicMax64(&pMemTable->maxKey, atomic_load_64(&pTbData->maxKey));
+  atomic_add_fetch_64(&pMemTable->nRow, nRow);
 
   if (affectedRows) *affectedRows = nRow;
 
@@ -765,7 +1000,7 @@ _exit:
   return code;
 }
 
-int32_t tsdbGetNRowsInTbData(STbData *pTbData) { return pTbData->sl.size; }
+int32_t tsdbGetNRowsInTbData(STbData *pTbData) { return pTbData->sl.size + atomic_load_64(&pTbData->nChunkRow); }
 
 int32_t tsdbRefMemTable(SMemTable *pMemTable, SQueryNode *pQNode) {
   int32_t code = 0;
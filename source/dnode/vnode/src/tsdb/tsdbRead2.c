@@ -21,6 +21,9 @@
 #include "tsdbReadUtil.h"
 #include "tsdbUtil2.h"
 #include "tsimplehash.h"
+#include "vnd.h"
+
+#define PREFETCH_DATA_BLOCKS_PER_SET 4  // max number of data blocks loaded ahead in each file set
 
 #define ASCENDING_TRAVERSE(o)        (o == TSDB_ORDER_ASC)
 #define getCurrentKeyInLastBlock(_r) ((_r)->currentKey)
@@ -58,6 +61,12 @@ static TSDBKEY       getCurrentKeyInBuf(STableBlockScanInfo* pScanInfo, STsdbRea
 static bool          hasDataInFileBlock(const SBlockData* pBlockData, const SFileBlockDumpInfo* pDumpInfo);
 static void          initBlockDumpInfo(STsdbReader* pReader, SDataBlockIter* pBlockIter);
 static int32_t       getInitialDelIndex(const SArray* pDelSkyline, int32_t order);
+static void          clearFilesetPrefetcher(SFilesetPrefetcher* pPrefetcher);
+static void          destroyFilesetPrefetcher(SFilesetPrefetcher** pPrefetcher);
+static bool          takeFilesetLoadTask(SFilesetIter* pIter, STsdbReader* pReader);
+static void          schedFilesetLoadTasks(SFilesetIter* pIter, STsdbReader* pReader);
+static void          closeDataFileReader(STsdbReader* pReader);
+static void          destroyBlockReadAhead(SBlockReadAhead** pReadAhead);
 
 static bool outOfTimeWindow(int64_t ts, STimeWindow* pWindow) { return (ts > pWindow->ekey) || (ts < pWindow->skey); }
 
@@ -153,10 +162,54 @@ static int32_t initFilesetIterator(SFilesetIter* pIter, TFileSetArray* pFileSetA
 
   pLReader->uid = 0;
   tMergeTreeClose(&pLReader->mergeTree);
+
+  clearFilesetPrefetcher(pIter->pPrefetcher);
+  if (pIter->pPrefetcher == NULL && tsQueryFilesetPrefetch > 0 && numOfFileset > 1) {
+    pIter->pPrefetcher = taosMemoryCalloc(1, sizeof(SFilesetPrefetcher));
+    if (pIter->pPrefetcher != NULL) {
+      taosThreadMutexInit(&pIter->pPrefetcher->mutex, NULL);
+      taosThreadCondInit(&pIter->pPrefetcher->cond, NULL);
+      pIter->pPrefetcher->pTaskList = taosArrayInit(4, POINTER_BYTES);
+    }
+  }
+
   tsdbDebug("init fileset iterator, total files:%d %s", pIter->numOfFiles, pReader->idStr);
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t openDataFileReader(STsdbReader* pReader, STFileSet* pFileset, SDataFileReader** ppFileReader) {
+  STFileObj** pFileObj = pFileset->farr;
+  if (pFileObj[0] == NULL && pFileObj[3] == NULL) {
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SDataFileReaderConfig conf = {.tsdb = pReader->pTsdb, .szPage = pReader->pTsdb->pVnode->config.tsdbPageSize};
+
+  const char* filesName[4] = {0};
+
+  if (pFileObj[0] != NULL) {
+    conf.files[0].file = *pFileObj[0]->f;
+    conf.files[0].exist = true;
+    filesName[0] = pFileObj[0]->fname;
+
+    conf.files[1].file = *pFileObj[1]->f;
+    conf.files[1].exist = true;
+    filesName[1] = pFileObj[1]->fname;
+
+    conf.files[2].file = *pFileObj[2]->f;
+    conf.files[2].exist = true;
+    filesName[2] = pFileObj[2]->fname;
+  }
+
+  if (pFileObj[3] != NULL) {
+    conf.files[3].exist = true;
+    conf.files[3].file = *pFileObj[3]->f;
+    filesName[3] = pFileObj[3]->fname;
+  }
+
+  return tsdbDataFileReaderOpen(filesName, &conf, ppFileReader);
+}
+
 static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bool* hasNext) {
   bool    asc = ASCENDING_TRAVERSE(pIter->order);
   int32_t step = asc ? 1 : -1;
@@ -180,43 +233,20 @@ static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bo
 
   while (1) {
     if (pReader->pFileReader != NULL) {
-      tsdbDataFileReaderClose(&pReader->pFileReader);
+      closeDataFileReader(pReader);
     }
 
     pReader->status.pCurrentFileset = pIter->pFilesetList->data[pIter->index];
 
-    STFileObj** pFileObj = pReader->status.pCurrentFileset->farr;
-    if (pFileObj[0] != NULL || pFileObj[3] != NULL) {
-      SDataFileReaderConfig conf = {.tsdb = pReader->pTsdb, .szPage = pReader->pTsdb->pVnode->config.tsdbPageSize};
-
-      const char* filesName[4] = {0};
-
-      if (pFileObj[0] != NULL) {
-        conf.files[0].file = *pFileObj[0]->f;
-        conf.files[0].exist = true;
-        filesName[0] = pFileObj[0]->fname;
-
-        conf.files[1].file = *pFileObj[1]->f;
-        conf.files[1].exist = true;
-        filesName[1] = pFileObj[1]->fname;
-
-        conf.files[2].file = *pFileObj[2]->f;
-        conf.files[2].exist = true;
-        filesName[2] = pFileObj[2]->fname;
-      }
-
-      if (pFileObj[3] != NULL) {
-        conf.files[3].exist = true;
-        conf.files[3].file = *pFileObj[3]->f;
-        filesName[3] = pFileObj[3]->fname;
-      }
-
-      code = tsdbDataFileReaderOpen(filesName, &conf, &pReader->pFileReader);
+    if (!takeFilesetLoadTask(pIter, pReader)) {
+      code = openDataFileReader(pReader, pReader->status.pCurrentFileset, &pReader->pFileReader);
       if (code != TSDB_CODE_SUCCESS) {
         goto _err;
       }
 
-      pReader->cost.headFileLoad += 1;
+      if (pReader->pFileReader != NULL) {
+        pReader->cost.headFileLoad += 1;
+      }
     }
 
     int32_t fid = pReader->status.pCurrentFileset->fid;
@@ -241,6 +271,7 @@ static int32_t filesetIteratorNext(SFilesetIter* pIter, STsdbReader* pReader, bo
 
     tsdbDebug("%p file found fid:%d for qrange:%" PRId64 "-%" PRId64 ", %s", pReader, fid, pReader->info.window.skey,
               pReader->info.window.ekey, pReader->idStr);
+    schedFilesetLoadTasks(pIter, pReader);
     *hasNext = true;
     return TSDB_CODE_SUCCESS;
   }
@@ -345,7 +376,13 @@ static int32_t tsdbReleaseReader(STsdbReader* pReader) {
   return code;
 }
 
+static STsdbReader* getRetrieveReader(STsdbReader* pReader);
+
 void tsdbReleaseDataBlock2(STsdbReader* pReader) {
+  SBlockLateLoadInfo* pLateLoad = &getRetrieveReader(pReader)->status.lateLoad;
+  pLateLoad->pending = false;
+  pLateLoad->partial = false;
+
   SReaderStatus* pStatus = &pReader->status;
   if (!pStatus->composedDataBlock) {
     tsdbReleaseReader(pReader);
@@ -416,6 +453,20 @@ static int32_t tsdbReaderCreate(SVnode* pVnode, SQueryTableDataCond* pCond, void
     goto _end;
   }
 
+  SBlockLateLoadInfo* pLateLoad = &pReader->status.lateLoad;
+  code = tBlockDataCreate(&pLateLoad->blockData);
+  if (code != TSDB_CODE_SUCCESS) {
+    terrno = code;
+    goto _end;
+  }
+
+  pLateLoad->pFilterCols = taosArrayInit(4, sizeof(int16_t));
+  pLateLoad->pRemainCols = taosArrayInit(4, sizeof(int16_t));
+  if (pLateLoad->pFilterCols == NULL || pLateLoad->pRemainCols == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _end;
+  }
+
   if (pReader->suppInfo.colId[0] != PRIMARYKEY_TIMESTAMP_COL_ID) {
     tsdbError("the first column isn't primary timestamp, %d, %s", pReader->suppInfo.colId[0], pReader->idStr);
     code = TSDB_CODE_INVALID_PARA;
@@ -442,6 +493,8 @@ _end:
   return code;
 }
 
+static void filterBrinBlk(STsdbReader* pReader, const TBrinBlkArray* pBlkArray, SArray* pIndexList);
+
 static int32_t doLoadBlockIndex(STsdbReader* pReader, SDataFileReader* pFileReader, SArray* pIndexList) {
   int64_t st = taosGetTimestampUs();
   int32_t numOfTables = tSimpleHashGetSize(pReader->status.pTableMap);
@@ -475,7 +528,23 @@ static int32_t doLoadBlockIndex(STsdbReader* pReader, SDataFileReader* pFileRead
 
   // todo binary search to the start position
   int64_t et1 = taosGetTimestampUs();
+  filterBrinBlk(pReader, pBlkArray, pIndexList);
+
+  int64_t et2 = taosGetTimestampUs();
+  tsdbDebug("load block index for %d/%d tables completed, elapsed time:%.2f ms, set BrinBlk:%.2f ms, size:%.2f Kb %s",
+            numOfTables, (int32_t)pBlkArray->size, (et1 - st) / 1000.0, (et2 - et1) / 1000.0,
+            pBlkArray->size * sizeof(SBrinBlk) / 1024.0, pReader->idStr);
+
+  pReader->cost.headFileLoadTime += (et1 - st) / 1000.0;
+
+_end:
+  //  tsdbBICacheRelease(pFileReader->pTsdb->biCache, handle);
+  return code;
+}
 
+// keep the brin blocks that may contain the queried tables
+static void filterBrinBlk(STsdbReader* pReader, const TBrinBlkArray* pBlkArray, SArray* pIndexList) {
+  int32_t        numOfTables = tSimpleHashGetSize(pReader->status.pTableMap);
   SBrinBlk*      pBrinBlk = NULL;
   STableUidList* pList = &pReader->status.uidList;
 
@@ -505,17 +574,6 @@ static int32_t doLoadBlockIndex(STsdbReader* pReader, SDataFileReader* pFileRead
     taosArrayPush(pIndexList, pBrinBlk);
     i += 1;
   }
-
-  int64_t et2 = taosGetTimestampUs();
-  tsdbDebug("load block index for %d/%d tables completed, elapsed time:%.2f ms, set BrinBlk:%.2f ms, size:%.2f Kb %s",
-            numOfTables, (int32_t)pBlkArray->size, (et1 - st) / 1000.0, (et2 - et1) / 1000.0,
-            pBlkArray->size * sizeof(SBrinBlk) / 1024.0, pReader->idStr);
-
-  pReader->cost.headFileLoadTime += (et1 - st) / 1000.0;
-
-_end:
-  //  tsdbBICacheRelease(pFileReader->pTsdb->biCache, handle);
-  return code;
 }
 
 static int32_t doLoadFileBlock(STsdbReader* pReader, SArray* pIndexList, SBlockNumber* pBlockNum,
@@ -532,8 +590,11 @@ static int32_t doLoadFileBlock(STsdbReader* pReader, SArray* pIndexList, SBlockN
   STimeWindow  w = pReader->info.window;
   SBrinRecord* pRecord = NULL;
 
+  SFilesetPrefetcher* pPrefetcher = pReader->status.fileIter.pPrefetcher;
+  SArray*             pBrinBlocks = (pPrefetcher != NULL && pPrefetcher->pCurrent != NULL) ? pPrefetcher->pCurrent->pBrinBlocks : NULL;
+
   SBrinRecordIter iter = {0};
-  initBrinRecordIter(&iter, pReader->pFileReader, pIndexList);
+  initBrinRecordIter(&iter, pReader->pFileReader, pIndexList, pBrinBlocks);
 
   while (((pRecord = getNextBrinRecord(&iter)) != NULL)) {
     if (pRecord->suid > pReader->info.suid) {
@@ -623,6 +684,578 @@ static int32_t doLoadFileBlock(STsdbReader* pReader, SArray* pIndexList, SBlockN
   return TSDB_CODE_SUCCESS;
 }
 
+static void destroyFilesetLoadTask(SFilesetLoadTask* pTask) {
+  if (pTask == NULL) {
+    return;
+  }
+
+  tsdbDataFileReaderClose(&pTask->pFileReader);
+
+  for (int32_t i = 0; i < taosArrayGetSize(pTask->pBrinBlocks); ++i) {
+    tBrinBlockDestroy(taosArrayGet(pTask->pBrinBlocks, i));
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pTask->pBlockData); ++i) {
+    SPrefetchBlockData* p = taosArrayGet(pTask->pBlockData, i);
+    tBlockDataDestroy(&p->data);
+  }
+
+  taosArrayDestroy(pTask->pIndexList);
+  taosArrayDestroy(pTask->pBrinBlocks);
+  taosArrayDestroy(pTask->pBlockData);
+  taosMemoryFree(pTask);
+}
+
+static void waitFilesetLoadTask(SFilesetPrefetcher* pPrefetcher, SFilesetLoadTask* pTask) {
+  taosThreadMutexLock(&pPrefetcher->mutex);
+  while (!pTask->done) {
+    taosThreadCondWait(&pPrefetcher->cond, &pPrefetcher->mutex);
+  }
+  taosThreadMutexUnlock(&pPrefetcher->mutex);
+}
+
+// wait for all running tasks, and discard the loaded file sets.
+static void clearFilesetPrefetcher(SFilesetPrefetcher* pPrefetcher) {
+  if (pPrefetcher == NULL) {
+    return;
+  }
+
+  taosThreadMutexLock(&pPrefetcher->mutex);
+  while (pPrefetcher->numOfRunning > 0) {
+    taosThreadCondWait(&pPrefetcher->cond, &pPrefetcher->mutex);
+  }
+  taosThreadMutexUnlock(&pPrefetcher->mutex);
+
+  for (int32_t i = 0; i < taosArrayGetSize(pPrefetcher->pTaskList); ++i) {
+    destroyFilesetLoadTask(taosArrayGetP(pPrefetcher->pTaskList, i));
+  }
+
+  taosArrayClear(pPrefetcher->pTaskList);
+  destroyFilesetLoadTask(pPrefetcher->pCurrent);
+  pPrefetcher->pCurrent = NULL;
+}
+
+static void destroyFilesetPrefetcher(SFilesetPrefetcher** pPrefetcher) {
+  if (*pPrefetcher == NULL) {
+    return;
+  }
+
+  clearFilesetPrefetcher(*pPrefetcher);
+  taosArrayDestroy((*pPrefetcher)->pTaskList);
+  taosThreadCondDestroy(&(*pPrefetcher)->cond);
+  taosThreadMutexDestroy(&(*pPrefetcher)->mutex);
+  taosMemoryFreeClear(*pPrefetcher);
+}
+
+// decode the leading data blocks in the access order, that may be required by the query.
+static int32_t doLoadDataBlocksAhead(SFilesetLoadTask* pTask) {
+  STsdbReader*        pReader = pTask->pReader;
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  STimeWindow*        pWindow = &pReader->info.window;
+  SVersionRange*      pVerRange = &pReader->info.verRange;
+  int32_t             numOfTables = tSimpleHashGetSize(pReader->status.pTableMap);
+  int32_t             code = TSDB_CODE_SUCCESS;
+
+  SArray* pRecList = taosArrayInit(PREFETCH_DATA_BLOCKS_PER_SET, sizeof(SBrinRecord));
+  if (pRecList == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  SBrinRecordIter iter = {0};
+  initBrinRecordIter(&iter, pTask->pFileReader, pTask->pIndexList, pTask->pBrinBlocks);
+
+  SBrinRecord* pRecord = NULL;
+  while ((pRecord = getNextBrinRecord(&iter)) != NULL) {
+    if (pRecord->suid != pReader->info.suid || pRecord->firstKey > pWindow->ekey || pRecord->lastKey < pWindow->skey ||
+        pRecord->minVer > pVerRange->maxVer || pRecord->maxVer < pVerRange->minVer) {
+      continue;
+    }
+
+    if (taosbsearch(&pRecord->uid, pReader->status.uidList.tableUidList, numOfTables, sizeof(uint64_t),
+                    uidComparFunc, TD_EQ) == NULL) {
+      continue;
+    }
+
+    if (ASCENDING_TRAVERSE(pReader->info.order)) {
+      taosArrayPush(pRecList, pRecord);
+      if (taosArrayGetSize(pRecList) >= PREFETCH_DATA_BLOCKS_PER_SET) {
+        break;
+      }
+    } else {  // keep the last ones for descending traverse
+      if (taosArrayGetSize(pRecList) >= PREFETCH_DATA_BLOCKS_PER_SET) {
+        taosArrayRemove(pRecList, 0);
+      }
+      taosArrayPush(pRecList, pRecord);
+    }
+  }
+
+  clearBrinBlockIter(&iter);
+
+  int32_t num = taosArrayGetSize(pRecList);
+  pTask->pBlockData = taosArrayInit(num, sizeof(SPrefetchBlockData));
+  if (pTask->pBlockData == NULL) {
+    taosArrayDestroy(pRecList);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  for (int32_t i = 0; i < num; ++i) {
+    SBrinRecord*       pRec = taosArrayGet(pRecList, i);
+    SPrefetchBlockData bd = {.blockOffset = pRec->blockOffset};
+
+    code = tBlockDataCreate(&bd.data);
+    if (code != TSDB_CODE_SUCCESS) {
+      break;
+    }
+
+    code = tsdbDataFileReadBlockDataByColumn(pTask->pFileReader, pRec, &bd.data, pTask->pSchema, &pSup->colId[1],
+                                             pSup->numOfCols - 1);
+    if (code != TSDB_CODE_SUCCESS) {
+      tBlockDataDestroy(&bd.data);
+      break;
+    }
+
+    taosArrayPush(pTask->pBlockData, &bd);
+  }
+
+  taosArrayDestroy(pRecList);
+  return code;
+}
+
+// executed in the vnode read threads. Only the read-only query conditions of the reader are accessed.
+static int32_t doLoadFilesetAhead(void* param) {
+  SFilesetLoadTask*   pTask = param;
+  SFilesetPrefetcher* pPrefetcher = pTask->pPrefetcher;
+  STsdbReader*        pReader = pTask->pReader;
+  int64_t             st = taosGetTimestampUs();
+
+  int32_t code = openDataFileReader(pReader, pTask->pFileset, &pTask->pFileReader);
+  if (code == TSDB_CODE_SUCCESS && pTask->pFileReader != NULL) {
+    const TBrinBlkArray* pBlkArray = NULL;
+
+    pTask->pIndexList = taosArrayInit(4, sizeof(SBrinBlk));
+    code = (pTask->pIndexList == NULL) ? TSDB_CODE_OUT_OF_MEMORY : tsdbDataFileReadBrinBlk(pTask->pFileReader, &pBlkArray);
+    if (code == TSDB_CODE_SUCCESS) {
+      filterBrinBlk(pReader, pBlkArray, pTask->pIndexList);
+
+      int32_t num = taosArrayGetSize(pTask->pIndexList);
+      pTask->pBrinBlocks = taosArrayInit(num, sizeof(SBrinBlock));
+      code = (pTask->pBrinBlocks == NULL) ? TSDB_CODE_OUT_OF_MEMORY : TSDB_CODE_SUCCESS;
+
+      for (int32_t i = 0; i < num && code == TSDB_CODE_SUCCESS; ++i) {
+        SBrinBlock block = {0};
+        tBrinBlockInit(&block);
+        code = tsdbDataFileReadBrinBlock(pTask->pFileReader, taosArrayGet(pTask->pIndexList, i), &block);
+        taosArrayPush(pTask->pBrinBlocks, &block);
+      }
+    }
+
+    // the tomb data blocks are cached in the file reader
+    if (code == TSDB_CODE_SUCCESS && pTask->pFileset->farr[3] != NULL) {
+      const TTombBlkArray* pTombBlkArray = NULL;
+      code = tsdbDataFileReadTombBlk(pTask->pFileReader, &pTombBlkArray);
+    }
+
+    int64_t et = taosGetTimestampUs();
+    pTask->headFileLoadTime = (et - st) / 1000.0;
+
+    if (code == TSDB_CODE_SUCCESS && pTask->pSchema != NULL) {
+      code = doLoadDataBlocksAhead(pTask);
+      pTask->blockLoadTime = (taosGetTimestampUs() - et) / 1000.0;
+    }
+  }
+
+  if (code != TSDB_CODE_SUCCESS) {
+    tsdbWarn("%p failed to load file set fid:%d ahead, code:%s %s", pReader, pTask->pFileset->fid, tstrerror(code),
+             pReader->idStr);
+  }
+
+  taosThreadMutexLock(&pPrefetcher->mutex);
+  pTask->code = code;
+  pTask->done = true;
+  pPrefetcher->numOfRunning -= 1;
+  taosThreadCondBroadcast(&pPrefetcher->cond);
+  taosThreadMutexUnlock(&pPrefetcher->mutex);
+  return code;
+}
+
+// schedule the following file sets to be loaded ahead, at most tsQueryFilesetPrefetch file sets are loaded ahead.
+static void schedFilesetLoadTasks(SFilesetIter* pIter, STsdbReader* pReader) {
+  SFilesetPrefetcher* pPrefetcher = pIter->pPrefetcher;
+  if (pPrefetcher == NULL) {
+    return;
+  }
+
+  bool    asc = ASCENDING_TRAVERSE(pIter->order);
+  int32_t step = asc ? 1 : -1;
+  int32_t index = pIter->index;
+  int32_t num = taosArrayGetSize(pPrefetcher->pTaskList);
+  if (num > 0) {
+    index = (*(SFilesetLoadTask**)taosArrayGetLast(pPrefetcher->pTaskList))->index;
+  }
+
+  while (num < tsQueryFilesetPrefetch) {
+    index += step;
+    if (index < 0 || index >= pIter->numOfFiles) {
+      break;
+    }
+
+    STFileSet*  pFileset = pIter->pFilesetList->data[index];
+    STimeWindow win = {0};
+    tsdbFidKeyRange(pFileset->fid, pReader->pTsdb->keepCfg.days, pReader->pTsdb->keepCfg.precision, &win.skey,
+                    &win.ekey);
+
+    if ((asc && win.skey > pReader->info.window.ekey) || (!asc && win.ekey < pReader->info.window.skey)) {
+      break;
+    }
+
+    if ((asc && (win.ekey < pReader->info.window.skey)) || ((!asc) && (win.skey > pReader->info.window.ekey)) ||
+        (pFileset->farr[0] == NULL && pFileset->farr[3] == NULL)) {
+      continue;
+    }
+
+    SFilesetLoadTask* pTask = taosMemoryCalloc(1, sizeof(SFilesetLoadTask));
+    if (pTask == NULL) {
+      break;
+    }
+
+    pTask->pPrefetcher = pPrefetcher;
+    pTask->pReader = pReader;
+    pTask->pFileset = pFileset;
+    pTask->pSchema = pReader->info.pSchema;
+    pTask->index = index;
+
+    taosArrayPush(pPrefetcher->pTaskList, &pTask);
+    num += 1;
+
+    taosThreadMutexLock(&pPrefetcher->mutex);
+    pPrefetcher->numOfRunning += 1;
+    taosThreadMutexUnlock(&pPrefetcher->mutex);
+
+    if (vnodeScheduleTaskEx(VNODE_READ_THREAD_POOL, doLoadFilesetAhead, pTask) != 0) {
+      taosThreadMutexLock(&pPrefetcher->mutex);
+      pPrefetcher->numOfRunning -= 1;
+      pTask->code = terrno;
+      pTask->done = true;
+      taosThreadMutexUnlock(&pPrefetcher->mutex);
+      break;
+    }
+  }
+}
+
+// take the file set loaded ahead, return false if current file set is not loaded ahead.
+static bool takeFilesetLoadTask(SFilesetIter* pIter, STsdbReader* pReader) {
+  SFilesetPrefetcher* pPrefetcher = pIter->pPrefetcher;
+  if (pPrefetcher == NULL) {
+    return false;
+  }
+
+  destroyFilesetLoadTask(pPrefetcher->pCurrent);
+  pPrefetcher->pCurrent = NULL;
+
+  bool              asc = ASCENDING_TRAVERSE(pIter->order);
+  SFilesetLoadTask* pTask = NULL;
+
+  while (taosArrayGetSize(pPrefetcher->pTaskList) > 0) {
+    SFilesetLoadTask* p = taosArrayGetP(pPrefetcher->pTaskList, 0);
+    if ((asc && p->index > pIter->index) || (!asc && p->index < pIter->index)) {
+      break;
+    }
+
+    waitFilesetLoadTask(pPrefetcher, p);
+    taosArrayRemove(pPrefetcher->pTaskList, 0);
+
+    if (p->index == pIter->index) {
+      pTask = p;
+      break;
+    }
+
+    // the file set is skipped
+    destroyFilesetLoadTask(p);
+  }
+
+  if (pTask == NULL) {
+    return false;
+  }
+
+  if (pTask->code != TSDB_CODE_SUCCESS || pTask->pFileReader == NULL) {  // try again in current thread
+    destroyFilesetLoadTask(pTask);
+    return false;
+  }
+
+  pReader->pFileReader = pTask->pFileReader;
+  pTask->pFileReader = NULL;
+
+  pReader->cost.headFileLoad += 1;
+  pReader->cost.headFileLoadTime += pTask->headFileLoadTime;
+  pReader->cost.blockLoadTime += pTask->blockLoadTime;
+
+  pPrefetcher->pCurrent = pTask;
+  tsdbDebug("%p file set fid:%d is loaded ahead, data blocks:%d, %s", pReader, pTask->pFileset->fid,
+            (int32_t)taosArrayGetSize(pTask->pBlockData), pReader->idStr);
+  return true;
+}
+
+// move the data block loaded ahead into pBlockData, return false if it is not loaded ahead.
+static bool takePrefetchedBlockData(STsdbReader* pReader, STSchema* pSchema, const SBrinRecord* pRecord,
+                                    SBlockData* pBlockData) {
+  SFilesetPrefetcher* pPrefetcher = pReader->status.fileIter.pPrefetcher;
+  if (pPrefetcher == NULL || pPrefetcher->pCurrent == NULL || pPrefetcher->pCurrent->pSchema != pSchema) {
+    return false;
+  }
+
+  SArray* pList = pPrefetcher->pCurrent->pBlockData;
+  for (int32_t i = 0; i < taosArrayGetSize(pList); ++i) {
+    SPrefetchBlockData* p = taosArrayGet(pList, i);
+    if (p->blockOffset == pRecord->blockOffset) {
+      SBlockData tmp = *pBlockData;
+      *pBlockData = p->data;
+      p->data = tmp;
+      p->blockOffset = -1;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void destroyBlockReadAheadTask(SBlockReadAheadTask* pTask) {
+  if (pTask != NULL) {
+    taosMemoryFree(pTask->pBuf);
+    taosMemoryFree(pTask);
+  }
+}
+
+// wait for and discard the first num tasks in the task list
+static void discardBlockReadAheadTasks(SBlockReadAhead* pReadAhead, int32_t num) {
+  taosThreadMutexLock(&pReadAhead->mutex);
+  for (int32_t i = 0; i < num; ++i) {
+    SBlockReadAheadTask* pTask = taosArrayGetP(pReadAhead->pTaskList, i);
+    while (!pTask->done) {
+      taosThreadCondWait(&pReadAhead->cond, &pReadAhead->mutex);
+    }
+  }
+  taosThreadMutexUnlock(&pReadAhead->mutex);
+
+  for (int32_t i = 0; i < num; ++i) {
+    destroyBlockReadAheadTask(taosArrayGetP(pReadAhead->pTaskList, i));
+  }
+  taosArrayRemoveBatch(pReadAhead->pTaskList, 0, num, NULL);
+}
+
+static void resetBlockReadAheadWindow(SBlockReadAhead* pReadAhead) {
+  if (pReadAhead->pCurrent != NULL) {
+    tsdbDataFileSetReadAhead(pReadAhead->pFileReader, 0, 0, NULL);
+    destroyBlockReadAheadTask(pReadAhead->pCurrent);
+    pReadAhead->pCurrent = NULL;
+  }
+}
+
+// the tasks read from the data file reader, so it must be invoked before the data file reader is closed.
+static void clearBlockReadAhead(SBlockReadAhead* pReadAhead) {
+  if (pReadAhead == NULL) {
+    return;
+  }
+
+  discardBlockReadAheadTasks(pReadAhead, taosArrayGetSize(pReadAhead->pTaskList));
+  resetBlockReadAheadWindow(pReadAhead);
+  pReadAhead->pFileReader = NULL;
+  pReadAhead->nextIndex = -1;
+  pReadAhead->disabled = false;
+}
+
+static void destroyBlockReadAhead(SBlockReadAhead** pReadAhead) {
+  if (*pReadAhead == NULL) {
+    return;
+  }
+
+  clearBlockReadAhead(*pReadAhead);
+  taosArrayDestroy((*pReadAhead)->pTaskList);
+  taosThreadCondDestroy(&(*pReadAhead)->cond);
+  taosThreadMutexDestroy(&(*pReadAhead)->mutex);
+  taosMemoryFreeClear(*pReadAhead);
+}
+
+static void closeDataFileReader(STsdbReader* pReader) {
+  clearBlockReadAhead(pReader->status.pReadAhead);
+  tsdbDataFileReaderClose(&pReader->pFileReader);
+}
+
+// executed in the vnode read threads.
+static int32_t doReadBlocksAhead(void* param) {
+  SBlockReadAheadTask* pTask = param;
+  SBlockReadAhead*     pReadAhead = pTask->pReadAhead;
+  int32_t              code = TSDB_CODE_SUCCESS;
+
+  pTask->pBuf = taosMemoryMalloc(pTask->size);
+  if (pTask->pBuf == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+  } else {
+    code = tsdbDataFileReadAhead(pTask->pFileReader, pTask->offset, pTask->size, pTask->pBuf);
+  }
+
+  taosThreadMutexLock(&pReadAhead->mutex);
+  pTask->code = code;
+  pTask->done = true;
+  pReadAhead->numOfRunning -= 1;
+  taosThreadCondBroadcast(&pReadAhead->cond);
+  taosThreadMutexUnlock(&pReadAhead->mutex);
+  return code;
+}
+
+// Read the following data blocks ahead, until tsQueryReadAheadSize KB are read or being read. The adjacent blocks of
+// the same table are merged into one range, which is limited to half of the read-ahead size to keep the pipeline.
+static void schedBlockReadAheadTasks(SBlockReadAhead* pReadAhead, SDataBlockIter* pBlockIter) {
+  bool    asc = ASCENDING_TRAVERSE(pBlockIter->order);
+  int32_t step = asc ? 1 : -1;
+  int32_t total = taosArrayGetSize(pBlockIter->blockList);
+  int64_t limit = tsQueryReadAheadSize * 1024LL;
+  int64_t maxRange = limit / 2;
+  int64_t inflight = 0;
+
+  for (int32_t i = 0; i < taosArrayGetSize(pReadAhead->pTaskList); ++i) {
+    inflight += ((SBlockReadAheadTask*)taosArrayGetP(pReadAhead->pTaskList, i))->size;
+  }
+
+  while (inflight < limit && pReadAhead->nextIndex >= 0 && pReadAhead->nextIndex < total) {
+    SFileDataBlockInfo* pFirst = taosArrayGet(pBlockIter->blockList, pReadAhead->nextIndex);
+    int64_t             start = pFirst->record.blockOffset;
+    int64_t             end = start + pFirst->record.blockSize;
+    int32_t             num = 1;
+    int32_t             index = pReadAhead->nextIndex + step;
+
+    for (; index >= 0 && index < total; index += step, num += 1) {
+      SFileDataBlockInfo* p = taosArrayGet(pBlockIter->blockList, index);
+      if (p->uid != pFirst->uid) {
+        break;
+      }
+
+      if (asc && p->record.blockOffset == end && end + p->record.blockSize - start <= maxRange) {
+        end += p->record.blockSize;
+      } else if (!asc && p->record.blockOffset + p->record.blockSize == start &&
+                 end - p->record.blockOffset <= maxRange) {
+        start = p->record.blockOffset;
+      } else {
+        break;
+      }
+    }
+
+    SBlockReadAheadTask* pTask = taosMemoryCalloc(1, sizeof(SBlockReadAheadTask));
+    if (pTask == NULL) {
+      break;
+    }
+
+    pTask->pReadAhead = pReadAhead;
+    pTask->pFileReader = pReadAhead->pFileReader;
+    pTask->offset = start;
+    pTask->size = end - start;
+    pTask->numOfBlocks = num;
+
+    taosArrayPush(pReadAhead->pTaskList, &pTask);
+    pReadAhead->nextIndex = index;
+    inflight += pTask->size;
+
+    taosThreadMutexLock(&pReadAhead->mutex);
+    pReadAhead->numOfRunning += 1;
+    taosThreadMutexUnlock(&pReadAhead->mutex);
+
+    if (vnodeScheduleTaskEx(VNODE_READ_THREAD_POOL, doReadBlocksAhead, pTask) != 0) {
+      taosThreadMutexLock(&pReadAhead->mutex);
+      pReadAhead->numOfRunning -= 1;
+      pTask->code = terrno;
+      pTask->done = true;
+      taosThreadMutexUnlock(&pReadAhead->mutex);
+      break;
+    }
+  }
+}
+
+static bool blockInReadAheadTask(const SBlockReadAheadTask* pTask, const SBrinRecord* pRecord) {
+  return pRecord->blockOffset >= pTask->offset && pRecord->blockOffset + pRecord->blockSize <= pTask->offset + pTask->size;
+}
+
+// Install the data read ahead that covers the block to be loaded as the read-ahead window of the data file, and
+// read the following blocks ahead. The block is loaded from the data file as usual if it is not read ahead.
+static void prepareBlockReadAhead(STsdbReader* pReader, SDataBlockIter* pBlockIter, const SBrinRecord* pRecord) {
+  if (tsQueryReadAheadSize <= 0 || pReader->pFileReader == NULL) {
+    return;
+  }
+
+  SBlockReadAhead* pReadAhead = pReader->status.pReadAhead;
+  if (pReadAhead == NULL) {
+    pReadAhead = taosMemoryCalloc(1, sizeof(SBlockReadAhead));
+    if (pReadAhead == NULL) {
+      return;
+    }
+
+    pReadAhead->pTaskList = taosArrayInit(4, POINTER_BYTES);
+    if (pReadAhead->pTaskList == NULL) {
+      taosMemoryFree(pReadAhead);
+      return;
+    }
+
+    taosThreadMutexInit(&pReadAhead->mutex, NULL);
+    taosThreadCondInit(&pReadAhead->cond, NULL);
+    pReadAhead->nextIndex = -1;
+    pReader->status.pReadAhead = pReadAhead;
+  }
+
+  if (pReadAhead->pFileReader != pReader->pFileReader) {
+    clearBlockReadAhead(pReadAhead);
+    pReadAhead->pFileReader = pReader->pFileReader;
+    pReadAhead->disabled = (tsdbDataFilePrepareReadAhead(pReadAhead->pFileReader) != TSDB_CODE_SUCCESS);
+  }
+
+  if (pReadAhead->disabled) {
+    return;
+  }
+
+  if (pReadAhead->pCurrent != NULL && blockInReadAheadTask(pReadAhead->pCurrent, pRecord)) {
+    return;
+  }
+
+  resetBlockReadAheadWindow(pReadAhead);
+
+  // the tasks of skipped blocks are discarded
+  int32_t num = taosArrayGetSize(pReadAhead->pTaskList);
+  int32_t pos = 0;
+  while (pos < num && !blockInReadAheadTask(taosArrayGetP(pReadAhead->pTaskList, pos), pRecord)) {
+    pos += 1;
+  }
+
+  discardBlockReadAheadTasks(pReadAhead, pos);
+  if (pos == num) {
+    pReadAhead->nextIndex = pBlockIter->index;
+  }
+
+  schedBlockReadAheadTasks(pReadAhead, pBlockIter);
+  if (taosArrayGetSize(pReadAhead->pTaskList) == 0) {
+    return;
+  }
+
+  SBlockReadAheadTask* pTask = taosArrayGetP(pReadAhead->pTaskList, 0);
+  if (!blockInReadAheadTask(pTask, pRecord)) {
+    return;
+  }
+
+  taosThreadMutexLock(&pReadAhead->mutex);
+  while (!pTask->done) {
+    taosThreadCondWait(&pReadAhead->cond, &pReadAhead->mutex);
+  }
+  taosThreadMutexUnlock(&pReadAhead->mutex);
+
+  taosArrayRemove(pReadAhead->pTaskList, 0);
+  if (pTask->code != TSDB_CODE_SUCCESS) {  // try again in current thread
+    destroyBlockReadAheadTask(pTask);
+    return;
+  }
+
+  pReadAhead->pCurrent = pTask;
+  tsdbDataFileSetReadAhead(pReadAhead->pFileReader, pTask->offset, pTask->size, pTask->pBuf);
+
+  pReader->cost.readAheadIO += 1;
+  pReader->cost.readAheadBlocks += pTask->numOfBlocks;
+}
+
 static void setBlockAllDumped(SFileBlockDumpInfo* pDumpInfo, int64_t maxKey, int32_t order) {
   int32_t step = ASCENDING_TRAVERSE(order) ? 1 : -1;
   pDumpInfo->allDumped = true;
@@ -861,19 +1494,104 @@ static void copyNumericCols(const SColData* pData, SFileBlockDumpInfo* pDumpInfo
   }
 }
 
+static bool isColumnInList(const SArray* pColIdList, int16_t cid) {
+  if (pColIdList == NULL) {
+    return true;
+  }
+
+  for (int32_t i = 0; i < taosArrayGetSize(pColIdList); ++i) {
+    if (*(int16_t*)taosArrayGet(pColIdList, i) == cid) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Copy the columns in pColIdList (all columns if it is NULL) to the result block, starting from the startIndex row of
+// the file block. The other columns of the result block are left untouched.
+static int32_t copyColumnsToSDataBlock(STsdbReader* pReader, SBlockData* pBlockData, int32_t startIndex,
+                                       int32_t dumpedRows, const SArray* pColIdList) {
+  SBlockLoadSuppInfo* pSupInfo = &pReader->suppInfo;
+  SSDataBlock*        pResBlock = pReader->resBlockInfo.pResBlock;
+  int32_t             numOfOutputCols = pSupInfo->numOfCols;
+  int32_t             code = TSDB_CODE_SUCCESS;
+  bool                asc = ASCENDING_TRAVERSE(pReader->info.order);
+  int32_t             step = asc ? 1 : -1;
+  SFileBlockDumpInfo  dumpInfo = {.rowIndex = startIndex};
+  SFileBlockDumpInfo* pDumpInfo = &dumpInfo;
+  SColVal             cv = {0};
+
+  int32_t i = 0;
+  int32_t rowIndex = 0;
+
+  SColumnInfoData* pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
+  if (pSupInfo->colId[i] == PRIMARYKEY_TIMESTAMP_COL_ID) {
+    copyPrimaryTsCol(pBlockData, pDumpInfo, pColData, dumpedRows, asc);
+    i += 1;
+  }
+
+  int32_t colIndex = 0;
+  int32_t num = pBlockData->nColData;
+  while (i < numOfOutputCols && colIndex < num) {
+    rowIndex = 0;
+
+    if (!isColumnInList(pColIdList, pSupInfo->colId[i])) {
+      i += 1;
+      continue;
+    }
+
+    SColData* pData = tBlockDataGetColDataByIdx(pBlockData, colIndex);
+    if (pData->cid < pSupInfo->colId[i]) {
+      colIndex += 1;
+    } else if (pData->cid == pSupInfo->colId[i]) {
+      pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
+
+      if (pData->flag == HAS_NONE || pData->flag == HAS_NULL || pData->flag == (HAS_NULL | HAS_NONE)) {
+        colDataSetNNULL(pColData, 0, dumpedRows);
+      } else {
+        if (IS_MATHABLE_TYPE(pColData->info.type)) {
+          copyNumericCols(pData, pDumpInfo, pColData, dumpedRows, asc);
+        } else {  // varchar/nchar type
+          for (int32_t j = pDumpInfo->rowIndex; rowIndex < dumpedRows; j += step) {
+            tColDataGetValue(pData, j, &cv);
+            code = doCopyColVal(pColData, rowIndex++, i, &cv, pSupInfo);
+            if (code) {
+              return code;
+            }
+          }
+        }
+      }
+
+      colIndex += 1;
+      i += 1;
+    } else {  // the specified column does not exist in file block, fill with null data
+      pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
+      colDataSetNNULL(pColData, 0, dumpedRows);
+      i += 1;
+    }
+  }
+
+  // fill the mis-matched columns with null value
+  for (; i < numOfOutputCols; ++i) {
+    if (isColumnInList(pColIdList, pSupInfo->colId[i])) {
+      pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
+      colDataSetNNULL(pColData, 0, dumpedRows);
+    }
+  }
+
+  return code;
+}
+
 static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader) {
   SReaderStatus*      pStatus = &pReader->status;
   SDataBlockIter*     pBlockIter = &pStatus->blockIter;
-  SBlockLoadSuppInfo* pSupInfo = &pReader->suppInfo;
   SFileBlockDumpInfo* pDumpInfo = &pReader->status.fBlockDumpInfo;
 
   SBlockData*         pBlockData = &pStatus->fileBlockData;
   SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(pBlockIter);
   SSDataBlock*        pResBlock = pReader->resBlockInfo.pResBlock;
-  int32_t             numOfOutputCols = pSupInfo->numOfCols;
   int32_t             code = TSDB_CODE_SUCCESS;
 
-  SColVal cv = {0};
   int64_t st = taosGetTimestampUs();
   bool    asc = ASCENDING_TRAVERSE(pReader->info.order);
   int32_t step = asc ? 1 : -1;
@@ -951,57 +1669,15 @@ static int32_t copyBlockDataToSDataBlock(STsdbReader* pReader) {
     return TSDB_CODE_SUCCESS;
   }
 
-  int32_t i = 0;
-  int32_t rowIndex = 0;
-
-  SColumnInfoData* pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
-  if (pSupInfo->colId[i] == PRIMARYKEY_TIMESTAMP_COL_ID) {
-    copyPrimaryTsCol(pBlockData, pDumpInfo, pColData, dumpedRows, asc);
-    i += 1;
-  }
-
-  int32_t colIndex = 0;
-  int32_t num = pBlockData->nColData;
-  while (i < numOfOutputCols && colIndex < num) {
-    rowIndex = 0;
-
-    SColData* pData = tBlockDataGetColDataByIdx(pBlockData, colIndex);
-    if (pData->cid < pSupInfo->colId[i]) {
-      colIndex += 1;
-    } else if (pData->cid == pSupInfo->colId[i]) {
-      pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
-
-      if (pData->flag == HAS_NONE || pData->flag == HAS_NULL || pData->flag == (HAS_NULL | HAS_NONE)) {
-        colDataSetNNULL(pColData, 0, dumpedRows);
-      } else {
-        if (IS_MATHABLE_TYPE(pColData->info.type)) {
-          copyNumericCols(pData, pDumpInfo, pColData, dumpedRows, asc);
-        } else {  // varchar/nchar type
-          for (int32_t j = pDumpInfo->rowIndex; rowIndex < dumpedRows; j += step) {
-            tColDataGetValue(pData, j, &cv);
-            code = doCopyColVal(pColData, rowIndex++, i, &cv, pSupInfo);
-            if (code) {
-              return code;
-            }
-          }
-        }
-      }
-
-      colIndex += 1;
-      i += 1;
-    } else {  // the specified column does not exist in file block, fill with null data
-      pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
-      colDataSetNNULL(pColData, 0, dumpedRows);
-      i += 1;
-    }
+  SBlockLateLoadInfo* pLateLoad = &pStatus->lateLoad;
+  code = copyColumnsToSDataBlock(pReader, pBlockData, pDumpInfo->rowIndex, dumpedRows,
+                                 pLateLoad->partial ? pLateLoad->pFilterCols : NULL);
+  if (code) {
+    return code;
   }
 
-  // fill the mis-matched columns with null value
-  while (i < numOfOutputCols) {
-    pColData = taosArrayGet(pResBlock->pDataBlock, pSupInfo->slotId[i]);
-    colDataSetNNULL(pColData, 0, dumpedRows);
-    i += 1;
-  }
+  pLateLoad->rowIndex = pDumpInfo->rowIndex;
+  pLateLoad->rows = dumpedRows;
 
   pResBlock->info.dataLoad = 1;
   pResBlock->info.rows = dumpedRows;
@@ -1051,8 +1727,8 @@ static FORCE_INLINE STSchema* getTableSchemaImpl(STsdbReader* pReader, uint64_t
   return pReader->info.pSchema;
 }
 
-static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
-                                   uint64_t uid) {
+static int32_t doLoadFileBlockDataByColumn(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                           uint64_t uid, int16_t* cids, int32_t ncid) {
   int32_t   code = 0;
   STSchema* pSchema = pReader->info.pSchema;
   int64_t   st = taosGetTimestampUs();
@@ -1069,11 +1745,16 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
 
   SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
   SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(pBlockIter);
-  SFileBlockDumpInfo* pDumpInfo = &pReader->status.fBlockDumpInfo;
 
+  // the data blocks loaded ahead contain all required columns
   SBrinRecord* pRecord = &pBlockInfo->record;
-  code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, &pSup->colId[1],
-                                           pSup->numOfCols - 1);
+  if (ncid == pSup->numOfCols - 1 && takePrefetchedBlockData(pReader, pSchema, pRecord, pBlockData)) {
+    code = TSDB_CODE_SUCCESS;
+  } else {
+    prepareBlockReadAhead(pReader, pBlockIter, pRecord);
+    code = tsdbDataFileReadBlockDataByColumn(pReader->pFileReader, pRecord, pBlockData, pSchema, cids, ncid);
+  }
+
   if (code != TSDB_CODE_SUCCESS) {
     tsdbError("%p error occurs in loading file block, global index:%d, table index:%d, brange:%" PRId64 "-%" PRId64
               ", rows:%d, code:%s %s",
@@ -1090,11 +1771,21 @@ static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockI
             pRecord->minVer, pRecord->maxVer, elapsedTime, pReader->idStr);
 
   pReader->cost.blockLoadTime += elapsedTime;
-  pDumpInfo->allDumped = false;
-
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t doLoadFileBlockData(STsdbReader* pReader, SDataBlockIter* pBlockIter, SBlockData* pBlockData,
+                                   uint64_t uid) {
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+
+  int32_t code = doLoadFileBlockDataByColumn(pReader, pBlockIter, pBlockData, uid, &pSup->colId[1], pSup->numOfCols - 1);
+  if (code == TSDB_CODE_SUCCESS) {
+    pReader->status.fBlockDumpInfo.allDumped = false;
+  }
+
+  return code;
+}
+
 /**
  * This is an two rectangles overlap cases.
  */
@@ -2504,10 +3195,16 @@ static int32_t moveToNextFile(STsdbReader* pReader, SBlockNumber* pBlockNum, SAr
     }
 
     taosArrayClear(pIndexList);
-    code = doLoadBlockIndex(pReader, pReader->pFileReader, pIndexList);
-    if (code != TSDB_CODE_SUCCESS) {
-      taosArrayDestroy(pIndexList);
-      return code;
+
+    SFilesetPrefetcher* pPrefetcher = pStatus->fileIter.pPrefetcher;
+    if (pPrefetcher != NULL && pPrefetcher->pCurrent != NULL) {  // the block index has been loaded ahead
+      taosArrayAddAll(pIndexList, pPrefetcher->pCurrent->pIndexList);
+    } else {
+      code = doLoadBlockIndex(pReader, pReader->pFileReader, pIndexList);
+      if (code != TSDB_CODE_SUCCESS) {
+        taosArrayDestroy(pIndexList);
+        return code;
+      }
     }
 
     if (taosArrayGetSize(pIndexList) > 0 || pReader->status.pCurrentFileset->lvlArr->size > 0) {
@@ -3767,6 +4464,9 @@ int32_t buildDataBlockFromBufImpl(STableBlockScanInfo* pBlockScanInfo, int64_t e
 int32_t tsdbSetTableList2(STsdbReader* pReader, const void* pTableList, int32_t num) {
   int32_t size = tSimpleHashGetSize(pReader->status.pTableMap);
 
+  // the table uid list is accessed by the file set load tasks
+  clearFilesetPrefetcher(pReader->status.fileIter.pPrefetcher);
+
   STableBlockScanInfo** p = NULL;
   int32_t               iter = 0;
 
@@ -4019,6 +4719,13 @@ void tsdbReaderClose2(STsdbReader* pReader) {
 
   {
     if (pReader->innerReader[0] != NULL || pReader->innerReader[1] != NULL) {
+      // the shared ptr may be accessed by the file set load tasks of inner readers
+      for (int32_t i = 0; i < tListLen(pReader->innerReader); ++i) {
+        if (pReader->innerReader[i] != NULL) {
+          destroyFilesetPrefetcher(&pReader->innerReader[i]->status.fileIter.pPrefetcher);
+        }
+      }
+
       STsdbReader* p = pReader->innerReader[0];
       clearSharedPtr(p);
 
@@ -4044,6 +4751,9 @@ void tsdbReaderClose2(STsdbReader* pReader) {
 
   taosMemoryFree(pSupInfo->colId);
   tBlockDataDestroy(&pReader->status.fileBlockData);
+  tBlockDataDestroy(&pReader->status.lateLoad.blockData);
+  taosArrayDestroy(pReader->status.lateLoad.pFilterCols);
+  taosArrayDestroy(pReader->status.lateLoad.pRemainCols);
   cleanupDataBlockIterator(&pReader->status.blockIter);
 
   size_t numOfTables = tSimpleHashGetSize(pReader->status.pTableMap);
@@ -4053,12 +4763,15 @@ void tsdbReaderClose2(STsdbReader* pReader) {
     pReader->status.pTableMap = NULL;
   }
 
+  SFilesetIter* pFilesetIter = &pReader->status.fileIter;
+  destroyFilesetPrefetcher(&pFilesetIter->pPrefetcher);
+
   if (pReader->pFileReader != NULL) {
-    tsdbDataFileReaderClose(&pReader->pFileReader);
+    closeDataFileReader(pReader);
   }
+  destroyBlockReadAhead(&pReader->status.pReadAhead);
 
   SCostSummary* pCost = &pReader->cost;
-  SFilesetIter* pFilesetIter = &pReader->status.fileIter;
   if (pFilesetIter->pLastBlockReader != NULL) {
     SLastBlockReader* pLReader = pFilesetIter->pLastBlockReader;
     tMergeTreeClose(&pLReader->mergeTree);
@@ -4082,12 +4795,13 @@ void tsdbReaderClose2(STsdbReader* pReader) {
       "build in-memory-block-time:%.2f ms, sttBlocks:%" PRId64 ", sttBlocks-time:%.2f ms, sttStatisBlock:%" PRId64
       ", stt-statis-Block-time:%.2f ms, composed-blocks:%" PRId64
       ", composed-blocks-time:%.2fms, STableBlockScanInfo size:%.2f Kb, createTime:%.2f ms,createSkylineIterTime:%.2f "
-      "ms, initLastBlockReader:%.2fms, %s",
+      "ms, initLastBlockReader:%.2fms, read-ahead IO:%" PRId64 ", read-ahead blocks:%" PRId64 ", %s",
       pReader, pCost->headFileLoad, pCost->headFileLoadTime, pCost->smaDataLoad, pCost->smaLoadTime, pCost->numOfBlocks,
       pCost->blockLoadTime, pCost->buildmemBlock, pCost->sttCost.loadBlocks, pCost->sttCost.blockElapsedTime,
       pCost->sttCost.loadStatisBlocks, pCost->sttCost.statisElapsedTime, pCost->composedBlocks,
       pCost->buildComposedBlockTime, numOfTables * sizeof(STableBlockScanInfo) / 1000.0, pCost->createScanInfoList,
-      pCost->createSkylineIterTime, pCost->initLastBlockReader, pReader->idStr);
+      pCost->createSkylineIterTime, pCost->initLastBlockReader, pCost->readAheadIO, pCost->readAheadBlocks,
+      pReader->idStr);
 
   taosMemoryFree(pReader->idStr);
 
@@ -4104,6 +4818,14 @@ int32_t tsdbReaderSuspend2(STsdbReader* pReader) {
   SReaderStatus*       pStatus = &pReader->status;
   STableBlockScanInfo* pBlockScanInfo = NULL;
 
+  // the file sets loaded ahead must be released before the read snapshot, including the ones of inner readers
+  clearFilesetPrefetcher(pStatus->fileIter.pPrefetcher);
+  for (int32_t i = 0; i < tListLen(pReader->innerReader); ++i) {
+    if (pReader->innerReader[i] != NULL) {
+      clearFilesetPrefetcher(pReader->innerReader[i]->status.fileIter.pPrefetcher);
+    }
+  }
+
   if (pStatus->loadFromFile) {
     SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(&pReader->status.blockIter);
     if (pBlockInfo != NULL) {
@@ -4115,7 +4837,7 @@ int32_t tsdbReaderSuspend2(STsdbReader* pReader) {
       pBlockScanInfo = *pStatus->pTableIter;
     }
 
-    tsdbDataFileReaderClose(&pReader->pFileReader);
+    closeDataFileReader(pReader);
 
     SCostSummary* pCost = &pReader->cost;
     pReader->status.pLDataIterArray = destroySttBlockReader(pReader->status.pLDataIterArray, &pCost->sttCost);
@@ -4575,8 +5297,48 @@ int32_t tsdbRetrieveDatablockSMA2(STsdbReader* pReader, SSDataBlock* pDataBlock,
   return code;
 }
 
-static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
+// Split the columns into the ones in pIdList and the remaining ones, return false if current file block can not be
+// loaded in two phases.
+static bool splitLateLoadColumns(STsdbReader* pReader, const SBrinRecord* pRecord, const SArray* pIdList) {
+  SBlockLoadSuppInfo* pSup = &pReader->suppInfo;
+  SBlockLateLoadInfo* pLateLoad = &pReader->status.lateLoad;
+
+  // the rows beyond the capacity are dumped from the loaded file block later, which requires all columns.
+  if (pIdList == NULL || pRecord->numRow > pReader->resBlockInfo.capacity) {
+    return false;
+  }
+
+  taosArrayClear(pLateLoad->pFilterCols);
+  taosArrayClear(pLateLoad->pRemainCols);
+
+  for (int32_t i = 1; i < pSup->numOfCols; ++i) {
+    SArray* pList = isColumnInList(pIdList, pSup->colId[i]) ? pLateLoad->pFilterCols : pLateLoad->pRemainCols;
+    taosArrayPush(pList, &pSup->colId[i]);
+  }
+
+  return taosArrayGetSize(pLateLoad->pRemainCols) > 0;
+}
+
+static int32_t doRetrieveRemainColumns(STsdbReader* pReader) {
+  SReaderStatus*      pStatus = &pReader->status;
+  SBlockLateLoadInfo* pLateLoad = &pStatus->lateLoad;
+  SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(&pStatus->blockIter);
+  SBlockData*         pBlockData = &pLateLoad->blockData;
+
+  int32_t code = doLoadFileBlockDataByColumn(pReader, &pStatus->blockIter, pBlockData, pBlockInfo->uid,
+                                             TARRAY_DATA(pLateLoad->pRemainCols),
+                                             taosArrayGetSize(pLateLoad->pRemainCols));
+  if (code == TSDB_CODE_SUCCESS && pBlockData->nRow > 0) {
+    code = copyColumnsToSDataBlock(pReader, pBlockData, pLateLoad->rowIndex, pLateLoad->rows, pLateLoad->pRemainCols);
+  }
+
+  tBlockDataReset(pBlockData);
+  return code;
+}
+
+static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader, SArray* pIdList) {
   SReaderStatus*      pStatus = &pReader->status;
+  SBlockLateLoadInfo* pLateLoad = &pStatus->lateLoad;
   int32_t             code = TSDB_CODE_SUCCESS;
   SFileDataBlockInfo* pBlockInfo = getCurrentBlockInfo(&pStatus->blockIter);
 
@@ -4584,44 +5346,88 @@ static SSDataBlock* doRetrieveDataBlock(STsdbReader* pReader) {
     return NULL;
   }
 
+  // the second phase, load the remaining columns of the rows dumped into the result block
+  if (pLateLoad->pending) {
+    pLateLoad->pending = false;
+    if (pLateLoad->partial) {
+      pLateLoad->partial = false;
+      code = doRetrieveRemainColumns(pReader);
+      if (code != TSDB_CODE_SUCCESS) {
+        terrno = code;
+        return NULL;
+      }
+    }
+
+    return pReader->resBlockInfo.pResBlock;
+  }
+
   STableBlockScanInfo* pBlockScanInfo = getTableBlockScanInfo(pStatus->pTableMap, pBlockInfo->uid, pReader->idStr);
   if (pBlockScanInfo == NULL) {
     return NULL;
   }
 
-  code = doLoadFileBlockData(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid);
+  pLateLoad->partial = splitLateLoadColumns(pReader, &pBlockInfo->record, pIdList);
+  if (pLateLoad->partial) {
+    code = doLoadFileBlockDataByColumn(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid,
+                                       TARRAY_DATA(pLateLoad->pFilterCols), taosArrayGetSize(pLateLoad->pFilterCols));
+    pStatus->fBlockDumpInfo.allDumped = false;
+  } else {
+    code = doLoadFileBlockData(pReader, &pStatus->blockIter, &pStatus->fileBlockData, pBlockScanInfo->uid);
+  }
+
   if (code != TSDB_CODE_SUCCESS) {
+    pLateLoad->partial = false;
     tBlockDataReset(&pStatus->fileBlockData);
     terrno = code;
     return NULL;
   }
 
+  pLateLoad->rows = 0;
   code = copyBlockDataToSDataBlock(pReader);
   if (code != TSDB_CODE_SUCCESS) {
+    pLateLoad->partial = false;
     tBlockDataReset(&pStatus->fileBlockData);
     terrno = code;
     return NULL;
   }
 
+  pLateLoad->partial = pLateLoad->partial && (pLateLoad->rows > 0);
+  pLateLoad->pending = (pIdList != NULL);
+
+  // the file block only contains part of the columns, which should not be used any more.
+  if (pLateLoad->partial) {
+    tBlockDataReset(&pStatus->fileBlockData);
+  }
+
   return pReader->resBlockInfo.pResBlock;
 }
 
-SSDataBlock* tsdbRetrieveDataBlock2(STsdbReader* pReader, SArray* pIdList) {
-  STsdbReader* pTReader = pReader;
+static STsdbReader* getRetrieveReader(STsdbReader* pReader) {
   if (pReader->type == TIMEWINDOW_RANGE_EXTERNAL) {
     if (pReader->step == EXTERNAL_ROWS_PREV) {
-      pTReader = pReader->innerReader[0];
+      return pReader->innerReader[0];
     } else if (pReader->step == EXTERNAL_ROWS_NEXT) {
-      pTReader = pReader->innerReader[1];
+      return pReader->innerReader[1];
     }
   }
 
+  return pReader;
+}
+
+// If pIdList (SArray<int16_t>) is not NULL, only the columns in pIdList are loaded for a clean file block, and the
+// reader is kept locked until the remaining columns are retrieved by invoking it again with NULL, or the data block
+// is released by tsdbReleaseDataBlock2.
+SSDataBlock* tsdbRetrieveDataBlock2(STsdbReader* pReader, SArray* pIdList) {
+  STsdbReader*   pTReader = getRetrieveReader(pReader);
   SReaderStatus* pStatus = &pTReader->status;
   if (pStatus->composedDataBlock) {
     return pTReader->resBlockInfo.pResBlock;
   }
 
-  SSDataBlock* ret = doRetrieveDataBlock(pTReader);
+  SSDataBlock* ret = doRetrieveDataBlock(pTReader, pIdList);
+  if (pStatus->lateLoad.pending) {
+    return ret;
+  }
 
   qTrace("tsdb/read-retrieve: %p, unlock read mutex", pReader);
   tsdbReleaseReader(pReader);
@@ -4662,7 +5468,7 @@ int32_t tsdbReaderReset2(STsdbReader* pReader, SQueryTableDataCond* pCond) {
   memset(&pReader->suppInfo.tsColAgg, 0, sizeof(SColumnDataAgg));
 
   pReader->suppInfo.tsColAgg.colId = PRIMARYKEY_TIMESTAMP_COL_ID;
-  tsdbDataFileReaderClose(&pReader->pFileReader);
+  closeDataFileReader(pReader);
 
   int32_t numOfTables = tSimpleHashGetSize(pStatus->pTableMap);
 
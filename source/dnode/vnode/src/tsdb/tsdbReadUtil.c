@@ -253,7 +253,7 @@ void cleanupInfoForNextFileset(SSHashObj* pTableMap) {
 }
 
 // brin records iterator
-void initBrinRecordIter(SBrinRecordIter* pIter, SDataFileReader* pReader, SArray* pList) {
+void initBrinRecordIter(SBrinRecordIter* pIter, SDataFileReader* pReader, SArray* pList, SArray* pBlocks) {
   memset(&pIter->block, 0, sizeof(SBrinBlock));
   memset(&pIter->record, 0, sizeof(SBrinRecord));
   pIter->blockIndex = -1;
@@ -261,10 +261,12 @@ void initBrinRecordIter(SBrinRecordIter* pIter, SDataFileReader* pReader, SArray
 
   pIter->pReader = pReader;
   pIter->pBrinBlockList = pList;
+  pIter->pBrinBlocks = pBlocks;
+  pIter->pBlock = &pIter->block;
 }
 
 SBrinRecord* getNextBrinRecord(SBrinRecordIter* pIter) {
-  if (pIter->blockIndex == -1 || (pIter->recordIndex + 1) >= TARRAY2_SIZE(pIter->block.numRow)) {
+  if (pIter->blockIndex == -1 || (pIter->recordIndex + 1) >= TARRAY2_SIZE(pIter->pBlock->numRow)) {
     pIter->blockIndex += 1;
     if (pIter->blockIndex >= taosArrayGetSize(pIter->pBrinBlockList)) {
       return NULL;
@@ -272,18 +274,22 @@ SBrinRecord* getNextBrinRecord(SBrinRecordIter* pIter) {
 
     pIter->pCurrentBlk = taosArrayGet(pIter->pBrinBlockList, pIter->blockIndex);
 
-    tBrinBlockClear(&pIter->block);
-    int32_t code = tsdbDataFileReadBrinBlock(pIter->pReader, pIter->pCurrentBlk, &pIter->block);
-    if (code != TSDB_CODE_SUCCESS) {
-      tsdbError("failed to read brinBlock from file, code:%s", tstrerror(code));
-      return NULL;
+    if (pIter->pBrinBlocks != NULL) {  // already loaded ahead
+      pIter->pBlock = taosArrayGet(pIter->pBrinBlocks, pIter->blockIndex);
+    } else {
+      tBrinBlockClear(&pIter->block);
+      int32_t code = tsdbDataFileReadBrinBlock(pIter->pReader, pIter->pCurrentBlk, &pIter->block);
+      if (code != TSDB_CODE_SUCCESS) {
+        tsdbError("failed to read brinBlock from file, code:%s", tstrerror(code));
+        return NULL;
+      }
     }
 
     pIter->recordIndex = -1;
   }
 
   pIter->recordIndex += 1;
-  tBrinBlockGet(&pIter->block, pIter->recordIndex, &pIter->record);
+  tBrinBlockGet(pIter->pBlock, pIter->recordIndex, &pIter->record);
   return &pIter->record;
 }
 
@@ -99,6 +99,8 @@ typedef struct SCostSummary {
   double  createScanInfoList;
   double  createSkylineIterTime;
   double  initLastBlockReader;
+  int64_t readAheadIO;
+  int64_t readAheadBlocks;
 } SCostSummary;
 
 typedef struct STableUidList {
@@ -149,14 +151,68 @@ typedef struct SLastBlockReader {
   int64_t            currentKey;
 } SLastBlockReader;
 
+typedef struct SPrefetchBlockData {
+  int64_t    blockOffset;
+  SBlockData data;
+} SPrefetchBlockData;
+
+// The head file and the leading data blocks of a file set, which are loaded ahead in the vnode read threads.
+typedef struct SFilesetLoadTask {
+  struct SFilesetPrefetcher* pPrefetcher;
+  STsdbReader*               pReader;
+  STFileSet*                 pFileset;
+  STSchema*                  pSchema;      // NULL if the data blocks are not loaded ahead
+  int32_t                    index;        // index of the file set in the file set list
+  int32_t                    code;
+  bool                       done;
+  SDataFileReader*           pFileReader;
+  SArray*                    pIndexList;   // SArray<SBrinBlk>
+  SArray*                    pBrinBlocks;  // SArray<SBrinBlock>, the decoded brin blocks of pIndexList
+  SArray*                    pBlockData;   // SArray<SPrefetchBlockData>
+  double                     headFileLoadTime;
+  double                     blockLoadTime;
+} SFilesetLoadTask;
+
+typedef struct SFilesetPrefetcher {
+  TdThreadMutex     mutex;
+  TdThreadCond      cond;
+  int32_t           numOfRunning;  // number of tasks not done yet
+  SArray*           pTaskList;     // SArray<SFilesetLoadTask*>, in the access order of file sets
+  SFilesetLoadTask* pCurrent;      // the task of current opened file set
+} SFilesetPrefetcher;
+
 typedef struct SFilesetIter {
-  int32_t           numOfFiles;    // number of total files
-  int32_t           index;         // current accessed index in the list
-  TFileSetArray*    pFilesetList;  // data file set list
-  int32_t           order;
-  SLastBlockReader* pLastBlockReader;  // last file block reader
+  int32_t             numOfFiles;    // number of total files
+  int32_t             index;         // current accessed index in the list
+  TFileSetArray*      pFilesetList;  // data file set list
+  int32_t             order;
+  SLastBlockReader*   pLastBlockReader;  // last file block reader
+  SFilesetPrefetcher* pPrefetcher;       // NULL if the file sets are not loaded ahead
 } SFilesetIter;
 
+// A coalesced range of data blocks in the .data file, which is read in one I/O in the vnode read threads.
+typedef struct SBlockReadAheadTask {
+  struct SBlockReadAhead* pReadAhead;
+  SDataFileReader*        pFileReader;
+  int64_t                 offset;
+  int64_t                 size;
+  int32_t                 numOfBlocks;
+  int32_t                 code;
+  bool                    done;
+  uint8_t*                pBuf;
+} SBlockReadAheadTask;
+
+typedef struct SBlockReadAhead {
+  TdThreadMutex        mutex;
+  TdThreadCond         cond;
+  int32_t              numOfRunning;  // number of tasks not done yet
+  SArray*              pTaskList;     // SArray<SBlockReadAheadTask*>, in the access order of data blocks
+  SBlockReadAheadTask* pCurrent;      // the task installed as the read-ahead window of the data file
+  SDataFileReader*     pFileReader;   // the data file reader that the tasks read from
+  int32_t              nextIndex;     // the next block in the block iterator to be read ahead
+  bool                 disabled;      // read-ahead is not supported by current data file
+} SBlockReadAhead;
+
 typedef struct SFileDataBlockInfo {
   // index position in STableBlockScanInfo in order to check whether neighbor block overlaps with it
   uint64_t    uid;
@@ -180,6 +236,18 @@ typedef struct SFileBlockDumpInfo {
   bool    allDumped;
 } SFileBlockDumpInfo;
 
+// Only the columns referred by the filter are loaded at first for a clean file block, and the remaining columns are
+// loaded after the filter is applied, see tsdbRetrieveDataBlock2.
+typedef struct SBlockLateLoadInfo {
+  bool       pending;      // the reader is locked until the remaining columns are retrieved or the block is released
+  bool       partial;      // the remaining columns of the result block are not loaded yet
+  int32_t    rowIndex;     // the start row in current file block that is dumped into the result block
+  int32_t    rows;         // number of rows dumped into the result block
+  SArray*    pFilterCols;  // SArray<int16_t>, the columns loaded at first
+  SArray*    pRemainCols;  // SArray<int16_t>, the columns loaded after the filter is applied
+  SBlockData blockData;    // the remaining columns of current file block
+} SBlockLateLoadInfo;
+
 typedef struct SReaderStatus {
   bool                  loadFromFile;       // check file stage
   bool                  composedDataBlock;  // the returned data block is a composed block or not
@@ -189,8 +257,10 @@ typedef struct SReaderStatus {
   SFileBlockDumpInfo    fBlockDumpInfo;
   STFileSet*            pCurrentFileset;  // current opened file set
   SBlockData            fileBlockData;
+  SBlockLateLoadInfo    lateLoad;
   SFilesetIter          fileIter;
   SDataBlockIter        blockIter;
+  SBlockReadAhead*      pReadAhead;  // NULL if the data blocks are not read ahead
   SArray*               pLDataIterArray;
   SRowMerger            merger;
   SColumnInfoData*      pPrimaryTsCol;  // primary time stamp output col info data
@@ -220,10 +290,12 @@ struct STsdbReader {
 
 typedef struct SBrinRecordIter {
   SArray*          pBrinBlockList;
+  SArray*          pBrinBlocks;  // the decoded brin blocks of pBrinBlockList, NULL if they are loaded on demand
   SBrinBlk*        pCurrentBlk;
   int32_t          blockIndex;
   int32_t          recordIndex;
   SDataFileReader* pReader;
+  SBrinBlock*      pBlock;
   SBrinBlock       block;
   SBrinRecord      record;
 } SBrinRecordIter;
@@ -243,7 +315,7 @@ void       clearBlockScanInfoBuf(SBlockInfoBuf* pBuf);
 void*      getPosInBlockInfoBuf(SBlockInfoBuf* pBuf, int32_t index);
 
 // brin records iterator
-void         initBrinRecordIter(SBrinRecordIter* pIter, SDataFileReader* pReader, SArray* pList);
+void         initBrinRecordIter(SBrinRecordIter* pIter, SDataFileReader* pReader, SArray* pList, SArray* pBlocks);
 SBrinRecord* getNextBrinRecord(SBrinRecordIter* pIter);
 void         clearBrinBlockIter(SBrinRecordIter* pIter);
 
@@ -264,6 +264,12 @@ int32_t tsdbReadFile(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int64_t size)
   // ASSERT(pgno && pgno <= pFD->szFile);
   ASSERT(bOffset < szPgCont);
 
+  // hit the read-ahead window
+  if (pFD->pRaBuf && offset >= pFD->raOffset && offset + size <= pFD->raOffset + pFD->raSize) {
+    memcpy(pBuf, pFD->pRaBuf + (offset - pFD->raOffset), size);
+    goto _exit;
+  }
+
   while (n < size) {
     if (pFD->pgno != pgno) {
       code = tsdbReadFilePage(pFD, pgno);
@@ -282,6 +288,81 @@ _exit:
   return code;
 }
 
+// open the file for tsdbReadFileAhead, which is not supported by the files on s3
+int32_t tsdbPrepareReadAhead(STsdbFD *pFD) {
+  int32_t code = 0;
+
+  if (!pFD->pFD) {
+    code = tsdbOpenFileImpl(pFD);
+    if (code) {
+      goto _exit;
+    }
+  }
+
+  if (pFD->s3File) {
+    code = TSDB_CODE_OPS_NOT_SUPPORT;
+  }
+
+_exit:
+  return code;
+}
+
+// read the logical range [offset, offset + size) with one positional read of all the pages it covers. The page
+// buffer of pFD is not touched, so it can be called in other threads once tsdbPrepareReadAhead succeeds.
+int32_t tsdbReadFileAhead(STsdbFD *pFD, int64_t offset, uint8_t *pBuf, int64_t size) {
+  int32_t  code = 0;
+  int32_t  szPage = pFD->szPage;
+  int32_t  szPgCont = PAGE_CONTENT_SIZE(szPage);
+  int64_t  fOffset = LOGIC_TO_FILE_OFFSET(offset, szPage);
+  int64_t  pgno = OFFSET_PGNO(fOffset, szPage);
+  int64_t  bOffset = fOffset % szPage;
+  int64_t  nPage = OFFSET_PGNO(LOGIC_TO_FILE_OFFSET(offset + size - 1, szPage), szPage) - pgno + 1;
+  uint8_t *pPages = NULL;
+
+  ASSERT(size > 0 && !pFD->s3File);
+
+  pPages = taosMemoryMalloc(nPage * szPage);
+  if (pPages == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _exit;
+  }
+
+  int64_t n = taosPReadFile(pFD->pFD, pPages, nPage * szPage, PAGE_OFFSET(pgno, szPage));
+  if (n < 0) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    goto _exit;
+  } else if (n < nPage * szPage) {
+    code = TSDB_CODE_FILE_CORRUPTED;
+    goto _exit;
+  }
+
+  n = 0;
+  for (int64_t i = 0; i < nPage; i++) {
+    uint8_t *pPage = pPages + i * szPage;
+    if (pgno + i > 1 && !taosCheckChecksumWhole(pPage, szPage)) {
+      code = TSDB_CODE_FILE_CORRUPTED;
+      goto _exit;
+    }
+
+    int64_t nRead = TMIN(szPgCont - bOffset, size - n);
+    memcpy(pBuf + n, pPage + bOffset, nRead);
+
+    n += nRead;
+    bOffset = 0;
+  }
+
+_exit:
+  taosMemoryFree(pPages);
+  return code;
+}
+
+// set the read-ahead window of pFD, the buffer is owned by the caller and must be valid until the window is reset
+void tsdbSetReadAheadWindow(STsdbFD *pFD, int64_t offset, int64_t size, uint8_t *pBuf) {
+  pFD->pRaBuf = pBuf;
+  pFD->raOffset = offset;
+  pFD->raSize = (pBuf == NULL) ? 0 : size;
+}
+
 int32_t tsdbFsyncFile(STsdbFD *pFD) {
   int32_t code = 0;
 
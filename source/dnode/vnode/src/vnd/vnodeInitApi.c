@@ -83,6 +83,7 @@ void initMetadataAPI(SStoreMeta* pMeta) {
   pMeta->extractTagVal = (const void* (*)(const void*, int16_t, STagVal*))metaGetTableTagVal;
   pMeta->getTableTags = metaGetTableTags;
   pMeta->getTableTagsByUid = metaGetTableTagsByUids;
+  pMeta->getTableTagBlock = metaGetTableTagBlock;
 
   pMeta->getTableUidByName = metaGetTableUidByName;
   pMeta->getTableTypeByName = metaGetTableTypeByName;
@@ -35,7 +35,7 @@ typedef struct {
 struct SVnodeGlobal {
   int8_t           init;
   int8_t           stop;
-  SVnodeThreadPool tp[2];
+  SVnodeThreadPool tp[VNODE_THREAD_POOLS];
 };
 
 struct SVnodeGlobal vnodeGlobal;
@@ -64,14 +64,19 @@ int vnodeInit(int nthreads) {
     taosThreadMutexUnlock(&(vnodeGlobal.tp[i].mutex));
 
     vnodeGlobal.tp[i].nthreads = nthreads;
-    vnodeGlobal.tp[i].threads = taosMemoryCalloc(nthreads, sizeof(TdThread));
+    if (i == VNODE_READ_THREAD_POOL && tsQueryFilesetPrefetch <= 0 && tsQueryReadAheadSize <= 0) {
+      // no read-ahead is enabled at start up, one thread serves it if it is enabled later
+      vnodeGlobal.tp[i].nthreads = 1;
+    }
+
+    vnodeGlobal.tp[i].threads = taosMemoryCalloc(vnodeGlobal.tp[i].nthreads, sizeof(TdThread));
     if (vnodeGlobal.tp[i].threads == NULL) {
       terrno = TSDB_CODE_OUT_OF_MEMORY;
       vError("failed to init vnode module since:%s", tstrerror(terrno));
       return -1;
     }
 
-    for (int j = 0; j < nthreads; j++) {
+    for (int j = 0; j < vnodeGlobal.tp[i].nthreads; j++) {
       taosThreadCreate(&(vnodeGlobal.tp[i].threads[j]), NULL, loop, &vnodeGlobal.tp[i]);
     }
   }
@@ -152,10 +157,14 @@ static void* loop(void* arg) {
   SVnodeTask*       pTask;
   int               ret;
 
-  if (tp == &vnodeGlobal.tp[0]) {
+  if (tp == &vnodeGlobal.tp[VNODE_COMMIT_THREAD_POOL]) {
     setThreadName("vnode-commit");
-  } else if (tp == &vnodeGlobal.tp[1]) {
+  } else if (tp == &vnodeGlobal.tp[VNODE_MERGE_THREAD_POOL]) {
     setThreadName("vnode-merge");
+  } else if (tp == &vnodeGlobal.tp[VNODE_READ_THREAD_POOL]) {
+    setThreadName("vnode-read");
+  } else if (tp == &vnodeGlobal.tp[VNODE_FSET_THREAD_POOL]) {
+    setThreadName("vnode-fset");
   }
 
   for (;;) {
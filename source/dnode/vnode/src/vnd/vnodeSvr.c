@@ -274,16 +274,17 @@ static int32_t vnodePreProcessSubmitTbData(SVnode *pVnode, SDecoder *pCoder, int
 
   TSKEY minKey = now - tsTickPerMin[pVnode->config.tsdbCfg.precision] * keep;
   TSKEY maxKey = tsMaxKeyByPrecision[pVnode->config.tsdbCfg.precision];
+  // the walk is bounds checked as tDecodeSubmitReq is, so a malformed request is rejected before it is proposed
   if (submitTbData.flags & SUBMIT_REQ_COLUMN_DATA_FORMAT) {
     uint64_t nColData;
-    if (tDecodeU64v(pCoder, &nColData) < 0) {
+    if (tDecodeU64v(pCoder, &nColData) < 0 || nColData == 0 || nColData > pCoder->size - pCoder->pos) {
       code = TSDB_CODE_INVALID_MSG;
       goto _exit;
     }
 
     SColData colData = {0};
     pCoder->pos += tGetColData(pCoder->data + pCoder->pos, &colData);
-    if (colData.flag != HAS_VALUE) {
+    if (pCoder->pos > pCoder->size || colData.flag != HAS_VALUE) {
       code = TSDB_CODE_INVALID_MSG;
       goto _exit;
     }
@@ -297,16 +298,25 @@ static int32_t vnodePreProcessSubmitTbData(SVnode *pVnode, SDecoder *pCoder, int
 
     for (uint64_t i = 1; i < nColData; i++) {
       pCoder->pos += tGetColData(pCoder->data + pCoder->pos, &colData);
+      if (pCoder->pos > pCoder->size) {
+        code = TSDB_CODE_INVALID_MSG;
+        goto _exit;
+      }
     }
   } else {
     uint64_t nRow;
-    if (tDecodeU64v(pCoder, &nRow) < 0) {
+    if (tDecodeU64v(pCoder, &nRow) < 0 || nRow > (pCoder->size - pCoder->pos) / sizeof(SRow)) {
       code = TSDB_CODE_INVALID_MSG;
       goto _exit;
     }
 
     for (int32_t iRow = 0; iRow < nRow; ++iRow) {
       SRow *pRow = (SRow *)(pCoder->data + pCoder->pos);
+      if (pCoder->size - pCoder->pos < sizeof(SRow) || pRow->len < sizeof(SRow) ||
+          pRow->len > pCoder->size - pCoder->pos) {
+        code = TSDB_CODE_INVALID_MSG;
+        goto _exit;
+      }
       pCoder->pos += pRow->len;
 
       if (pRow->ts < minKey || pRow->ts > maxKey) {
@@ -1389,6 +1399,67 @@ static int32_t vnodeRebuildSubmitReqMsg(SSubmitReq2 *pSubmitReq, void **ppMsg) {
   return code;
 }
 
+// check in one sweep that the keys are within [minKey, maxKey] and strictly increasing
+static bool vnodeCheckSubmitKeysAVX2(const TSKEY *aKey, int32_t nKey, TSKEY minKey, TSKEY maxKey, int32_t *iKey) {
+#if __AVX2__
+  const __m256i vMin = _mm256_set1_epi64x(minKey);
+  const __m256i vMax = _mm256_set1_epi64x(maxKey);
+  __m256i       vBad = _mm256_setzero_si256();
+
+  // compare keys [i, i + 4) with keys [i - 1, i + 3) to check the order, the first key is checked alone
+  int32_t i = 1;
+  for (; i + 4 <= nKey; i += 4) {
+    __m256i vKey = _mm256_loadu_si256((const __m256i *)(aKey + i));
+    __m256i vPrev = _mm256_loadu_si256((const __m256i *)(aKey + i - 1));
+
+    vBad = _mm256_or_si256(vBad, _mm256_cmpgt_epi64(vMin, vKey));
+    vBad = _mm256_or_si256(vBad, _mm256_cmpgt_epi64(vKey, vMax));
+    vBad = _mm256_or_si256(vBad, _mm256_cmpgt_epi64(vPrev, vKey));
+    vBad = _mm256_or_si256(vBad, _mm256_cmpeq_epi64(vPrev, vKey));
+  }
+  bool valid = _mm256_testz_si256(vBad, vBad) && aKey[0] >= minKey && aKey[0] <= maxKey;
+  for (; valid && i < nKey; i++) {
+    valid = aKey[i] >= minKey && aKey[i] <= maxKey && aKey[i] > aKey[i - 1];
+  }
+
+  *iKey = nKey;
+  return valid;
+#else
+  *iKey = 0;
+  return true;
+#endif
+}
+
+static bool vnodeCheckSubmitKeys(const TSKEY *aKey, int32_t nKey, TSKEY minKey, TSKEY maxKey) {
+  int32_t iKey = 0;
+
+  if (nKey <= 0) return true;
+  if (tsAVX2Enable && tsSIMDBuiltins) {
+    bool valid = vnodeCheckSubmitKeysAVX2(aKey, nKey, minKey, maxKey, &iKey);
+    if (iKey == nKey) return valid;
+  }
+
+  // no branch in the loop, so the compiler is free to vectorize it
+  int32_t nBad = (aKey[0] < minKey) | (aKey[0] > maxKey);
+  for (iKey = 1; iKey < nKey; iKey++) {
+    nBad |= (aKey[iKey] < minKey) | (aKey[iKey] > maxKey) | (aKey[iKey] <= aKey[iKey - 1]);
+  }
+  return nBad == 0;
+}
+
+static bool vnodeCheckSubmitRows(SRow *const *aRow, int32_t nRow, TSKEY minKey, TSKEY maxKey) {
+  if (nRow <= 0) return true;
+
+  TSKEY   prev = aRow[0]->ts;
+  int32_t nBad = (prev < minKey) | (prev > maxKey);
+  for (int32_t iRow = 1; iRow < nRow; iRow++) {
+    TSKEY ts = aRow[iRow]->ts;
+    nBad |= (ts < minKey) | (ts > maxKey) | (ts <= prev);
+    prev = ts;
+  }
+  return nBad == 0;
+}
+
 static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, int32_t len, SRpcMsg *pRsp) {
   int32_t code = 0;
   terrno = 0;
@@ -1415,16 +1486,19 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
       goto _exit;
     }
   } else {
-    // decode
+    // decode again rather than take the walk of vnodePreProcessSubmitMsg: that walk only runs on the leader, over the
+    // rpc buffer which is freed once the request is copied into the raft log. Followers and the wal replay apply the
+    // logged copy, so this decode is the only one every replica does. It allocates no row or column data, the decoded
+    // tables refer to pReq and tsdbInsertTableData copies from there into the buffer pool.
     pReq = POINTER_SHIFT(pReq, sizeof(SSubmitReq2Msg));
     len -= sizeof(SSubmitReq2Msg);
     SDecoder dc = {0};
     tDecoderInit(&dc, pReq, len);
-    if (tDecodeSubmitReq(&dc, pSubmitReq) < 0) {
-      code = TSDB_CODE_INVALID_MSG;
+    code = tDecodeSubmitReq(&dc, pSubmitReq);
+    tDecoderClear(&dc);
+    if (code) {
       goto _exit;
     }
-    tDecoderClear(&dc);
   }
 
   // scan
@@ -1446,26 +1520,19 @@ static int32_t vnodeProcessSubmitReq(SVnode *pVnode, int64_t ver, void *pReq, in
       }
 
       SColData *pColData = (SColData *)taosArrayGet(pSubmitTbData->aCol, 0);
-      TSKEY    *aKey = (TSKEY *)(pColData->pData);
 
-      for (int32_t iRow = 0; iRow < pColData->nVal; iRow++) {
-        if (aKey[iRow] < minKey || aKey[iRow] > maxKey || (iRow > 0 && aKey[iRow] <= aKey[iRow - 1])) {
-          code = TSDB_CODE_INVALID_MSG;
-          vError("vgId:%d %s failed since %s, version:%" PRId64, TD_VID(pVnode), __func__, tstrerror(terrno), ver);
-          goto _exit;
-        }
+      if (pColData->type != TSDB_DATA_TYPE_TIMESTAMP || pColData->flag != HAS_VALUE ||
+          !vnodeCheckSubmitKeys((TSKEY *)pColData->pData, pColData->nVal, minKey, maxKey)) {
+        code = TSDB_CODE_INVALID_MSG;
+        vError("vgId:%d %s failed since %s, version:%" PRId64, TD_VID(pVnode), __func__, tstrerror(code), ver);
+        goto _exit;
       }
-
     } else {
-      int32_t nRow = TARRAY_SIZE(pSubmitTbData->aRowP);
-      SRow  **aRow = (SRow **)TARRAY_DATA(pSubmitTbData->aRowP);
-      for (int32_t iRow = 0; iRow < nRow; ++iRow) {
-
-        if (aRow[iRow]->ts < minKey || aRow[iRow]->ts > maxKey || (iRow > 0 && aRow[iRow]->ts <= aRow[iRow - 1]->ts)) {
-          code = TSDB_CODE_INVALID_MSG;
-          vError("vgId:%d %s failed since %s, version:%" PRId64, TD_VID(pVnode), __func__, tstrerror(code), ver);
-          goto _exit;
-        }
+      if (!vnodeCheckSubmitRows((SRow **)TARRAY_DATA(pSubmitTbData->aRowP), TARRAY_SIZE(pSubmitTbData->aRowP), minKey,
+                                maxKey)) {
+        code = TSDB_CODE_INVALID_MSG;
+        vError("vgId:%d %s failed since %s, version:%" PRId64, TD_VID(pVnode), __func__, tstrerror(code), ver);
+        goto _exit;
       }
     }
   }
@@ -0,0 +1,377 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Tests of the columnar tag store of the meta. Child tables are created, their tags altered and the tables dropped,
+ * and after each step the tags got by metaGetTableTagBlock are compared with the ones decoded by metaGetTableTags.
+ * The vnode headers do not compile as C++, so the test is in C rather than gtest.
+ */
+
+#include "meta.h"
+#include "vnodeInt.h"
+
+#define TEST_PATH "/tmp/metaTagStoreTest"
+
+#define TEST_CHECK(_c)                                                   \
+  do {                                                                   \
+    if (!(_c)) {                                                         \
+      printf("%s:%d check failed: %s\n", __FILE__, __LINE__, #_c);       \
+      return -1;                                                         \
+    }                                                                    \
+  } while (0)
+
+#define TEST_RUN(_f)                                                     \
+  do {                                                                   \
+    if ((_f) != 0) {                                                     \
+      printf("%s:%d failed: %s\n", __FILE__, __LINE__, #_f);             \
+      return -1;                                                         \
+    }                                                                    \
+  } while (0)
+
+typedef struct {
+  SVnode   vnode;
+  int64_t  version;
+  tb_uid_t lastUid;
+} STestCtx;
+
+// the tag columns of the test super tables, t2 of every 10th table is null
+static SSchema tagSchema[] = {
+    {.type = TSDB_DATA_TYPE_INT, .colId = 3, .bytes = sizeof(int32_t), .name = "t1"},
+    {.type = TSDB_DATA_TYPE_BINARY, .colId = 4, .bytes = 200 + VARSTR_HEADER_SIZE, .name = "t2"},
+    {.type = TSDB_DATA_TYPE_DOUBLE, .colId = 5, .bytes = sizeof(double), .name = "t3"},
+    {.type = TSDB_DATA_TYPE_BIGINT, .colId = 6, .bytes = sizeof(int64_t), .name = "t4"},
+};
+#define TEST_TAG_NUM ((int32_t)(sizeof(tagSchema) / sizeof(tagSchema[0])))
+
+static int32_t testOpen(STestCtx *pCtx) {
+  taosRemoveDir(TEST_PATH);
+  taosMkDir(TEST_PATH);
+
+  memset(pCtx, 0, sizeof(*pCtx));
+  pCtx->lastUid = 1000;
+  pCtx->vnode.path = TEST_PATH;
+  pCtx->vnode.config.vgId = 2;
+  pCtx->vnode.config.szPage = 4096;
+  pCtx->vnode.config.szCache = 256;
+  strcpy(pCtx->vnode.config.dbname, "1.db");
+  TEST_RUN(metaOpen(&pCtx->vnode, &pCtx->vnode.pMeta, 0));
+  TEST_RUN(metaBegin(pCtx->vnode.pMeta, META_BEGIN_HEAP_OS));
+  return 0;
+}
+
+static void testClose(STestCtx *pCtx) {
+  metaClose(&pCtx->vnode.pMeta);
+  taosRemoveDir(TEST_PATH);
+}
+
+static tb_uid_t testCreateSTable(STestCtx *pCtx, const char *name) {
+  SSchema cols[] = {{.type = TSDB_DATA_TYPE_TIMESTAMP, .colId = 1, .bytes = sizeof(int64_t), .name = "ts"},
+                    {.type = TSDB_DATA_TYPE_INT, .colId = 2, .bytes = sizeof(int32_t), .name = "c1"}};
+  SVCreateStbReq req = {.name = (char *)name,
+                        .suid = ++pCtx->lastUid,
+                        .schemaRow = {.nCols = 2, .version = 1, .pSchema = cols},
+                        .schemaTag = {.nCols = TEST_TAG_NUM, .version = 1, .pSchema = tagSchema}};
+
+  if (metaCreateSTable(pCtx->vnode.pMeta, ++pCtx->version, &req) < 0) return 0;
+  return req.suid;
+}
+
+static int32_t testCreateTables(STestCtx *pCtx, const char *stbName, tb_uid_t suid, int32_t start, int32_t end,
+                                int32_t t2Len) {
+  char name[TSDB_TABLE_NAME_LEN];
+  char t2[256];
+
+  for (int32_t i = start; i < end; i++) {
+    SArray *pVals = taosArrayInit(TEST_TAG_NUM, sizeof(STagVal));
+    int32_t t1 = i;
+    double  t3 = i * 0.5;
+    STagVal val = {.cid = 3, .type = TSDB_DATA_TYPE_INT};
+    memcpy(&val.i64, &t1, sizeof(t1));
+    taosArrayPush(pVals, &val);
+
+    if (i % 10 != 0) {
+      int32_t len = snprintf(t2, sizeof(t2), "%d", i);
+      memset(t2 + len, 'x', t2Len - len);
+      val = (STagVal){.cid = 4, .type = TSDB_DATA_TYPE_BINARY, .nData = t2Len, .pData = (uint8_t *)t2};
+      taosArrayPush(pVals, &val);
+    }
+
+    val = (STagVal){.cid = 5, .type = TSDB_DATA_TYPE_DOUBLE};
+    memcpy(&val.i64, &t3, sizeof(t3));
+    taosArrayPush(pVals, &val);
+
+    val = (STagVal){.cid = 6, .type = TSDB_DATA_TYPE_BIGINT, .i64 = (int64_t)i << 33};
+    taosArrayPush(pVals, &val);
+
+    STag *pTag = NULL;
+    int32_t code = tTagNew(pVals, 1, 0, &pTag);
+    taosArrayDestroy(pVals);
+    TEST_RUN(code);
+
+    snprintf(name, sizeof(name), "%s_%d", stbName, i);
+    SVCreateTbReq req = {.name = name, .uid = ++pCtx->lastUid, .type = TSDB_CHILD_TABLE};
+    req.ctb.stbName = (char *)stbName;
+    req.ctb.suid = suid;
+    req.ctb.pTag = (uint8_t *)pTag;
+    code = metaCreateTable(pCtx->vnode.pMeta, ++pCtx->version, &req, NULL);
+    tTagFree(pTag);
+    TEST_RUN(code);
+  }
+
+  return 0;
+}
+
+static int32_t testAlterTag(STestCtx *pCtx, const char *stbName, int32_t i, const char *tagName, const void *pVal,
+                            int32_t len) {
+  char name[TSDB_TABLE_NAME_LEN];
+  snprintf(name, sizeof(name), "%s_%d", stbName, i);
+
+  SVAlterTbReq req = {.tbName = name,
+                      .action = TSDB_ALTER_TABLE_UPDATE_TAG_VAL,
+                      .tagName = (char *)tagName,
+                      .isNull = (pVal == NULL),
+                      .nTagVal = len,
+                      .pTagVal = (uint8_t *)pVal};
+  return metaAlterTable(pCtx->vnode.pMeta, ++pCtx->version, &req, NULL);
+}
+
+static int32_t testDropTable(STestCtx *pCtx, const char *stbName, tb_uid_t suid, int32_t i) {
+  char name[TSDB_TABLE_NAME_LEN];
+  snprintf(name, sizeof(name), "%s_%d", stbName, i);
+
+  SVDropTbReq req = {.name = name, .suid = suid};
+  return metaDropTable(pCtx->vnode.pMeta, ++pCtx->version, &req, NULL, NULL);
+}
+
+// each row of the block should have the tags of the table in pUidList, got from tdb in pOld
+static int32_t testCheckBlock(SArray *pOld, SArray *pUidList, SArray *pColList, SSDataBlock *pBlock) {
+  int32_t   code = 0;
+  SHashObj *pTags = taosHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT), false, HASH_NO_LOCK);
+
+  for (int32_t i = 0; i < taosArrayGetSize(pOld); i++) {
+    STUidTagInfo *pInfo = taosArrayGet(pOld, i);
+    taosHashPut(pTags, &pInfo->uid, sizeof(pInfo->uid), &pInfo->pTagVal, POINTER_BYTES);
+  }
+
+  for (int32_t iRow = 0; iRow < taosArrayGetSize(pUidList) && code == 0; iRow++) {
+    uint64_t uid = ((STUidTagInfo *)taosArrayGet(pUidList, iRow))->uid;
+    STag   **ppTag = taosHashGet(pTags, &uid, sizeof(uid));
+
+    for (int32_t iCol = 0; iCol < taosArrayGetSize(pColList); iCol++) {
+      SColumnInfo     *pInfo = taosArrayGet(pColList, iCol);
+      SColumnInfoData *pCol = taosArrayGet(pBlock->pDataBlock, iCol);
+      STagVal          val = {.cid = pInfo->colId};
+
+      if (ppTag == NULL || !tTagGet(*ppTag, &val)) {
+        if (!colDataIsNull_s(pCol, iRow)) code = -1;
+      } else if (colDataIsNull_s(pCol, iRow)) {
+        code = -1;
+      } else if (IS_VAR_DATA_TYPE(pInfo->type)) {
+        char *pData = colDataGetData(pCol, iRow);
+        if (varDataLen(pData) != val.nData || memcmp(varDataVal(pData), val.pData, val.nData) != 0) code = -1;
+      } else if (memcmp(colDataGetData(pCol, iRow), &val.i64, pInfo->bytes) != 0) {
+        code = -1;
+      }
+
+      if (code) {
+        printf("uid:%" PRIu64 " col:%d row:%d differs from metaGetTableTags\n", uid, pInfo->colId, iRow);
+        break;
+      }
+    }
+  }
+
+  taosHashCleanup(pTags);
+  return code;
+}
+
+static int32_t testCheckTags(STestCtx *pCtx, tb_uid_t suid, int32_t expectTables) {
+  SArray      *pColList = taosArrayInit(TEST_TAG_NUM, sizeof(SColumnInfo));
+  SArray      *pOld = taosArrayInit(16, sizeof(STUidTagInfo));
+  SArray      *pUidList = taosArrayInit(16, sizeof(STUidTagInfo));
+  SSDataBlock *pBlock = NULL;
+  int32_t      code = -1;
+
+  // the columns asked for are in another order than the tag schema
+  for (int32_t i = TEST_TAG_NUM - 1; i >= 0; i--) {
+    SColumnInfo info = {.colId = tagSchema[i].colId, .type = tagSchema[i].type, .bytes = tagSchema[i].bytes};
+    taosArrayPush(pColList, &info);
+  }
+
+  if (metaGetTableTags(&pCtx->vnode, suid, pOld) != 0 || taosArrayGetSize(pOld) != expectTables) goto _exit;
+
+  // all tables of the super table
+  if (metaGetTableTagBlock(&pCtx->vnode, suid, pColList, pUidList, &pBlock) != 0 || pBlock == NULL) goto _exit;
+  if (taosArrayGetSize(pUidList) != expectTables || pBlock->info.rows != expectTables) goto _exit;
+  if (testCheckBlock(pOld, pUidList, pColList, pBlock) != 0) goto _exit;
+  blockDataDestroy(pBlock);
+  pBlock = NULL;
+
+  // the tables asked for, and a table that does not exist
+  taosArrayClear(pUidList);
+  for (int32_t i = 0; i < taosArrayGetSize(pOld); i += 3) {
+    STUidTagInfo info = {.uid = ((STUidTagInfo *)taosArrayGet(pOld, i))->uid};
+    taosArrayPush(pUidList, &info);
+  }
+  STUidTagInfo missing = {.uid = ++pCtx->lastUid};
+  taosArrayPush(pUidList, &missing);
+
+  if (metaGetTableTagBlock(&pCtx->vnode, suid, pColList, pUidList, &pBlock) != 0 || pBlock == NULL) goto _exit;
+  if (pBlock->info.rows != taosArrayGetSize(pUidList)) goto _exit;
+  if (testCheckBlock(pOld, pUidList, pColList, pBlock) != 0) goto _exit;
+  code = 0;
+
+_exit:
+  for (int32_t i = 0; i < taosArrayGetSize(pOld); i++) {
+    taosMemoryFree(((STUidTagInfo *)taosArrayGet(pOld, i))->pTagVal);
+  }
+  blockDataDestroy(pBlock);
+  taosArrayDestroy(pOld);
+  taosArrayDestroy(pUidList);
+  taosArrayDestroy(pColList);
+  return code;
+}
+
+static int32_t testCreateAlterDrop() {
+  STestCtx ctx;
+  TEST_RUN(testOpen(&ctx));
+
+  tb_uid_t suid = testCreateSTable(&ctx, "stb");
+  TEST_CHECK(suid != 0);
+  TEST_RUN(testCreateTables(&ctx, "stb", suid, 0, 3000, 16));
+  TEST_RUN(testCheckTags(&ctx, suid, 3000));
+
+  // appended to the store built by the query above
+  TEST_RUN(testCreateTables(&ctx, "stb", suid, 3000, 3100, 16));
+  TEST_RUN(testCheckTags(&ctx, suid, 3100));
+
+  // tag values updated in place, set to null and set from null
+  int32_t t1 = -1;
+  double  t3 = -2.5;
+  char    t2[200];
+  memset(t2, 'y', sizeof(t2));
+  for (int32_t i = 0; i + 2 < 3100; i += 7) {
+    TEST_RUN(testAlterTag(&ctx, "stb", i, "t1", &t1, sizeof(t1)));
+    TEST_RUN(testAlterTag(&ctx, "stb", i + 1, "t3", &t3, sizeof(t3)));
+    TEST_RUN(testAlterTag(&ctx, "stb", i + 2, "t2", t2, sizeof(t2)));
+  }
+  TEST_RUN(testAlterTag(&ctx, "stb", 11, "t2", NULL, 0));
+  TEST_RUN(testAlterTag(&ctx, "stb", 20, "t2", "z", 1));
+  TEST_RUN(testCheckTags(&ctx, suid, 3100));
+
+  // a few tables dropped, their rows are skipped
+  for (int32_t i = 0; i < 100; i++) {
+    TEST_RUN(testDropTable(&ctx, "stb", suid, i * 5));
+  }
+  TEST_RUN(testCheckTags(&ctx, suid, 3000));
+
+  // most tables dropped, the store is rebuilt
+  int32_t nTable = 3000;
+  for (int32_t i = 0; i < 3100; i++) {
+    if (i % 5 != 0 && i % 4 != 0) {
+      TEST_RUN(testDropTable(&ctx, "stb", suid, i));
+      nTable--;
+    }
+  }
+  TEST_RUN(testCheckTags(&ctx, suid, nTable));
+
+  TEST_RUN(testCreateTables(&ctx, "stb", suid, 5000, 5010, 16));
+  TEST_RUN(testCheckTags(&ctx, suid, nTable + 10));
+
+  testClose(&ctx);
+  return 0;
+}
+
+static int32_t testEvictLeastUsed() {
+  STestCtx ctx;
+  tb_uid_t suids[6];
+  int32_t  nTables[6];
+  int32_t  nStb = 6;
+  int32_t  num = 0;
+  int64_t  size = 0;
+  int64_t  limit = 1024 * 1024;
+  char     name[TSDB_TABLE_NAME_LEN];
+
+  TEST_RUN(testOpen(&ctx));
+  for (int32_t i = 0; i < nStb; i++) {
+    snprintf(name, sizeof(name), "stb%d", i);
+    suids[i] = testCreateSTable(&ctx, name);
+    TEST_CHECK(suids[i] != 0);
+    TEST_RUN(testCreateTables(&ctx, name, suids[i], 0, 1000, 200));
+    nTables[i] = 1000;
+  }
+
+  // each store takes a few hundred KB, they do not fit in 1MB all together
+  tsTagColumnarCacheSize = 1;
+  for (int32_t i = 0; i < nStb; i++) {
+    TEST_RUN(testCheckTags(&ctx, suids[i], nTables[i]));
+    metaTagStoreGetStat(ctx.vnode.pMeta, &num, &size);
+    TEST_CHECK(num > 0 && size <= limit);
+  }
+  TEST_CHECK(num < nStb);
+
+  // the evicted stores are built again
+  for (int32_t i = 0; i < nStb; i++) {
+    TEST_RUN(testCheckTags(&ctx, suids[i], nTables[i]));
+  }
+
+  // the size of a store follows the updates of it
+  char t2[200];
+  memset(t2, 'u', sizeof(t2));
+  for (int32_t i = 0; i < 1000; i += 2) {
+    TEST_RUN(testAlterTag(&ctx, "stb5", i, "t2", t2, sizeof(t2)));
+  }
+  TEST_RUN(testCreateTables(&ctx, "stb5", suids[5], 1000, 1500, 200));
+  nTables[5] = 1500;
+  metaTagStoreGetStat(ctx.vnode.pMeta, &num, &size);
+  TEST_CHECK(size <= limit);
+  TEST_RUN(testCheckTags(&ctx, suids[5], nTables[5]));
+
+  // a store larger than the limit is only used by the query building it
+  TEST_RUN(testCreateTables(&ctx, "stb1", suids[1], 1000, 6000, 200));
+  nTables[1] = 6000;
+  TEST_RUN(testCheckTags(&ctx, suids[1], nTables[1]));
+  metaTagStoreGetStat(ctx.vnode.pMeta, &num, &size);
+  TEST_CHECK(size <= limit);
+
+  tsTagColumnarCacheSize = 64;
+  for (int32_t i = 0; i < nStb; i++) {
+    TEST_RUN(testCheckTags(&ctx, suids[i], nTables[i]));
+  }
+  metaTagStoreGetStat(ctx.vnode.pMeta, &num, &size);
+  TEST_CHECK(num == nStb);
+
+  testClose(&ctx);
+  return 0;
+}
+
+int main(int argc, char *argv[]) {
+  int32_t code = 0;
+
+  tsTagColumnarCache = true;
+  taosInitLog(TEST_PATH ".log", 1);
+
+  if (testCreateAlterDrop() != 0) {
+    printf("createAlterDrop failed\n");
+    code = -1;
+  }
+  if (testEvictLeastUsed() != 0) {
+    printf("evictLeastUsed failed\n");
+    code = -1;
+  }
+
+  if (code == 0) printf("all tests passed\n");
+  taosCloseLog();
+  return code == 0 ? 0 : 1;
+}
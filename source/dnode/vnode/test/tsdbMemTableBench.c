@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Concurrent insert/scan benchmark of the tsdb memtable skiplist.
+ *
+ * Writers put interleaved timestamps into the same tables so that they race on the same skiplist positions, readers
+ * keep scanning the tables and check the rows come in key order. With -s the writers are serialized by a mutex, which
+ * is how rows are put into a memtable by the vnode write thread, and gives the baseline to compare with. With -c the
+ * batches are submitted in column format, a single writer then appends all of them as columnar chunks.
+ *
+ * usage: tsdbMemTableBench [-w writers] [-r readers] [-n rows per writer] [-b rows per batch] [-t tables] [-s] [-c]
+ */
+
+#include "tsdb.h"
+#include "vnd.h"
+
+typedef struct {
+  STsdb        *pTsdb;
+  int32_t       nWriter;
+  int32_t       nReader;
+  int32_t       nRow;
+  int32_t       nBatch;
+  int32_t       nTable;
+  bool          serial;
+  bool          colFmt;
+  TdThreadMutex mutex;
+  int64_t       version;
+  int32_t       nRunning;
+  int64_t       nScan;
+  int64_t       nDisorder;
+} SBenchCtx;
+
+typedef struct {
+  SBenchCtx *pCtx;
+  int32_t    idx;
+} SBenchArg;
+
+static void *benchWriteFn(void *param) {
+  SBenchArg *pArg = param;
+  SBenchCtx *pCtx = pArg->pCtx;
+  SArray    *aRowP = taosArrayInit(pCtx->nBatch, sizeof(SRow *));
+  SRow      *aRow = taosMemoryCalloc(pCtx->nBatch, sizeof(SRow));
+  SArray    *aCol = taosArrayInit(1, sizeof(SColData));
+  TSKEY     *aKey = taosMemoryCalloc(pCtx->nBatch, sizeof(TSKEY));
+
+  for (int32_t iRow = 0; iRow < pCtx->nRow; iRow += pCtx->nBatch) {
+    int32_t       nRow = TMIN(pCtx->nBatch, pCtx->nRow - iRow);
+    SSubmitTbData tbData = {.uid = 1 + (iRow / pCtx->nBatch) % pCtx->nTable, .aRowP = aRowP};
+
+    if (pCtx->colFmt) {
+      SColData colData = {.cid = PRIMARYKEY_TIMESTAMP_COL_ID,
+                          .type = TSDB_DATA_TYPE_TIMESTAMP,
+                          .numOfValue = nRow,
+                          .nVal = nRow,
+                          .flag = HAS_VALUE,
+                          .nData = nRow * sizeof(TSKEY),
+                          .pData = (uint8_t *)aKey};
+      for (int32_t i = 0; i < nRow; i++) {
+        aKey[i] = (int64_t)(iRow + i) * pCtx->nWriter + pArg->idx;
+      }
+      taosArrayClear(aCol);
+      taosArrayPush(aCol, &colData);
+      tbData.flags = SUBMIT_REQ_COLUMN_DATA_FORMAT;
+      tbData.aCol = aCol;
+    } else {
+      taosArrayClear(aRowP);
+      for (int32_t i = 0; i < nRow; i++) {
+        SRow *pRow = &aRow[i];
+        pRow->flag = HAS_NONE;
+        pRow->len = sizeof(SRow);
+        pRow->ts = (int64_t)(iRow + i) * pCtx->nWriter + pArg->idx;
+        taosArrayPush(aRowP, &pRow);
+      }
+    }
+
+    if (pCtx->serial) taosThreadMutexLock(&pCtx->mutex);
+    int32_t code = tsdbInsertTableData(pCtx->pTsdb, atomic_add_fetch_64(&pCtx->version, 1), &tbData, NULL);
+    if (pCtx->serial) taosThreadMutexUnlock(&pCtx->mutex);
+    if (code) {
+      printf("failed to insert since %s\n", tstrerror(code));
+      break;
+    }
+  }
+
+  taosMemoryFree(aKey);
+  taosArrayDestroy(aCol);
+  taosMemoryFree(aRow);
+  taosArrayDestroy(aRowP);
+  atomic_sub_fetch_32(&pCtx->nRunning, 1);
+  return NULL;
+}
+
+static void *benchScanFn(void *param) {
+  SBenchArg *pArg = param;
+  SBenchCtx *pCtx = pArg->pCtx;
+  int64_t    nScan = 0;
+  int64_t    nDisorder = 0;
+
+  while (atomic_load_32(&pCtx->nRunning) > 0) {
+    for (int32_t iTable = 0; iTable < pCtx->nTable; iTable++) {
+      STbData     *pTbData = tsdbGetTbDataFromMemTable(pCtx->pTsdb->mem, 0, 1 + iTable);
+      STbDataIter *pIter = NULL;
+      TSDBKEY      lastKey = {.version = VERSION_MIN, .ts = TSKEY_MIN};
+
+      if (pTbData == NULL || tsdbTbDataIterCreate(pTbData, NULL, pArg->idx & 0x1, &pIter)) continue;
+
+      for (TSDBROW *pRow; (pRow = tsdbTbDataIterGet(pIter)) != NULL; tsdbTbDataIterNext(pIter)) {
+        TSDBKEY key = TSDBROW_KEY(pRow);
+        if (lastKey.ts != TSKEY_MIN && (pIter->backward ? key.ts >= lastKey.ts : key.ts <= lastKey.ts)) nDisorder++;
+        lastKey = key;
+        nScan++;
+      }
+
+      tsdbTbDataIterDestroy(pIter);
+    }
+  }
+
+  atomic_add_fetch_64(&pCtx->nScan, nScan);
+  atomic_add_fetch_64(&pCtx->nDisorder, nDisorder);
+  return NULL;
+}
+
+int main(int argc, char *argv[]) {
+  SBenchCtx ctx = {.nWriter = 4, .nReader = 2, .nRow = 1000000, .nBatch = 100, .nTable = 1};
+
+  for (int32_t i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+      ctx.nWriter = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+      ctx.nReader = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      ctx.nRow = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+      ctx.nBatch = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+      ctx.nTable = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-s") == 0) {
+      ctx.serial = true;
+    } else if (strcmp(argv[i], "-c") == 0) {
+      ctx.colFmt = true;
+    } else {
+      printf("usage: %s [-w writers] [-r readers] [-n rows per writer] [-b rows per batch] [-t tables] [-s] [-c]\n",
+             argv[0]);
+      return -1;
+    }
+  }
+  if (ctx.nWriter <= 0 || ctx.nReader < 0 || ctx.nRow <= 0 || ctx.nBatch <= 0 || ctx.nTable <= 0) {
+    printf("invalid arguments\n");
+    return -1;
+  }
+
+  // rsma vnodes allocate from the buffer pool under a spin lock, which concurrent writers need as well
+  SVnode *pVnode = taosMemoryCalloc(1, sizeof(SVnode));
+  STsdb  *pTsdb = taosMemoryCalloc(1, sizeof(STsdb));
+  pVnode->config.vgId = 1;
+  pVnode->config.isRsma = 1;
+  pVnode->config.cacheLast = 0;
+  pVnode->config.szBuf = (int64_t)ctx.nWriter * ctx.nRow * 128;
+  pVnode->config.tsdbCfg.slLevel = 5;
+  pTsdb->pVnode = pVnode;
+  ctx.pTsdb = pTsdb;
+  if (vnodeOpenBufPool(pVnode) < 0) {
+    printf("failed to open buffer pool since %s\n", terrstr());
+    return -1;
+  }
+  pVnode->inUse = pVnode->freeList;
+  pVnode->inUse->nRef = 1;
+  if (tsdbMemTableCreate(pTsdb, &pTsdb->mem)) {
+    printf("failed to create memtable\n");
+    return -1;
+  }
+
+  int32_t    nThread = ctx.nWriter + ctx.nReader;
+  TdThread  *aThread = taosMemoryCalloc(nThread, sizeof(TdThread));
+  SBenchArg *aArg = taosMemoryCalloc(nThread, sizeof(SBenchArg));
+
+  taosThreadMutexInit(&ctx.mutex, NULL);
+  ctx.nRunning = ctx.nWriter;
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 0; i < nThread; i++) {
+    aArg[i].pCtx = &ctx;
+    aArg[i].idx = i < ctx.nWriter ? i : i - ctx.nWriter;
+    taosThreadCreate(&aThread[i], NULL, i < ctx.nWriter ? benchWriteFn : benchScanFn, &aArg[i]);
+  }
+  for (int32_t i = 0; i < nThread; i++) {
+    taosThreadJoin(aThread[i], NULL);
+  }
+  int64_t et = taosGetTimestampUs();
+
+  int64_t nExpect = (int64_t)ctx.nWriter * ctx.nRow;
+  int64_t nFound = 0;
+  for (int32_t iTable = 0; iTable < ctx.nTable; iTable++) {
+    STbData *pTbData = tsdbGetTbDataFromMemTable(pTsdb->mem, 0, 1 + iTable);
+    STbDataIter *pIter = NULL;
+    if (pTbData == NULL || tsdbTbDataIterCreate(pTbData, NULL, 0, &pIter)) continue;
+
+    for (; tsdbTbDataIterGet(pIter) != NULL; tsdbTbDataIterNext(pIter)) nFound++;
+    tsdbTbDataIterDestroy(pIter);
+  }
+
+  double elapsed = (et - st) / 1000000.0;
+  printf("%s %s writers:%d readers:%d tables:%d batch:%d rows:%" PRId64 " elapsed:%.3fs\n",
+         ctx.serial ? "serial" : "concurrent", ctx.colFmt ? "col" : "row", ctx.nWriter, ctx.nReader, ctx.nTable,
+         ctx.nBatch, nExpect, elapsed);
+  printf("insert:%.0f rows/s scan:%.0f rows/s\n", nExpect / elapsed, ctx.nScan / elapsed);
+  printf("rows in memtable:%" PRId64 " out of order:%" PRId64 "\n", nFound, ctx.nDisorder);
+
+  taosThreadMutexDestroy(&ctx.mutex);
+  taosMemoryFree(aArg);
+  taosMemoryFree(aThread);
+  return (nFound == nExpect && ctx.nDisorder == 0) ? 0 : -1;
+}
@@ -38,6 +38,7 @@ typedef void (*FEndPut)(struct SDataSinkHandle* pHandle, uint64_t useconds);
 typedef void (*FReset)(struct SDataSinkHandle* pHandle);
 typedef void (*FGetDataLength)(struct SDataSinkHandle* pHandle, int64_t* pLen, bool* pQueryEnd);
 typedef int32_t (*FGetDataBlock)(struct SDataSinkHandle* pHandle, SOutputData* pOutput);
+typedef int32_t (*FGetDataBlockRef)(struct SDataSinkHandle* pHandle, SOutputData* pOutput, void** ppBuf);
 typedef int32_t (*FDestroyDataSinker)(struct SDataSinkHandle* pHandle);
 typedef int32_t (*FGetCacheSize)(struct SDataSinkHandle* pHandle, uint64_t* size);
 
@@ -47,6 +48,7 @@ typedef struct SDataSinkHandle {
   FReset             fReset;
   FGetDataLength     fGetLen;
   FGetDataBlock      fGetData;
+  FGetDataBlockRef   fGetDataRef;
   FDestroyDataSinker fDestroy;
   FGetCacheSize      fGetCacheSize;
 } SDataSinkHandle;
@@ -254,6 +254,7 @@ typedef struct STableScanBase {
   // there are more than one table list exists in one task, if only one vnode exists.
   STableListInfo* pTableListInfo;
   TsdReader       readerAPI;
+  SArray*         pFilterCols;  // SArray<int16_t>, the data columns referred by the filter, loaded before the others
 } STableScanBase;
 
 typedef struct STableScanInfo {
@@ -696,6 +697,8 @@ int32_t     getBufferPgSize(int32_t rowSize, uint32_t* defaultPgsz, uint32_t* de
 extern void doDestroyExchangeOperatorInfo(void* param);
 
 int32_t doFilter(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColMatchInfo* pColMatchInfo);
+int32_t doFilterEvaluate(SSDataBlock* pBlock, SFilterInfo* pFilterInfo, SColumnInfoData** pRes, int32_t* status);
+void    doFilterApply(SSDataBlock* pBlock, SColumnInfoData* p, int32_t status, SColMatchInfo* pColMatchInfo);
 int32_t addTagPseudoColumnData(SReadHandle* pHandle, const SExprInfo* pExpr, int32_t numOfExpr, SSDataBlock* pBlock,
                                int32_t rows, const char* idStr, STableMetaCacheInfo* pCache);
 
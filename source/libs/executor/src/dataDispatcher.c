@@ -190,8 +190,12 @@ static void getDataLength(SDataSinkHandle* pHandle, int64_t* pLen, bool* pQueryE
 }
 
 
-static int32_t getDataBlock(SDataSinkHandle* pHandle, SOutputData* pOutput) {
+// copy the data to pOutput->pData, or hand out the buffer holding it if ppBuf is given
+static int32_t getDataBlockImpl(SDataSinkHandle* pHandle, SOutputData* pOutput, void** ppBuf) {
   SDataDispatchHandle* pDispatcher = (SDataDispatchHandle*)pHandle;
+  if (NULL != ppBuf) {
+    *ppBuf = NULL;
+  }
   if (NULL == pDispatcher->nextOutput.pData) {
     ASSERT(pDispatcher->queryEnd);
     pOutput->useconds = pDispatcher->useconds;
@@ -201,7 +205,11 @@ static int32_t getDataBlock(SDataSinkHandle* pHandle, SOutputData* pOutput) {
     return TSDB_CODE_SUCCESS;
   }
   SDataCacheEntry* pEntry = (SDataCacheEntry*)(pDispatcher->nextOutput.pData);
-  memcpy(pOutput->pData, pEntry->data, pEntry->dataLen);
+  if (NULL != ppBuf) {
+    pOutput->pData = pEntry->data;
+  } else {
+    memcpy(pOutput->pData, pEntry->data, pEntry->dataLen);
+  }
   pOutput->numOfRows = pEntry->numOfRows;
   pOutput->numOfCols = pEntry->numOfCols;
   pOutput->compressed = pEntry->compressed;
@@ -209,7 +217,12 @@ static int32_t getDataBlock(SDataSinkHandle* pHandle, SOutputData* pOutput) {
   atomic_sub_fetch_64(&pDispatcher->cachedSize, pEntry->dataLen);
   atomic_sub_fetch_64(&gDataSinkStat.cachedSize, pEntry->dataLen);
 
-  taosMemoryFreeClear(pDispatcher->nextOutput.pData);  // todo persistent
+  if (NULL != ppBuf) {
+    *ppBuf = pDispatcher->nextOutput.pData;
+    pDispatcher->nextOutput.pData = NULL;
+  } else {
+    taosMemoryFreeClear(pDispatcher->nextOutput.pData);  // todo persistent
+  }
   pOutput->bufStatus = updateStatus(pDispatcher);
   taosThreadMutexLock(&pDispatcher->mutex);
   pOutput->queryEnd = pDispatcher->queryEnd;
@@ -220,6 +233,14 @@ static int32_t getDataBlock(SDataSinkHandle* pHandle, SOutputData* pOutput) {
   return TSDB_CODE_SUCCESS;
 }
 
+static int32_t getDataBlock(SDataSinkHandle* pHandle, SOutputData* pOutput) {
+  return getDataBlockImpl(pHandle, pOutput, NULL);
+}
+
+static int32_t getDataBlockRef(SDataSinkHandle* pHandle, SOutputData* pOutput, void** ppBuf) {
+  return getDataBlockImpl(pHandle, pOutput, ppBuf);
+}
+
 static int32_t destroyDataSinker(SDataSinkHandle* pHandle) {
   SDataDispatchHandle* pDispatcher = (SDataDispatchHandle*)pHandle;
   atomic_sub_fetch_64(&gDataSinkStat.cachedSize, pDispatcher->cachedSize);
@@ -256,6 +277,7 @@ int32_t createDataDispatcher(SDataSinkManager* pManager, const SDataSinkNode* pD
   dispatcher->sink.fReset = resetDispatcher;
   dispatcher->sink.fGetLen = getDataLength;
   dispatcher->sink.fGetData = getDataBlock;
+  dispatcher->sink.fGetDataRef = getDataBlockRef;
   dispatcher->sink.fDestroy = destroyDataSinker;
   dispatcher->sink.fGetCacheSize = getCacheSize;
   dispatcher->pManager = pManager;
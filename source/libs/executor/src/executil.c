@@ -1014,7 +1014,16 @@ static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SN
     }
     terrno = 0;
   } else {
-    if ((condType == FILTER_NO_LOGIC || condType == FILTER_AND) && status != SFLT_NOT_INDEX) {
+    bool byUid = (condType == FILTER_NO_LOGIC || condType == FILTER_AND) && status != SFLT_NOT_INDEX;
+
+    // try the columnar tag store of the super table first, which hands over the tag block without decoding any tag
+    if (pAPI->metaFn.getTableTagBlock != NULL && (!byUid || taosArrayGetSize(pUidTagList) > 0)) {
+      code = pAPI->metaFn.getTableTagBlock(pVnode, pListInfo->idInfo.suid, ctx.cInfoList, pUidTagList, &pResBlock);
+    }
+
+    if (code != TSDB_CODE_SUCCESS || pResBlock != NULL) {
+      // served by the tag store, or failed
+    } else if (byUid) {
       code = pAPI->metaFn.getTableTagsByUid(pVnode, pListInfo->idInfo.suid, pUidTagList);
     } else {
       code = pAPI->metaFn.getTableTags(pVnode, pListInfo->idInfo.suid, pUidTagList);
@@ -1031,10 +1040,12 @@ static int32_t doFilterByTagCond(STableListInfo* pListInfo, SArray* pUidList, SN
     goto end;
   }
 
-  pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
   if (pResBlock == NULL) {
-    code = terrno;
-    goto end;
+    pResBlock = createTagValBlockForFilter(ctx.cInfoList, numOfTables, pUidTagList, pVnode, pAPI);
+    if (pResBlock == NULL) {
+      code = terrno;
+      goto end;
+    }
   }
 
   //  int64_t st1 = taosGetTimestampUs();
@@ -293,6 +293,34 @@ bool applyLimitOffset(SLimitInfo* pLimitInfo, SSDataBlock* pBlock, SExecTaskInfo
   return false;
 }
 
+// The filter is evaluated with the columns it refers to, and the remaining columns are loaded only if any row is
+// qualified. The data reader is released once the remaining columns are loaded or the block is filtered out.
+static int32_t doFilterAndLoadRemainColumns(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo,
+                                            SSDataBlock* pBlock) {
+  SStorageAPI*     pAPI = &pOperator->pTaskInfo->storageAPI;
+  SColumnInfoData* p = NULL;
+  int32_t          status = FILTER_RESULT_NONE_QUALIFIED;
+  int32_t          code = TSDB_CODE_SUCCESS;
+
+  if (pBlock->info.rows > 0) {
+    code = doFilterEvaluate(pBlock, pOperator->exprSupp.pFilterInfo, &p, &status);
+  }
+
+  if (code != TSDB_CODE_SUCCESS || status == FILTER_RESULT_NONE_QUALIFIED) {
+    pAPI->tsdReader.tsdReaderReleaseDataBlock(pTableScanInfo->dataReader);
+  } else if (pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, NULL) == NULL) {
+    code = terrno;
+  }
+
+  if (code == TSDB_CODE_SUCCESS && pBlock->info.rows > 0) {
+    doFilterApply(pBlock, p, status, &pTableScanInfo->matchInfo);
+  }
+
+  colDataDestroy(p);
+  taosMemoryFree(p);
+  return code;
+}
+
 static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableScanInfo, SSDataBlock* pBlock,
                              uint32_t* status) {
   SExecTaskInfo*          pTaskInfo = pOperator->pTaskInfo;
@@ -387,7 +415,10 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   pCost->totalCheckedRows += pBlock->info.rows;
   pCost->loadBlocks += 1;
 
-  SSDataBlock* p = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, NULL);
+  // only the columns referred by the filter are loaded before the filter is applied
+  SArray* pFilterCols = (pOperator->exprSupp.pFilterInfo != NULL) ? pTableScanInfo->pFilterCols : NULL;
+
+  SSDataBlock* p = pAPI->tsdReader.tsdReaderRetrieveDataBlock(pTableScanInfo->dataReader, pFilterCols);
   if (p == NULL) {
     return terrno;
   }
@@ -398,10 +429,15 @@ static int32_t loadDataBlock(SOperatorInfo* pOperator, STableScanBase* pTableSca
   // restore the previous value
   pCost->totalRows -= pBlock->info.rows;
 
-  if (pOperator->exprSupp.pFilterInfo != NULL) {
+  if (pFilterCols != NULL) {
+    int32_t code = doFilterAndLoadRemainColumns(pOperator, pTableScanInfo, pBlock);
+    if (code != TSDB_CODE_SUCCESS) return code;
+  } else if (pOperator->exprSupp.pFilterInfo != NULL) {
     int32_t code = doFilter(pBlock, pOperator->exprSupp.pFilterInfo, &pTableScanInfo->matchInfo);
     if (code != TSDB_CODE_SUCCESS) return code;
+  }
 
+  if (pOperator->exprSupp.pFilterInfo != NULL) {
     int64_t st = taosGetTimestampUs();
     double el = (taosGetTimestampUs() - st) / 1000.0;
     pTableScanInfo->readRecorder.filterTime += el;
@@ -1004,6 +1040,7 @@ static void destroyTableScanBase(STableScanBase* pBase, TsdReader* pAPI) {
   tableListDestroy(pBase->pTableListInfo);
   taosLRUCacheCleanup(pBase->metaCache.pTableMetaEntryCache);
   cleanupExprSupp(&pBase->pseudoSup);
+  taosArrayDestroy(pBase->pFilterCols);
 }
 
 static void destroyTableScanOperatorInfo(void* param) {
@@ -1014,6 +1051,31 @@ static void destroyTableScanOperatorInfo(void* param) {
   taosMemoryFreeClear(param);
 }
 
+static EDealRes collectFilterColumn(SNode* pNode, void* pContext) {
+  if (nodeType(pNode) == QUERY_NODE_COLUMN) {
+    SColumnNode* pCol = (SColumnNode*)pNode;
+    SArray*      pList = pContext;
+
+    if (pCol->colType == COLUMN_TYPE_COLUMN && pCol->colId != PRIMARYKEY_TIMESTAMP_COL_ID &&
+        taosArraySearch(pList, &pCol->colId, compareInt16Val, TD_EQ) == NULL) {
+      taosArrayPush(pList, &pCol->colId);
+      taosArraySort(pList, compareInt16Val);
+    }
+  }
+
+  return DEAL_RES_CONTINUE;
+}
+
+// the data columns referred by the filter, which are loaded before the other columns of a data block.
+static SArray* extractFilterColumns(SNode* pConditions) {
+  SArray* pList = taosArrayInit(4, sizeof(int16_t));
+  if (pList != NULL) {
+    nodesWalkExpr(pConditions, collectFilterColumn, pList);
+  }
+
+  return pList;
+}
+
 SOperatorInfo* createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode, SReadHandle* readHandle,
                                            STableListInfo* pTableListInfo, SExecTaskInfo* pTaskInfo) {
   int32_t         code = 0;
@@ -1066,6 +1128,10 @@ SOperatorInfo* createTableScanOperatorInfo(STableScanPhysiNode* pTableScanNode,
     goto _error;
   }
 
+  if (pOperator->exprSupp.pFilterInfo != NULL) {
+    pInfo->base.pFilterCols = extractFilterColumns(pTableScanNode->scan.node.pConditions);
+  }
+
   pInfo->currentGroupId = -1;
   pInfo->assignBlockUid = pTableScanNode->assignBlockUid;
   pInfo->hasGroupByTag = pTableScanNode->pGroupTags ? true : false;
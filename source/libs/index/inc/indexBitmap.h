@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _TD_INDEX_BITMAP_H_
+#define _TD_INDEX_BITMAP_H_
+
+#include "tarray.h"
+#include "thash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * compressed bitmap of 32-bit ordinals, laid out as a roaring bitmap: the high 16 bits of an ordinal select a
+ * container, which keeps the low 16 bits in a sorted array while sparse and in a 64k bit set once dense
+ */
+typedef struct SIdxBitmap SIdxBitmap;
+
+SIdxBitmap *idxBitmapCreate();
+void        idxBitmapDestroy(SIdxBitmap *bm);
+int32_t     idxBitmapAdd(SIdxBitmap *bm, uint32_t v);
+bool        idxBitmapContains(const SIdxBitmap *bm, uint32_t v);
+uint64_t    idxBitmapCardinality(const SIdxBitmap *bm);
+
+// dst &= src, dst |= src, dst &= ~src
+int32_t idxBitmapAnd(SIdxBitmap *dst, const SIdxBitmap *src);
+int32_t idxBitmapOr(SIdxBitmap *dst, const SIdxBitmap *src);
+int32_t idxBitmapAndNot(SIdxBitmap *dst, const SIdxBitmap *src);
+
+// append the ordinals in ascending order, <uint32_t>
+int32_t idxBitmapToArray(const SIdxBitmap *bm, SArray *out);
+
+/*
+ * dense ordinals of the table uids met by one query, so that the uid lists of the posting lists can be turned into
+ * bitmaps and combined, and only the final result turned back into uids
+ */
+typedef struct SIdxUidDict {
+  SHashObj *pOrd;  // uid -> ordinal
+  SArray   *aUid;  // <uint64_t>, ordinal -> uid
+} SIdxUidDict;
+
+SIdxUidDict *idxUidDictCreate();
+void         idxUidDictDestroy(SIdxUidDict *dict);
+
+// add the uids into bm, assigning ordinals to the uids not met yet
+int32_t idxBitmapAddUids(SIdxBitmap *bm, SIdxUidDict *dict, const SArray *uids);
+// append the uids of bm to out, in ascending order of uid
+int32_t idxBitmapToUids(const SIdxBitmap *bm, const SIdxUidDict *dict, SArray *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /*_TD_INDEX_BITMAP_H_*/
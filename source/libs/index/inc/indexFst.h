@@ -72,6 +72,7 @@ typedef struct FstOutput {
  */
 typedef struct FstUnFinishedNodes {
   SArray* stack;  // <FstBuilderNodeUnfinished> } FstUnFinishedNodes;
+  SArray* free;   // <FstBuilderNode*>, compiled nodes kept for reuse
 } FstUnFinishedNodes;
 
 #define FST_UNFINISHED_NODES_LEN(nodes) taosArrayGetSize(nodes->stack)
@@ -79,6 +80,7 @@ typedef struct FstUnFinishedNodes {
 FstUnFinishedNodes* fstUnFinishedNodesCreate();
 void                fstUnFinishedNodesDestroy(FstUnFinishedNodes* node);
 void                fstUnFinishedNodesPushEmpty(FstUnFinishedNodes* nodes, bool isFinal);
+void                fstUnFinishedNodesRecycle(FstUnFinishedNodes* nodes, FstBuilderNode* node);
 void                fstUnFinishedNodesSetRootOutput(FstUnFinishedNodes* node, Output out);
 void                fstUnFinishedNodesTopLastFreeze(FstUnFinishedNodes* node, CompiledAddr addr);
 void                fstUnFinishedNodesAddSuffix(FstUnFinishedNodes* node, FstSlice bs, Output out);
@@ -14,6 +14,7 @@
  */
 
 #include "index.h"
+#include "indexBitmap.h"
 #include "indexCache.h"
 #include "indexComm.h"
 #include "indexInt.h"
@@ -458,23 +459,44 @@ static void idxInterRsltDestroy(SArray* results) {
 }
 
 static int idxMergeFinalResults(SArray* in, EIndexOperatorType oType, SArray* out) {
-  // refactor, merge interResults into fResults by oType
-  for (int i = 0; i < taosArrayGetSize(in); i--) {
-    SArray* t = taosArrayGetP(in, i);
-    taosArraySort(t, uidCompare);
-    taosArrayRemoveDuplicate(t, uidCompare, NULL);
-  }
-
-  if (oType == MUST) {
-    iIntersection(in, out);
-  } else if (oType == SHOULD) {
-    iUnion(in, out);
-  } else if (oType == NOT) {
+  if (oType == NOT) {
     // just one column index, enhance later
-    // taosArrayAddAll(fResults, interResults);
     // not use currently
+    return 0;
   }
-  return 0;
+  int32_t sz = taosArrayGetSize(in);
+  if (sz == 0) {
+    return 0;
+  }
+
+  // combine the uid lists of the terms as bitmaps over their ordinals, only the final one is turned back into uids
+  int32_t      code = 0;
+  SIdxUidDict* dict = idxUidDictCreate();
+  SIdxBitmap*  bm = idxBitmapCreate();
+  if (dict == NULL || bm == NULL) {
+    code = TSDB_CODE_OUT_OF_MEMORY;
+    goto _end;
+  }
+  for (int32_t i = 0; i < sz && code == 0; i++) {
+    SIdxBitmap* sub = idxBitmapCreate();
+    if (sub == NULL) {
+      code = TSDB_CODE_OUT_OF_MEMORY;
+      break;
+    }
+    code = idxBitmapAddUids(sub, dict, taosArrayGetP(in, i));
+    if (code == 0) {
+      code = (i == 0 || oType == SHOULD) ? idxBitmapOr(bm, sub) : idxBitmapAnd(bm, sub);
+    }
+    idxBitmapDestroy(sub);
+  }
+  if (code == 0) {
+    code = idxBitmapToUids(bm, dict, out);
+  }
+
+_end:
+  idxBitmapDestroy(bm);
+  idxUidDictDestroy(dict);
+  return code == 0 ? 0 : -1;
 }
 
 static void idxMayMergeTempToFinalRslt(SArray* result, TFileValue* tfv, SIdxTRslt* tr) {
@@ -0,0 +1,545 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "indexBitmap.h"
+#include "taosdef.h"
+#include "taoserror.h"
+
+#define BM_ARRAY_MAX 4096  // an array container of more values takes more room than a bit set
+#define BM_SET_WORDS 1024  // 65536 bits
+
+typedef struct {
+  uint16_t key;    // high 16 bits of the ordinals in the container
+  bool     isSet;  // bit set or sorted array
+  int32_t  card;
+  int32_t  cap;   // capacity of the array
+  void*    data;  // uint16_t[cap] or uint64_t[BM_SET_WORDS]
+} SBmCont;
+
+struct SIdxBitmap {
+  SArray* aCont;  // <SBmCont>, in ascending order of key
+};
+
+static FORCE_INLINE int32_t bmPopCount(uint64_t w) {
+  w = w - ((w >> 1) & 0x5555555555555555ull);
+  w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+  w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0full;
+  return (int32_t)((w * 0x0101010101010101ull) >> 56);
+}
+static FORCE_INLINE bool bmSetTest(const uint64_t* words, uint16_t v) { return (words[v >> 6] >> (v & 63)) & 1; }
+
+static int32_t bmSetCount(const uint64_t* words) {
+  int32_t card = 0;
+  for (int32_t i = 0; i < BM_SET_WORDS; i++) {
+    card += bmPopCount(words[i]);
+  }
+  return card;
+}
+
+// binary search of the first value >= v in a sorted array
+static FORCE_INLINE int32_t bmArrayLowerBound(const uint16_t* arr, int32_t n, uint16_t v) {
+  int32_t s = 0, e = n;
+  while (s < e) {
+    int32_t m = s + (e - s) / 2;
+    if (arr[m] < v) {
+      s = m + 1;
+    } else {
+      e = m;
+    }
+  }
+  return s;
+}
+
+static void bmContFree(SBmCont* c) {
+  taosMemoryFreeClear(c->data);
+  c->card = 0;
+  c->cap = 0;
+}
+
+static int32_t bmContToSet(SBmCont* c) {
+  uint64_t* words = taosMemoryCalloc(BM_SET_WORDS, sizeof(uint64_t));
+  if (words == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  uint16_t* arr = c->data;
+  for (int32_t i = 0; i < c->card; i++) {
+    words[arr[i] >> 6] |= 1ull << (arr[i] & 63);
+  }
+  taosMemoryFree(c->data);
+  c->data = words;
+  c->isSet = true;
+  c->cap = 0;
+  return 0;
+}
+
+static int32_t bmContToArray(SBmCont* c) {
+  uint16_t* arr = taosMemoryMalloc(sizeof(uint16_t) * TMAX(c->card, 1));
+  if (arr == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  uint64_t* words = c->data;
+  int32_t   n = 0;
+  for (int32_t i = 0; i < BM_SET_WORDS; i++) {
+    for (uint64_t w = words[i]; w != 0; w &= w - 1) {
+      arr[n++] = (uint16_t)(i * 64 + BUILDIN_CTZL(w));
+    }
+  }
+  taosMemoryFree(c->data);
+  c->data = arr;
+  c->isSet = false;
+  c->cap = TMAX(c->card, 1);
+  return 0;
+}
+
+// a bit set back to an array once it is sparse enough again
+static FORCE_INLINE int32_t bmContShrink(SBmCont* c) {
+  if (c->isSet && c->card <= BM_ARRAY_MAX) {
+    return bmContToArray(c);
+  }
+  return 0;
+}
+
+static int32_t bmContClone(SBmCont* dst, const SBmCont* src) {
+  *dst = *src;
+  int32_t size = src->isSet ? BM_SET_WORDS * sizeof(uint64_t) : TMAX(src->card, 1) * sizeof(uint16_t);
+  dst->data = taosMemoryMalloc(size);
+  if (dst->data == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  memcpy(dst->data, src->data, src->isSet ? size : src->card * sizeof(uint16_t));
+  dst->cap = src->isSet ? 0 : TMAX(src->card, 1);
+  return 0;
+}
+
+static int32_t bmContAdd(SBmCont* c, uint16_t v) {
+  if (c->isSet) {
+    uint64_t* words = c->data;
+    if (!bmSetTest(words, v)) {
+      words[v >> 6] |= 1ull << (v & 63);
+      c->card++;
+    }
+    return 0;
+  }
+
+  uint16_t* arr = c->data;
+  int32_t   pos = bmArrayLowerBound(arr, c->card, v);
+  if (pos < c->card && arr[pos] == v) {
+    return 0;
+  }
+  if (c->card >= BM_ARRAY_MAX) {
+    int32_t code = bmContToSet(c);
+    if (code != 0) {
+      return code;
+    }
+    return bmContAdd(c, v);
+  }
+  if (c->card >= c->cap) {
+    int32_t   cap = TMIN(TMAX(c->cap * 2, 8), BM_ARRAY_MAX);
+    uint16_t* t = taosMemoryRealloc(arr, sizeof(uint16_t) * cap);
+    if (t == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    c->data = arr = t;
+    c->cap = cap;
+  }
+  memmove(arr + pos + 1, arr + pos, sizeof(uint16_t) * (c->card - pos));
+  arr[pos] = v;
+  c->card++;
+  return 0;
+}
+
+static int32_t bmContAnd(SBmCont* dst, const SBmCont* src) {
+  if (dst->isSet && src->isSet) {
+    uint64_t*       dw = dst->data;
+    const uint64_t* sw = src->data;
+    for (int32_t i = 0; i < BM_SET_WORDS; i++) {
+      dw[i] &= sw[i];
+    }
+    dst->card = bmSetCount(dw);
+    return bmContShrink(dst);
+  } else if (dst->isSet) {
+    // the result is no larger than the array of src
+    uint64_t* dw = dst->data;
+    uint16_t* arr = taosMemoryMalloc(sizeof(uint16_t) * TMAX(src->card, 1));
+    if (arr == NULL) {
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+    const uint16_t* sa = src->data;
+    int32_t         n = 0;
+    for (int32_t i = 0; i < src->card; i++) {
+      if (bmSetTest(dw, sa[i])) arr[n++] = sa[i];
+    }
+    taosMemoryFree(dst->data);
+    dst->data = arr;
+    dst->isSet = false;
+    dst->card = n;
+    dst->cap = TMAX(src->card, 1);
+    return 0;
+  }
+
+  uint16_t* da = dst->data;
+  int32_t   n = 0;
+  if (src->isSet) {
+    for (int32_t i = 0; i < dst->card; i++) {
+      if (bmSetTest(src->data, da[i])) da[n++] = da[i];
+    }
+  } else {
+    const uint16_t* sa = src->data;
+    for (int32_t i = 0, j = 0; i < dst->card && j < src->card;) {
+      if (da[i] < sa[j]) {
+        i++;
+      } else if (da[i] > sa[j]) {
+        j++;
+      } else {
+        da[n++] = da[i];
+        i++;
+        j++;
+      }
+    }
+  }
+  dst->card = n;
+  return 0;
+}
+
+static int32_t bmContOr(SBmCont* dst, const SBmCont* src) {
+  int32_t code = 0;
+  if (!dst->isSet && (src->isSet || dst->card + src->card > BM_ARRAY_MAX)) {
+    if ((code = bmContToSet(dst)) != 0) {
+      return code;
+    }
+  }
+
+  if (dst->isSet) {
+    uint64_t* dw = dst->data;
+    if (src->isSet) {
+      const uint64_t* sw = src->data;
+      for (int32_t i = 0; i < BM_SET_WORDS; i++) {
+        dw[i] |= sw[i];
+      }
+      dst->card = bmSetCount(dw);
+    } else {
+      const uint16_t* sa = src->data;
+      for (int32_t i = 0; i < src->card; i++) {
+        if (!bmSetTest(dw, sa[i])) {
+          dw[sa[i] >> 6] |= 1ull << (sa[i] & 63);
+          dst->card++;
+        }
+      }
+    }
+    return bmContShrink(dst);
+  }
+
+  // both are arrays, merge them into a new one
+  const uint16_t* da = dst->data;
+  const uint16_t* sa = src->data;
+  uint16_t*       arr = taosMemoryMalloc(sizeof(uint16_t) * TMAX(dst->card + src->card, 1));
+  if (arr == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  int32_t i = 0, j = 0, n = 0;
+  while (i < dst->card && j < src->card) {
+    if (da[i] < sa[j]) {
+      arr[n++] = da[i++];
+    } else if (da[i] > sa[j]) {
+      arr[n++] = sa[j++];
+    } else {
+      arr[n++] = da[i++];
+      j++;
+    }
+  }
+  while (i < dst->card) arr[n++] = da[i++];
+  while (j < src->card) arr[n++] = sa[j++];
+
+  taosMemoryFree(dst->data);
+  dst->data = arr;
+  dst->cap = TMAX(dst->card + src->card, 1);
+  dst->card = n;
+  return 0;
+}
+
+static int32_t bmContAndNot(SBmCont* dst, const SBmCont* src) {
+  if (dst->isSet) {
+    uint64_t* dw = dst->data;
+    if (src->isSet) {
+      const uint64_t* sw = src->data;
+      for (int32_t i = 0; i < BM_SET_WORDS; i++) {
+        dw[i] &= ~sw[i];
+      }
+      dst->card = bmSetCount(dw);
+    } else {
+      const uint16_t* sa = src->data;
+      for (int32_t i = 0; i < src->card; i++) {
+        if (bmSetTest(dw, sa[i])) {
+          dw[sa[i] >> 6] &= ~(1ull << (sa[i] & 63));
+          dst->card--;
+        }
+      }
+    }
+    return bmContShrink(dst);
+  }
+
+  uint16_t* da = dst->data;
+  int32_t   n = 0;
+  if (src->isSet) {
+    for (int32_t i = 0; i < dst->card; i++) {
+      if (!bmSetTest(src->data, da[i])) da[n++] = da[i];
+    }
+  } else {
+    const uint16_t* sa = src->data;
+    int32_t         j = 0;
+    for (int32_t i = 0; i < dst->card; i++) {
+      while (j < src->card && sa[j] < da[i]) j++;
+      if (j < src->card && sa[j] == da[i]) continue;
+      da[n++] = da[i];
+    }
+  }
+  dst->card = n;
+  return 0;
+}
+
+static int32_t bmFindCont(const SIdxBitmap* bm, uint16_t key, bool* found) {
+  int32_t s = 0, e = (int32_t)taosArrayGetSize(bm->aCont);
+  while (s < e) {
+    int32_t        m = s + (e - s) / 2;
+    const SBmCont* c = taosArrayGet(bm->aCont, m);
+    if (c->key < key) {
+      s = m + 1;
+    } else {
+      e = m;
+    }
+  }
+  *found = s < taosArrayGetSize(bm->aCont) && ((SBmCont*)taosArrayGet(bm->aCont, s))->key == key;
+  return s;
+}
+
+SIdxBitmap* idxBitmapCreate() {
+  SIdxBitmap* bm = taosMemoryCalloc(1, sizeof(SIdxBitmap));
+  if (bm == NULL) {
+    return NULL;
+  }
+  bm->aCont = taosArrayInit(4, sizeof(SBmCont));
+  if (bm->aCont == NULL) {
+    taosMemoryFree(bm);
+    return NULL;
+  }
+  return bm;
+}
+void idxBitmapDestroy(SIdxBitmap* bm) {
+  if (bm == NULL) {
+    return;
+  }
+  for (int32_t i = 0; i < taosArrayGetSize(bm->aCont); i++) {
+    bmContFree(taosArrayGet(bm->aCont, i));
+  }
+  taosArrayDestroy(bm->aCont);
+  taosMemoryFree(bm);
+}
+
+int32_t idxBitmapAdd(SIdxBitmap* bm, uint32_t v) {
+  bool    found = false;
+  int32_t idx = bmFindCont(bm, v >> 16, &found);
+  if (!found) {
+    SBmCont c = {.key = v >> 16, .isSet = false, .card = 0, .cap = 4};
+    c.data = taosMemoryMalloc(sizeof(uint16_t) * c.cap);
+    if (c.data == NULL || taosArrayInsert(bm->aCont, idx, &c) == NULL) {
+      taosMemoryFree(c.data);
+      return TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+  return bmContAdd(taosArrayGet(bm->aCont, idx), v & 0xffff);
+}
+bool idxBitmapContains(const SIdxBitmap* bm, uint32_t v) {
+  bool    found = false;
+  int32_t idx = bmFindCont(bm, v >> 16, &found);
+  if (!found) {
+    return false;
+  }
+  const SBmCont* c = taosArrayGet(bm->aCont, idx);
+  if (c->isSet) {
+    return bmSetTest(c->data, v & 0xffff);
+  }
+  int32_t pos = bmArrayLowerBound(c->data, c->card, v & 0xffff);
+  return pos < c->card && ((uint16_t*)c->data)[pos] == (v & 0xffff);
+}
+uint64_t idxBitmapCardinality(const SIdxBitmap* bm) {
+  uint64_t card = 0;
+  for (int32_t i = 0; i < taosArrayGetSize(bm->aCont); i++) {
+    card += ((SBmCont*)taosArrayGet(bm->aCont, i))->card;
+  }
+  return card;
+}
+
+int32_t idxBitmapAnd(SIdxBitmap* dst, const SIdxBitmap* src) {
+  int32_t code = 0;
+  int32_t dsz = taosArrayGetSize(dst->aCont), ssz = taosArrayGetSize(src->aCont);
+  int32_t n = 0;
+  for (int32_t i = 0, j = 0; i < dsz; i++) {
+    SBmCont* dc = taosArrayGet(dst->aCont, i);
+    while (j < ssz && ((SBmCont*)taosArrayGet(src->aCont, j))->key < dc->key) j++;
+
+    if (code == 0 && j < ssz && ((SBmCont*)taosArrayGet(src->aCont, j))->key == dc->key) {
+      code = bmContAnd(dc, taosArrayGet(src->aCont, j));
+    } else {
+      dc->card = 0;
+    }
+    if (dc->card == 0) {
+      bmContFree(dc);
+    } else if (n++ != i) {
+      taosArraySet(dst->aCont, n - 1, dc);
+    }
+  }
+  taosArrayPopTailBatch(dst->aCont, dsz - n);
+  return code;
+}
+
+int32_t idxBitmapOr(SIdxBitmap* dst, const SIdxBitmap* src) {
+  int32_t code = 0;
+  for (int32_t j = 0; j < taosArrayGetSize(src->aCont) && code == 0; j++) {
+    const SBmCont* sc = taosArrayGet(src->aCont, j);
+
+    bool    found = false;
+    int32_t idx = bmFindCont(dst, sc->key, &found);
+    if (found) {
+      code = bmContOr(taosArrayGet(dst->aCont, idx), sc);
+      continue;
+    }
+
+    SBmCont c = {0};
+    if ((code = bmContClone(&c, sc)) != 0) {
+      break;
+    }
+    if (taosArrayInsert(dst->aCont, idx, &c) == NULL) {
+      bmContFree(&c);
+      code = TSDB_CODE_OUT_OF_MEMORY;
+    }
+  }
+  return code;
+}
+
+int32_t idxBitmapAndNot(SIdxBitmap* dst, const SIdxBitmap* src) {
+  int32_t code = 0;
+  int32_t dsz = taosArrayGetSize(dst->aCont), ssz = taosArrayGetSize(src->aCont);
+  int32_t n = 0;
+  for (int32_t i = 0, j = 0; i < dsz; i++) {
+    SBmCont* dc = taosArrayGet(dst->aCont, i);
+    while (j < ssz && ((SBmCont*)taosArrayGet(src->aCont, j))->key < dc->key) j++;
+
+    if (code == 0 && j < ssz && ((SBmCont*)taosArrayGet(src->aCont, j))->key == dc->key) {
+      code = bmContAndNot(dc, taosArrayGet(src->aCont, j));
+    }
+    if (dc->card == 0) {
+      bmContFree(dc);
+    } else if (n++ != i) {
+      taosArraySet(dst->aCont, n - 1, dc);
+    }
+  }
+  taosArrayPopTailBatch(dst->aCont, dsz - n);
+  return code;
+}
+
+int32_t idxBitmapToArray(const SIdxBitmap* bm, SArray* out) {
+  if (taosArrayEnsureCap(out, taosArrayGetSize(out) + idxBitmapCardinality(bm)) != 0) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  for (int32_t i = 0; i < taosArrayGetSize(bm->aCont); i++) {
+    const SBmCont* c = taosArrayGet(bm->aCont, i);
+    uint32_t       high = (uint32_t)c->key << 16;
+    if (c->isSet) {
+      const uint64_t* words = c->data;
+      for (int32_t k = 0; k < BM_SET_WORDS; k++) {
+        for (uint64_t w = words[k]; w != 0; w &= w - 1) {
+          uint32_t v = high | (uint32_t)(k * 64 + BUILDIN_CTZL(w));
+          taosArrayPush(out, &v);
+        }
+      }
+    } else {
+      const uint16_t* arr = c->data;
+      for (int32_t k = 0; k < c->card; k++) {
+        uint32_t v = high | arr[k];
+        taosArrayPush(out, &v);
+      }
+    }
+  }
+  return 0;
+}
+
+SIdxUidDict* idxUidDictCreate() {
+  SIdxUidDict* dict = taosMemoryCalloc(1, sizeof(SIdxUidDict));
+  if (dict == NULL) {
+    return NULL;
+  }
+  dict->pOrd = taosHashInit(1024, taosGetDefaultHashFunction(TSDB_DATA_TYPE_UBIGINT), false, HASH_NO_LOCK);
+  dict->aUid = taosArrayInit(1024, sizeof(uint64_t));
+  if (dict->pOrd == NULL || dict->aUid == NULL) {
+    idxUidDictDestroy(dict);
+    return NULL;
+  }
+  return dict;
+}
+void idxUidDictDestroy(SIdxUidDict* dict) {
+  if (dict == NULL) {
+    return;
+  }
+  taosHashCleanup(dict->pOrd);
+  taosArrayDestroy(dict->aUid);
+  taosMemoryFree(dict);
+}
+
+int32_t idxBitmapAddUids(SIdxBitmap* bm, SIdxUidDict* dict, const SArray* uids) {
+  for (int32_t i = 0; i < taosArrayGetSize(uids); i++) {
+    uint64_t  uid = *(uint64_t*)taosArrayGet(uids, i);
+    uint32_t* pOrd = taosHashGet(dict->pOrd, &uid, sizeof(uid));
+    uint32_t  ord = 0;
+    if (pOrd != NULL) {
+      ord = *pOrd;
+    } else {
+      ord = (uint32_t)taosArrayGetSize(dict->aUid);
+      if (taosArrayPush(dict->aUid, &uid) == NULL || taosHashPut(dict->pOrd, &uid, sizeof(uid), &ord, sizeof(ord))) {
+        return TSDB_CODE_OUT_OF_MEMORY;
+      }
+    }
+    int32_t code = idxBitmapAdd(bm, ord);
+    if (code != 0) {
+      return code;
+    }
+  }
+  return 0;
+}
+
+static int idxUidCompareFn(const void* a, const void* b) {
+  uint64_t l = *(uint64_t*)a, r = *(uint64_t*)b;
+  return l < r ? -1 : (l > r ? 1 : 0);
+}
+int32_t idxBitmapToUids(const SIdxBitmap* bm, const SIdxUidDict* dict, SArray* out) {
+  SArray* ords = taosArrayInit(idxBitmapCardinality(bm) + 1, sizeof(uint32_t));
+  if (ords == NULL || idxBitmapToArray(bm, ords) != 0) {
+    taosArrayDestroy(ords);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t start = taosArrayGetSize(out);
+  if (taosArrayEnsureCap(out, start + taosArrayGetSize(ords)) != 0) {
+    taosArrayDestroy(ords);
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  for (int32_t i = 0; i < taosArrayGetSize(ords); i++) {
+    taosArrayPush(out, taosArrayGet(dict->aUid, *(uint32_t*)taosArrayGet(ords, i)));
+  }
+  taosArrayDestroy(ords);
+
+  // ordinals follow the order the uids were met in, not the order of the uids
+  taosSort(TARRAY_GET_ELEM(out, start), taosArrayGetSize(out) - start, sizeof(uint64_t), idxUidCompareFn);
+  return 0;
+}
@@ -15,6 +15,7 @@
 
 #include "filter.h"
 #include "index.h"
+#include "indexBitmap.h"
 #include "indexComm.h"
 #include "indexInt.h"
 #include "nodes.h"
@@ -66,9 +67,10 @@ typedef union {
   } while (0);
 
 typedef struct SIFParam {
-  SHashObj *pFilter;
-  SArray   *result;
-  char     *condValue;
+  SHashObj   *pFilter;
+  SArray     *result;
+  SIdxBitmap *pBitmap;  // result of a logic condition, over the table ordinals of SIFCtx
+  char       *condValue;
 
   SIdxFltStatus status;
   uint8_t       colValType;
@@ -87,6 +89,7 @@ typedef struct SIFCtx {
   bool          noExec;  // true: just iterate condition tree, and add hint to executor plan
   SIndexMetaArg arg;
   SMetaDataFilterAPI *pAPI;
+  SIdxUidDict        *pDict;  // dense ordinals of the uids met by the query
 } SIFCtx;
 
 static FORCE_INLINE int32_t sifGetFuncFromSql(EOperatorType src, EIndexQueryType *dst) {
@@ -117,6 +120,8 @@ static FORCE_INLINE void sifFreeParam(SIFParam *param) {
   if (param == NULL) return;
 
   taosArrayDestroy(param->result);
+  idxBitmapDestroy(param->pBitmap);
+  param->pBitmap = NULL;
   taosMemoryFree(param->condValue);
   param->condValue = NULL;
   taosHashCleanup(param->pFilter);
@@ -854,6 +859,76 @@ _return:
   return code;
 }
 
+static int32_t sifGetRsltBitmap(SIFCtx *ctx, SIFParam *param, SIdxBitmap **ppBitmap, bool *tmp) {
+  if (param->pBitmap != NULL) {
+    *ppBitmap = param->pBitmap;
+    *tmp = false;
+    return TSDB_CODE_SUCCESS;
+  }
+
+  SIdxBitmap *pBitmap = idxBitmapCreate();
+  if (pBitmap == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+  int32_t code = idxBitmapAddUids(pBitmap, ctx->pDict, param->result);
+  if (code != TSDB_CODE_SUCCESS) {
+    idxBitmapDestroy(pBitmap);
+    return code;
+  }
+  *ppBitmap = pBitmap;
+  *tmp = true;
+  return TSDB_CODE_SUCCESS;
+}
+
+/*
+ * combine the results of the sub conditions as bitmaps over the table ordinals of the query, the uids are restored
+ * from the bitmap of the whole condition only. A sub condition without index restricts nothing of an AND, but leaves
+ * an OR without index.
+ */
+static int32_t sifMergeLogicRslt(SLogicConditionNode *node, SIFParam *params, SIFCtx *ctx, SIFParam *output) {
+  ELogicConditionType type = node->condType;
+  int32_t             nParam = node->pParameterList->length;
+  if (type != LOGIC_COND_TYPE_AND && type != LOGIC_COND_TYPE_OR) {
+    output->status = SFLT_NOT_INDEX;
+    return TSDB_CODE_SUCCESS;
+  }
+  for (int32_t m = 0; m < nParam && type == LOGIC_COND_TYPE_OR; m++) {
+    if (params[m].status == SFLT_NOT_INDEX) {
+      output->status = SFLT_NOT_INDEX;
+      return TSDB_CODE_SUCCESS;
+    }
+  }
+
+  SIdxBitmap *pBitmap = idxBitmapCreate();
+  if (pBitmap == NULL) {
+    return TSDB_CODE_OUT_OF_MEMORY;
+  }
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  bool    first = true;
+  for (int32_t m = 0; m < nParam; m++) {
+    if (params[m].status == SFLT_NOT_INDEX) continue;
+
+    SIdxBitmap *pSub = NULL;
+    bool        tmp = false;
+    if ((code = sifGetRsltBitmap(ctx, &params[m], &pSub, &tmp)) != TSDB_CODE_SUCCESS) {
+      break;
+    }
+    code = (first || type == LOGIC_COND_TYPE_OR) ? idxBitmapOr(pBitmap, pSub) : idxBitmapAnd(pBitmap, pSub);
+    first = false;
+    if (tmp) idxBitmapDestroy(pSub);
+    if (code != TSDB_CODE_SUCCESS) break;
+  }
+
+  if (code != TSDB_CODE_SUCCESS || first) {
+    idxBitmapDestroy(pBitmap);
+    if (first) output->status = SFLT_NOT_INDEX;
+    return code;
+  }
+  output->pBitmap = pBitmap;
+  return TSDB_CODE_SUCCESS;
+}
+
 static int32_t sifExecLogic(SLogicConditionNode *node, SIFCtx *ctx, SIFParam *output) {
   if (NULL == node->pParameterList || node->pParameterList->length <= 0) {
     indexError("invalid logic parameter list, list:%p, paramNum:%d", node->pParameterList,
@@ -866,17 +941,7 @@ static int32_t sifExecLogic(SLogicConditionNode *node, SIFCtx *ctx, SIFParam *ou
   SIF_ERR_RET(sifInitParamList(&params, node->pParameterList, ctx));
 
   if (ctx->noExec == false) {
-    for (int32_t m = 0; m < node->pParameterList->length; m++) {
-      if (node->condType == LOGIC_COND_TYPE_AND) {
-        taosArrayAddAll(output->result, params[m].result);
-      } else if (node->condType == LOGIC_COND_TYPE_OR) {
-        taosArrayAddAll(output->result, params[m].result);
-      } else if (node->condType == LOGIC_COND_TYPE_NOT) {
-        // taosArrayAddAll(output->result, params[m].result);
-      }
-      taosArraySort(output->result, idxUidCompare);
-      taosArrayRemoveDuplicate(output->result, idxUidCompare, NULL);
-    }
+    code = sifMergeLogicRslt(node, params, ctx, output);
   } else {
     for (int32_t m = 0; m < node->pParameterList->length; m++) {
       output->status = sifMergeCond(node->condType, output->status, params[m].status);
@@ -984,9 +1049,12 @@ static int32_t sifCalculate(SNode *pNode, SIFParam *pDst) {
   int32_t code = 0;
   SIFCtx  ctx = {.code = 0, .noExec = false, .arg = pDst->arg, .pAPI = &pDst->api};
   ctx.pRes = taosHashInit(4, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BIGINT), false, HASH_NO_LOCK);
+  ctx.pDict = idxUidDictCreate();
 
-  if (NULL == ctx.pRes) {
+  if (NULL == ctx.pRes || NULL == ctx.pDict) {
     indexError("index-filter failed to taosHashInit");
+    taosHashCleanup(ctx.pRes);
+    idxUidDictDestroy(ctx.pDict);
     return TSDB_CODE_OUT_OF_MEMORY;
   }
 
@@ -994,6 +1062,7 @@ static int32_t sifCalculate(SNode *pNode, SIFParam *pDst) {
 
   if (ctx.code != 0) {
     sifFreeRes(ctx.pRes);
+    idxUidDictDestroy(ctx.pDict);
     return ctx.code;
   }
 
@@ -1001,9 +1070,13 @@ static int32_t sifCalculate(SNode *pNode, SIFParam *pDst) {
     SIFParam *res = (SIFParam *)taosHashGet(ctx.pRes, (void *)&pNode, POINTER_BYTES);
     if (res == NULL) {
       indexError("no valid res in hash, node:(%p), type(%d)", (void *)&pNode, nodeType(pNode));
+      sifFreeRes(ctx.pRes);
+      idxUidDictDestroy(ctx.pDict);
       SIF_ERR_RET(TSDB_CODE_APP_ERROR);
     }
-    if (res->result != NULL) {
+    if (res->pBitmap != NULL) {
+      code = idxBitmapToUids(res->pBitmap, ctx.pDict, pDst->result);
+    } else if (res->result != NULL) {
       taosArrayAddAll(pDst->result, res->result);
     }
     pDst->status = res->status;
@@ -1012,6 +1085,7 @@ static int32_t sifCalculate(SNode *pNode, SIFParam *pDst) {
     taosHashRemove(ctx.pRes, (void *)&pNode, POINTER_BYTES);
   }
   sifFreeRes(ctx.pRes);
+  idxUidDictDestroy(ctx.pDict);
   return code;
 }
 
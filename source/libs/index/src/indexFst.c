@@ -37,6 +37,7 @@ FstUnFinishedNodes* fstUnFinishedNodesCreate() {
   }
 
   nodes->stack = (SArray*)taosArrayInit(64, sizeof(FstBuilderNodeUnfinished));
+  nodes->free = (SArray*)taosArrayInit(64, sizeof(FstBuilderNode*));
   fstUnFinishedNodesPushEmpty(nodes, false);
   return nodes;
 }
@@ -52,14 +53,39 @@ void fstUnFinishedNodesDestroy(FstUnFinishedNodes* nodes) {
   }
 
   taosArrayDestroyEx(nodes->stack, unFinishedNodeDestroyElem);
+  for (int32_t i = 0; i < taosArrayGetSize(nodes->free); i++) {
+    fstBuilderNodeDestroy(taosArrayGetP(nodes->free, i));
+  }
+  taosArrayDestroy(nodes->free);
   taosMemoryFree(nodes);
 }
 
-void fstUnFinishedNodesPushEmpty(FstUnFinishedNodes* nodes, bool isFinal) {
-  FstBuilderNode* node = taosMemoryMalloc(sizeof(FstBuilderNode));
+// every key inserted pushes one node per suffix byte, and they are all compiled away by the next key, so keep the
+// compiled nodes and their transition arrays around instead of going through malloc/free for each byte of each key
+static FstBuilderNode* fstUnFinishedNodesAlloc(FstUnFinishedNodes* nodes, bool isFinal) {
+  FstBuilderNode* node = NULL;
+  if (taosArrayGetSize(nodes->free) > 0) {
+    node = *(FstBuilderNode**)taosArrayPop(nodes->free);
+  } else {
+    node = taosMemoryMalloc(sizeof(FstBuilderNode));
+    node->trans = taosArrayInit(16, sizeof(FstTransition));
+  }
   node->isFinal = isFinal;
   node->finalOutput = 0;
-  node->trans = taosArrayInit(16, sizeof(FstTransition));
+  return node;
+}
+void fstUnFinishedNodesRecycle(FstUnFinishedNodes* nodes, FstBuilderNode* node) {
+  if (node == NULL) {
+    return;
+  }
+  taosArrayClear(node->trans);
+  if (taosArrayPush(nodes->free, &node) == NULL) {
+    fstBuilderNodeDestroy(node);
+  }
+}
+
+void fstUnFinishedNodesPushEmpty(FstUnFinishedNodes* nodes, bool isFinal) {
+  FstBuilderNode* node = fstUnFinishedNodesAlloc(nodes, isFinal);
 
   FstBuilderNodeUnfinished un = {.node = node, .last = NULL};
   taosArrayPush(nodes->stack, &un);
@@ -109,10 +135,7 @@ void fstUnFinishedNodesAddSuffix(FstUnFinishedNodes* nodes, FstSlice bs, Output
   un->last = fstLastTransitionCreate(data[0], out);
 
   for (uint64_t i = 1; i < len; i++) {
-    FstBuilderNode* n = taosMemoryMalloc(sizeof(FstBuilderNode));
-    n->isFinal = false;
-    n->finalOutput = 0;
-    n->trans = taosArrayInit(16, sizeof(FstTransition));
+    FstBuilderNode* n = fstUnFinishedNodesAlloc(nodes, false);
 
     // FstLastTransition *trn = taosMemoryMalloc(sizeof(FstLastTransition));
     // trn->inp = s->data[i];
@@ -813,6 +836,22 @@ void fstBuilderInsertOutput(FstBuilder* b, FstSlice bs, Output in) {
   return;
 }
 
+// keys come in order and mostly with similar length, so copy the new key into the buffer of the last one if it fits
+static void fstBuilderSetLastKey(FstBuilder* b, FstSlice* input) {
+  FstString* str = b->last.str;
+  int32_t    len = 0;
+  uint8_t*   data = fstSliceData(input, &len);
+  if (str->ref != 1 || str->len < len) {
+    fstSliceDestroy(&b->last);
+    b->last = fstSliceDeepCopy(input, input->start, input->end);
+    return;
+  }
+  if (len > 0) {
+    memcpy(str->data, data, len);
+  }
+  b->last.start = 0;
+  b->last.end = len - 1;
+}
 FstOrderType fstBuilderCheckLastKey(FstBuilder* b, FstSlice bs, bool ckDup) {
   FstSlice* input = &bs;
   if (fstSliceIsEmpty(&b->last)) {
@@ -826,9 +865,7 @@ FstOrderType fstBuilderCheckLastKey(FstBuilder* b, FstSlice bs, bool ckDup) {
     } else if (comp == 1) {
       return OutOfOrdered;
     }
-    // deep copy or not
-    fstSliceDestroy(&b->last);
-    b->last = fstSliceDeepCopy(&bs, input->start, input->end);
+    fstBuilderSetLastKey(b, input);
   }
   return Ordered;
 }
@@ -843,7 +880,7 @@ void fstBuilderCompileFrom(FstBuilder* b, uint64_t istate) {
     }
     addr = fstBuilderCompile(b, bn);
 
-    fstBuilderNodeDestroy(bn);
+    fstUnFinishedNodesRecycle(b->unfinished, bn);
     ASSERT(addr != NONE_ADDRESS);
   }
   fstUnFinishedNodesTopLastFreeze(b->unfinished, addr);
@@ -22,6 +22,8 @@
 #include "tutil.h"
 
 static int32_t kBlockSize = 4096;
+// tfiles are written sequentially in one pass, keep the syscalls few when a big index is built
+static int32_t kWriteBufSize = 4096 * 64;
 
 typedef struct {
   int32_t blockId;
@@ -49,8 +51,6 @@ static FORCE_INLINE int idxFileCtxDoWrite(IFileCtx* ctx, uint8_t* buf, int len)
       int32_t nw = cap - ctx->file.wBufOffset;
       memcpy(ctx->file.wBuf + ctx->file.wBufOffset, buf, nw);
       taosWriteFile(ctx->file.pFile, ctx->file.wBuf, cap);
-
-      memset(ctx->file.wBuf, 0, cap);
       ctx->file.wBufOffset = 0;
 
       len -= nw;
@@ -203,8 +203,8 @@ IFileCtx* idxFileCtxCreate(WriterType type, const char* path, bool readOnly, int
       UNUSED(code);
 
       ctx->file.wBufOffset = 0;
-      ctx->file.wBufCap = kBlockSize * 4;
-      ctx->file.wBuf = taosMemoryCalloc(1, ctx->file.wBufCap);
+      ctx->file.wBufCap = kWriteBufSize;
+      ctx->file.wBuf = taosMemoryMalloc(ctx->file.wBufCap);
     } else {
       ctx->file.pFile = taosOpenFile(path, TD_FILE_READ);
       code = taosFStatFile(ctx->file.pFile, &ctx->file.size, NULL);
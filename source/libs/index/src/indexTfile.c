@@ -34,8 +34,22 @@ typedef struct TFileFstIter {
 
 #define TF_TABLE_TATOAL_SIZE(sz) (sizeof(sz) + sz * sizeof(uint64_t))
 
+// values of a batch are sorted and their table ids deduplicated by several threads when the batch is big enough, as
+// when the index of a super table with a lot of child tables is built or rebuilt
+#define TF_PARALLEL_PREPARE_SIZE (64 * 1024)
+#define TF_MAX_PREPARE_THREADS   8
+
+typedef struct {
+  TFileValue**   pData;
+  int32_t        start;
+  int32_t        end;
+  bool           sort;
+  __compar_fn_t* fn;
+} TFilePrepareTask;
+
 static int  tfileStrCompare(const void* a, const void* b);
 static int  tfileValueCompare(const void* a, const void* b, const void* param);
+static int  tfileWriterPrepare(SArray* data, __compar_fn_t fn, bool sort);
 static void tfileSerialTableIdsToBuf(char* buf, SArray* tableIds);
 
 static int tfileWriteHeader(TFileWriter* writer);
@@ -538,11 +552,73 @@ TFileWriter* tfileWriterCreate(IFileCtx* ctx, TFileHeader* header) {
   return tw;
 }
 
+static void* tfilePrepareTaskFn(void* param) {
+  TFilePrepareTask* task = param;
+  if (task->sort) {
+    taosqsort(task->pData + task->start, task->end - task->start, sizeof(TFileValue*), task->fn, tfileValueCompare);
+  }
+  for (int32_t i = task->start; i < task->end; i++) {
+    TFileValue* v = task->pData[i];
+    taosArraySort(v->tableId, idxUidCompare);
+    taosArrayRemoveDuplicate(v->tableId, idxUidCompare, NULL);
+  }
+  return NULL;
+}
+static int tfileWriterPrepare(SArray* data, __compar_fn_t fn, bool sort) {
+  int32_t sz = taosArrayGetSize(data);
+  int32_t nThread = 1;
+  if (sz >= TF_PARALLEL_PREPARE_SIZE) {
+    nThread = TMIN(TMAX((int32_t)tsNumOfCores, 1), TF_MAX_PREPARE_THREADS);
+  }
+
+  TFilePrepareTask tasks[TF_MAX_PREPARE_THREADS] = {0};
+  TdThread         threads[TF_MAX_PREPARE_THREADS] = {0};
+  bool             started[TF_MAX_PREPARE_THREADS] = {0};
+  for (int32_t i = 0; i < nThread; i++) {
+    tasks[i].pData = (TFileValue**)TARRAY_DATA(data);
+    tasks[i].start = (int64_t)sz * i / nThread;
+    tasks[i].end = (int64_t)sz * (i + 1) / nThread;
+    tasks[i].sort = sort;
+    tasks[i].fn = &fn;
+  }
+  for (int32_t i = 1; i < nThread; i++) {
+    started[i] = (taosThreadCreate(&threads[i], NULL, tfilePrepareTaskFn, &tasks[i]) == 0);
+  }
+  for (int32_t i = 0; i < nThread; i++) {
+    if (i == 0 || !started[i]) {
+      tfilePrepareTaskFn(&tasks[i]);
+    } else {
+      taosThreadJoin(threads[i], NULL);
+    }
+  }
+  if (!sort || nThread == 1) {
+    return 0;
+  }
+
+  // merge the sorted runs, there are only a few of them
+  TFileValue** merged = taosMemoryMalloc(sizeof(TFileValue*) * sz);
+  if (merged == NULL) {
+    return -1;
+  }
+  for (int32_t n = 0; n < sz; n++) {
+    int32_t k = -1;
+    for (int32_t i = 0; i < nThread; i++) {
+      if (tasks[i].start >= tasks[i].end) continue;
+      if (k == -1 || tfileValueCompare(&tasks[i].pData[tasks[i].start], &tasks[k].pData[tasks[k].start], &fn) < 0) {
+        k = i;
+      }
+    }
+    merged[n] = tasks[k].pData[tasks[k].start++];
+  }
+  memcpy(TARRAY_DATA(data), merged, sizeof(TFileValue*) * sz);
+  taosMemoryFree(merged);
+  return 0;
+}
+
 int tfileWriterPut(TFileWriter* tw, void* data, bool order) {
   // sort by coltype and write to tindex
+  __compar_fn_t fn = NULL;
   if (order == false) {
-    __compar_fn_t fn;
-
     int8_t colType = tw->header.colType;
     colType = IDX_TYPE_GET_TYPE(colType);
     if (colType == TSDB_DATA_TYPE_BINARY || colType == TSDB_DATA_TYPE_VARBINARY ||
@@ -551,7 +627,9 @@ int tfileWriterPut(TFileWriter* tw, void* data, bool order) {
     } else {
       fn = getComparFunc(colType, 0);
     }
-    taosArraySortPWithExt((SArray*)(data), tfileValueCompare, &fn);
+  }
+  if (tfileWriterPrepare((SArray*)data, fn, order == false) != 0) {
+    return -1;
   }
 
   int32_t sz = taosArrayGetSize((SArray*)data);
@@ -560,9 +638,7 @@ int tfileWriterPut(TFileWriter* tw, void* data, bool order) {
   // ugly code, refactor later
   for (size_t i = 0; i < sz; i++) {
     TFileValue* v = taosArrayGetP((SArray*)data, i);
-    taosArraySort(v->tableId, idxUidCompare);
-    taosArrayRemoveDuplicate(v->tableId, idxUidCompare, NULL);
-    int32_t tbsz = taosArrayGetSize(v->tableId);
+    int32_t     tbsz = taosArrayGetSize(v->tableId);
     if (tbsz == 0) continue;
     fstOffset += TF_TABLE_TATOAL_SIZE(tbsz);
   }
@@ -594,7 +670,6 @@ int tfileWriterPut(TFileWriter* tw, void* data, bool order) {
     tw->ctx->write(tw->ctx, buf, ttsz);
     v->offset = tw->offset;
     tw->offset += ttsz;
-    memset(buf, 0, cap);
   }
   taosMemoryFree(buf);
 
@@ -794,8 +869,8 @@ static int tfileStrCompare(const void* a, const void* b) {
 static int tfileValueCompare(const void* a, const void* b, const void* param) {
   __compar_fn_t fn = *(__compar_fn_t*)param;
 
-  TFileValue* av = (TFileValue*)a;
-  TFileValue* bv = (TFileValue*)b;
+  TFileValue* av = *(TFileValue**)a;
+  TFileValue* bv = *(TFileValue**)b;
 
   return fn(av->colVal, bv->colVal);
 }
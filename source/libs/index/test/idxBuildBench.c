@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Build/lookup benchmark of the tag index file.
+ *
+ * A batch of distinct tag values in random order, each with a few table uids, is written into one tfile as an index
+ * rebuild does, then random values are looked up through the fst of the file and the latency is reported.
+ *
+ * usage: idxBuildBench [-n values] [-u uids per value] [-q lookups]
+ */
+
+#include "indexFstFile.h"
+#include "indexInt.h"
+#include "indexTfile.h"
+#include "indexUtil.h"
+#include "tlrucache.h"
+
+#define BENCH_COL_NAME "tag"
+
+static int benchLatencyCompare(const void *a, const void *b) {
+  int64_t la = *(int64_t *)a, lb = *(int64_t *)b;
+  return la < lb ? -1 : (la > lb ? 1 : 0);
+}
+
+static void benchGenValue(char *buf, int32_t idx) { sprintf(buf, "tag_value_%09d", idx); }
+
+int main(int argc, char *argv[]) {
+  int32_t nValue = 1000000;
+  int32_t nUid = 4;
+  int32_t nQuery = 100000;
+
+  for (int32_t i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      nValue = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-u") == 0 && i + 1 < argc) {
+      nUid = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-q") == 0 && i + 1 < argc) {
+      nQuery = atoi(argv[++i]);
+    } else {
+      printf("usage: %s [-n values] [-u uids per value] [-q lookups]\n", argv[0]);
+      return -1;
+    }
+  }
+  if (nValue <= 0 || nUid <= 0 || nQuery < 0) {
+    printf("invalid arguments\n");
+    return -1;
+  }
+
+  char path[PATH_MAX] = {0};
+  snprintf(path, sizeof(path), "%sidxBuildBench.tindex", TD_TMP_DIR_PATH);
+  taosRemoveFile(path);
+
+  // shuffled values, the uids of a value are pushed in reverse order with a duplicate to be sorted out
+  int32_t *aIdx = taosMemoryMalloc(sizeof(int32_t) * nValue);
+  for (int32_t i = 0; i < nValue; i++) aIdx[i] = i;
+  for (int32_t i = nValue - 1; i > 0; i--) {
+    int32_t j = taosRand() % (i + 1);
+    TSWAP(aIdx[i], aIdx[j]);
+  }
+
+  SArray *data = taosArrayInit(nValue, sizeof(void *));
+  char    buf[64] = {0};
+  for (int32_t i = 0; i < nValue; i++) {
+    benchGenValue(buf, aIdx[i]);
+    TFileValue *tv = tfileValueCreate(buf);
+    for (int32_t j = nUid - 1; j >= 0; j--) {
+      tfileValuePush(tv, (uint64_t)aIdx[i] * nUid + j);
+    }
+    tfileValuePush(tv, (uint64_t)aIdx[i] * nUid);
+    taosArrayPush(data, &tv);
+  }
+
+  TFileHeader header = {.suid = 1, .version = 1, .colType = TSDB_DATA_TYPE_BINARY};
+  memcpy(header.colName, BENCH_COL_NAME, strlen(BENCH_COL_NAME));
+
+  int64_t      st = taosGetTimestampUs();
+  IFileCtx    *wctx = idxFileCtxCreate(TFILE, path, false, 1024 * 1024 * 64);
+  TFileWriter *tw = wctx ? tfileWriterCreate(wctx, &header) : NULL;
+  if (tw == NULL || tfileWriterPut(tw, data, false) != 0) {
+    printf("failed to write index file %s\n", path);
+    return -1;
+  }
+  tfileWriterClose(tw);
+  int64_t et = taosGetTimestampUs();
+
+  int64_t fileSize = 0;
+  taosStatFile(path, &fileSize, NULL, NULL);
+  double elapsed = (et - st) / 1000000.0;
+  printf("build values:%d uids per value:%d elapsed:%.3fs %.0f values/s file size:%" PRId64 "\n", nValue, nUid,
+         elapsed, nValue / elapsed, fileSize);
+
+  taosArrayDestroyEx(data, (FDelete)tfileValueDestroy);
+  taosMemoryFree(aIdx);
+
+  IFileCtx *rctx = idxFileCtxCreate(TFILE, path, true, 1024 * 1024 * 1024);
+  if (rctx == NULL) {
+    printf("failed to open index file %s\n", path);
+    return -1;
+  }
+  rctx->lru = taosLRUCacheInit(1024 * 1024 * 64, -1, .5);
+  TFileReader *reader = tfileReaderCreate(rctx);
+  if (reader == NULL) {
+    printf("failed to load index file %s\n", path);
+    return -1;
+  }
+  // searching unrefs the reader, hold it until the end
+  tfileReaderRef(reader);
+
+  int64_t *aLatency = taosMemoryCalloc(TMAX(nQuery, 1), sizeof(int64_t));
+  SArray  *result = taosArrayInit(nUid, sizeof(uint64_t));
+  int32_t  nMiss = 0;
+  for (int32_t i = 0; i < nQuery; i++) {
+    char    val[64] = {0};
+    int32_t idx = taosRand() % nValue;
+    benchGenValue(varDataVal(val), idx);
+    varDataSetLen(val, strlen(varDataVal(val)));
+
+    SIndexTerm *term = indexTermCreate(1, ADD_VALUE, TSDB_DATA_TYPE_BINARY, BENCH_COL_NAME, strlen(BENCH_COL_NAME),
+                                       val, varDataTLen(val));
+    SIndexTermQuery query = {.term = term, .qType = QUERY_TERM};
+    SIdxTRslt      *tr = idxTRsltCreate();
+
+    st = taosGetTimestampUs();
+    tfileReaderRef(reader);
+    tfileReaderSearch(reader, &query, tr);
+    aLatency[i] = taosGetTimestampUs() - st;
+
+    taosArrayClear(result);
+    idxTRsltMergeTo(tr, result);
+    if (taosArrayGetSize(result) != nUid) nMiss++;
+
+    idxTRsltDestroy(tr);
+    indexTermDestroy(term);
+  }
+
+  if (nQuery > 0) {
+    int64_t total = 0;
+    for (int32_t i = 0; i < nQuery; i++) total += aLatency[i];
+    taosSort(aLatency, nQuery, sizeof(int64_t), benchLatencyCompare);
+    printf("lookup:%d avg:%.2fus p50:%" PRId64 "us p99:%" PRId64 "us max:%" PRId64 "us wrong results:%d\n", nQuery,
+           (double)total / nQuery, aLatency[nQuery / 2], aLatency[(int64_t)nQuery * 99 / 100], aLatency[nQuery - 1],
+           nMiss);
+  }
+
+  SLRUCache *lru = rctx->lru;
+  taosArrayDestroy(result);
+  taosMemoryFree(aLatency);
+  tfileReaderUnRef(reader);
+  taosLRUCacheCleanup(lru);
+  taosRemoveFile(path);
+  return nMiss == 0 ? 0 : -1;
+}
@@ -14,6 +14,7 @@
  */
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <thread>
@@ -516,6 +517,107 @@ TEST_F(IndexTFileEnv, test_tfile_write) {
 
   // tfileWriterDestroy(twrite);
 }
+static SArray* genUnorderedTFileValues(int32_t num) {
+  std::vector<int32_t> order(num);
+  for (int32_t i = 0; i < num; i++) {
+    order[i] = i;
+  }
+  std::random_shuffle(order.begin(), order.end());
+
+  SArray* data = (SArray*)taosArrayInit(num, sizeof(void*));
+  for (int32_t i = 0; i < num; i++) {
+    char buf[32] = {0};
+    sprintf(buf, "tag_%07d", order[i]);
+    TFileValue* tv = (TFileValue*)taosMemoryCalloc(1, sizeof(TFileValue));
+    tv->colVal = taosStrdup(buf);
+    tv->tableId = (SArray*)taosArrayInit(4, sizeof(uint64_t));
+    // unordered and duplicated table uids, 3 * order[i] appears twice
+    uint64_t uids[] = {(uint64_t)order[i] * 3 + 2, (uint64_t)order[i] * 3, (uint64_t)order[i] * 3 + 1,
+                       (uint64_t)order[i] * 3};
+    for (size_t j = 0; j < sizeof(uids) / sizeof(uids[0]); j++) {
+      taosArrayPush(tv->tableId, &uids[j]);
+    }
+    taosArrayPush(data, &tv);
+  }
+  return data;
+}
+static std::string writeTFileValues(const std::string& dir, SArray* data, float numOfCores) {
+  taosMkDir(dir.c_str());
+  TFileWriter* tw = tfileWriterOpen((char*)dir.c_str(), 1, 1, "voltage", TSDB_DATA_TYPE_BINARY);
+  EXPECT_TRUE(tw != NULL);
+
+  float cores = tsNumOfCores;
+  tsNumOfCores = numOfCores;
+  EXPECT_EQ(tfileWriterPut(tw, data, false), 0);
+  tsNumOfCores = cores;
+  tfileWriterDestroy(tw);
+
+  std::ifstream in(dir + "/1-voltage-1.tindex", std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+TEST_F(IndexTFileEnv, test_tfile_write_parallel_prepare) {
+  // more terms than TF_PARALLEL_PREPARE_SIZE, sorted and merged by several threads
+  const int32_t num = 64 * 1024 + 1000;
+  std::srand(7);
+  SArray* serial = genUnorderedTFileValues(num);
+  std::srand(7);
+  SArray* parallel = genUnorderedTFileValues(num);
+
+  std::string serialFile = writeTFileValues(dir + "/serial", serial, 1);
+  std::string parallelFile = writeTFileValues(dir + "/parallel", parallel, 4);
+  EXPECT_GT(serialFile.size(), (size_t)num);
+  EXPECT_TRUE(serialFile == parallelFile);
+
+  for (int32_t i = 0; i < num; i++) {
+    TFileValue* tv = (TFileValue*)taosArrayGetP(parallel, i);
+    char        buf[32] = {0};
+    sprintf(buf, "tag_%07d", i);
+    ASSERT_STREQ(tv->colVal, buf);
+    ASSERT_EQ(taosArrayGetSize(tv->tableId), 3);
+    for (int32_t j = 0; j < 3; j++) {
+      ASSERT_EQ(*(uint64_t*)taosArrayGet(tv->tableId, j), (uint64_t)i * 3 + j);
+    }
+  }
+  for (int32_t i = 0; i < num; i++) {
+    destroyTFileValue(taosArrayGetP(serial, i));
+    destroyTFileValue(taosArrayGetP(parallel, i));
+  }
+  taosArrayDestroy(serial);
+  taosArrayDestroy(parallel);
+
+  IFileCtx* ctx = idxFileCtxCreate(TFILE, (dir + "/parallel/1-voltage-1.tindex").c_str(), true, 64 * 1024 * 1024);
+  ctx->lru = taosLRUCacheInit(1024 * 1024 * 4, -1, .5);
+  TFileReader* reader = tfileReaderCreate(ctx);
+  ASSERT_TRUE(reader != NULL);
+
+  int32_t vals[] = {0, 1, 4096, 32767, num / 2, 65535, 65536, num - 1};
+  for (size_t i = 0; i < sizeof(vals) / sizeof(vals[0]); i++) {
+    char colVal[32] = {0};
+    sprintf(colVal, "tag_%07d", vals[i]);
+
+    char    buf[256] = {0};
+    int16_t sz = strlen(colVal);
+    memcpy(buf, (uint16_t*)&sz, 2);
+    memcpy(buf + 2, colVal, sz);
+    SIndexTerm* term =
+        indexTermCreate(1, ADD_VALUE, TSDB_DATA_TYPE_BINARY, colName.c_str(), colName.size(), buf, sizeof(buf));
+    SIndexTermQuery query = {term, QUERY_TERM};
+
+    SArray*    result = (SArray*)taosArrayInit(4, sizeof(uint64_t));
+    SIdxTRslt* tr = idxTRsltCreate();
+    tfileReaderSearch(reader, &query, tr);
+    idxTRsltMergeTo(tr, result);
+    idxTRsltDestroy(tr);
+
+    EXPECT_EQ(taosArrayGetSize(result), 3);
+    for (int32_t j = 0; j < (int32_t)taosArrayGetSize(result); j++) {
+      EXPECT_EQ(*(uint64_t*)taosArrayGet(result, j), (uint64_t)vals[i] * 3 + j);
+    }
+    indexTermDestroy(term);
+    taosArrayDestroy(result);
+  }
+  tfileReaderDestroy(reader);
+}
 class CacheObj {
  public:
   CacheObj() {
@@ -5,6 +5,7 @@
 #include <thread>
 #include <vector>
 #include "index.h"
+#include "indexBitmap.h"
 #include "indexCache.h"
 #include "indexComm.h"
 #include "indexFst.h"
@@ -365,3 +366,66 @@ TEST_F(UtilEnv, testDictComm) {
     EXPECT_EQ(COMMON_INPUTS[v], i);
   }
 }
+
+TEST_F(UtilEnv, bitmapAlgebra) {
+  // sparse values go into array containers, dense ones into bit sets
+  SIdxBitmap *a = idxBitmapCreate();
+  SIdxBitmap *b = idxBitmapCreate();
+  for (uint32_t i = 0; i < 100000; i += 2) idxBitmapAdd(a, i);
+  for (uint32_t i = 0; i < 100000; i += 3) idxBitmapAdd(b, i);
+  idxBitmapAdd(b, 1u << 30);
+  EXPECT_EQ(idxBitmapCardinality(a), 50000);
+  EXPECT_EQ(idxBitmapCardinality(b), 33335);
+
+  SIdxBitmap *c = idxBitmapCreate();
+  idxBitmapOr(c, a);
+  idxBitmapAnd(c, b);
+  EXPECT_EQ(idxBitmapCardinality(c), 16667);
+  EXPECT_TRUE(idxBitmapContains(c, 6));
+  EXPECT_FALSE(idxBitmapContains(c, 4));
+
+  idxBitmapOr(c, b);
+  EXPECT_EQ(idxBitmapCardinality(c), 33335);
+  EXPECT_TRUE(idxBitmapContains(c, 1u << 30));
+
+  idxBitmapAndNot(c, a);
+  EXPECT_EQ(idxBitmapCardinality(c), 16668);
+  EXPECT_FALSE(idxBitmapContains(c, 6));
+
+  SArray *out = taosArrayInit(0, sizeof(uint32_t));
+  idxBitmapToArray(c, out);
+  EXPECT_EQ(taosArrayGetSize(out), 16668);
+  for (int i = 1; i < taosArrayGetSize(out); i++) {
+    EXPECT_LT(*(uint32_t *)taosArrayGet(out, i - 1), *(uint32_t *)taosArrayGet(out, i));
+  }
+  taosArrayDestroy(out);
+  idxBitmapDestroy(a);
+  idxBitmapDestroy(b);
+  idxBitmapDestroy(c);
+}
+TEST_F(UtilEnv, bitmapUids) {
+  SIdxUidDict *dict = idxUidDictCreate();
+  SIdxBitmap  *a = idxBitmapCreate();
+  SIdxBitmap  *b = idxBitmapCreate();
+
+  SArray *f = (SArray *)taosArrayGetP(src, 0);
+  SArray *s = (SArray *)taosArrayGetP(src, 1);
+  for (uint64_t i = 0; i < 1000; i++) {
+    uint64_t val = UINT64_MAX - i * 7;
+    taosArrayPush(f, &val);
+    if (i % 2 == 0) taosArrayPush(s, &val);
+  }
+  idxBitmapAddUids(a, dict, f);
+  idxBitmapAddUids(b, dict, s);
+  idxBitmapAnd(a, b);
+  idxBitmapToUids(a, dict, rslt);
+
+  // uids come back in ascending order
+  EXPECT_EQ(taosArrayGetSize(rslt), 500);
+  EXPECT_EQ(*(uint64_t *)taosArrayGet(rslt, 0), UINT64_MAX - 998 * 7);
+  EXPECT_EQ(*(uint64_t *)taosArrayGetLast(rslt), UINT64_MAX);
+
+  idxBitmapDestroy(a);
+  idxBitmapDestroy(b);
+  idxUidDictDestroy(dict);
+}
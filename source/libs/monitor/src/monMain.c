@@ -324,6 +324,7 @@ static void monGenDnodeJson(SMonInfo *pMonitor) {
   SMonDnodeInfo *pInfo = &pMonitor->dmInfo.dnode;
   SMonSysInfo   *pSys = &pMonitor->dmInfo.sys;
   SVnodesStat   *pStat = &pMonitor->vmInfo.vstat;
+  SRpcBufStat   *pRpcBuf = &pMonitor->dmInfo.rpcBuf;
 
   SJson *pJson = tjsonCreateObject();
   if (pJson == NULL) return;
@@ -404,6 +405,11 @@ static void monGenDnodeJson(SMonInfo *pMonitor) {
   tjsonAddDoubleToObject(pJson, "has_mnode", pInfo->has_mnode);
   tjsonAddDoubleToObject(pJson, "has_qnode", pInfo->has_qnode);
   tjsonAddDoubleToObject(pJson, "has_snode", pInfo->has_snode);
+  tjsonAddDoubleToObject(pJson, "rpc_buf_allocs", pRpcBuf->numOfAllocs);
+  tjsonAddDoubleToObject(pJson, "rpc_buf_pool_hits", pRpcBuf->numOfPoolHits);
+  tjsonAddDoubleToObject(pJson, "rpc_buf_big_allocs", pRpcBuf->numOfBigAllocs);
+  tjsonAddDoubleToObject(pJson, "rpc_buf_mem_in_use", pRpcBuf->memInUse);
+  tjsonAddDoubleToObject(pJson, "rpc_buf_mem_in_pool", pRpcBuf->memInPool);
 }
 
 static void monGenDiskJson(SMonInfo *pMonitor) {
@@ -133,6 +133,7 @@ typedef struct SQWTaskCtx {
   bool    queryContinue;
   bool    queryExecDone;
   bool    queryInQueue;
+  bool    queryYield;  // exec gave up the worker on its budget, the task is to be continued from the queue
   bool    explainRsped;
   int32_t rspCode;
   int64_t affectedRows;  // for insert ...select stmt
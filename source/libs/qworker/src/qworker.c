@@ -131,6 +131,11 @@ int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop) {
   qTaskInfo_t    taskHandle = ctx->taskHandle;
   DataSinkHandle sinkHandle = ctx->sinkHandle;
   SLocalFetch    localFetch = {(void *)mgmt, ctx->localExec, qWorkerProcessLocalFetch, ctx->explainRes};
+  int64_t        putRows = 0;
+  int64_t        startTs = taosGetTimestampMs();
+  bool           canYield = !ctx->localExec && !ctx->dynamicTask && (tsQueryYieldRows > 0 || tsQueryYieldMs > 0);
+
+  ctx->queryYield = false;
 
   if (ctx->queryExecDone) {
     if (queryStop) {
@@ -175,6 +180,7 @@ int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop) {
       }
 
       QW_TASK_DLOG("data put into sink, rows:%" PRId64 ", continueExecTask:%d", pRes->info.rows, qcontinue);
+      putRows += pRes->info.rows;
     }
 
     if (numOfResBlock == 0 || (hasMore == false)) {
@@ -217,6 +223,14 @@ int32_t qwExecTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, bool *queryStop) {
       break;
     }
 
+    // give the worker to the other tasks, the caller puts this one back to the queue
+    if (canYield && ((tsQueryYieldRows > 0 && putRows >= tsQueryYieldRows) ||
+                     (tsQueryYieldMs > 0 && taosGetTimestampMs() - startTs >= tsQueryYieldMs))) {
+      QW_TASK_DLOG("task yields, rows:%" PRId64 ", execNum:%d", putRows, execNum);
+      ctx->queryYield = true;
+      break;
+    }
+
     if (QW_EVENT_RECEIVED(ctx, QW_EVENT_FETCH)) {
       break;
     }
@@ -344,10 +358,28 @@ int32_t qwGetQueryResFromSink(QW_FPARAMS_DEF, SQWTaskCtx *ctx, int32_t *dataLen,
 
     *dataLen += len;
 
-    QW_ERR_RET(qwMallocFetchRsp(!ctx->localExec, *dataLen, &rsp));
+    code = TSDB_CODE_OPS_NOT_SUPPORT;
+    if (!ctx->localExec && tsCompressMsgSize < 0) {
+      // the block is sent from the buffer of the sink, attached to rsp instead of copied into it, unless the rpc
+      // compresses the rsp as a whole
+      if (NULL == rsp) {
+        QW_ERR_RET(qwMallocFetchRsp(true, 0, &rsp));
+      }
+
+      void *pBuf = NULL;
+      code = dsGetDataBlockRef(ctx->sinkHandle, &output, &pBuf);
+      if (TSDB_CODE_SUCCESS == code && pBuf && rpcAddContRef(rsp, output.pData, len, pBuf, taosMemoryFree)) {
+        taosMemoryFree(pBuf);
+        code = terrno;
+      }
+    }
+
+    if (TSDB_CODE_OPS_NOT_SUPPORT == code) {
+      QW_ERR_RET(qwMallocFetchRsp(!ctx->localExec, *dataLen, &rsp));
 
-    output.pData = rsp->data + *dataLen - len;
-    code = dsGetDataBlock(ctx->sinkHandle, &output);
+      output.pData = rsp->data + *dataLen - len;
+      code = dsGetDataBlock(ctx->sinkHandle, &output);
+    }
     if (code) {
       QW_TASK_ELOG("dsGetDataBlock failed, code:%x - %s", code, tstrerror(code));
       QW_ERR_RET(code);
@@ -488,7 +520,7 @@ int32_t qwStartDynamicTaskNewExec(QW_FPARAMS_DEF, SQWTaskCtx *ctx, SQWMsg *qwMsg
   } else if (0 == atomic_load_8((int8_t *)&ctx->queryInQueue)) {
     atomic_store_8((int8_t *)&ctx->queryInQueue, 1);
     QW_TASK_DLOG("the %dth dynamic task exec started", ctx->dynExecId++);
-    QW_ERR_RET(qwBuildAndSendCQueryMsg(QW_FPARAMS(), &qwMsg->connInfo));
+    QW_ERR_RET(qwBuildAndSendCQueryMsg(QW_FPARAMS(), &qwMsg->connInfo, false));
   }
 
   return TSDB_CODE_SUCCESS;
@@ -705,6 +737,23 @@ _return:
   QW_RET(TSDB_CODE_SUCCESS);
 }
 
+// put a continue msg of the task that yielded into the queue, unless it is running again or already queued
+static void qwContinueYieldedTask(QW_FPARAMS_DEF, SQWTaskCtx *ctx, SRpcHandleInfo *pConn) {
+  QW_LOCK(QW_WRITE, &ctx->lock);
+  ctx->queryYield = false;
+
+  if (!QW_QUERY_RUNNING(ctx) && 0 == atomic_load_8((int8_t *)&ctx->queryInQueue) &&
+      !atomic_load_8((int8_t *)&ctx->queryEnd) && 0 == atomic_load_32(&ctx->rspCode) &&
+      !QW_EVENT_RECEIVED(ctx, QW_EVENT_DROP)) {
+    atomic_store_8((int8_t *)&ctx->queryInQueue, 1);
+    if (qwBuildAndSendCQueryMsg(QW_FPARAMS(), pConn, true)) {
+      atomic_store_8((int8_t *)&ctx->queryInQueue, 0);
+    }
+  }
+
+  QW_UNLOCK(QW_WRITE, &ctx->lock);
+}
+
 int32_t qwProcessQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg, char *sql) {
   int32_t        code = 0;
   bool           queryRsped = false;
@@ -769,6 +818,10 @@ _return:
   input.msgType = qwMsg->msgType;
   code = qwHandlePostPhaseEvents(QW_FPARAMS(), QW_PHASE_POST_QUERY, &input, NULL);
 
+  if (TSDB_CODE_SUCCESS == code && ctx && ctx->queryYield) {
+    qwContinueYieldedTask(QW_FPARAMS(), ctx, &qwMsg->connInfo);
+  }
+
   qwQuickRspFetchReq(QW_FPARAMS(), ctx, qwMsg, code);
 
   QW_RET(TSDB_CODE_SUCCESS);
@@ -854,6 +907,13 @@ int32_t qwProcessCQuery(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
       QW_UNLOCK(QW_WRITE, &ctx->lock);
       break;
     }
+    if (ctx->queryYield) {
+      // continue from the queue instead of looping here, the tasks queued meanwhile go first
+      QW_SET_PHASE(ctx, QW_PHASE_POST_CQUERY);
+      QW_UNLOCK(QW_WRITE, &ctx->lock);
+      qwContinueYieldedTask(QW_FPARAMS(), ctx, &qwMsg->connInfo);
+      break;
+    }
     QW_UNLOCK(QW_WRITE, &ctx->lock);
     queryStop = false;
   } while (true);
@@ -914,7 +974,7 @@ int32_t qwProcessFetch(QW_FPARAMS_DEF, SQWMsg *qwMsg) {
 
       atomic_store_8((int8_t *)&ctx->queryInQueue, 1);
 
-      QW_ERR_JRET(qwBuildAndSendCQueryMsg(QW_FPARAMS(), &qwMsg->connInfo));
+      QW_ERR_JRET(qwBuildAndSendCQueryMsg(QW_FPARAMS(), &qwMsg->connInfo, false));
     }
   }
 
@@ -15,6 +15,7 @@
 
 #include <gtest/gtest.h>
 #include <iostream>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wwrite-strings"
@@ -94,6 +95,17 @@ SRpcMsg            qwtdropRpc = {0};
 STaskDropReq       qwtdropMsg = {0};
 SSchTasksStatusReq qwtstatusMsg = {0};
 
+// a task of the yield case returns qwtYieldBlockNum blocks of qwtYieldBlockRows rows, the msgs it puts to the query
+// queue are kept in qwtYieldQueue
+int32_t              qwtYieldBlockRows = 100;
+int32_t              qwtYieldBlockNum = 0;
+int32_t              qwtYieldExecNum = 0;
+int64_t              qwtYieldPutRows = 0;
+bool                 qwtYieldQueryEnd = false;
+int32_t              qwtYieldQueryRspNum = 0;
+std::vector<SRpcMsg> qwtYieldQueue;
+SSubplan             qwtYieldPlan;
+
 void qwtInitLogFile() {
   if (!qwtEnableLog) {
     return;
@@ -402,6 +414,100 @@ int32_t qwtGetDataBlock(DataSinkHandle handle, SOutputData *pOutput) {
 
 void qwtDestroyDataSinker(DataSinkHandle handle) {}
 
+int32_t qwtYieldMsgToSubplan(const char *pStr, int32_t len, SSubplan **pSubplan) {
+  *pSubplan = &qwtYieldPlan;
+  return 0;
+}
+
+int32_t qwtYieldCreateExecTask(SReadHandle *readHandle, int32_t vgId, uint64_t taskId, struct SSubplan *pPlan,
+                               qTaskInfo_t *pTaskInfo, DataSinkHandle *handle, char *sql, EOPTR_EXEC_MODEL model) {
+  *pTaskInfo = (qTaskInfo_t)0x1;
+  *handle = (DataSinkHandle)0x2;
+  taosMemoryFree(sql);
+  return 0;
+}
+
+bool qwtYieldIsDynamicExecTask(qTaskInfo_t tinfo) { return false; }
+
+bool qwtYieldTaskIsExecuting(qTaskInfo_t qinfo) { return false; }
+
+int32_t qwtYieldGetQueryTableSchemaVersion(qTaskInfo_t tinfo, char *dbName, char *tableName, int32_t *sversion,
+                                           int32_t *tversion, int32_t idx) {
+  return -1;
+}
+
+int32_t qwtYieldExecTaskOpt(qTaskInfo_t tinfo, SArray *pResList, uint64_t *useconds, bool *hasMore,
+                            SLocalFetch *pLocal) {
+  taosArrayClear(pResList);
+  qwtYieldExecNum++;
+
+  // the result block is owned by the task, as the operators own theirs
+  static SSDataBlock res = {0};
+  if (qwtYieldBlockNum > 0) {
+    SSDataBlock *pRes = &res;
+    pRes->info.rows = qwtYieldBlockRows;
+    taosArrayPush(pResList, &pRes);
+    qwtYieldBlockNum--;
+  }
+
+  *hasMore = qwtYieldBlockNum > 0;
+  *useconds = 0;
+  return 0;
+}
+
+int32_t qwtYieldPutDataBlock(DataSinkHandle handle, const SInputData *pInput, bool *pContinue) {
+  qwtYieldPutRows += pInput->pData->info.rows;
+
+  // the sink never fills up, the task only stops on its yield budget
+  *pContinue = true;
+  return 0;
+}
+
+void qwtYieldEndPut(DataSinkHandle handle, uint64_t useconds) { qwtYieldQueryEnd = true; }
+
+void qwtYieldGetDataLength(DataSinkHandle handle, int64_t *pLen, bool *pQueryEnd) {
+  *pLen = qwtYieldPutRows;
+  if (pQueryEnd) {
+    *pQueryEnd = qwtYieldQueryEnd;
+  }
+}
+
+void qwtYieldRpcSendResponse(const SRpcMsg *pRsp) {
+  if (TDMT_SCH_QUERY_RSP == pRsp->msgType) {
+    qwtYieldQueryRspNum++;
+  }
+
+  rpcFreeCont(pRsp->pCont);
+}
+
+void qwtYieldRegisterBrokenLinkArg(SRpcMsg *pMsg) { rpcFreeCont(pMsg->pCont); }
+
+int32_t qwtYieldPutReqToQueue(void *node, EQueueType qtype, struct SRpcMsg *pMsg) {
+  qwtYieldQueue.push_back(*pMsg);
+  return 0;
+}
+
+void qwtYieldBuildQueryReqMsg(SRpcMsg *queryRpc) {
+  SSubQueryMsg msg = {0};
+  msg.sId = 1;
+  msg.queryId = atomic_add_fetch_64(&qwtTestQueryId, 1);
+  msg.taskId = 1;
+  msg.taskType = TASK_TYPE_TEMP;
+  msg.needFetch = false;
+  msg.sql = (char *)"select * from tb";
+  msg.sqlLen = strlen(msg.sql);
+  msg.msg = (char *)"plan";
+  msg.msgLen = strlen(msg.msg);
+
+  int32_t msgSize = tSerializeSSubQueryMsg(NULL, 0, &msg);
+  void   *pMsg = taosMemoryCalloc(1, msgSize);
+  tSerializeSSubQueryMsg(pMsg, msgSize, &msg);
+
+  queryRpc->msgType = TDMT_SCH_QUERY;
+  queryRpc->pCont = pMsg;
+  queryRpc->contLen = msgSize;
+}
+
 void stubSetStringToPlan() {
   static Stub stub;
   stub.set(qStringToSubplan, qwtStringToPlan);
@@ -622,6 +728,20 @@ void stubSetGetDataBlock() {
   }
 }
 
+void stubSetYieldTask() {
+  static Stub stub;
+  stub.set(qMsgToSubplan, qwtYieldMsgToSubplan);
+  stub.set(qCreateExecTask, qwtYieldCreateExecTask);
+  stub.set(qIsDynamicExecTask, qwtYieldIsDynamicExecTask);
+  stub.set(qTaskIsExecuting, qwtYieldTaskIsExecuting);
+  stub.set(qGetQueryTableSchemaVersion, qwtYieldGetQueryTableSchemaVersion);
+  stub.set(qExecTaskOpt, qwtYieldExecTaskOpt);
+  stub.set(dsPutDataBlock, qwtYieldPutDataBlock);
+  stub.set(dsEndPut, qwtYieldEndPut);
+  stub.set(dsGetDataLength, qwtYieldGetDataLength);
+  stub.set(rpcSendResponse, qwtYieldRpcSendResponse);
+}
+
 void *queryThread(void *param) {
   SRpcMsg  queryRpc = {0};
   int32_t  code = 0;
@@ -1051,6 +1171,82 @@ TEST(seqTest, multithreadRand) {
   qWorkerDestroy(&mgmt);
 }
 
+TEST(seqTest, yieldCase) {
+  void   *mgmt = NULL;
+  int32_t code = 0;
+  void   *mockPointer = (void *)0x1;
+  SRpcMsg queryRpc = {0};
+  SRpcMsg dropRpc = {0};
+
+  qwtInitLogFile();
+
+  stubSetDestroyTask();
+  stubSetDestroyDataSinker();
+  stubSetYieldTask();
+
+  SMsgCb msgCb = {0};
+  msgCb.mgmt = (void *)mockPointer;
+  msgCb.putToQueueFp = (PutToQueueFp)qwtYieldPutReqToQueue;
+  msgCb.registerBrokenLinkArgFp = qwtYieldRegisterBrokenLinkArg;
+  tmsgSetDefault(&msgCb);
+  code = qWorkerInit(NODE_TYPE_VNODE, 1, &mgmt, &msgCb);
+  ASSERT_EQ(code, 0);
+
+  // the task yields once it has put 250 rows, after every third block
+  tsQueryYieldRows = 250;
+  qwtYieldBlockNum = 10;
+  qwtYieldExecNum = 0;
+  qwtYieldPutRows = 0;
+  qwtYieldQueryEnd = false;
+  qwtYieldQueryRspNum = 0;
+  qwtYieldQueue.clear();
+
+  qwtYieldBuildQueryReqMsg(&queryRpc);
+  code = qWorkerPreprocessQueryMsg(mgmt, &queryRpc, false);
+  ASSERT_EQ(code, 0);
+  code = qWorkerProcessQueryMsg(mockPointer, mgmt, &queryRpc, 0);
+  ASSERT_EQ(code, 0);
+  taosMemoryFree(queryRpc.pCont);
+
+  // the query is responded and the rest of the task is put back to the queue as a continue msg
+  EXPECT_EQ(qwtYieldExecNum, 3);
+  EXPECT_EQ(qwtYieldPutRows, 3 * qwtYieldBlockRows);
+  EXPECT_EQ(qwtYieldQueryRspNum, 1);
+  EXPECT_FALSE(qwtYieldQueryEnd);
+  ASSERT_EQ(qwtYieldQueue.size(), 1);
+
+  // every continue msg runs the task for another budget, and only one of them is queued at a time
+  int32_t cqueryNum = 0;
+  while (!qwtYieldQueue.empty()) {
+    SRpcMsg cqueryRpc = qwtYieldQueue.front();
+    qwtYieldQueue.erase(qwtYieldQueue.begin());
+    ASSERT_EQ(cqueryRpc.msgType, TDMT_SCH_QUERY_CONTINUE);
+    EXPECT_TRUE(((SQueryContinueReq *)cqueryRpc.pCont)->yielded);
+
+    code = qWorkerProcessCQueryMsg(mockPointer, mgmt, &cqueryRpc, 0);
+    ASSERT_EQ(code, 0);
+    rpcFreeCont(cqueryRpc.pCont);
+
+    ++cqueryNum;
+    EXPECT_EQ(qwtYieldPutRows, TMIN(3 * (cqueryNum + 1), 10) * qwtYieldBlockRows);
+    EXPECT_LE(qwtYieldQueue.size(), 1);
+  }
+
+  EXPECT_EQ(cqueryNum, 3);
+  EXPECT_EQ(qwtYieldExecNum, 10);
+  EXPECT_EQ(qwtYieldPutRows, 10 * qwtYieldBlockRows);
+  EXPECT_TRUE(qwtYieldQueryEnd);
+  EXPECT_EQ(qwtYieldQueryRspNum, 1);
+
+  qwtBuildDropReqMsg(&qwtdropMsg, &dropRpc);
+  code = qWorkerProcessDropMsg(mockPointer, mgmt, &dropRpc, 0);
+  ASSERT_EQ(code, 0);
+  taosMemoryFree(dropRpc.pCont);
+
+  tsQueryYieldRows = 0;
+  qWorkerDestroy(&mgmt);
+}
+
 TEST(rcTest, shortExecshortDelay) {
   void   *mgmt = NULL;
   int32_t code = 0;
@@ -103,6 +103,16 @@ static FORCE_INLINE _getDoubleValue_fn_t getVectorDoubleValueFn(int32_t srcType)
   return p;
 }
 
+// bit (i & 63) of word (i >> 6) of a selection bitmap is set when row i qualifies
+#define VECTOR_SEL_WORDS(_n) (((_n) + 63) >> 6)
+
+typedef void (*_vec_cmp_fn_t)(const void *pLeft, const void *pRight, int32_t numOfRows, uint64_t *pSel);
+
+_vec_cmp_fn_t getVectorCompareFn(int32_t type, int32_t optr, bool rightIsScalar);
+int32_t       vectorReverseCompareOptr(int32_t optr);
+void          vectorSelClearNull(uint64_t *pSel, const SColumnInfoData *pCol, int32_t startIndex, int32_t numOfRows);
+int32_t       vectorSelToBool(const uint64_t *pSel, int32_t numOfRows, bool *pRes);
+
 typedef void (*_bufConverteFunc)(char *buf, SScalarParam *pOut, int32_t outType, int32_t *overflow);
 typedef void (*_bin_scalar_fn_t)(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *output, int32_t order);
 _bin_scalar_fn_t getBinScalarOperatorFn(int32_t binOperator);
@@ -21,6 +21,7 @@
 #include "filterInt.h"
 #include "functionMgt.h"
 #include "sclInt.h"
+#include "sclvector.h"
 #include "tcompare.h"
 #include "tdatablock.h"
 #include "tsimplehash.h"
@@ -3151,6 +3152,195 @@ static FORCE_INLINE bool filterExecuteImplNotNull(void *pinfo, int32_t numOfRows
   return all;
 }
 
+static bool filterDoUnitCompare(SFilterComUnit *cunit, int32_t i) {
+  void *colData = NULL;
+  bool  isNull = colDataIsNull((SColumnInfoData *)(cunit->colData), 0, i, NULL);
+  bool  res = false;
+
+  uint8_t optr = cunit->optr;
+
+  if (!isNull) {
+    colData = colDataGetData((SColumnInfoData *)(cunit->colData), i);
+  }
+
+  if (colData == NULL || isNull) {
+    return optr == OP_TYPE_IS_NULL ? true : false;
+  }
+
+  if (optr == OP_TYPE_IS_NOT_NULL) {
+    res = true;
+  } else if (optr == OP_TYPE_IS_NULL) {
+    res = false;
+  } else if (cunit->rfunc >= 0) {
+    res = (*gRangeCompare[cunit->rfunc])(colData, colData, cunit->valData, cunit->valData2, gDataCompare[cunit->func]);
+  } else {
+    if (cunit->dataType == TSDB_DATA_TYPE_NCHAR && (cunit->optr == OP_TYPE_MATCH || cunit->optr == OP_TYPE_NMATCH)) {
+      char   *newColData = taosMemoryCalloc(cunit->dataSize * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE, 1);
+      int32_t len = taosUcs4ToMbs((TdUcs4 *)varDataVal(colData), varDataLen(colData), varDataVal(newColData));
+      if (len < 0) {
+        qError("castConvert1 taosUcs4ToMbs error");
+      } else {
+        varDataSetLen(newColData, len);
+        res = filterDoCompare(gDataCompare[cunit->func], cunit->optr, newColData, cunit->valData);
+      }
+      taosMemoryFreeClear(newColData);
+    } else {
+      res = filterDoCompare(gDataCompare[cunit->func], cunit->optr, colData, cunit->valData);
+    }
+  }
+
+  return res;
+}
+
+static bool filterExecuteImplRowWise(SFilterInfo *info, int32_t numOfRows, int8_t *p, int32_t *numOfQualified) {
+  bool all = true;
+
+  for (int32_t i = 0; i < numOfRows; ++i) {
+    p[i] = 0;
+
+    for (uint32_t g = 0; g < info->groupNum; ++g) {
+      SFilterGroup *group = &info->groups[g];
+      for (uint32_t u = 0; u < group->unitNum; ++u) {
+        p[i] = filterDoUnitCompare(&info->cunits[group->unitIdxs[u]], i);
+        if (p[i] == 0) {
+          break;
+        }
+      }
+
+      if (p[i]) {
+        break;
+      }
+    }
+
+    if (p[i] == 0) {
+      all = false;
+    } else {
+      (*numOfQualified) += 1;
+    }
+  }
+
+  return all;
+}
+
+static FORCE_INLINE bool filterUnitIsFixedCol(const SFilterComUnit *cunit) {
+  const SColumnInfoData *pCol = (const SColumnInfoData *)cunit->colData;
+  return !IS_VAR_DATA_TYPE(pCol->info.type) && pCol->info.type == cunit->dataType;
+}
+
+// Keep the rows of pSel that satisfy the unit. Numeric compares go through the selection bitmap kernels of
+// sclvector.c, the other operators are evaluated row by row, but only for the rows still selected.
+static void filterExecuteUnitSel(SFilterInfo *info, uint32_t uidx, int32_t numOfRows, uint64_t *pSel, uint64_t *pTmp) {
+  SFilterComUnit  *cunit = &info->cunits[uidx];
+  SColumnInfoData *pCol = (SColumnInfoData *)cunit->colData;
+  int32_t          words = VECTOR_SEL_WORDS(numOfRows);
+
+  if (filterUnitIsFixedCol(cunit)) {
+    if (cunit->optr == OP_TYPE_IS_NOT_NULL) {
+      vectorSelClearNull(pSel, pCol, 0, numOfRows);
+      return;
+    }
+
+    if (cunit->optr == OP_TYPE_IS_NULL) {
+      memset(pTmp, 0xFF, words * sizeof(uint64_t));
+      vectorSelClearNull(pTmp, pCol, 0, numOfRows);
+      for (int32_t w = 0; w < words; ++w) {
+        pSel[w] &= ~pTmp[w];
+      }
+      return;
+    }
+
+    uint8_t       optr2 = info->units[uidx].compare.optr2;
+    _vec_cmp_fn_t fn = getVectorCompareFn(cunit->dataType, cunit->optr, true);
+    _vec_cmp_fn_t fn2 = (cunit->rfunc >= 0 && optr2) ? getVectorCompareFn(cunit->dataType, optr2, true) : NULL;
+
+    if (fn != NULL && (optr2 == 0 || cunit->rfunc < 0 || fn2 != NULL)) {
+      fn(pCol->pData, cunit->valData, numOfRows, pTmp);
+      for (int32_t w = 0; w < words; ++w) {
+        pSel[w] &= pTmp[w];
+      }
+
+      if (fn2 != NULL) {
+        fn2(pCol->pData, cunit->valData2, numOfRows, pTmp);
+        for (int32_t w = 0; w < words; ++w) {
+          pSel[w] &= pTmp[w];
+        }
+      }
+
+      vectorSelClearNull(pSel, pCol, 0, numOfRows);
+      return;
+    }
+  }
+
+  for (int32_t w = 0; w < words; ++w) {
+    uint64_t bits = pSel[w];
+    while (bits != 0) {
+      int32_t k = __builtin_ctzll(bits);
+      bits &= bits - 1;
+      if (!filterDoUnitCompare(cunit, (w << 6) + k)) {
+        pSel[w] &= ~(1ull << k);
+      }
+    }
+  }
+}
+
+static FORCE_INLINE bool filterSelIsEmpty(const uint64_t *pSel, int32_t words) {
+  for (int32_t w = 0; w < words; ++w) {
+    if (pSel[w] != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Each group is the AND of its units and the result is the OR of the groups, both are done on selection bitmaps
+// a word at a time, a group only evaluates the rows that no earlier group has selected yet.
+static bool filterExecuteSel(SFilterInfo *info, int32_t numOfRows, int8_t *p, int32_t *numOfQualified) {
+  if (numOfRows <= 0) {
+    return true;
+  }
+
+  int32_t   words = VECTOR_SEL_WORDS(numOfRows);
+  uint64_t *pSel = taosMemoryCalloc(words * 3, sizeof(uint64_t));
+  if (pSel == NULL) {
+    return filterExecuteImplRowWise(info, numOfRows, p, numOfQualified);
+  }
+
+  uint64_t *pGroupSel = pSel + words;
+  uint64_t *pTmp = pGroupSel + words;
+  uint64_t  tailMask = (numOfRows & 63) ? ((1ull << (numOfRows & 63)) - 1) : UINT64_MAX;
+
+  for (uint32_t g = 0; g < info->groupNum; ++g) {
+    SFilterGroup *group = &info->groups[g];
+
+    for (int32_t w = 0; w < words; ++w) {
+      pGroupSel[w] = ~pSel[w];
+    }
+    pGroupSel[words - 1] &= tailMask;
+
+    if (filterSelIsEmpty(pGroupSel, words)) {
+      break;
+    }
+
+    for (uint32_t u = 0; u < group->unitNum; ++u) {
+      filterExecuteUnitSel(info, group->unitIdxs[u], numOfRows, pGroupSel, pTmp);
+      if (filterSelIsEmpty(pGroupSel, words)) {
+        break;
+      }
+    }
+
+    for (int32_t w = 0; w < words; ++w) {
+      pSel[w] |= pGroupSel[w];
+    }
+  }
+
+  int32_t num = vectorSelToBool(pSel, numOfRows, (bool *)p);
+  taosMemoryFree(pSel);
+
+  (*numOfQualified) += num;
+  return num == numOfRows;
+}
+
 bool filterExecuteImplRange(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SColumnDataAgg *statis,
                             int16_t numOfCols, int32_t *numOfQualified) {
   SFilterInfo  *info = (SFilterInfo *)pinfo;
@@ -3165,6 +3355,10 @@ bool filterExecuteImplRange(void *pinfo, int32_t numOfRows, SColumnInfoData *pRe
     return all;
   }
 
+  if (filterUnitIsFixedCol(&info->cunits[0])) {
+    return filterExecuteSel(info, numOfRows, (int8_t *)pRes->pData, numOfQualified);
+  }
+
   int8_t *p = (int8_t *)pRes->pData;
 
   for (int32_t i = 0; i < numOfRows; ++i) {
@@ -3246,76 +3440,7 @@ bool filterExecuteImpl(void *pinfo, int32_t numOfRows, SColumnInfoData *pRes, SC
     return all;
   }
 
-  int8_t *p = (int8_t *)pRes->pData;
-
-  for (int32_t i = 0; i < numOfRows; ++i) {
-    // FILTER_UNIT_CLR_F(info);
-
-    for (uint32_t g = 0; g < info->groupNum; ++g) {
-      SFilterGroup *group = &info->groups[g];
-      for (uint32_t u = 0; u < group->unitNum; ++u) {
-        uint32_t        uidx = group->unitIdxs[u];
-        SFilterComUnit *cunit = &info->cunits[uidx];
-        void           *colData = NULL;
-        bool            isNull = colDataIsNull((SColumnInfoData *)(cunit->colData), 0, i, NULL);
-        // if (FILTER_UNIT_GET_F(info, uidx)) {
-        //   p[i] = FILTER_UNIT_GET_R(info, uidx);
-        // } else {
-        uint8_t optr = cunit->optr;
-
-        if (!isNull) {
-          colData = colDataGetData((SColumnInfoData *)(cunit->colData), i);
-        }
-
-        if (colData == NULL || isNull) {
-          p[i] = optr == OP_TYPE_IS_NULL ? true : false;
-        } else {
-          if (optr == OP_TYPE_IS_NOT_NULL) {
-            p[i] = 1;
-          } else if (optr == OP_TYPE_IS_NULL) {
-            p[i] = 0;
-          } else if (cunit->rfunc >= 0) {
-            p[i] = (*gRangeCompare[cunit->rfunc])(colData, colData, cunit->valData, cunit->valData2,
-                                                  gDataCompare[cunit->func]);
-          } else {
-            if (cunit->dataType == TSDB_DATA_TYPE_NCHAR &&
-                (cunit->optr == OP_TYPE_MATCH || cunit->optr == OP_TYPE_NMATCH)) {
-              char   *newColData = taosMemoryCalloc(cunit->dataSize * TSDB_NCHAR_SIZE + VARSTR_HEADER_SIZE, 1);
-              int32_t len = taosUcs4ToMbs((TdUcs4 *)varDataVal(colData), varDataLen(colData), varDataVal(newColData));
-              if (len < 0) {
-                qError("castConvert1 taosUcs4ToMbs error");
-              } else {
-                varDataSetLen(newColData, len);
-                p[i] = filterDoCompare(gDataCompare[cunit->func], cunit->optr, newColData, cunit->valData);
-              }
-              taosMemoryFreeClear(newColData);
-            } else {
-              p[i] = filterDoCompare(gDataCompare[cunit->func], cunit->optr, colData, cunit->valData);
-            }
-          }
-
-          // FILTER_UNIT_SET_R(info, uidx, p[i]);
-          // FILTER_UNIT_SET_F(info, uidx);
-        }
-
-        if (p[i] == 0) {
-          break;
-        }
-      }
-
-      if (p[i]) {
-        break;
-      }
-    }
-
-    if (p[i] == 0) {
-      all = false;
-    } else {
-      (*numOfQualified) += 1;
-    }
-  }
-
-  return all;
+  return filterExecuteSel(info, numOfRows, (int8_t *)pRes->pData, numOfQualified);
 }
 
 int32_t filterSetExecFunc(SFilterInfo *info) {
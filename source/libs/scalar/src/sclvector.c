@@ -1145,6 +1145,277 @@ static void doReleaseVec(SColumnInfoData *pCol, int32_t type) {
   }
 }
 
+// Type-specialized arithmetic kernels. The generic loops above convert every row to double through a function
+// pointer and test the null bitmap row by row, the kernels below are chosen once per column pair and run over the
+// raw column data, the nulls are merged afterwards one bitmap word at a time.
+typedef void (*_vec_arith_fn_t)(const void *pLeft, const void *pRight, double *pOut, int32_t numOfRows);
+typedef void (*_vec_arith_scalar_fn_t)(const void *pVec, double v, double *pOut, int32_t numOfRows);
+
+enum {
+  VECTOR_ARITH_ADD = 0,
+  VECTOR_ARITH_SUB,
+  VECTOR_ARITH_RSUB,  // scalar minus vector, only used by the vector/scalar kernels
+  VECTOR_ARITH_MUL,
+  VECTOR_ARITH_MAX,
+};
+
+#define VEC_OP_ADD(_l, _r)  ((_l) + (_r))
+#define VEC_OP_SUB(_l, _r)  ((_l) - (_r))
+#define VEC_OP_RSUB(_l, _r) ((_r) - (_l))
+#define VEC_OP_MUL(_l, _r)  ((_l) * (_r))
+
+#if __AVX__
+// load four values of the given type and widen them to four doubles
+#define VEC_LOAD4_PD_INT(_p)    _mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)(_p)))
+#define VEC_LOAD4_PD_BIGINT(_p) _mm256_set_pd((double)(_p)[3], (double)(_p)[2], (double)(_p)[1], (double)(_p)[0])
+#define VEC_LOAD4_PD_FLOAT(_p)  _mm256_cvtps_pd(_mm_loadu_ps((const float *)(_p)))
+#define VEC_LOAD4_PD_DOUBLE(_p) _mm256_loadu_pd((const double *)(_p))
+
+#define VEC_OP_PD_ADD(_l, _r)  _mm256_add_pd((_l), (_r))
+#define VEC_OP_PD_SUB(_l, _r)  _mm256_sub_pd((_l), (_r))
+#define VEC_OP_PD_RSUB(_l, _r) _mm256_sub_pd((_r), (_l))
+#define VEC_OP_PD_MUL(_l, _r)  _mm256_mul_pd((_l), (_r))
+
+#define VEC_ARITH_AVX_VV(_ln, _rn, _opn, l, r, pOut, numOfRows, i)                \
+  if (tsAVXEnable && tsSIMDBuiltins) {                                             \
+    for (; (i) + 4 <= (numOfRows); (i) += 4) {                                     \
+      __m256d a = VEC_LOAD4_PD_##_ln((l) + (i));                                   \
+      __m256d b = VEC_LOAD4_PD_##_rn((r) + (i));                                   \
+      _mm256_storeu_pd((pOut) + (i), VEC_OP_PD_##_opn(a, b));                      \
+    }                                                                              \
+  }
+
+#define VEC_ARITH_AVX_VS(_ln, _opn, l, v, pOut, numOfRows, i)                     \
+  if (tsAVXEnable && tsSIMDBuiltins) {                                             \
+    __m256d b = _mm256_set1_pd(v);                                                 \
+    for (; (i) + 4 <= (numOfRows); (i) += 4) {                                     \
+      __m256d a = VEC_LOAD4_PD_##_ln((l) + (i));                                   \
+      _mm256_storeu_pd((pOut) + (i), VEC_OP_PD_##_opn(a, b));                      \
+    }                                                                              \
+  }
+#else
+#define VEC_ARITH_AVX_VV(_ln, _rn, _opn, l, r, pOut, numOfRows, i)
+#define VEC_ARITH_AVX_VS(_ln, _opn, l, v, pOut, numOfRows, i)
+#endif
+
+#define DEFINE_VEC_ARITH_VV(_opn, _ln, _lt, _rn, _rt)                                                      \
+  static void vectorArith##_opn##_##_ln##_##_rn(const void *pLeft, const void *pRight, double *pOut,       \
+                                                 int32_t numOfRows) {                                       \
+    const _lt *l = (const _lt *)pLeft;                                                                     \
+    const _rt *r = (const _rt *)pRight;                                                                    \
+    int32_t    i = 0;                                                                                      \
+    VEC_ARITH_AVX_VV(_ln, _rn, _opn, l, r, pOut, numOfRows, i)                                             \
+    for (; i < numOfRows; ++i) {                                                                           \
+      pOut[i] = VEC_OP_##_opn((double)l[i], (double)r[i]);                                                 \
+    }                                                                                                      \
+  }
+
+#define DEFINE_VEC_ARITH_VS(_opn, _ln, _lt)                                                                     \
+  static void vectorArithScalar##_opn##_##_ln(const void *pVec, double v, double *pOut, int32_t numOfRows) {    \
+    const _lt *l = (const _lt *)pVec;                                                                           \
+    int32_t    i = 0;                                                                                           \
+    VEC_ARITH_AVX_VS(_ln, _opn, l, v, pOut, numOfRows, i)                                                       \
+    for (; i < numOfRows; ++i) {                                                                                \
+      pOut[i] = VEC_OP_##_opn((double)l[i], v);                                                                 \
+    }                                                                                                           \
+  }
+
+#define DEFINE_VEC_ARITH_VV_LEFT(_opn, _ln, _lt)      \
+  DEFINE_VEC_ARITH_VV(_opn, _ln, _lt, INT, int32_t)   \
+  DEFINE_VEC_ARITH_VV(_opn, _ln, _lt, BIGINT, int64_t) \
+  DEFINE_VEC_ARITH_VV(_opn, _ln, _lt, FLOAT, float)   \
+  DEFINE_VEC_ARITH_VV(_opn, _ln, _lt, DOUBLE, double)
+
+#define DEFINE_VEC_ARITH_OP(_opn)                      \
+  DEFINE_VEC_ARITH_VV_LEFT(_opn, INT, int32_t)         \
+  DEFINE_VEC_ARITH_VV_LEFT(_opn, BIGINT, int64_t)      \
+  DEFINE_VEC_ARITH_VV_LEFT(_opn, FLOAT, float)         \
+  DEFINE_VEC_ARITH_VV_LEFT(_opn, DOUBLE, double)       \
+  DEFINE_VEC_ARITH_VS(_opn, INT, int32_t)              \
+  DEFINE_VEC_ARITH_VS(_opn, BIGINT, int64_t)           \
+  DEFINE_VEC_ARITH_VS(_opn, FLOAT, float)              \
+  DEFINE_VEC_ARITH_VS(_opn, DOUBLE, double)
+
+DEFINE_VEC_ARITH_OP(ADD)
+DEFINE_VEC_ARITH_OP(SUB)
+DEFINE_VEC_ARITH_OP(RSUB)
+DEFINE_VEC_ARITH_OP(MUL)
+
+#define VEC_ARITH_VV_ROW(_opn, _ln)                                                              \
+  {                                                                                              \
+    vectorArith##_opn##_##_ln##_INT, vectorArith##_opn##_##_ln##_BIGINT,                         \
+        vectorArith##_opn##_##_ln##_FLOAT, vectorArith##_opn##_##_ln##_DOUBLE                    \
+  }
+
+#define VEC_ARITH_VV_TABLE(_opn)                                                                                \
+  {                                                                                                             \
+    VEC_ARITH_VV_ROW(_opn, INT), VEC_ARITH_VV_ROW(_opn, BIGINT), VEC_ARITH_VV_ROW(_opn, FLOAT),                 \
+        VEC_ARITH_VV_ROW(_opn, DOUBLE)                                                                          \
+  }
+
+#define VEC_ARITH_VS_ROW(_opn)                                                                                 \
+  {                                                                                                            \
+    vectorArithScalar##_opn##_INT, vectorArithScalar##_opn##_BIGINT, vectorArithScalar##_opn##_FLOAT,          \
+        vectorArithScalar##_opn##_DOUBLE                                                                       \
+  }
+
+static _vec_arith_fn_t vectorArithFnTable[VECTOR_ARITH_MAX][4][4] = {
+    VEC_ARITH_VV_TABLE(ADD),
+    VEC_ARITH_VV_TABLE(SUB),
+    VEC_ARITH_VV_TABLE(RSUB),
+    VEC_ARITH_VV_TABLE(MUL),
+};
+
+static _vec_arith_scalar_fn_t vectorArithScalarFnTable[VECTOR_ARITH_MAX][4] = {
+    VEC_ARITH_VS_ROW(ADD),
+    VEC_ARITH_VS_ROW(SUB),
+    VEC_ARITH_VS_ROW(RSUB),
+    VEC_ARITH_VS_ROW(MUL),
+};
+
+static int32_t vectorArithTypeIndex(int32_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_INT:
+      return 0;
+    case TSDB_DATA_TYPE_BIGINT:
+      return 1;
+    case TSDB_DATA_TYPE_FLOAT:
+      return 2;
+    case TSDB_DATA_TYPE_DOUBLE:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+static _vec_arith_fn_t getVectorArithFn(int32_t op, int32_t leftType, int32_t rightType) {
+  int32_t l = vectorArithTypeIndex(leftType);
+  int32_t r = vectorArithTypeIndex(rightType);
+  if (l < 0 || r < 0) {
+    return NULL;
+  }
+
+  return vectorArithFnTable[op][l][r];
+}
+
+static _vec_arith_scalar_fn_t getVectorArithScalarFn(int32_t op, int32_t type) {
+  int32_t l = vectorArithTypeIndex(type);
+  return (l < 0) ? NULL : vectorArithScalarFnTable[op][l];
+}
+
+static FORCE_INLINE bool vectorColHasNullBitmap(const SColumnInfoData *pCol) {
+  return pCol->hasNull && pCol->nullbitmap != NULL;
+}
+
+// Merge the null bitmap of an input column into the output column, eight bytes at a time, and reset the output
+// value of every null row as colDataSetNULL does.
+static void vectorMergeNullBitmap(const SColumnInfoData *pInput, SColumnInfoData *pOutputCol, int32_t numOfRows) {
+  if (!vectorColHasNullBitmap(pInput)) {
+    return;
+  }
+
+  const char *src = pInput->nullbitmap;
+  char       *dst = pOutputCol->nullbitmap;
+  double     *output = (double *)pOutputCol->pData;
+  int32_t     len = BitmapLen(numOfRows);
+  bool        hasNull = false;
+
+  int32_t j = 0;
+  for (; j + (int32_t)sizeof(uint64_t) <= len; j += sizeof(uint64_t)) {
+    uint64_t w = 0;
+    memcpy(&w, src + j, sizeof(uint64_t));
+    if (w == 0) {
+      continue;
+    }
+
+    uint64_t d = 0;
+    memcpy(&d, dst + j, sizeof(uint64_t));
+    d |= w;
+    memcpy(dst + j, &d, sizeof(uint64_t));
+    hasNull = true;
+
+    int32_t end = TMIN((j + (int32_t)sizeof(uint64_t)) << NBIT, numOfRows);
+    for (int32_t k = j << NBIT; k < end; ++k) {
+      if (colDataIsNull_f(src, k)) {
+        output[k] = 0;
+      }
+    }
+  }
+
+  for (; j < len; ++j) {
+    if (src[j] == 0) {
+      continue;
+    }
+
+    dst[j] |= src[j];
+    hasNull = true;
+
+    int32_t end = TMIN((j + 1) << NBIT, numOfRows);
+    for (int32_t k = j << NBIT; k < end; ++k) {
+      if (colDataIsNull_f(src, k)) {
+        output[k] = 0;
+      }
+    }
+  }
+
+  if (hasNull) {
+    pOutputCol->hasNull = true;
+  }
+}
+
+// Try the type-specialized kernels, return false if the column pair is not covered and the generic per-row loop has
+// to be used instead. The kernels always write rows in ascending order, so the descending scan keeps the old path.
+static bool vectorMathDoKernel(SScalarParam *pLeft, SScalarParam *pRight, SColumnInfoData *pLeftCol,
+                               SColumnInfoData *pRightCol, SColumnInfoData *pOutputCol, int32_t op, int32_t _ord) {
+  if (_ord != TSDB_ORDER_ASC || pOutputCol->info.type != TSDB_DATA_TYPE_DOUBLE) {
+    return false;
+  }
+
+  double *output = (double *)pOutputCol->pData;
+
+  if (pLeft->numOfRows == pRight->numOfRows) {
+    _vec_arith_fn_t fn = getVectorArithFn(op, pLeftCol->info.type, pRightCol->info.type);
+    if (fn == NULL) {
+      return false;
+    }
+
+    fn(pLeftCol->pData, pRightCol->pData, output, pLeft->numOfRows);
+    vectorMergeNullBitmap(pLeftCol, pOutputCol, pLeft->numOfRows);
+    vectorMergeNullBitmap(pRightCol, pOutputCol, pLeft->numOfRows);
+    return true;
+  }
+
+  SColumnInfoData *pVecCol = NULL, *pScalarCol = NULL;
+  int32_t          numOfRows = 0;
+  if (pLeft->numOfRows == 1) {
+    pVecCol = pRightCol;
+    pScalarCol = pLeftCol;
+    numOfRows = pRight->numOfRows;
+    op = (op == VECTOR_ARITH_SUB) ? VECTOR_ARITH_RSUB : op;
+  } else if (pRight->numOfRows == 1) {
+    pVecCol = pLeftCol;
+    pScalarCol = pRightCol;
+    numOfRows = pLeft->numOfRows;
+  } else {
+    return false;
+  }
+
+  _vec_arith_scalar_fn_t fn = getVectorArithScalarFn(op, pVecCol->info.type);
+  if (fn == NULL || !IS_NUMERIC_TYPE(pScalarCol->info.type)) {
+    return false;
+  }
+
+  if (colDataIsNull_s(pScalarCol, 0)) {
+    colDataSetNNULL(pOutputCol, 0, numOfRows);
+    return true;
+  }
+
+  double v = getVectorDoubleValueFn(pScalarCol->info.type)(pScalarCol->pData, 0);
+  fn(pVecCol->pData, v, output, numOfRows);
+  vectorMergeNullBitmap(pVecCol, pOutputCol, numOfRows);
+  return true;
+}
+
 void vectorMathAdd(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut, int32_t _ord) {
   SColumnInfoData *pOutputCol = pOut->columnData;
 
@@ -1185,7 +1456,7 @@ void vectorMathAdd(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
         *output = getVectorBigintValueFnLeft(pLeftCol->pData, i) + getVectorBigintValueFnRight(pRightCol->pData, i);
       }
     }
-  } else {
+  } else if (!vectorMathDoKernel(pLeft, pRight, pLeftCol, pRightCol, pOutputCol, VECTOR_ARITH_ADD, _ord)) {
     double              *output = (double *)pOutputCol->pData;
     _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
     _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
@@ -1286,7 +1557,7 @@ void vectorMathSub(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut
         *output = getVectorBigintValueFnLeft(pLeftCol->pData, i) - getVectorBigintValueFnRight(pRightCol->pData, i);
       }
     }
-  } else {
+  } else if (!vectorMathDoKernel(pLeft, pRight, pLeftCol, pRightCol, pOutputCol, VECTOR_ARITH_SUB, _ord)) {
     double              *output = (double *)pOutputCol->pData;
     _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
     _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
@@ -1342,6 +1613,12 @@ void vectorMathMultiply(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam
   SColumnInfoData *pLeftCol = vectorConvertVarToDouble(pLeft, &leftConvert);
   SColumnInfoData *pRightCol = vectorConvertVarToDouble(pRight, &rightConvert);
 
+  if (vectorMathDoKernel(pLeft, pRight, pLeftCol, pRightCol, pOutputCol, VECTOR_ARITH_MUL, _ord)) {
+    doReleaseVec(pLeftCol, leftConvert);
+    doReleaseVec(pRightCol, rightConvert);
+    return;
+  }
+
   _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
   _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
 
@@ -1646,12 +1923,366 @@ void vectorBitOr(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut,
   doReleaseVec(pRightCol, rightConvert);
 }
 
+// Type and operator specialized compare kernels. Each kernel compares a column with a constant or with another
+// column of the same type and writes a packed selection bitmap, bit (i & 63) of word (i >> 6) is set when row i
+// qualifies. Null rows are not taken into account by the kernels, see vectorSelClearNull.
+static FORCE_INLINE int32_t vectorCmpFloat(float p1, float p2) {
+  if (isnan(p1) || isnan(p2)) {
+    return (isnan(p1) && isnan(p2)) ? 0 : (isnan(p1) ? -1 : 1);
+  }
+  if (FLT_EQUAL(p1, p2)) {
+    return 0;
+  }
+  return (p1 > p2) ? 1 : -1;
+}
+
+static FORCE_INLINE int32_t vectorCmpDouble(double p1, double p2) {
+  if (isnan(p1) || isnan(p2)) {
+    return (isnan(p1) && isnan(p2)) ? 0 : (isnan(p1) ? -1 : 1);
+  }
+  if (FLT_EQUAL(p1, p2)) {
+    return 0;
+  }
+  return (p1 > p2) ? 1 : -1;
+}
+
+#define VEC_CMP_INT(_l, _r)    (((_l) > (_r)) - ((_l) < (_r)))
+#define VEC_CMP_FLOAT(_l, _r)  vectorCmpFloat((_l), (_r))
+#define VEC_CMP_DOUBLE(_l, _r) vectorCmpDouble((_l), (_r))
+
+#define VEC_CMP_RES_GT(_c) ((_c) > 0)
+#define VEC_CMP_RES_GE(_c) ((_c) >= 0)
+#define VEC_CMP_RES_LT(_c) ((_c) < 0)
+#define VEC_CMP_RES_LE(_c) ((_c) <= 0)
+#define VEC_CMP_RES_EQ(_c) ((_c) == 0)
+#define VEC_CMP_RES_NE(_c) ((_c) != 0)
+
+#if __AVX2__
+#define VEC_MASK_EPI32(_m) ((uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(_m)))
+#define VEC_MASK_EPI64(_m) ((uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(_m)))
+
+#define VEC_LOAD_INT(_p)    _mm256_loadu_si256((const __m256i *)(_p))
+#define VEC_SET1_INT(_v)    _mm256_set1_epi32(_v)
+#define VEC_LOAD_BIGINT(_p) _mm256_loadu_si256((const __m256i *)(_p))
+#define VEC_SET1_BIGINT(_v) _mm256_set1_epi64x(_v)
+#define VEC_LOAD_FLOAT(_p)  _mm256_loadu_ps((const float *)(_p))
+#define VEC_SET1_FLOAT(_v)  _mm256_set1_ps(_v)
+#define VEC_LOAD_DOUBLE(_p) _mm256_loadu_pd((const double *)(_p))
+#define VEC_SET1_DOUBLE(_v) _mm256_set1_pd(_v)
+
+#define VEC_LANES_INT    8
+#define VEC_LANES_BIGINT 4
+#define VEC_LANES_FLOAT  8
+#define VEC_LANES_DOUBLE 4
+
+#define VEC_FULL(_tn) ((1u << VEC_LANES_##_tn) - 1)
+
+static FORCE_INLINE uint32_t vectorGtLanesINT(__m256i a, __m256i b) { return VEC_MASK_EPI32(_mm256_cmpgt_epi32(a, b)); }
+static FORCE_INLINE uint32_t vectorEqLanesINT(__m256i a, __m256i b) { return VEC_MASK_EPI32(_mm256_cmpeq_epi32(a, b)); }
+static FORCE_INLINE uint32_t vectorGtLanesBIGINT(__m256i a, __m256i b) {
+  return VEC_MASK_EPI64(_mm256_cmpgt_epi64(a, b));
+}
+static FORCE_INLINE uint32_t vectorEqLanesBIGINT(__m256i a, __m256i b) {
+  return VEC_MASK_EPI64(_mm256_cmpeq_epi64(a, b));
+}
+
+// same semantics as compareFloatVal/compareDoubleVal: values closer than FLT_EQUAL tolerance are equal, two nan are
+// equal and nan is lower than any other value
+#define DEFINE_VEC_LANES_FP(_tn, _ps, _pd)                                                                      \
+  static FORCE_INLINE uint32_t vectorEqLanes##_tn(__m256##_pd a, __m256##_pd b) {                               \
+    __m256##_pd tol = _mm256_set1_##_ps(FLT_COMPAR_TOL_FACTOR * FLT_EPSILON);                                   \
+    __m256##_pd abs = _mm256_andnot_##_ps(_mm256_set1_##_ps(-0.0), _mm256_sub_##_ps(a, b));                      \
+    uint32_t    nanA = (uint32_t)_mm256_movemask_##_ps(_mm256_cmp_##_ps(a, a, _CMP_UNORD_Q));                   \
+    uint32_t    nanB = (uint32_t)_mm256_movemask_##_ps(_mm256_cmp_##_ps(b, b, _CMP_UNORD_Q));                   \
+    return (uint32_t)_mm256_movemask_##_ps(_mm256_cmp_##_ps(abs, tol, _CMP_LE_OQ)) | (nanA & nanB);            \
+  }                                                                                                             \
+  static FORCE_INLINE uint32_t vectorGtLanes##_tn(__m256##_pd a, __m256##_pd b) {                               \
+    uint32_t nanA = (uint32_t)_mm256_movemask_##_ps(_mm256_cmp_##_ps(a, a, _CMP_UNORD_Q));                      \
+    uint32_t nanB = (uint32_t)_mm256_movemask_##_ps(_mm256_cmp_##_ps(b, b, _CMP_UNORD_Q));                      \
+    return ((uint32_t)_mm256_movemask_##_ps(_mm256_cmp_##_ps(a, b, _CMP_GT_OQ)) & ~vectorEqLanes##_tn(a, b)) | \
+           (nanB & ~nanA);                                                                                      \
+  }
+
+DEFINE_VEC_LANES_FP(FLOAT, ps, )
+DEFINE_VEC_LANES_FP(DOUBLE, pd, d)
+
+// lane mask of the operator, each operator only computes the compare it needs, a < b is b > a and the inclusive or
+// negated operators flip the lanes of their counterpart
+#define VEC_SEL_GT(_tn, _a, _b) vectorGtLanes##_tn((_a), (_b))
+#define VEC_SEL_GE(_tn, _a, _b) (vectorGtLanes##_tn((_b), (_a)) ^ VEC_FULL(_tn))
+#define VEC_SEL_LT(_tn, _a, _b) vectorGtLanes##_tn((_b), (_a))
+#define VEC_SEL_LE(_tn, _a, _b) (vectorGtLanes##_tn((_a), (_b)) ^ VEC_FULL(_tn))
+#define VEC_SEL_EQ(_tn, _a, _b) vectorEqLanes##_tn((_a), (_b))
+#define VEC_SEL_NE(_tn, _a, _b) (vectorEqLanes##_tn((_a), (_b)) ^ VEC_FULL(_tn))
+
+#define VEC_CMP_AVX2(_tn, _opn, l, r, _ridx, base, n, k, bits)                                          \
+  if (tsAVX2Enable && tsSIMDBuiltins) {                                                                 \
+    for (; (k) + VEC_LANES_##_tn <= (n); (k) += VEC_LANES_##_tn) {                                      \
+      (bits) |= ((uint64_t)VEC_SEL_##_opn(_tn, VEC_LOAD_##_tn((l) + (base) + (k)),                      \
+                                          ((_ridx) ? VEC_LOAD_##_tn((r) + (base) + (k)) : VEC_SET1_##_tn(*(r))))) \
+                << (k);                                                                                 \
+    }                                                                                                   \
+  }
+
+#define VEC_CMP_AVX2_INT(_opn, l, r, _ridx, base, n, k, bits)    VEC_CMP_AVX2(INT, _opn, l, r, _ridx, base, n, k, bits)
+#define VEC_CMP_AVX2_BIGINT(_opn, l, r, _ridx, base, n, k, bits) VEC_CMP_AVX2(BIGINT, _opn, l, r, _ridx, base, n, k, bits)
+#define VEC_CMP_AVX2_FLOAT(_opn, l, r, _ridx, base, n, k, bits)  VEC_CMP_AVX2(FLOAT, _opn, l, r, _ridx, base, n, k, bits)
+#define VEC_CMP_AVX2_DOUBLE(_opn, l, r, _ridx, base, n, k, bits) VEC_CMP_AVX2(DOUBLE, _opn, l, r, _ridx, base, n, k, bits)
+#else
+#define VEC_CMP_AVX2_INT(_opn, l, r, _ridx, base, n, k, bits)
+#define VEC_CMP_AVX2_BIGINT(_opn, l, r, _ridx, base, n, k, bits)
+#define VEC_CMP_AVX2_FLOAT(_opn, l, r, _ridx, base, n, k, bits)
+#define VEC_CMP_AVX2_DOUBLE(_opn, l, r, _ridx, base, n, k, bits)
+#endif
+#define VEC_CMP_AVX2_NONE(_opn, l, r, _ridx, base, n, k, bits)
+
+#define DEFINE_VEC_CMP(_opn, _tn, _t, _cmp, _simd, _suffix, _ridx)                                                \
+  static void vectorCmp##_opn##_##_tn##_suffix(const void *pLeft, const void *pRight, int32_t numOfRows,         \
+                                               uint64_t *pSel) {                                                 \
+    const _t *l = (const _t *)pLeft;                                                                             \
+    const _t *r = (const _t *)pRight;                                                                            \
+    for (int32_t base = 0; base < numOfRows; base += 64) {                                                       \
+      int32_t  n = TMIN(64, numOfRows - base);                                                                   \
+      int32_t  k = 0;                                                                                            \
+      uint64_t bits = 0;                                                                                         \
+      VEC_CMP_AVX2_##_simd(_opn, l, r, _ridx, base, n, k, bits) for (; k < n; ++k) {                             \
+        bits |= ((uint64_t)VEC_CMP_RES_##_opn(_cmp(l[base + k], r[(_ridx) ? (base + k) : 0]))) << k;             \
+      }                                                                                                          \
+      pSel[base >> 6] = bits;                                                                                    \
+    }                                                                                                            \
+  }
+
+#define DEFINE_VEC_CMP_TYPE(_tn, _t, _cmp, _simd)    \
+  DEFINE_VEC_CMP(GT, _tn, _t, _cmp, _simd, _S, 0)    \
+  DEFINE_VEC_CMP(GE, _tn, _t, _cmp, _simd, _S, 0)    \
+  DEFINE_VEC_CMP(LT, _tn, _t, _cmp, _simd, _S, 0)    \
+  DEFINE_VEC_CMP(LE, _tn, _t, _cmp, _simd, _S, 0)    \
+  DEFINE_VEC_CMP(EQ, _tn, _t, _cmp, _simd, _S, 0)    \
+  DEFINE_VEC_CMP(NE, _tn, _t, _cmp, _simd, _S, 0)    \
+  DEFINE_VEC_CMP(GT, _tn, _t, _cmp, _simd, _V, 1)    \
+  DEFINE_VEC_CMP(GE, _tn, _t, _cmp, _simd, _V, 1)    \
+  DEFINE_VEC_CMP(LT, _tn, _t, _cmp, _simd, _V, 1)    \
+  DEFINE_VEC_CMP(LE, _tn, _t, _cmp, _simd, _V, 1)    \
+  DEFINE_VEC_CMP(EQ, _tn, _t, _cmp, _simd, _V, 1)    \
+  DEFINE_VEC_CMP(NE, _tn, _t, _cmp, _simd, _V, 1)
+
+DEFINE_VEC_CMP_TYPE(TINYINT, int8_t, VEC_CMP_INT, NONE)
+DEFINE_VEC_CMP_TYPE(SMALLINT, int16_t, VEC_CMP_INT, NONE)
+DEFINE_VEC_CMP_TYPE(INT, int32_t, VEC_CMP_INT, INT)
+DEFINE_VEC_CMP_TYPE(BIGINT, int64_t, VEC_CMP_INT, BIGINT)
+DEFINE_VEC_CMP_TYPE(UTINYINT, uint8_t, VEC_CMP_INT, NONE)
+DEFINE_VEC_CMP_TYPE(USMALLINT, uint16_t, VEC_CMP_INT, NONE)
+DEFINE_VEC_CMP_TYPE(UINT, uint32_t, VEC_CMP_INT, NONE)
+DEFINE_VEC_CMP_TYPE(UBIGINT, uint64_t, VEC_CMP_INT, NONE)
+DEFINE_VEC_CMP_TYPE(FLOAT, float, VEC_CMP_FLOAT, FLOAT)
+DEFINE_VEC_CMP_TYPE(DOUBLE, double, VEC_CMP_DOUBLE, DOUBLE)
+
+#define VEC_CMP_FN_ROW(_tn, _suffix)                                                                      \
+  {                                                                                                       \
+    vectorCmpGT_##_tn##_suffix, vectorCmpGE_##_tn##_suffix, vectorCmpLT_##_tn##_suffix,                   \
+        vectorCmpLE_##_tn##_suffix, vectorCmpEQ_##_tn##_suffix, vectorCmpNE_##_tn##_suffix                \
+  }
+
+#define VEC_CMP_FN_TABLE(_suffix)                                                                             \
+  {                                                                                                           \
+    VEC_CMP_FN_ROW(TINYINT, _suffix), VEC_CMP_FN_ROW(SMALLINT, _suffix), VEC_CMP_FN_ROW(INT, _suffix),        \
+        VEC_CMP_FN_ROW(BIGINT, _suffix), VEC_CMP_FN_ROW(UTINYINT, _suffix), VEC_CMP_FN_ROW(USMALLINT, _suffix), \
+        VEC_CMP_FN_ROW(UINT, _suffix), VEC_CMP_FN_ROW(UBIGINT, _suffix), VEC_CMP_FN_ROW(FLOAT, _suffix),      \
+        VEC_CMP_FN_ROW(DOUBLE, _suffix)                                                                       \
+  }
+
+static _vec_cmp_fn_t vectorCmpFnTable[2][10][6] = {VEC_CMP_FN_TABLE(_S), VEC_CMP_FN_TABLE(_V)};
+
+static int32_t vectorCmpTypeIndex(int32_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_BOOL:
+    case TSDB_DATA_TYPE_TINYINT:
+      return 0;
+    case TSDB_DATA_TYPE_SMALLINT:
+      return 1;
+    case TSDB_DATA_TYPE_INT:
+      return 2;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+      return 3;
+    case TSDB_DATA_TYPE_UTINYINT:
+      return 4;
+    case TSDB_DATA_TYPE_USMALLINT:
+      return 5;
+    case TSDB_DATA_TYPE_UINT:
+      return 6;
+    case TSDB_DATA_TYPE_UBIGINT:
+      return 7;
+    case TSDB_DATA_TYPE_FLOAT:
+      return 8;
+    case TSDB_DATA_TYPE_DOUBLE:
+      return 9;
+    default:
+      return -1;
+  }
+}
+
+static int32_t vectorCmpOptrIndex(int32_t optr) {
+  switch (optr) {
+    case OP_TYPE_GREATER_THAN:
+      return 0;
+    case OP_TYPE_GREATER_EQUAL:
+      return 1;
+    case OP_TYPE_LOWER_THAN:
+      return 2;
+    case OP_TYPE_LOWER_EQUAL:
+      return 3;
+    case OP_TYPE_EQUAL:
+      return 4;
+    case OP_TYPE_NOT_EQUAL:
+      return 5;
+    default:
+      return -1;
+  }
+}
+
+_vec_cmp_fn_t getVectorCompareFn(int32_t type, int32_t optr, bool rightIsScalar) {
+  int32_t t = vectorCmpTypeIndex(type);
+  int32_t o = vectorCmpOptrIndex(optr);
+  if (t < 0 || o < 0) {
+    return NULL;
+  }
+
+  return vectorCmpFnTable[rightIsScalar ? 0 : 1][t][o];
+}
+
+int32_t vectorReverseCompareOptr(int32_t optr) {
+  switch (optr) {
+    case OP_TYPE_GREATER_THAN:
+      return OP_TYPE_LOWER_THAN;
+    case OP_TYPE_GREATER_EQUAL:
+      return OP_TYPE_LOWER_EQUAL;
+    case OP_TYPE_LOWER_THAN:
+      return OP_TYPE_GREATER_THAN;
+    case OP_TYPE_LOWER_EQUAL:
+      return OP_TYPE_GREATER_EQUAL;
+    default:
+      return optr;
+  }
+}
+
+#define R2(n) n, n + 2 * 64, n + 1 * 64, n + 3 * 64
+#define R4(n) R2(n), R2(n + 2 * 16), R2(n + 1 * 16), R2(n + 3 * 16)
+#define R6(n) R4(n), R4(n + 2 * 4), R4(n + 1 * 4), R4(n + 3 * 4)
+// the null bitmap keeps the first row in the highest bit of each byte, the selection bitmap in the lowest one
+static const uint8_t vectorBitReverseTable[256] = {R6(0), R6(2), R6(1), R6(3)};
+#undef R2
+#undef R4
+#undef R6
+
+void vectorSelClearNull(uint64_t *pSel, const SColumnInfoData *pCol, int32_t startIndex, int32_t numOfRows) {
+  if (!pCol->hasNull || pCol->nullbitmap == NULL) {
+    return;
+  }
+
+  if ((startIndex & 0x7) != 0) {
+    for (int32_t i = 0; i < numOfRows; ++i) {
+      if (colDataIsNull_f(pCol->nullbitmap, startIndex + i)) {
+        pSel[i >> 6] &= ~(1ull << (i & 63));
+      }
+    }
+    return;
+  }
+
+  const uint8_t *bm = (const uint8_t *)pCol->nullbitmap + (startIndex >> NBIT);
+  int32_t        len = BitmapLen(numOfRows);
+  for (int32_t j = 0; j < len; ++j) {
+    if (bm[j] != 0) {
+      pSel[j >> 3] &= ~(((uint64_t)vectorBitReverseTable[bm[j]]) << ((j & 0x7) << 3));
+    }
+  }
+}
+
+int32_t vectorSelToBool(const uint64_t *pSel, int32_t numOfRows, bool *pRes) {
+  int32_t num = 0;
+  for (int32_t base = 0; base < numOfRows; base += 64) {
+    uint64_t w = pSel[base >> 6];
+    int32_t  n = TMIN(64, numOfRows - base);
+    if (n < 64) {
+      w &= (1ull << n) - 1;
+    }
+
+    num += __builtin_popcountll(w);
+    for (int32_t k = 0; k < n; ++k) {
+      pRes[base + k] = (w >> k) & 0x1;
+    }
+  }
+
+  return num;
+}
+
+// Compare two numeric columns of the same type with the kernels above, return -1 if they do not cover the case.
+static int32_t doVectorCompareKernel(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut,
+                                     int32_t startIndex, int32_t numOfRows, int32_t step, int32_t optr) {
+  int32_t type = GET_PARAM_TYPE(pLeft);
+  if (step != 1 || type != GET_PARAM_TYPE(pRight) || startIndex >= numOfRows) {
+    return -1;
+  }
+
+  SScalarParam *pVec = pLeft, *pScalar = pRight;
+  if (pLeft->numOfRows == 1 && pRight->numOfRows > 1) {
+    pVec = pRight;
+    pScalar = pLeft;
+    optr = vectorReverseCompareOptr(optr);
+  }
+
+  // the kernels read rows [startIndex, numOfRows) of both sides but a constant right one. An operand with fewer rows,
+  // as the one row operands CASE WHEN compares at each row, is read at row 0 by the row loop instead.
+  bool scalar = (pScalar->numOfRows == 1 && pVec->numOfRows > 1);
+  if (pVec->numOfRows < numOfRows || (!scalar && pScalar->numOfRows < numOfRows)) {
+    return -1;
+  }
+
+  _vec_cmp_fn_t fn = getVectorCompareFn(type, optr, scalar);
+  if (fn == NULL) {
+    return -1;
+  }
+
+  int32_t   rows = numOfRows - startIndex;
+  uint64_t *pSel = taosMemoryMalloc(VECTOR_SEL_WORDS(rows) * sizeof(uint64_t));
+  if (pSel == NULL) {
+    return -1;
+  }
+
+  int32_t bytes = pVec->columnData->info.bytes;
+  bool   *pRes = (bool *)pOut->columnData->pData + startIndex;
+
+  if (scalar && colDataIsNull_s(pScalar->columnData, 0)) {
+    memset(pRes, 0, rows * sizeof(bool));
+    taosMemoryFree(pSel);
+    return 0;
+  }
+
+  char *pRightData = pScalar->columnData->pData + (scalar ? 0 : startIndex * bytes);
+  fn(pVec->columnData->pData + startIndex * bytes, pRightData, rows, pSel);
+
+  vectorSelClearNull(pSel, pVec->columnData, startIndex, rows);
+  if (!scalar) {
+    vectorSelClearNull(pSel, pScalar->columnData, startIndex, rows);
+  }
+
+  int32_t num = vectorSelToBool(pSel, rows, pRes);
+  taosMemoryFree(pSel);
+  return num;
+}
+
 int32_t doVectorCompareImpl(SScalarParam *pLeft, SScalarParam *pRight, SScalarParam *pOut, int32_t startIndex,
                             int32_t numOfRows, int32_t step, __compar_fn_t fp, int32_t optr) {
   int32_t num = 0;
   bool   *pRes = (bool *)pOut->columnData->pData;
 
   if (IS_MATHABLE_TYPE(GET_PARAM_TYPE(pLeft)) && IS_MATHABLE_TYPE(GET_PARAM_TYPE(pRight))) {
+    num = doVectorCompareKernel(pLeft, pRight, pOut, startIndex, numOfRows, step, optr);
+    if (num >= 0) {
+      return num;
+    }
+
+    num = 0;
     if (!(pLeft->columnData->hasNull || pRight->columnData->hasNull)) {
       for (int32_t i = startIndex; i < numOfRows && i >= 0; i += step) {
         int32_t leftIndex = (i >= pLeft->numOfRows) ? 0 : i;
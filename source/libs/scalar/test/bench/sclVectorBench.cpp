@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtest/gtest.h>
+#include <iostream>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wwrite-strings"
+#pragma GCC diagnostic ignored "-Wunused-function"
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#pragma GCC diagnostic ignored "-Wsign-compare"
+
+#include "os.h"
+
+#include "filterInt.h"
+#include "nodes.h"
+#include "scalar.h"
+#include "sclvector.h"
+#include "tdatablock.h"
+#include "tglobal.h"
+
+namespace {
+
+const int32_t sbRows = 4096;
+const int32_t sbLoops = 2000;
+
+SColumnInfoData *sbMakeCol(int32_t type, int32_t rows, int32_t nullStep) {
+  SColumnInfoData *pCol = (SColumnInfoData *)taosMemoryCalloc(1, sizeof(SColumnInfoData));
+  *pCol = createColumnInfoData(type, tDataTypes[type].bytes, 1);
+  colInfoDataEnsureCapacity(pCol, rows, true);
+
+  for (int32_t i = 0; i < rows; ++i) {
+    if (nullStep > 0 && i % nullStep == 0) {
+      colDataSetNULL(pCol, i);
+      continue;
+    }
+
+    switch (type) {
+      case TSDB_DATA_TYPE_INT:
+        ((int32_t *)pCol->pData)[i] = i * 7 - 1000;
+        break;
+      case TSDB_DATA_TYPE_BIGINT:
+        ((int64_t *)pCol->pData)[i] = (int64_t)i * 1000003;
+        break;
+      case TSDB_DATA_TYPE_FLOAT:
+        ((float *)pCol->pData)[i] = i * 0.25f;
+        break;
+      case TSDB_DATA_TYPE_DOUBLE:
+        ((double *)pCol->pData)[i] = i * 1.8;
+        break;
+      default:
+        break;
+    }
+  }
+
+  return pCol;
+}
+
+void sbFreeCol(SColumnInfoData *pCol) {
+  colDataDestroy(pCol);
+  taosMemoryFree(pCol);
+}
+
+// a one row operand, the constant side of a vector/scalar expression
+SColumnInfoData *sbMakeScalar(int32_t type, bool isNull) {
+  SColumnInfoData *pCol = sbMakeCol(type, 1, 0);
+  if (isNull) {
+    colDataSetNULL(pCol, 0);
+    return pCol;
+  }
+
+  switch (type) {
+    case TSDB_DATA_TYPE_INT:
+      *(int32_t *)pCol->pData = -37;
+      break;
+    case TSDB_DATA_TYPE_BIGINT:
+      *(int64_t *)pCol->pData = 100000007;
+      break;
+    case TSDB_DATA_TYPE_FLOAT:
+      *(float *)pCol->pData = 2.5f;
+      break;
+    case TSDB_DATA_TYPE_DOUBLE:
+      *(double *)pCol->pData = -0.75;
+      break;
+    default:
+      break;
+  }
+  return pCol;
+}
+
+enum {
+  SB_VEC_VEC = 0,
+  SB_VEC_SCALAR,
+  SB_SCALAR_VEC,  // a subtraction of this shape runs the reversed subtraction kernel
+};
+
+const char *sbOpName(int32_t op) {
+  switch (op) {
+    case OP_TYPE_ADD:
+      return "+";
+    case OP_TYPE_SUB:
+      return "-";
+    case OP_TYPE_MULTI:
+      return "*";
+    default:
+      return "?";
+  }
+}
+
+double sbApply(int32_t op, double l, double r) {
+  switch (op) {
+    case OP_TYPE_ADD:
+      return l + r;
+    case OP_TYPE_SUB:
+      return l - r;
+    case OP_TYPE_MULTI:
+      return l * r;
+    default:
+      return 0;
+  }
+}
+
+// the per-row path the arithmetic operators used before the typed kernels, kept here as the baseline. A one row
+// operand is read at row 0.
+void sbGeneric(int32_t op, SScalarParam *pLeft, SScalarParam *pRight, SColumnInfoData *pOutputCol, int32_t rows) {
+  SColumnInfoData     *pLeftCol = pLeft->columnData;
+  SColumnInfoData     *pRightCol = pRight->columnData;
+  _getDoubleValue_fn_t getVectorDoubleValueFnLeft = getVectorDoubleValueFn(pLeftCol->info.type);
+  _getDoubleValue_fn_t getVectorDoubleValueFnRight = getVectorDoubleValueFn(pRightCol->info.type);
+
+  double *output = (double *)pOutputCol->pData;
+  for (int32_t i = 0; i < rows; ++i, output += 1) {
+    int32_t l = (pLeft->numOfRows == 1) ? 0 : i;
+    int32_t r = (pRight->numOfRows == 1) ? 0 : i;
+    if (colDataIsNull_s(pLeftCol, l) || colDataIsNull_s(pRightCol, r)) {
+      colDataSetNULL(pOutputCol, i);
+      continue;
+    }
+    *output = sbApply(op, getVectorDoubleValueFnLeft(pLeftCol->pData, l),
+                      getVectorDoubleValueFnRight(pRightCol->pData, r));
+  }
+}
+
+void sbRun(int32_t op, int32_t shape, int32_t leftType, int32_t rightType, int32_t nullStep) {
+  // both vectors have nulls at different rows, the constant is null when the vector has none
+  SColumnInfoData *pLeftCol = (shape == SB_SCALAR_VEC) ? sbMakeScalar(leftType, nullStep == 0)
+                                                       : sbMakeCol(leftType, sbRows, nullStep);
+  SColumnInfoData *pRightCol = (shape == SB_VEC_SCALAR) ? sbMakeScalar(rightType, nullStep == 0)
+                               : (shape == SB_SCALAR_VEC) ? sbMakeCol(rightType, sbRows, nullStep)
+                                                          : sbMakeCol(rightType, sbRows, nullStep > 0 ? nullStep + 4 : 0);
+  SColumnInfoData *pExpect = sbMakeCol(TSDB_DATA_TYPE_DOUBLE, sbRows, 0);
+  SColumnInfoData *pRes = sbMakeCol(TSDB_DATA_TYPE_DOUBLE, sbRows, 0);
+
+  SScalarParam left = {0}, right = {0}, out = {0};
+  left.columnData = pLeftCol;
+  left.numOfRows = (shape == SB_SCALAR_VEC) ? 1 : sbRows;
+  right.columnData = pRightCol;
+  right.numOfRows = (shape == SB_VEC_SCALAR) ? 1 : sbRows;
+  out.columnData = pRes;
+  out.numOfRows = sbRows;
+
+  _bin_scalar_fn_t fn = getBinScalarOperatorFn(op);
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 0; i < sbLoops; ++i) {
+    sbGeneric(op, &left, &right, pExpect, sbRows);
+  }
+  int64_t genericUs = taosGetTimestampUs() - st;
+
+  st = taosGetTimestampUs();
+  for (int32_t i = 0; i < sbLoops; ++i) {
+    fn(&left, &right, &out, TSDB_ORDER_ASC);
+  }
+  int64_t kernelUs = taosGetTimestampUs() - st;
+
+  ASSERT_EQ(out.numOfRows, sbRows);
+  for (int32_t i = 0; i < sbRows; ++i) {
+    ASSERT_EQ(colDataIsNull_s(pRes, i), colDataIsNull_s(pExpect, i))
+        << tDataTypes[leftType].name << sbOpName(op) << tDataTypes[rightType].name << " shape:" << shape << " row:" << i;
+    if (!colDataIsNull_s(pRes, i)) {
+      ASSERT_EQ(((double *)pRes->pData)[i], ((double *)pExpect->pData)[i])
+          << tDataTypes[leftType].name << sbOpName(op) << tDataTypes[rightType].name << " shape:" << shape
+          << " row:" << i;
+    }
+  }
+
+  const char *shapes[] = {"vec/vec", "vec/const", "const/vec"};
+  double      rows = (double)sbRows * sbLoops;
+  printf("%-7s %s %-7s %-9s nulls:%-3s generic:%8.2f Mrows/s kernel:%8.2f Mrows/s\n", tDataTypes[leftType].name,
+         sbOpName(op), tDataTypes[rightType].name, shapes[shape], nullStep > 0 ? "yes" : "no",
+         rows / TMAX(genericUs, 1), rows / TMAX(kernelUs, 1));
+
+  sbFreeCol(pLeftCol);
+  sbFreeCol(pRightCol);
+  sbFreeCol(pExpect);
+  sbFreeCol(pRes);
+}
+
+void sbRunOp(int32_t op) {
+  int32_t types[] = {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_BIGINT, TSDB_DATA_TYPE_FLOAT, TSDB_DATA_TYPE_DOUBLE};
+  char    simd = tsSIMDBuiltins;
+  if (!tsAVXEnable) {
+    taosGetCpuInstructions(&tsSSE42Enable, &tsAVXEnable, &tsAVX2Enable, &tsFMAEnable);
+  }
+
+  // the typed scalar loops first, then the avx ones when the cpu has them
+  for (int32_t s = 0; s <= (tsAVXEnable ? 1 : 0); ++s) {
+    tsSIMDBuiltins = s;
+    printf("simd:%d avx:%d avx2:%d\n", tsSIMDBuiltins, tsAVXEnable, tsAVX2Enable);
+    for (int32_t shape = SB_VEC_VEC; shape <= SB_SCALAR_VEC; ++shape) {
+      for (int32_t l = 0; l < tListLen(types); ++l) {
+        for (int32_t r = 0; r < tListLen(types); ++r) {
+          sbRun(op, shape, types[l], types[r], 0);
+          sbRun(op, shape, types[l], types[r], 13);
+        }
+      }
+    }
+  }
+  tsSIMDBuiltins = simd;
+}
+
+}  // namespace
+
+TEST(sclVectorBench, add) { sbRunOp(OP_TYPE_ADD); }
+
+TEST(sclVectorBench, sub) { sbRunOp(OP_TYPE_SUB); }
+
+TEST(sclVectorBench, multi) { sbRunOp(OP_TYPE_MULTI); }
+
+int main(int argc, char **argv) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
+
+#pragma GCC diagnostic pop
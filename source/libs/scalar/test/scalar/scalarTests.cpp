@@ -36,6 +36,8 @@
 #include "nodes.h"
 #include "parUtil.h"
 #include "scalar.h"
+#include "sclInt.h"
+#include "sclvector.h"
 #include "stub.h"
 #include "taos.h"
 #include "tdatablock.h"
@@ -1679,6 +1681,218 @@ TEST(columnTest, smallint_column_greater_double_value) {
   nodesDestroyNode(opNode);
 }
 
+TEST(columnTest, double_column_greater_double_value_with_null) {
+  SNode       *pLeft = NULL, *pRight = NULL, *opNode = NULL;
+  double       leftv[150] = {0};
+  double       rightv = 70.5;
+  SSDataBlock *src = NULL;
+  int32_t      rowNum = sizeof(leftv) / sizeof(leftv[0]);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    leftv[i] = i;
+  }
+  scltMakeColumnNode(&pLeft, &src, TSDB_DATA_TYPE_DOUBLE, sizeof(double), rowNum, leftv);
+  SColumnInfoData *pLeftCol = (SColumnInfoData *)taosArrayGetLast(src->pDataBlock);
+  for (int32_t i = 0; i < rowNum; i += 7) {
+    colDataSetNULL(pLeftCol, i);
+  }
+  scltMakeValueNode(&pRight, TSDB_DATA_TYPE_DOUBLE, &rightv);
+  scltMakeOpNode(&opNode, OP_TYPE_GREATER_THAN, TSDB_DATA_TYPE_BOOL, pLeft, pRight);
+
+  SArray *blockList = taosArrayInit(1, POINTER_BYTES);
+  taosArrayPush(blockList, &src);
+  SColumnInfo colInfo = createColumnInfo(1, TSDB_DATA_TYPE_BOOL, sizeof(bool));
+  int16_t     dataBlockId = 0, slotId = 0;
+  scltAppendReservedSlot(blockList, &dataBlockId, &slotId, true, rowNum, &colInfo);
+  scltMakeTargetNode(&opNode, dataBlockId, slotId, opNode);
+
+  int32_t code = scalarCalculate(opNode, blockList, NULL);
+  ASSERT_EQ(code, 0);
+
+  SSDataBlock *res = *(SSDataBlock **)taosArrayGetLast(blockList);
+  ASSERT_EQ(res->info.rows, rowNum);
+  SColumnInfoData *column = (SColumnInfoData *)taosArrayGetLast(res->pDataBlock);
+  ASSERT_EQ(column->info.type, TSDB_DATA_TYPE_BOOL);
+  for (int32_t i = 0; i < rowNum; ++i) {
+    bool eRes = (i % 7 != 0) && (leftv[i] > rightv);
+    ASSERT_EQ(*((bool *)colDataGetData(column, i)), eRes);
+  }
+  taosArrayDestroyEx(blockList, scltFreeDataBlock);
+  nodesDestroyNode(opNode);
+}
+
+template <typename T>
+static void scltCheckCompareKernel(int32_t type, const std::vector<T> &leftv, const std::vector<T> &rightv) {
+  int32_t optrs[] = {OP_TYPE_GREATER_THAN, OP_TYPE_GREATER_EQUAL, OP_TYPE_LOWER_THAN,
+                     OP_TYPE_LOWER_EQUAL,  OP_TYPE_EQUAL,         OP_TYPE_NOT_EQUAL};
+  // lengths around the vector width and the 64 rows of a selection word
+  int32_t lens[] = {1, 3, 4, 7, 8, 9, 31, 63, 64, 65, 127, 130};
+  bool    simd = tsSIMDBuiltins;
+
+  for (int32_t optr : optrs) {
+    for (int32_t scalar = 0; scalar < 2; ++scalar) {
+      _vec_cmp_fn_t fp = getVectorCompareFn(type, optr, scalar);
+      ASSERT_TRUE(fp != NULL);
+      for (int32_t len : lens) {
+        ASSERT_LE(len, (int32_t)leftv.size());
+        int32_t               words = (len + 63) / 64;
+        std::vector<uint64_t> vecSel(words + 1, 0xA5A5A5A5A5A5A5A5), rowSel(words + 1, 0xA5A5A5A5A5A5A5A5);
+        const T              *pRight = scalar ? &rightv[len / 2] : rightv.data();
+
+        tsSIMDBuiltins = true;
+        fp(leftv.data(), pRight, len, vecSel.data());
+        tsSIMDBuiltins = false;
+        fp(leftv.data(), pRight, len, rowSel.data());
+        tsSIMDBuiltins = simd;
+
+        for (int32_t i = 0; i < len; ++i) {
+          bool v = (vecSel[i >> 6] >> (i & 63)) & 1;
+          bool r = (rowSel[i >> 6] >> (i & 63)) & 1;
+          ASSERT_EQ(v, r) << "type:" << type << " optr:" << optr << " scalar:" << scalar << " len:" << len
+                          << " row:" << i;
+        }
+        // bits past the last row are left clear and the next word is untouched
+        if (len & 63) {
+          ASSERT_EQ(vecSel[words - 1] >> (len & 63), 0);
+        }
+        ASSERT_EQ(vecSel[words], 0xA5A5A5A5A5A5A5A5);
+      }
+    }
+  }
+}
+
+TEST(columnTest, compare_kernel_same_as_row_path) {
+  if (!tsAVX2Enable) {
+    taosGetCpuInstructions(&tsSSE42Enable, &tsAVXEnable, &tsAVX2Enable, &tsFMAEnable);
+  }
+  int32_t rows = 130;
+
+  std::vector<int32_t> i32l(rows), i32r(rows);
+  std::vector<int64_t> i64l(rows), i64r(rows);
+  std::vector<int8_t>  i8l(rows), i8r(rows);
+  std::vector<float>   fl(rows), fr(rows);
+  std::vector<double>  dl(rows), dr(rows);
+  for (int32_t i = 0; i < rows; ++i) {
+    i32l[i] = (i * 7) % 13 - 6;
+    i32r[i] = (i * 5) % 11 - 5;
+    i64l[i] = ((int64_t)((i * 7) % 13 - 6)) << 40;
+    i64r[i] = ((int64_t)((i * 5) % 11 - 5)) << 40;
+    i8l[i] = (int8_t)i32l[i];
+    i8r[i] = (int8_t)i32r[i];
+    fl[i] = (float)i32l[i] / 2;
+    fr[i] = (float)i32r[i] / 2;
+    dl[i] = (double)i32l[i] / 4;
+    dr[i] = (double)i32r[i] / 4;
+  }
+  // nan on either side, and values within the FLT_EQUAL tolerance
+  for (int32_t i = 0; i < rows; i += 9) {
+    fl[i] = NAN;
+    dl[i] = NAN;
+  }
+  for (int32_t i = 0; i < rows; i += 6) {
+    fr[i] = NAN;
+    dr[i] = NAN;
+  }
+  for (int32_t i = 2; i < rows; i += 10) {
+    fr[i] = fl[i] + FLT_EPSILON;
+    dr[i] = dl[i] + FLT_EPSILON;
+  }
+
+  scltCheckCompareKernel<int32_t>(TSDB_DATA_TYPE_INT, i32l, i32r);
+  scltCheckCompareKernel<int64_t>(TSDB_DATA_TYPE_BIGINT, i64l, i64r);
+  scltCheckCompareKernel<int8_t>(TSDB_DATA_TYPE_TINYINT, i8l, i8r);
+  scltCheckCompareKernel<float>(TSDB_DATA_TYPE_FLOAT, fl, fr);
+  scltCheckCompareKernel<double>(TSDB_DATA_TYPE_DOUBLE, dl, dr);
+
+  // the row path itself agrees with the plain operators
+  uint64_t sel[3] = {0};
+  getVectorCompareFn(TSDB_DATA_TYPE_INT, OP_TYPE_GREATER_THAN, false)(i32l.data(), i32r.data(), rows, sel);
+  for (int32_t i = 0; i < rows; ++i) {
+    ASSERT_EQ((bool)((sel[i >> 6] >> (i & 63)) & 1), i32l[i] > i32r[i]);
+  }
+}
+
+static SColumnInfoData *scltMakeCompareCol(int32_t type, int32_t rows) {
+  SColumnInfoData *pCol = (SColumnInfoData *)taosMemoryCalloc(1, sizeof(SColumnInfoData));
+  *pCol = createColumnInfoData(type, tDataTypes[type].bytes, 1);
+  colInfoDataEnsureCapacity(pCol, rows, true);
+  for (int32_t i = 0; i < rows; ++i) {
+    int32_t v = (i * 7) % 11 - 3;
+    if (type == TSDB_DATA_TYPE_INT) {
+      ((int32_t *)pCol->pData)[i] = v;
+    } else if (type == TSDB_DATA_TYPE_DOUBLE) {
+      ((double *)pCol->pData)[i] = v / 2.0;
+    }
+  }
+  return pCol;
+}
+
+// CASE WHEN compares row by row, one row operands are read at row 0 whatever the row compared
+TEST(columnTest, compare_one_row_operands_at_later_rows) {
+  int32_t rows = 70;
+  int32_t types[] = {TSDB_DATA_TYPE_INT, TSDB_DATA_TYPE_DOUBLE};
+  int32_t optrs[] = {OP_TYPE_GREATER_THAN, OP_TYPE_GREATER_EQUAL, OP_TYPE_LOWER_THAN,
+                     OP_TYPE_LOWER_EQUAL,  OP_TYPE_EQUAL,         OP_TYPE_NOT_EQUAL};
+
+  for (int32_t type : types) {
+    SColumnInfoData *pVec = scltMakeCompareCol(type, rows);
+    SColumnInfoData *pOne = scltMakeCompareCol(type, 1);
+    SColumnInfoData *pOther = scltMakeCompareCol(type, 2);
+    SColumnInfoData *pNull = scltMakeCompareCol(type, 1);
+    SColumnInfoData *pRes = scltMakeCompareCol(TSDB_DATA_TYPE_BOOL, rows);
+    for (int32_t i = 0; i < rows; i += 9) {
+      colDataSetNULL(pVec, i);
+    }
+    colDataSetNULL(pNull, 0);
+
+    // the constant of pOther is its row 1
+    memmove(pOther->pData, pOther->pData + pOther->info.bytes, pOther->info.bytes);
+
+    SScalarParam vec = {0}, one = {0}, other = {0}, null = {0}, out = {0};
+    vec.columnData = pVec;
+    vec.numOfRows = rows;
+    one.columnData = pOne;
+    one.numOfRows = 1;
+    other.columnData = pOther;
+    other.numOfRows = 1;
+    null.columnData = pNull;
+    null.numOfRows = 1;
+    out.columnData = pRes;
+    out.numOfRows = rows;
+
+    SScalarParam *pairs[][2] = {{&one, &other}, {&other, &one}, {&one, &one},  {&one, &null},
+                                {&vec, &one},   {&one, &vec},   {&vec, &null}, {&vec, &vec}};
+    for (auto &pair : pairs) {
+      SScalarParam *pLeft = pair[0], *pRight = pair[1];
+      for (int32_t optr : optrs) {
+        __compar_fn_t fp = filterGetCompFunc(type, optr);
+        for (int32_t rowIdx = 0; rowIdx < rows; ++rowIdx) {
+          memset(pRes->pData, 0xFF, rows);
+          vectorCompareImpl(pLeft, pRight, &out, rowIdx, 1, TSDB_ORDER_ASC, optr);
+
+          // the row loop the compare kernels replaced
+          int32_t l = (pLeft->numOfRows > 1) ? rowIdx : 0;
+          int32_t r = (pRight->numOfRows > 1) ? rowIdx : 0;
+          bool    expect = false;
+          if (!colDataIsNull_s(pLeft->columnData, l) && !colDataIsNull_s(pRight->columnData, r)) {
+            expect = filterDoCompare(fp, optr, colDataGetData(pLeft->columnData, l),
+                                     colDataGetData(pRight->columnData, r));
+          }
+          ASSERT_EQ(*(bool *)colDataGetData(pRes, rowIdx), expect)
+              << "type:" << type << " optr:" << optr << " left rows:" << pLeft->numOfRows
+              << " right rows:" << pRight->numOfRows << " row:" << rowIdx;
+          ASSERT_EQ(out.numOfQualified, expect ? 1 : 0);
+        }
+      }
+    }
+
+    SColumnInfoData *cols[] = {pVec, pOne, pOther, pNull, pRes};
+    for (SColumnInfoData *pCol : cols) {
+      colDataDestroy(pCol);
+      taosMemoryFree(pCol);
+    }
+  }
+}
+
 TEST(columnTest, int_column_in_double_list) {
   SNode       *pLeft = NULL, *pRight = NULL, *listNode = NULL, *opNode = NULL;
   int32_t      leftv[5] = {1, 2, 3, 4, 5};
@@ -2976,6 +2976,11 @@ static int32_t syncNodeAppendNoopOld(SSyncNode* ths) {
       return -1;
     }
 
+    // the append leaves the fsync to the log buffer under group commit, this entry does not go through it
+    if (walGroupCommit(ths->pWal)) {
+      walFsync(ths->pWal, false);
+    }
+
     syncCacheEntry(ths->pLogStore, pEntry, &h);
   }
 
@@ -20,6 +20,7 @@
 #include "syncIndexMgr.h"
 #include "syncInt.h"
 #include "syncRaftEntry.h"
+#include "syncRaftLog.h"
 #include "syncRaftStore.h"
 #include "syncReplication.h"
 #include "syncRespMgr.h"
@@ -436,6 +437,9 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
 
   SSyncLogStore* pLogStore = pNode->pLogStore;
   int64_t        matchIndex = pBuf->matchIndex;
+  int64_t        syncedIndex = matchIndex;
+  bool           groupCommit = walGroupCommit(pNode->pWal);
+  bool           forceSync = false;
 
   while (pBuf->matchIndex + 1 < pBuf->endIndex) {
     int64_t index = pBuf->matchIndex + 1;
@@ -484,7 +488,8 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
       taosMsleep(1);
       goto _out;
     }
-    
+    forceSync |= syncLogStoreNeedFlush(pEntry, pNode->replicaNum);
+
     if(pEntry->originalRpcType == TDMT_SYNC_CONFIG_CHANGE){
       if(pNode->pLogBuf->commitIndex == pEntry->index -1){
         sInfo("vgId:%d, to change config at %s. "
@@ -521,16 +526,36 @@ int64_t syncLogBufferProceed(SSyncLogBuffer* pBuf, SSyncNode* pNode, SyncTerm* p
 
     // update my match index
     matchIndex = pBuf->matchIndex;
-    syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, pBuf->matchIndex);
+    if (!groupCommit) {
+      syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, pBuf->matchIndex);
+    }
   }  // end of while
 
 _out:
   pBuf->matchIndex = matchIndex;
+  SyncTerm matchTerm = pBuf->entries[(matchIndex + pBuf->size) % pBuf->size].pItem->term;
   if (pMatchTerm) {
-    *pMatchTerm = pBuf->entries[(matchIndex + pBuf->size) % pBuf->size].pItem->term;
+    *pMatchTerm = matchTerm;
   }
   syncLogBufferValidate(pBuf);
   taosThreadMutexUnlock(&pBuf->mutex);
+
+  // with group commit the entries persisted above are made durable by one fsync, taken out of the buffer lock so that
+  // the other appenders and the replies go on meanwhile. My match index is published once it is done, unless the
+  // entries were rolled back in between, and the caller only replies or commits up to matchIndex after it returns.
+  if (groupCommit && matchIndex > syncedIndex) {
+    walFsync(pNode->pWal, forceSync);
+
+    taosThreadMutexLock(&pBuf->mutex);
+    SSyncRaftEntry* pMatch = pBuf->entries[(matchIndex + pBuf->size) % pBuf->size].pItem;
+    if (pBuf->matchIndex >= matchIndex && pMatch != NULL && pMatch->index == matchIndex &&
+        pMatch->term == matchTerm &&
+        syncIndexMgrGetIndex(pNode->pMatchIndex, &pNode->myRaftId) < matchIndex) {
+      syncIndexMgrSetIndex(pNode->pMatchIndex, &pNode->myRaftId, matchIndex);
+    }
+    taosThreadMutexUnlock(&pBuf->mutex);
+  }
+
   return matchIndex;
 }
 
@@ -219,7 +219,10 @@ static int32_t raftLogAppendEntry(struct SSyncLogStore* pLogStore, SSyncRaftEntr
 
   ASSERT(pEntry->index == index);
 
-  walFsync(pWal, forceSync);
+  // with group commit, the caller fsyncs once for the batch it appends
+  if (!walGroupCommit(pWal)) {
+    walFsync(pWal, forceSync);
+  }
 
   sNTrace(pData->pSyncNode, "write index:%" PRId64 ", type:%s, origin type:%s, elapsed:%" PRId64, pEntry->index,
           TMSG_INFO(pEntry->msgType), TMSG_INFO(pEntry->originalRpcType), tsElapsed);
@@ -42,6 +42,14 @@ int32_t tdbPrepareAsyncCommit(TDB *pDb, TXN *pTxn);
 int32_t tdbAbort(TDB *pDb, TXN *pTxn);
 int32_t tdbAlter(TDB *pDb, int pages);
 
+typedef struct {
+  int64_t nHit;         // fetches served from the page cache
+  int64_t nMiss;        // fetches that had to load or copy the page
+  int64_t nContention;  // page cache locks that were held by another thread
+} STdbCacheStat;
+
+void tdbGetCacheStat(TDB *pDb, STdbCacheStat *pStat);
+
 // TTB
 int32_t tdbTbOpen(const char *tbname, int keyLen, int valLen, tdb_cmpr_fn_t keyCmprFn, TDB *pEnv, TTB **ppTb,
                   int8_t rollback);
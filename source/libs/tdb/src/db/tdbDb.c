@@ -108,6 +108,8 @@ int tdbClose(TDB *pDb) {
 
 int32_t tdbAlter(TDB *pDb, int pages) { return tdbPCacheAlter(pDb->pCache, pages); }
 
+void tdbGetCacheStat(TDB *pDb, STdbCacheStat *pStat) { tdbPCacheGetStat(pDb->pCache, pStat); }
+
 int32_t tdbBegin(TDB *pDb, TXN **ppTxn, void *(*xMalloc)(void *, size_t), void (*xFree)(void *, void *), void *xArg,
                  int flags) {
   SPager *pPager;
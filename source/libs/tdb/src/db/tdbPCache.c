@@ -17,10 +17,12 @@
 // #include <sys/types.h>
 // #include <unistd.h>
 
-struct SPCache {
-  int         szPage;
-  int         nPages;
-  SPage     **aPage;
+// pages are partitioned by the hash of their pgid, each partition has its own lock, hash table, free list and lru so
+// that fetches of different pages do not serialize on one cache lock
+#define TDB_PCACHE_MAX_PARTS      16
+#define TDB_PCACHE_MIN_PART_PAGES 64
+
+typedef struct SPCachePart {
   tdb_mutex_t mutex;
   int         nFree;
   SPage      *pFree;
@@ -29,6 +31,17 @@ struct SPCache {
   SPage     **pgHash;
   int         nRecyclable;
   SPage       lru;
+  i64         nHit;
+  i64         nMiss;
+  i64         nContention;
+} SPCachePart;
+
+struct SPCache {
+  int          szPage;
+  int          nPages;
+  SPage      **aPage;
+  int          nPart;
+  SPCachePart *aPart;
 };
 
 static inline uint32_t tdbPCachePageHash(const SPgid *pPgid) {
@@ -36,18 +49,39 @@ static inline uint32_t tdbPCachePageHash(const SPgid *pPgid) {
   return (uint32_t)(t[0] + t[1] + t[2] + t[3] + t[4] + t[5] + (pPgid)->pgno);
 }
 
+static inline SPCachePart *tdbPCacheGetPart(SPCache *pCache, const SPgid *pPgid) {
+  return &pCache->aPart[tdbPCachePageHash(pPgid) % pCache->nPart];
+}
+
 static int    tdbPCacheOpenImpl(SPCache *pCache);
-static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn);
-static void   tdbPCachePinPage(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheRemovePageFromHash(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheAddPageToHash(SPCache *pCache, SPage *pPage);
-static void   tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage);
+static SPage *tdbPCacheFetchImpl(SPCache *pCache, SPCachePart *pPart, const SPgid *pPgid, TXN *pTxn);
+static void   tdbPCachePinPage(SPCachePart *pPart, SPage *pPage);
+static void   tdbPCacheRemovePageFromHash(SPCache *pCache, SPCachePart *pPart, SPage *pPage);
+static void   tdbPCacheAddPageToHash(SPCache *pCache, SPCachePart *pPart, SPage *pPage);
+static void   tdbPCacheUnpinPage(SPCache *pCache, SPCachePart *pPart, SPage *pPage);
 static int    tdbPCacheCloseImpl(SPCache *pCache);
 
-static void tdbPCacheInitLock(SPCache *pCache) { tdbMutexInit(&(pCache->mutex), NULL); }
-static void tdbPCacheDestroyLock(SPCache *pCache) { tdbMutexDestroy(&(pCache->mutex)); }
-static void tdbPCacheLock(SPCache *pCache) { tdbMutexLock(&(pCache->mutex)); }
-static void tdbPCacheUnlock(SPCache *pCache) { tdbMutexUnlock(&(pCache->mutex)); }
+static void tdbPCacheInitLock(SPCachePart *pPart) { tdbMutexInit(&(pPart->mutex), NULL); }
+static void tdbPCacheDestroyLock(SPCachePart *pPart) { tdbMutexDestroy(&(pPart->mutex)); }
+static void tdbPCacheLock(SPCachePart *pPart) {
+  if (tdbMutexTryLock(&(pPart->mutex)) != 0) {
+    atomic_add_fetch_64(&pPart->nContention, 1);
+    tdbMutexLock(&(pPart->mutex));
+  }
+}
+static void tdbPCacheUnlock(SPCachePart *pPart) { tdbMutexUnlock(&(pPart->mutex)); }
+
+static void tdbPCacheLockAll(SPCache *pCache) {
+  for (int iPart = 0; iPart < pCache->nPart; iPart++) {
+    tdbPCacheLock(&pCache->aPart[iPart]);
+  }
+}
+
+static void tdbPCacheUnlockAll(SPCache *pCache) {
+  for (int iPart = pCache->nPart - 1; iPart >= 0; iPart--) {
+    tdbPCacheUnlock(&pCache->aPart[iPart]);
+  }
+}
 
 int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
   SPCache *pCache;
@@ -67,7 +101,21 @@ int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
     return -1;
   }
 
+  // small caches keep one partition, so that pages are not stranded in idle partitions
+  pCache->nPart = 1;
+  while (pCache->nPart < TDB_PCACHE_MAX_PARTS && pCache->nPart * 2 * TDB_PCACHE_MIN_PART_PAGES <= cacheSize) {
+    pCache->nPart *= 2;
+  }
+  pCache->aPart = (SPCachePart *)tdbOsCalloc(pCache->nPart, sizeof(SPCachePart));
+  if (pCache->aPart == NULL) {
+    tdbOsFree(pCache->aPage);
+    tdbOsFree(pCache);
+    return -1;
+  }
+
   if (tdbPCacheOpenImpl(pCache) < 0) {
+    tdbOsFree(pCache->aPart);
+    tdbOsFree(pCache->aPage);
     tdbOsFree(pCache);
     return -1;
   }
@@ -78,13 +126,29 @@ int tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache) {
 
 int tdbPCacheClose(SPCache *pCache) {
   if (pCache) {
+    STdbCacheStat stat;
+    tdbPCacheGetStat(pCache, &stat);
+    tdbDebug("pcache/close: %p, parts:%d, hit:%" PRId64 ", miss:%" PRId64 ", contention:%" PRId64, pCache,
+             pCache->nPart, stat.nHit, stat.nMiss, stat.nContention);
+
     tdbPCacheCloseImpl(pCache);
+    tdbOsFree(pCache->aPart);
     tdbOsFree(pCache->aPage);
     tdbOsFree(pCache);
   }
   return 0;
 }
 
+void tdbPCacheGetStat(SPCache *pCache, STdbCacheStat *pStat) {
+  memset(pStat, 0, sizeof(*pStat));
+  for (int iPart = 0; iPart < pCache->nPart; iPart++) {
+    SPCachePart *pPart = &pCache->aPart[iPart];
+    pStat->nHit += atomic_load_64(&pPart->nHit);
+    pStat->nMiss += atomic_load_64(&pPart->nMiss);
+    pStat->nContention += atomic_load_64(&pPart->nContention);
+  }
+}
+
 // TODO:
 // if (pPage->id >= pCache->nPages) {
 //   free(pPage);
@@ -122,11 +186,12 @@ static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
       aPage[iPage]->id = iPage;
     }
 
-    // add page to free list
+    // add page to the free lists of the partitions in turn
     for (int32_t iPage = pCache->nPages; iPage < nPage; iPage++) {
-      aPage[iPage]->pFreeNext = pCache->pFree;
-      pCache->pFree = aPage[iPage];
-      pCache->nFree++;
+      SPCachePart *pPart = &pCache->aPart[iPage % pCache->nPart];
+      aPage[iPage]->pFreeNext = pPart->pFree;
+      pPart->pFree = aPage[iPage];
+      pPart->nFree++;
     }
 
     for (int32_t iPage = 0; iPage < pCache->nPages; iPage++) {
@@ -136,17 +201,21 @@ static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
     tdbOsFree(pCache->aPage);
     pCache->aPage = aPage;
   } else {
-    for (SPage **ppPage = &pCache->pFree; *ppPage;) {
-      int32_t iPage = (*ppPage)->id;
-
-      if (iPage >= nPage) {
-        SPage *pPage = *ppPage;
-        *ppPage = pPage->pFreeNext;
-        pCache->aPage[pPage->id] = NULL;
-        tdbPageDestroy(pPage, tdbDefaultFree, NULL);
-        pCache->nFree--;
-      } else {
-        ppPage = &(*ppPage)->pFreeNext;
+    for (int iPart = 0; iPart < pCache->nPart; iPart++) {
+      SPCachePart *pPart = &pCache->aPart[iPart];
+
+      for (SPage **ppPage = &pPart->pFree; *ppPage;) {
+        int32_t iPage = (*ppPage)->id;
+
+        if (iPage >= nPage) {
+          SPage *pPage = *ppPage;
+          *ppPage = pPage->pFreeNext;
+          pCache->aPage[pPage->id] = NULL;
+          tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+          pPart->nFree--;
+        } else {
+          ppPage = &(*ppPage)->pFreeNext;
+        }
       }
     }
   }
@@ -158,27 +227,28 @@ static int tdbPCacheAlterImpl(SPCache *pCache, int32_t nPage) {
 int tdbPCacheAlter(SPCache *pCache, int32_t nPage) {
   int ret = 0;
 
-  tdbPCacheLock(pCache);
+  tdbPCacheLockAll(pCache);
 
   ret = tdbPCacheAlterImpl(pCache, nPage);
 
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlockAll(pCache);
 
   return ret;
 }
 
 SPage *tdbPCacheFetch(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
-  SPage *pPage;
-  i32    nRef = 0;
+  SPCachePart *pPart = tdbPCacheGetPart(pCache, pPgid);
+  SPage       *pPage;
+  i32          nRef = 0;
 
-  tdbPCacheLock(pCache);
+  tdbPCacheLock(pPart);
 
-  pPage = tdbPCacheFetchImpl(pCache, pPgid, pTxn);
+  pPage = tdbPCacheFetchImpl(pCache, pPart, pPgid, pTxn);
   if (pPage) {
     nRef = tdbRefPage(pPage);
   }
 
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pPart);
 
   // printf("thread %" PRId64 " fetch page %d pgno %d pPage %p nRef %d\n", taosGetSelfPthreadId(), pPage->id,
   //        TDB_PAGE_PGNO(pPage), pPage, nRef);
@@ -193,63 +263,89 @@ SPage *tdbPCacheFetch(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
 }
 
 void tdbPCacheMarkFree(SPCache *pCache, SPage *pPage) {
-  tdbPCacheLock(pCache);
-  tdbPCacheRemovePageFromHash(pCache, pPage);
+  SPCachePart *pPart = tdbPCacheGetPart(pCache, &pPage->pgid);
+
+  tdbPCacheLock(pPart);
+  tdbPCacheRemovePageFromHash(pCache, pPart, pPage);
   pPage->isFree = 1;
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pPart);
 }
 
-static void tdbPCacheFreePage(SPCache *pCache, SPage *pPage) {
+static void tdbPCacheFreePage(SPCache *pCache, SPCachePart *pPart, SPage *pPage) {
   if (pPage->id < pCache->nPages) {
-    pPage->pFreeNext = pCache->pFree;
-    pCache->pFree = pPage;
+    pPage->pFreeNext = pPart->pFree;
+    pPart->pFree = pPage;
     pPage->isFree = 0;
-    ++pCache->nFree;
+    ++pPart->nFree;
     tdbTrace("pcache/free page %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
   } else {
     tdbTrace("pcache/free2 page: %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
 
-    tdbPCacheRemovePageFromHash(pCache, pPage);
+    tdbPCacheRemovePageFromHash(pCache, pPart, pPage);
     tdbPageDestroy(pPage, tdbDefaultFree, NULL);
   }
 }
 
+static SPage *tdbPCacheSearchHash(SPCache *pCache, SPCachePart *pPart, const SPgid *pPgid) {
+  SPage *pPage = pPart->pgHash[tdbPCachePageHash(pPgid) / pCache->nPart % pPart->nHash];
+
+  while (pPage) {
+    if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
+    pPage = pPage->pHashNext;
+  }
+
+  return pPage;
+}
+
 void tdbPCacheInvalidatePage(SPCache *pCache, SPager *pPager, SPgno pgno) {
   SPgid        pgid;
-  const SPgid *pPgid = &pgid;
+  SPCachePart *pPart;
   SPage       *pPage = NULL;
 
   memcpy(&pgid, pPager->fid, TDB_FILE_ID_LEN);
   pgid.pgno = pgno;
+  pPart = tdbPCacheGetPart(pCache, &pgid);
 
-  pPage = pCache->pgHash[tdbPCachePageHash(pPgid) % pCache->nHash];
-  while (pPage) {
-    if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
-    pPage = pPage->pHashNext;
-  }
+  tdbPCacheLock(pPart);
 
+  pPage = tdbPCacheSearchHash(pCache, pPart, &pgid);
   if (pPage) {
     bool moveToFreeList = false;
     if (pPage->pLruNext) {
-      tdbPCachePinPage(pCache, pPage);
+      tdbPCachePinPage(pPart, pPage);
       moveToFreeList = true;
     }
-    tdbPCacheRemovePageFromHash(pCache, pPage);
+    tdbPCacheRemovePageFromHash(pCache, pPart, pPage);
     if (moveToFreeList) {
-      tdbPCacheFreePage(pCache, pPage);
+      tdbPCacheFreePage(pCache, pPart, pPage);
     }
   }
+
+  tdbPCacheUnlock(pPart);
 }
 
 void tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn) {
-  i32 nRef;
+  SPCachePart *pPart;
+  i32          nRef;
 
   if (!pTxn) {
     tdbError("tdb/pcache: null ptr pTxn, release failed.");
     return;
   }
 
-  tdbPCacheLock(pCache);
+  // pages read in place from the file map are private to the read txn and never enter the cache
+  if (pPage->isMapped) {
+    nRef = tdbUnrefPage(pPage);
+    tdbTrace("pcache/release mapped page %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), nRef);
+    if (nRef == 0) {
+      tdbPageDestroy(pPage, pTxn->xFree, pTxn->xArg);
+    }
+    return;
+  }
+
+  pPart = tdbPCacheGetPart(pCache, &pPage->pgid);
+
+  tdbPCacheLock(pPart);
   nRef = tdbUnrefPage(pPage);
   tdbTrace("pcache/release page %p/%d/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id, nRef);
   if (nRef == 0) {
@@ -259,26 +355,77 @@ void tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn) {
     // if (nRef == 0) {
     if (pPage->isLocal) {
       if (!pPage->isFree) {
-        tdbPCacheUnpinPage(pCache, pPage);
+        tdbPCacheUnpinPage(pCache, pPart, pPage);
       } else {
-        tdbPCacheFreePage(pCache, pPage);
+        tdbPCacheFreePage(pCache, pPart, pPage);
       }
     } else {
       if (TDB_TXN_IS_WRITE(pTxn)) {
         // remove from hash
-        tdbPCacheRemovePageFromHash(pCache, pPage);
+        tdbPCacheRemovePageFromHash(pCache, pPart, pPage);
       }
 
       tdbPageDestroy(pPage, pTxn->xFree, pTxn->xArg);
     }
     // }
   }
-  tdbPCacheUnlock(pCache);
+  tdbPCacheUnlock(pPart);
 }
 
 int tdbPCacheGetPageSize(SPCache *pCache) { return pCache->szPage; }
 
-static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn) {
+// clock eviction over the lru of a partition: pages hit again since they were loaded get a second chance at the head
+// of the lru, so that a scan over cold pages does not push the hot ones out
+static SPage *tdbPCacheEvictPage(SPCache *pCache, SPCachePart *pPart) {
+  SPage *pPage;
+
+  for (int nLoops = pPart->nRecyclable; nLoops > 0; nLoops--) {
+    pPage = pPart->lru.pLruPrev;
+    if (!pPage->isAccessed) break;
+
+    pPage->isAccessed = 0;
+    pPage->pLruPrev->pLruNext = &(pPart->lru);
+    pPart->lru.pLruPrev = pPage->pLruPrev;
+    pPage->pLruPrev = &(pPart->lru);
+    pPage->pLruNext = pPart->lru.pLruNext;
+    pPart->lru.pLruNext->pLruPrev = pPage;
+    pPart->lru.pLruNext = pPage;
+  }
+
+  pPage = pPart->lru.pLruPrev;
+  if (pPage->isAnchor) {
+    return NULL;
+  }
+
+  tdbPCacheRemovePageFromHash(pCache, pPart, pPage);
+  tdbPCachePinPage(pPart, pPage);
+  return pPage;
+}
+
+// take a free or recyclable page of another partition, never waiting on its lock
+static SPage *tdbPCacheStealPage(SPCache *pCache, SPCachePart *pPart) {
+  SPage *pPage = NULL;
+
+  for (int iPart = 0; iPart < pCache->nPart && pPage == NULL; iPart++) {
+    SPCachePart *pOther = &pCache->aPart[iPart];
+    if (pOther == pPart || tdbMutexTryLock(&pOther->mutex) != 0) continue;
+
+    if (pOther->pFree) {
+      pPage = pOther->pFree;
+      pOther->pFree = pPage->pFreeNext;
+      pOther->nFree--;
+      pPage->pLruNext = NULL;
+    } else {
+      pPage = tdbPCacheEvictPage(pCache, pOther);
+    }
+
+    tdbPCacheUnlock(pOther);
+  }
+
+  return pPage;
+}
+
+static SPage *tdbPCacheFetchImpl(SPCache *pCache, SPCachePart *pPart, const SPgid *pPgid, TXN *pTxn) {
   int    ret = 0;
   SPage *pPage = NULL;
   SPage *pPageH = NULL;
@@ -289,40 +436,43 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   }
 
   // 1. Search the hash table
-  pPage = pCache->pgHash[tdbPCachePageHash(pPgid) % pCache->nHash];
-  while (pPage) {
-    if (pPage->pgid.pgno == pPgid->pgno && memcmp(pPage->pgid.fileid, pPgid->fileid, TDB_FILE_ID_LEN) == 0) break;
-    pPage = pPage->pHashNext;
-  }
+  pPage = tdbPCacheSearchHash(pCache, pPart, pPgid);
 
   if (pPage) {
     if (pPage->isLocal || TDB_TXN_IS_WRITE(pTxn)) {
-      tdbPCachePinPage(pCache, pPage);
+      pPart->nHit++;
+      pPage->isAccessed = 1;
+      tdbPCachePinPage(pPart, pPage);
       return pPage;
     }
   }
 
+  pPart->nMiss++;
+
   // 1. pPage == NULL
   // 2. pPage && !pPage->isLocal == 0 && !TDB_TXN_IS_WRITE(pTxn)
   pPageH = pPage;
   pPage = NULL;
 
   // 2. Try to allocate a new page from the free list
-  if (pCache->pFree) {
-    pPage = pCache->pFree;
-    pCache->pFree = pPage->pFreeNext;
-    pCache->nFree--;
+  if (pPart->pFree) {
+    pPage = pPart->pFree;
+    pPart->pFree = pPage->pFreeNext;
+    pPart->nFree--;
     pPage->pLruNext = NULL;
   }
 
   // 3. Try to Recycle a page
-  if (!pPage && !pCache->lru.pLruPrev->isAnchor) {
-    pPage = pCache->lru.pLruPrev;
-    tdbPCacheRemovePageFromHash(pCache, pPage);
-    tdbPCachePinPage(pCache, pPage);
+  if (!pPage) {
+    pPage = tdbPCacheEvictPage(pCache, pPart);
   }
 
-  // 4. Try a create new page
+  // 4. Try to take a page from the other partitions
+  if (!pPage && pCache->nPart > 1) {
+    pPage = tdbPCacheStealPage(pCache, pPart);
+  }
+
+  // 5. Try a create new page
   if (!pPage && pTxn->xMalloc != NULL) {
     ret = tdbPageCreate(pCache->szPage, &pPage, pTxn->xMalloc, pTxn->xArg);
     if (ret < 0 || pPage == NULL) {
@@ -338,10 +488,11 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
     pPage->id = -1;
   }
 
-  // 5. Page here are just created from a free list
+  // 6. Page here are just created from a free list
   // or by recycling or allocated streesly,
   // need to initialize it
   if (pPage) {
+    pPage->isAccessed = 0;
     if (pPageH) {
       // copy the page content
       memcpy(&(pPage->pgid), pPgid, sizeof(*pPgid));
@@ -371,7 +522,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
       pPage->pPager = NULL;
 
       if (pPage->isLocal || TDB_TXN_IS_WRITE(pTxn)) {
-        tdbPCacheAddPageToHash(pCache, pPage);
+        tdbPCacheAddPageToHash(pCache, pPart, pPage);
       }
     }
   }
@@ -379,7 +530,7 @@ static SPage *tdbPCacheFetchImpl(SPCache *pCache, const SPgid *pPgid, TXN *pTxn)
   return pPage;
 }
 
-static void tdbPCachePinPage(SPCache *pCache, SPage *pPage) {
+static void tdbPCachePinPage(SPCachePart *pPart, SPage *pPage) {
   if (pPage->pLruNext != NULL) {
     int32_t nRef = tdbGetPageRef(pPage);
     if (nRef != 0) {
@@ -391,13 +542,13 @@ static void tdbPCachePinPage(SPCache *pCache, SPage *pPage) {
     pPage->pLruNext->pLruPrev = pPage->pLruPrev;
     pPage->pLruNext = NULL;
 
-    pCache->nRecyclable--;
+    pPart->nRecyclable--;
 
     tdbTrace("pcache/pin page %p/%d, pgno:%d, ", pPage, pPage->id, TDB_PAGE_PGNO(pPage));
   }
 }
 
-static void tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage) {
+static void tdbPCacheUnpinPage(SPCache *pCache, SPCachePart *pPart, SPage *pPage) {
   i32 nRef = tdbGetPageRef(pPage);
   if (nRef != 0) {
     tdbError("tdb/pcache: unpin page's ref not zero: %" PRId32, nRef);
@@ -419,62 +570,82 @@ static void tdbPCacheUnpinPage(SPCache *pCache, SPage *pPage) {
   tdbTrace("pCache:%p unpin page %p/%d, nPages:%d, pgno:%d, ", pCache, pPage, pPage->id, pCache->nPages,
            TDB_PAGE_PGNO(pPage));
   if (pPage->id < pCache->nPages) {
-    pPage->pLruPrev = &(pCache->lru);
-    pPage->pLruNext = pCache->lru.pLruNext;
-    pCache->lru.pLruNext->pLruPrev = pPage;
-    pCache->lru.pLruNext = pPage;
+    pPage->pLruPrev = &(pPart->lru);
+    pPage->pLruNext = pPart->lru.pLruNext;
+    pPart->lru.pLruNext->pLruPrev = pPage;
+    pPart->lru.pLruNext = pPage;
 
-    pCache->nRecyclable++;
+    pPart->nRecyclable++;
 
     // printf("unpin page %d pgno %d pPage %p\n", pPage->id, TDB_PAGE_PGNO(pPage), pPage);
     tdbTrace("pcache/unpin page %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
   } else {
     tdbTrace("pcache destroy page: %p/%d/%d", pPage, TDB_PAGE_PGNO(pPage), pPage->id);
 
-    tdbPCacheRemovePageFromHash(pCache, pPage);
+    tdbPCacheRemovePageFromHash(pCache, pPart, pPage);
     tdbPageDestroy(pPage, tdbDefaultFree, NULL);
   }
 }
 
-static void tdbPCacheRemovePageFromHash(SPCache *pCache, SPage *pPage) {
-  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pCache->nHash;
+static void tdbPCacheRemovePageFromHash(SPCache *pCache, SPCachePart *pPart, SPage *pPage) {
+  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) / pCache->nPart % pPart->nHash;
 
-  SPage **ppPage = &(pCache->pgHash[h]);
+  SPage **ppPage = &(pPart->pgHash[h]);
   for (; (*ppPage) && *ppPage != pPage; ppPage = &((*ppPage)->pHashNext))
     ;
 
   if (*ppPage) {
     *ppPage = pPage->pHashNext;
-    pCache->nPage--;
+    pPart->nPage--;
     // printf("rmv page %d to hash, pgno %d, pPage %p\n", pPage->id, TDB_PAGE_PGNO(pPage), pPage);
   }
 
   tdbTrace("pcache/remove page %p/%d from hash %" PRIu32 " pgno:%d, ", pPage, pPage->id, h, TDB_PAGE_PGNO(pPage));
 }
 
-static void tdbPCacheAddPageToHash(SPCache *pCache, SPage *pPage) {
-  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) % pCache->nHash;
+static void tdbPCacheAddPageToHash(SPCache *pCache, SPCachePart *pPart, SPage *pPage) {
+  uint32_t h = tdbPCachePageHash(&(pPage->pgid)) / pCache->nPart % pPart->nHash;
 
-  pPage->pHashNext = pCache->pgHash[h];
-  pCache->pgHash[h] = pPage;
+  pPage->pHashNext = pPart->pgHash[h];
+  pPart->pgHash[h] = pPage;
 
-  pCache->nPage++;
+  pPart->nPage++;
 
   tdbTrace("pcache/add page %p/%d to hash %" PRIu32 " pgno:%d, ", pPage, pPage->id, h, TDB_PAGE_PGNO(pPage));
 }
 
 static int tdbPCacheOpenImpl(SPCache *pCache) {
   SPage *pPage;
-  u8    *pPtr;
-  int    tsize;
-  int    ret;
+  int    nPartPages = pCache->nPages / pCache->nPart;
+
+  for (int iPart = 0; iPart < pCache->nPart; iPart++) {
+    SPCachePart *pPart = &pCache->aPart[iPart];
 
-  tdbPCacheInitLock(pCache);
+    tdbPCacheInitLock(pPart);
+
+    // Open the free list
+    pPart->nFree = 0;
+    pPart->pFree = NULL;
+
+    // Open the hash table
+    pPart->nPage = 0;
+    pPart->nHash = nPartPages < 8 ? 8 : nPartPages;
+    pPart->pgHash = (SPage **)tdbOsCalloc(pPart->nHash, sizeof(SPage *));
+    if (pPart->pgHash == NULL) {
+      // TODO
+      return -1;
+    }
+
+    // Open LRU list
+    pPart->nRecyclable = 0;
+    pPart->lru.isAnchor = 1;
+    pPart->lru.pLruNext = &(pPart->lru);
+    pPart->lru.pLruPrev = &(pPart->lru);
+  }
 
-  // Open the free list
-  pCache->nFree = 0;
-  pCache->pFree = NULL;
   for (int i = 0; i < pCache->nPages; i++) {
+    SPCachePart *pPart = &pCache->aPart[i % pCache->nPart];
+
     if (tdbPageCreate(pCache->szPage, &pPage, tdbDefaultMalloc, NULL) < 0) {
       // TODO: handle error
       return -1;
@@ -490,50 +661,40 @@ static int tdbPCacheOpenImpl(SPCache *pCache) {
     pPage->pDirtyNext = NULL;
 
     // add page to free list
-    pPage->pFreeNext = pCache->pFree;
-    pCache->pFree = pPage;
-    pCache->nFree++;
+    pPage->pFreeNext = pPart->pFree;
+    pPart->pFree = pPage;
+    pPart->nFree++;
 
     // add to local list
     pPage->id = i;
     pCache->aPage[i] = pPage;
   }
 
-  // Open the hash table
-  pCache->nPage = 0;
-  pCache->nHash = pCache->nPages < 8 ? 8 : pCache->nPages;
-  pCache->pgHash = (SPage **)tdbOsCalloc(pCache->nHash, sizeof(SPage *));
-  if (pCache->pgHash == NULL) {
-    // TODO
-    return -1;
-  }
-
-  // Open LRU list
-  pCache->nRecyclable = 0;
-  pCache->lru.isAnchor = 1;
-  pCache->lru.pLruNext = &(pCache->lru);
-  pCache->lru.pLruPrev = &(pCache->lru);
-
   return 0;
 }
 
 static int tdbPCacheCloseImpl(SPCache *pCache) {
-  // free free page
-  for (SPage *pPage = pCache->pFree; pPage;) {
-    SPage *pPageT = pPage->pFreeNext;
-    tdbPageDestroy(pPage, tdbDefaultFree, NULL);
-    pPage = pPageT;
-  }
+  for (int iPart = 0; iPart < pCache->nPart; iPart++) {
+    SPCachePart *pPart = &pCache->aPart[iPart];
 
-  for (int32_t iBucket = 0; iBucket < pCache->nHash; iBucket++) {
-    for (SPage *pPage = pCache->pgHash[iBucket]; pPage;) {
-      SPage *pPageT = pPage->pHashNext;
+    // free free page
+    for (SPage *pPage = pPart->pFree; pPage;) {
+      SPage *pPageT = pPage->pFreeNext;
       tdbPageDestroy(pPage, tdbDefaultFree, NULL);
       pPage = pPageT;
     }
+
+    for (int32_t iBucket = 0; iBucket < pPart->nHash; iBucket++) {
+      for (SPage *pPage = pPart->pgHash[iBucket]; pPage;) {
+        SPage *pPageT = pPage->pHashNext;
+        tdbPageDestroy(pPage, tdbDefaultFree, NULL);
+        pPage = pPageT;
+      }
+    }
+
+    tdbOsFree(pPart->pgHash);
+    tdbPCacheDestroyLock(pPart);
   }
 
-  tdbOsFree(pCache->pgHash);
-  tdbPCacheDestroyLock(pCache);
   return 0;
 }
@@ -79,6 +79,44 @@ int tdbPageCreate(int pageSize, SPage **ppPage, void *(*xMalloc)(void *, size_t)
   return 0;
 }
 
+int tdbPageCreateMapped(int pageSize, u8 *pData, SPage **ppPage, void *(*xMalloc)(void *, size_t), void *arg) {
+  SPage *pPage;
+
+  if (!xMalloc) {
+    tdbError("tdb/page-create-mapped: null xMalloc.");
+    return -1;
+  }
+
+  if (!TDB_IS_PGSIZE_VLD(pageSize)) {
+    tdbError("tdb/page-create-mapped: invalid pageSize: %d.", pageSize);
+    return -1;
+  }
+
+  *ppPage = NULL;
+
+  // only the page header is allocated, the content stays in the map and must never be written
+  pPage = (SPage *)(xMalloc(arg, sizeof(*pPage)));
+  if (pPage == NULL) {
+    return -1;
+  }
+
+  memset(pPage, 0, sizeof(*pPage));
+  TDB_INIT_PAGE_LOCK(pPage);
+  pPage->pageSize = pageSize;
+  pPage->pData = pData;
+  pPage->isMapped = 1;
+  if (pageSize < 65536) {
+    pPage->pPageMethods = &pageMethods;
+  } else {
+    pPage->pPageMethods = &pageLargeMethods;
+  }
+
+  *ppPage = pPage;
+
+  tdbTrace("tdb/page-create-mapped: %p %p %p", pPage, pData, xMalloc);
+  return 0;
+}
+
 int tdbPageDestroy(SPage *pPage, void (*xFree)(void *arg, void *ptr), void *arg) {
   u8 *ptr;
 
@@ -99,7 +137,7 @@ int tdbPageDestroy(SPage *pPage, void (*xFree)(void *arg, void *ptr), void *arg)
     tdbOsFree(pPage->apOvfl[iOvfl]);
   }
 
-  ptr = pPage->pData;
+  ptr = pPage->isMapped ? (u8 *)pPage : pPage->pData;
   xFree(arg, ptr);
 
   return 0;
@@ -129,6 +167,16 @@ void tdbPageInit(SPage *pPage, u8 szAmHdr, int (*xCellSize)(const SPage *, SCell
   tdbTrace("page/init: %p %" PRIu8 " %p", pPage, szAmHdr, xCellSize);
   pPage->pPageHdr = pPage->pData + szAmHdr;
   if (TDB_PAGE_NCELLS(pPage) == 0) {
+    if (pPage->isMapped) {
+      // lay out an empty mapped page without zeroing it, the map is read-only
+      pPage->pCellIdx = pPage->pPageHdr + TDB_PAGE_HDR_SIZE(pPage);
+      pPage->pFreeStart = pPage->pCellIdx;
+      pPage->pPageFtr = (SPageFtr *)(pPage->pData + pPage->pageSize - sizeof(SPageFtr));
+      pPage->pFreeEnd = (u8 *)pPage->pPageFtr;
+      pPage->nOverflow = 0;
+      pPage->xCellSize = xCellSize;
+      return;
+    }
     return tdbPageZero(pPage, szAmHdr, xCellSize);
   }
   pPage->pCellIdx = pPage->pPageHdr + TDB_PAGE_HDR_SIZE(pPage);
@@ -143,6 +143,9 @@ static int tdbPagerInitPage(SPager *pPager, SPage *pPage, int (*initPage)(SPage
                             u8 loadPage);
 static int tdbPagerWritePageToJournal(SPager *pPager, SPage *pPage);
 static int tdbPagerPWritePageToDB(SPager *pPager, SPage *pPage);
+static int tdbPagerMapFile(SPager *pPager);
+static void tdbPagerUnmapFile(SPager *pPager);
+static void tdbPagerSetMapDirty(SPager *pPager, SPgno pgno, int8_t dirty);
 
 static FORCE_INLINE int32_t pageCmpFn(const SRBTreeNode *lhs, const SRBTreeNode *rhs) {
   SPage *pPageL = (SPage *)(((uint8_t *)lhs) - offsetof(SPage, node));
@@ -213,6 +216,11 @@ int tdbPagerOpen(SPCache *pCache, const char *fileName, SPager **ppPager) {
   tdbTrace("pager/open reset dirty tree: %p", &pPager->rbt);
   tRBTreeCreate(&pPager->rbt, pageCmpFn);
 
+  // read txns fall back to the page cache if the file can not be mapped
+  if (tdbPagerMapFile(pPager) < 0) {
+    tdbWarn("failed to map file:%s, read from the page cache instead", pPager->dbFileName);
+  }
+
   *ppPager = pPager;
   return 0;
 }
@@ -224,6 +232,7 @@ int tdbPagerClose(SPager *pPager) {
       tdbOsClose(pPager->jfd);
     }
     */
+    tdbPagerUnmapFile(pPager);
     tdbOsClose(pPager->fd);
     tdbOsFree(pPager);
   }
@@ -242,6 +251,7 @@ int tdbPagerWrite(SPager *pPager, SPage *pPage) {
 
   // Set page as dirty
   pPage->isDirty = 1;
+  tdbPagerSetMapDirty(pPager, TDB_PAGE_PGNO(pPage), 1);
 
   tdbTrace("tdb/pager-write: put page: %p %d to dirty tree: %p", pPage, TDB_PAGE_PGNO(pPage), &pPager->rbt);
   tRBTreePut(&pPager->rbt, (SRBTreeNode *)pPage);
@@ -349,6 +359,7 @@ int tdbPagerCommit(SPager *pPager, TXN *pTxn) {
     pPage = (SPage *)pNode;
 
     pPage->isDirty = 0;
+    tdbPagerSetMapDirty(pPager, TDB_PAGE_PGNO(pPage), 0);
 
     tRBTreeDrop(&pPager->rbt, (SRBTreeNode *)pPage);
     if (pTxn->jPageSet) {
@@ -370,6 +381,10 @@ int tdbPagerCommit(SPager *pPager, TXN *pTxn) {
     return -1;
   }
 
+  if (tdbPagerMapFile(pPager) < 0) {
+    tdbWarn("failed to remap file:%s, pages beyond the map are read from the page cache", pPager->dbFileName);
+  }
+
   return 0;
 }
 
@@ -438,11 +453,16 @@ int tdbPagerPrepareAsyncCommit(SPager *pPager, TXN *pTxn) {
     pPage = (SPage *)pNode;
     if (pPage->isLocal) continue;
     pPage->isDirty = 0;
+    tdbPagerSetMapDirty(pPager, TDB_PAGE_PGNO(pPage), 0);
 
     tRBTreeDrop(&pPager->rbt, (SRBTreeNode *)pPage);
     tdbPCacheRelease(pPager->pCache, pPage, pTxn);
   }
 
+  if (tdbPagerMapFile(pPager) < 0) {
+    tdbWarn("failed to remap file:%s, pages beyond the map are read from the page cache", pPager->dbFileName);
+  }
+
   /*
   tdbTrace("reset dirty tree: %p", &pPager->rbt);
   tRBTreeCreate(&pPager->rbt, pageCmpFn);
@@ -554,6 +574,7 @@ int tdbPagerAbort(SPager *pPager, TXN *pTxn) {
     tdbTrace("pager/abort: drop dirty pgno:%d,", pgno);
 
     pPage->isDirty = 0;
+    tdbPagerSetMapDirty(pPager, pgno, 0);
 
     tRBTreeDrop(&pPager->rbt, (SRBTreeNode *)pPage);
     hashset_remove(pTxn->jPageSet, (void *)((long)TDB_PAGE_PGNO(pPage)));
@@ -648,7 +669,9 @@ int tdbPagerFlushPage(SPager *pPager, TXN *pTxn) {
   return 0;
 }
 
-static int tdbPagerAllocPage(SPager *pPager, SPgno *ppgno, TXN *pTxn);
+static int    tdbPagerAllocPage(SPager *pPager, SPgno *ppgno, TXN *pTxn);
+static SPage *tdbPagerFetchMappedPage(SPager *pPager, SPgno pgno, int (*initPage)(SPage *, void *, int), void *arg,
+                                      TXN *pTxn);
 
 int tdbPagerFetchPage(SPager *pPager, SPgno *ppgno, SPage **ppPage, int (*initPage)(SPage *, void *, int), void *arg,
                       TXN *pTxn) {
@@ -676,6 +699,16 @@ int tdbPagerFetchPage(SPager *pPager, SPgno *ppgno, SPage **ppPage, int (*initPa
     return -1;
   }
 
+  // read txns traverse the committed pages in place, without going through the page cache
+  if (loadPage && pTxn && TDB_TXN_IS_READ(pTxn)) {
+    pPage = tdbPagerFetchMappedPage(pPager, pgno, initPage, arg, pTxn);
+    if (pPage) {
+      *ppgno = pgno;
+      *ppPage = pPage;
+      return 0;
+    }
+  }
+
   // fetch a page container
   memcpy(&pgid, pPager->fid, TDB_FILE_ID_LEN);
   pgid.pgno = pgno;
@@ -906,6 +939,121 @@ static int tdbPagerInitPage(SPager *pPager, SPage *pPage, int (*initPage)(SPage
   return 0;
 }
 
+// ---------------------------- File map
+#define TDB_PAGER_MAP_MIN_PAGES 1024
+
+static int tdbPagerMapFile(SPager *pPager) {
+  SPagerMap *pMap = pPager->pMap;
+  SPgno      nPage = 0;
+
+  if (tdbGetFileSize(pPager->fd, pPager->pageSize, &nPage) < 0) {
+    return -1;
+  }
+
+  // pages not written to the file yet are not readable through the map
+  nPage = TMIN(nPage, pPager->dbOrigSize);
+  if (nPage == 0) {
+    return 0;
+  }
+
+  if (pMap == NULL || nPage > pMap->nCap) {
+    SPgno      nCap = (SPgno)TMIN((i64)nPage * 2, INT32_MAX);
+    SPagerMap *pNew;
+
+    nCap = TMAX(nCap, TDB_PAGER_MAP_MIN_PAGES);
+    pNew = (SPagerMap *)tdbOsCalloc(1, sizeof(*pNew) + nCap);
+    if (pNew == NULL) {
+      return -1;
+    }
+
+    // the map is larger than the file so that it is not redone on each commit, pages beyond the end of the file
+    // are never touched
+    pNew->size = (i64)nCap * pPager->pageSize;
+    pNew->pData = taosMmapReadOnlyFile(pPager->fd, pNew->size);
+    if (pNew->pData == NULL) {
+      tdbOsFree(pNew);
+      return -1;
+    }
+    pNew->nCap = nCap;
+
+    // pages still dirty in the cache must not be read from the file
+    SRBTreeIter  iter = tRBTreeIterCreate(&pPager->rbt, 1);
+    SRBTreeNode *pNode = NULL;
+    while ((pNode = tRBTreeIterNext(&iter)) != NULL) {
+      SPgno pgno = TDB_PAGE_PGNO((SPage *)pNode);
+      if (pgno <= nCap) {
+        pNew->aDirty[pgno - 1] = 1;
+      }
+    }
+
+    pNew->pPrev = pMap;
+    atomic_store_ptr(&pPager->pMap, pNew);
+    pMap = pNew;
+
+    tdbDebug("pager/map: %p, file:%s, pages:%d, cap:%d", pPager, pPager->dbFileName, nPage, nCap);
+  }
+
+  atomic_store_32(&pMap->nPage, (i32)nPage);
+  return 0;
+}
+
+static void tdbPagerUnmapFile(SPager *pPager) {
+  SPagerMap *pMap = pPager->pMap;
+
+  while (pMap) {
+    SPagerMap *pPrev = pMap->pPrev;
+    taosMunmapFile(pMap->pData, pMap->size);
+    tdbOsFree(pMap);
+    pMap = pPrev;
+  }
+
+  pPager->pMap = NULL;
+}
+
+static void tdbPagerSetMapDirty(SPager *pPager, SPgno pgno, int8_t dirty) {
+  SPagerMap *pMap = pPager->pMap;
+
+  if (pMap && pgno > 0 && pgno <= pMap->nCap) {
+    atomic_store_8((int8_t *)&pMap->aDirty[pgno - 1], dirty);
+  }
+}
+
+static SPage *tdbPagerFetchMappedPage(SPager *pPager, SPgno pgno, int (*initPage)(SPage *, void *, int), void *arg,
+                                      TXN *pTxn) {
+  SPagerMap *pMap = (SPagerMap *)atomic_load_ptr(&pPager->pMap);
+  SPage     *pPage = NULL;
+
+  if (pMap == NULL || pTxn->xMalloc == NULL) {
+    return NULL;
+  }
+
+  // pages dirtied by the write txn are only up to date in the page cache
+  if (pgno > (SPgno)atomic_load_32(&pMap->nPage) || atomic_load_8((int8_t *)&pMap->aDirty[pgno - 1])) {
+    return NULL;
+  }
+
+  if (tdbPageCreateMapped(pPager->pageSize, pMap->pData + (i64)pPager->pageSize * (pgno - 1), &pPage, pTxn->xMalloc,
+                          pTxn->xArg) < 0) {
+    return NULL;
+  }
+
+  memcpy(&pPage->pgid, pPager->fid, TDB_FILE_ID_LEN);
+  pPage->pgid.pgno = pgno;
+  pPage->id = -1;
+
+  if ((*initPage)(pPage, arg, 1) < 0) {
+    tdbError("tdb/pager:%p, pgno:%d, init mapped page failed.", pPager, pgno);
+    tdbPageDestroy(pPage, pTxn->xFree, pTxn->xArg);
+    return NULL;
+  }
+
+  pPage->pPager = pPager;
+  tdbRefPage(pPage);
+
+  tdbTrace("tdb/pager:%p, fetch mapped page %p/%d", pPager, pPage, pgno);
+  return pPage;
+}
+
 // ---------------------------- Journal manipulation
 static int tdbPagerWritePageToJournal(SPager *pPager, SPage *pPage) {
   int   ret;
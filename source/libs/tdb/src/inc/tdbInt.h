@@ -210,6 +210,8 @@ int tdbPagerRollback(SPager *pPager);
   u8           isLocal;    \
   u8           isDirty;    \
   u8           isFree;     \
+  u8           isMapped;   \
+  u8           isAccessed; \
   volatile i32 nRef;       \
   i32          id;         \
   SPage       *pFreeNext;  \
@@ -225,6 +227,7 @@ int tdbPagerRollback(SPager *pPager);
 int    tdbPCacheOpen(int pageSize, int cacheSize, SPCache **ppCache);
 int    tdbPCacheClose(SPCache *pCache);
 int    tdbPCacheAlter(SPCache *pCache, int32_t nPage);
+void   tdbPCacheGetStat(SPCache *pCache, STdbCacheStat *pStat);
 SPage *tdbPCacheFetch(SPCache *pCache, const SPgid *pPgid, TXN *pTxn);
 void   tdbPCacheRelease(SPCache *pCache, SPage *pPage, TXN *pTxn);
 void   tdbPCacheMarkFree(SPCache *pCache, SPage *pPage);
@@ -338,6 +341,7 @@ static inline int tdbTryLockPage(tdb_spinlock_t *pLock) {
 #define TDB_PAGE_OFFSET_SIZE(pPage) ((pPage)->pPageMethods->szOffset)
 
 int  tdbPageCreate(int pageSize, SPage **ppPage, void *(*xMalloc)(void *, size_t), void *arg);
+int  tdbPageCreateMapped(int pageSize, u8 *pData, SPage **ppPage, void *(*xMalloc)(void *, size_t), void *arg);
 int  tdbPageDestroy(SPage *pPage, void (*xFree)(void *arg, void *ptr), void *arg);
 void tdbPageZero(SPage *pPage, u8 szAmHdr, int (*xCellSize)(const SPage *, SCell *, int, TXN *, SBTree *pBt));
 void tdbPageInit(SPage *pPage, u8 szAmHdr, int (*xCellSize)(const SPage *, SCell *, int, TXN *, SBTree *pBt));
@@ -394,6 +398,17 @@ struct STDB {
   int64_t txnId;
 };
 
+// read-only map of the committed part of a db file, pages of a read txn are read from it in place
+typedef struct SPagerMap SPagerMap;
+struct SPagerMap {
+  u8          *pData;
+  i64          size;
+  SPgno        nCap;   // pages the map spans
+  volatile i32 nPage;  // pages readable through the map
+  SPagerMap   *pPrev;  // retired maps, kept until the pager is closed since readers may still be on them
+  u8           aDirty[];
+};
+
 struct SPager {
   char    *dbFileName;
   char    *jFileName;
@@ -406,11 +421,12 @@ struct SPager {
   // SPage   *pDirty;
   SRBTree rbt;
   // u8        inTran;
-  TXN    *pActiveTxn;
-  SArray *ofps;
-  SArray *frps;
-  SPager *pNext;      // used by TDB
-  SPager *pHashNext;  // used by TDB
+  TXN       *pActiveTxn;
+  SArray    *ofps;
+  SArray    *frps;
+  SPagerMap *pMap;
+  SPager    *pNext;      // used by TDB
+  SPager    *pHashNext;  // used by TDB
 #ifdef USE_MAINDB
   TDB *pEnv;
 #endif
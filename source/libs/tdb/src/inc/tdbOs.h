@@ -83,6 +83,7 @@ typedef TdThreadMutex tdb_mutex_t;
 #define tdbMutexInit    taosThreadMutexInit
 #define tdbMutexDestroy taosThreadMutexDestroy
 #define tdbMutexLock    taosThreadMutexLock
+#define tdbMutexTryLock taosThreadMutexTryLock
 #define tdbMutexUnlock  taosThreadMutexUnlock
 
 #else
@@ -141,6 +142,7 @@ typedef pthread_mutex_t tdb_mutex_t;
 #define tdbMutexInit    pthread_mutex_init
 #define tdbMutexDestroy pthread_mutex_destroy
 #define tdbMutexLock    pthread_mutex_lock
+#define tdbMutexTryLock pthread_mutex_trylock
 #define tdbMutexUnlock  pthread_mutex_unlock
 
 #endif
@@ -0,0 +1,176 @@
+#include <gtest/gtest.h>
+
+#define ALLOW_FORBID_FUNC
+#include "os.h"
+#include "tdbInt.h"
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+// a cache of 256 pages is split into 4 partitions of 64 pages. The pages of a zero file id hash to their pgno, so pgnos
+// that are multiples of TDB_PCACHE_PGNO_STEP all fall into the first partition, whatever the number of partitions.
+#define TDB_PCACHE_TEST_PAGES 256
+#define TDB_PCACHE_PGNO_STEP  16
+
+static SPgid pcacheTestPgid(SPgno pgno) {
+  SPgid pgid;
+  memset(&pgid, 0, sizeof(pgid));
+  pgid.pgno = pgno;
+  return pgid;
+}
+
+static void pcacheTestTxn(TXN *pTxn) {
+  memset(pTxn, 0, sizeof(*pTxn));
+  pTxn->flags = TDB_TXN_WRITE;
+  // no page is allocated out of the cache, a fetch fails when all pages are pinned
+  pTxn->xMalloc = NULL;
+}
+
+static SPage *pcacheTestFetch(SPCache *pCache, SPgno pgno, TXN *pTxn) {
+  SPgid  pgid = pcacheTestPgid(pgno);
+  SPage *pPage = tdbPCacheFetch(pCache, &pgid, pTxn);
+  if (pPage) {
+    EXPECT_EQ(pPage->pgid.pgno, pgno);
+  }
+  return pPage;
+}
+
+TEST(tdb_pcache_test, steal_from_other_partitions) {
+  SPCache      *pCache = NULL;
+  TXN           txn;
+  STdbCacheStat stat0, stat1;
+
+  pcacheTestTxn(&txn);
+  ASSERT_EQ(tdbPCacheOpen(4096, TDB_PCACHE_TEST_PAGES, &pCache), 0);
+
+  // all pages of the cache are pinned by pgnos of one partition, the pages of the others are stolen
+  std::vector<SPage *> pages;
+  for (int i = 0; i < TDB_PCACHE_TEST_PAGES; i++) {
+    SPage *pPage = pcacheTestFetch(pCache, i * TDB_PCACHE_PGNO_STEP, &txn);
+    ASSERT_NE(pPage, nullptr);
+    pages.push_back(pPage);
+  }
+  ASSERT_EQ(pcacheTestFetch(pCache, TDB_PCACHE_TEST_PAGES * TDB_PCACHE_PGNO_STEP, &txn), nullptr);
+
+  for (SPage *pPage : pages) {
+    tdbPCacheRelease(pCache, pPage, &txn);
+  }
+
+  // the stolen pages stay cached in the partition of their pgno
+  tdbPCacheGetStat(pCache, &stat0);
+  for (int i = 0; i < TDB_PCACHE_TEST_PAGES; i++) {
+    SPage *pPage = pcacheTestFetch(pCache, i * TDB_PCACHE_PGNO_STEP, &txn);
+    ASSERT_NE(pPage, nullptr);
+    tdbPCacheRelease(pCache, pPage, &txn);
+  }
+  tdbPCacheGetStat(pCache, &stat1);
+  EXPECT_EQ(stat1.nHit - stat0.nHit, TDB_PCACHE_TEST_PAGES);
+  EXPECT_EQ(stat1.nMiss - stat0.nMiss, 0);
+
+  // pages of the other partitions are recycled from the lru of the first one
+  for (int i = 0; i < TDB_PCACHE_TEST_PAGES; i++) {
+    SPage *pPage = pcacheTestFetch(pCache, i * TDB_PCACHE_PGNO_STEP + 1, &txn);
+    ASSERT_NE(pPage, nullptr);
+    pages[i] = pPage;
+  }
+  for (SPage *pPage : pages) {
+    tdbPCacheRelease(pCache, pPage, &txn);
+  }
+
+  tdbPCacheClose(pCache);
+}
+
+TEST(tdb_pcache_test, clock_eviction_keeps_hot_pages) {
+  SPCache      *pCache = NULL;
+  TXN           txn;
+  STdbCacheStat stat0, stat1;
+  const int     nHot = 16;
+  const int     nCold = 60;  // 48 take the free pages of the partition, 12 evict pages
+
+  pcacheTestTxn(&txn);
+  ASSERT_EQ(tdbPCacheOpen(4096, TDB_PCACHE_TEST_PAGES, &pCache), 0);
+
+  // hot pages are loaded and hit once, so they have the second chance
+  for (int round = 0; round < 2; round++) {
+    for (int i = 0; i < nHot; i++) {
+      SPage *pPage = pcacheTestFetch(pCache, i * TDB_PCACHE_PGNO_STEP, &txn);
+      ASSERT_NE(pPage, nullptr);
+      tdbPCacheRelease(pCache, pPage, &txn);
+    }
+  }
+
+  // the hot pages are the least recently used when the scan of cold pages evicts, a plain lru would drop them
+  for (int i = 0; i < nCold; i++) {
+    SPage *pPage = pcacheTestFetch(pCache, (1000 + i) * TDB_PCACHE_PGNO_STEP, &txn);
+    ASSERT_NE(pPage, nullptr);
+    tdbPCacheRelease(pCache, pPage, &txn);
+  }
+
+  tdbPCacheGetStat(pCache, &stat0);
+  for (int i = 0; i < nHot; i++) {
+    SPage *pPage = pcacheTestFetch(pCache, i * TDB_PCACHE_PGNO_STEP, &txn);
+    ASSERT_NE(pPage, nullptr);
+    tdbPCacheRelease(pCache, pPage, &txn);
+  }
+  tdbPCacheGetStat(pCache, &stat1);
+  EXPECT_EQ(stat1.nHit - stat0.nHit, nHot);
+  EXPECT_EQ(stat1.nMiss - stat0.nMiss, 0);
+
+  // the oldest cold page is evicted instead
+  SPage *pPage = pcacheTestFetch(pCache, 1000 * TDB_PCACHE_PGNO_STEP, &txn);
+  ASSERT_NE(pPage, nullptr);
+  tdbPCacheRelease(pCache, pPage, &txn);
+  tdbPCacheGetStat(pCache, &stat0);
+  EXPECT_EQ(stat0.nMiss - stat1.nMiss, 1);
+
+  tdbPCacheClose(pCache);
+}
+
+TEST(tdb_pcache_test, concurrent_fetch_release) {
+  SPCache      *pCache = NULL;
+  STdbCacheStat stat;
+  const int     nThreads = 8;
+  const int     nFetch = 50000;
+  const int     nHot = 48;
+  const int     nPgno = 1024;  // the working set is four times the cache
+  std::atomic<int> nFailed(0);
+
+  ASSERT_EQ(tdbPCacheOpen(4096, TDB_PCACHE_TEST_PAGES, &pCache), 0);
+
+  // half of the fetches are of a hot set spread over the partitions, the others of the whole working set
+  auto f = [&](int iThread) {
+    TXN          txn;
+    std::mt19937 rng(iThread);
+
+    pcacheTestTxn(&txn);
+    for (int i = 0; i < nFetch; i++) {
+      SPgno  pgno = (i % 2) ? rng() % nHot : rng() % nPgno;
+      SPgid  pgid = pcacheTestPgid(pgno);
+      SPage *pPage = tdbPCacheFetch(pCache, &pgid, &txn);
+      if (pPage == NULL || pPage->pgid.pgno != pgno) {
+        nFailed++;
+        continue;
+      }
+      tdbPCacheRelease(pCache, pPage, &txn);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; i++) {
+    threads.push_back(std::thread(f, i));
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+
+  tdbPCacheGetStat(pCache, &stat);
+  EXPECT_EQ(nFailed.load(), 0);
+  EXPECT_EQ(stat.nHit + stat.nMiss, (int64_t)nThreads * nFetch);
+  EXPECT_GT(stat.nHit, (int64_t)nThreads * nFetch / 4);
+  EXPECT_GT(stat.nMiss, 0);
+  EXPECT_GT(stat.nContention, 0);
+
+  tdbPCacheClose(pCache);
+}
@@ -585,6 +585,79 @@ TEST(tdb_test, multi_thread_query) {
   GTEST_ASSERT_EQ(ret, 0);
 }
 
+TEST(tdb_test, read_mapped_and_dirty_pages) {
+  int  ret;
+  TDB *pEnv;
+  TTB *pDb;
+  TXN *txn;
+  int  nData = 20000;
+  char key[64];
+  char val[64];
+
+  SPoolMem *pPool = openPool();
+
+  taosRemoveDir("tdb");
+
+  ret = tdbOpen("tdb", 4096, 64, &pEnv, 0);
+  GTEST_ASSERT_EQ(ret, 0);
+
+  ret = tdbTbOpen("db.db", -1, -1, tKeyCmpr, pEnv, &pDb, 0);
+  GTEST_ASSERT_EQ(ret, 0);
+
+  // the committed pages are read in place from the file map
+  tdbBegin(pEnv, &txn, poolMalloc, poolFree, pPool, TDB_TXN_WRITE | TDB_TXN_READ_UNCOMMITTED);
+  for (int iData = 0; iData < nData; iData++) {
+    sprintf(key, "key%d", iData);
+    sprintf(val, "value%d", iData);
+    ret = tdbTbInsert(pDb, key, strlen(key), val, strlen(val), txn);
+    GTEST_ASSERT_EQ(ret, 0);
+  }
+  tdbCommit(pEnv, txn);
+  tdbPostCommit(pEnv, txn);
+  clearPool(pPool);
+
+  // the pages dirtied by the next txn must be read from the page cache
+  tdbBegin(pEnv, &txn, poolMalloc, poolFree, pPool, TDB_TXN_WRITE | TDB_TXN_READ_UNCOMMITTED);
+  for (int iData = 0; iData < nData; iData += 3) {
+    sprintf(key, "key%d", iData);
+    sprintf(val, "value%d-1", iData);
+    ret = tdbTbUpsert(pDb, key, strlen(key), val, strlen(val), txn);
+    GTEST_ASSERT_EQ(ret, 0);
+  }
+
+  for (int round = 0; round < 2; round++) {
+    void *pVal = NULL;
+    int   vLen;
+
+    for (int iData = 0; iData < nData; iData++) {
+      sprintf(key, "key%d", iData);
+      sprintf(val, iData % 3 ? "value%d" : "value%d-1", iData);
+      ret = tdbTbGet(pDb, key, strlen(key), &pVal, &vLen);
+      GTEST_ASSERT_EQ(ret, 0);
+      GTEST_ASSERT_EQ(vLen, strlen(val));
+      GTEST_ASSERT_EQ(memcmp(val, pVal, vLen), 0);
+    }
+    tdbFree(pVal);
+
+    if (round == 0) {
+      tdbCommit(pEnv, txn);
+      tdbPostCommit(pEnv, txn);
+    }
+  }
+
+  STdbCacheStat stat;
+  tdbGetCacheStat(pEnv, &stat);
+  GTEST_ASSERT_GT(stat.nHit, 0);
+
+  ret = tdbTbClose(pDb);
+  GTEST_ASSERT_EQ(ret, 0);
+
+  ret = tdbClose(pEnv);
+  GTEST_ASSERT_EQ(ret, 0);
+
+  closePool(pPool);
+}
+
 TEST(tdb_test, DISABLED_multi_thread1) {
 #if 0
   int           ret;
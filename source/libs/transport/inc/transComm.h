@@ -314,6 +314,16 @@ void transSetIpWhiteList(void* shandle, void* arg, FilteFunc* func);
 
 int transSockInfo2Str(struct sockaddr* sockname, char* dst);
 
+/*
+ * A server also listens on a unix domain socket named after its ip and port, a client on the same host connects to it
+ * instead of the tcp port and skips the tcp stack, the messages keep the same framing. Return -1 if the socket is not
+ * supported or its path does not fit in a socket address.
+ */
+#define TRANS_LOCAL_SOCK_PATH_LEN       104
+#define TRANS_LOCAL_SOCK_RETRY_INTERVAL 60000  // ms a client uses tcp after failing to connect a local socket
+
+int transLocalSockPath(uint32_t ip, uint16_t port, char* path, int32_t len);
+
 int64_t transAllocHandle();
 
 void* transInitServer(uint32_t ip, uint32_t port, char* label, int numOfThreads, void* fp, void* shandle);
@@ -422,8 +432,33 @@ void transInit();
 void transCleanup();
 void transPrintEpSet(SEpSet* pEpSet);
 
+/*
+ * msg buffers, the STransMsgHead and the content behind it. A buffer of up to TRANS_BUF_MAX_SIZE bytes is rounded up
+ * to a power of two and reused through a cache of the calling thread, which exchanges buffers in batches with a
+ * shared pool of the size class, so that a buffer freed by another thread than the one allocating it is reused too
+ */
+#define TRANS_BUF_MIN_SHIFT 8   // 256B
+#define TRANS_BUF_MAX_SHIFT 16  // 64KB
+#define TRANS_BUF_MAX_SIZE  (1 << TRANS_BUF_MAX_SHIFT)
+
+void* transBufMalloc(int64_t size);
+void* transBufCalloc(int64_t size);
+void* transBufRealloc(void* buf, int64_t size);
+void  transBufFree(void* buf);
+void  transBufGetStat(SRpcBufStat* pStat);
+
+/*
+ * buffers attached to a msg buffer are written to the stream behind it, so a large body is sent without being copied
+ * into the msg buffer, and they are freed with it. The msg length counts them, the msg buffer itself holds only the
+ * bytes before them, so a msg with buffers attached is not compressed
+ */
+int32_t transBufAddRef(void* buf, void* pData, int32_t len, void* pOwner, void (*freeFp)(void*));
+int32_t transBufGetRefNum(void* buf);
+int64_t transBufGetRefLen(void* buf);
+void    transBufGetRefs(void* buf, uv_buf_t* pBufs);
+
 void    transFreeMsg(void* msg);
-int32_t transCompressMsg(char* msg, int32_t len);
+int32_t transCompressMsg(char** msg, int32_t len);
 int32_t transDecompressMsg(char** msg, int32_t len);
 
 int32_t transOpenRefMgt(int size, void (*func)(void*));
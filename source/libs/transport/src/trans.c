@@ -127,7 +127,7 @@ void rpcCloseImpl(void* arg) {
 
 void* rpcMallocCont(int64_t contLen) {
   int64_t size = contLen + TRANS_MSG_OVERHEAD;
-  char*   start = taosMemoryCalloc(1, size);
+  char*   start = transBufCalloc(size);
   if (start == NULL) {
     tError("failed to malloc msg, size:%" PRId64, size);
     terrno = TSDB_CODE_OUT_OF_MEMORY;
@@ -141,7 +141,7 @@ void* rpcMallocCont(int64_t contLen) {
 
 void rpcFreeCont(void* cont) {
   if (cont == NULL) return;
-  taosMemoryFree((char*)cont - TRANS_MSG_OVERHEAD);
+  transBufFree((char*)cont - TRANS_MSG_OVERHEAD);
   tTrace("rpc free cont:%p", (char*)cont - TRANS_MSG_OVERHEAD);
 }
 
@@ -150,7 +150,7 @@ void* rpcReallocCont(void* ptr, int64_t contLen) {
 
   char*   st = (char*)ptr - TRANS_MSG_OVERHEAD;
   int64_t sz = contLen + TRANS_MSG_OVERHEAD;
-  st = taosMemoryRealloc(st, sz);
+  st = transBufRealloc(st, sz);
   if (st == NULL) {
     terrno = TSDB_CODE_OUT_OF_MEMORY;
     return NULL;
@@ -159,6 +159,12 @@ void* rpcReallocCont(void* ptr, int64_t contLen) {
   return st + TRANS_MSG_OVERHEAD;
 }
 
+void rpcGetBufStat(SRpcBufStat* pStat) { transBufGetStat(pStat); }
+
+int32_t rpcAddContRef(void* pCont, void* pData, int32_t len, void* pOwner, void (*freeFp)(void*)) {
+  return transBufAddRef((char*)pCont - TRANS_MSG_OVERHEAD, pData, len, pOwner, freeFp);
+}
+
 int rpcSendRequest(void* shandle, const SEpSet* pEpSet, SRpcMsg* pMsg, int64_t* pRid) {
   return transSendRequest(shandle, pEpSet, pMsg, NULL);
 }
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "transComm.h"
+
+#define TRANS_BUF_CLASSES      (TRANS_BUF_MAX_SHIFT - TRANS_BUF_MIN_SHIFT + 1)
+#define TRANS_BUF_BIG_CLASS    -1
+#define TRANS_BUF_THREAD_CACHE (32 * 1024)        // bytes of a size class cached by a thread, at least 2 buffers
+#define TRANS_BUF_POOL_CACHE   (2 * 1024 * 1024)  // bytes of a size class kept by the shared pool
+#define TRANS_BUF_STAT_OPS     64                 // a thread adds its counters to the shared ones every so many ops
+
+#define TRANS_BUF_CLASS_SIZE(cls) ((int64_t)1 << ((cls) + TRANS_BUF_MIN_SHIFT))
+
+// a buffer attached to a msg buffer, pOwner is freed by freeFp along with the msg buffer
+typedef struct {
+  void*   pData;
+  int32_t len;
+  void*   pOwner;
+  void (*freeFp)(void*);
+} STransBufRef;
+
+typedef struct {
+  int64_t       size;       // usable bytes behind the head
+  int32_t       cls;        // size class, TRANS_BUF_BIG_CLASS for a buffer not pooled
+  int32_t       numOfRefs;  // buffers attached, sent behind this one in the order attached
+  STransBufRef* pRefs;
+  int64_t       refLen;
+} STransBufHead;
+
+// a free buffer, linked through its first bytes
+typedef struct STransBufNode {
+  struct STransBufNode* next;
+} STransBufNode;
+
+typedef struct {
+  STransBufNode* head;
+  int32_t        num;
+} STransBufList;
+
+typedef struct {
+  TdThreadMutex mutex;
+  STransBufList list;
+} STransBufPool;
+
+typedef struct {
+  int8_t        inited;
+  int32_t       ops;
+  SRpcBufStat   stat;  // not yet added to transBufStat
+  STransBufList lists[TRANS_BUF_CLASSES];
+} STransBufCache;
+
+static TdThreadOnce               transBufInit = PTHREAD_ONCE_INIT;
+static TdThreadKey                transBufKey;
+static STransBufPool              transBufPools[TRANS_BUF_CLASSES];
+static SRpcBufStat                transBufStat;
+static threadlocal STransBufCache transBufCache;
+
+static void transBufCacheDestroy(void* param);
+
+static void transBufInitOnce() {
+  for (int32_t cls = 0; cls < TRANS_BUF_CLASSES; ++cls) {
+    taosThreadMutexInit(&transBufPools[cls].mutex, NULL);
+  }
+  taosThreadKeyCreate(&transBufKey, transBufCacheDestroy);
+}
+
+static FORCE_INLINE int32_t transBufClass(int64_t size) {
+  if (size > TRANS_BUF_MAX_SIZE) return TRANS_BUF_BIG_CLASS;
+  if (size <= TRANS_BUF_CLASS_SIZE(0)) return 0;
+  return 64 - BUILDIN_CLZL((uint64_t)size - 1) - TRANS_BUF_MIN_SHIFT;
+}
+
+static FORCE_INLINE int32_t transBufThreadCap(int32_t cls) {
+  int32_t cap = (int32_t)(TRANS_BUF_THREAD_CACHE / TRANS_BUF_CLASS_SIZE(cls));
+  return cap < 2 ? 2 : cap;
+}
+
+static FORCE_INLINE STransBufCache* transBufGetCache() {
+  STransBufCache* pCache = &transBufCache;
+  if (!pCache->inited) {
+    taosThreadOnce(&transBufInit, transBufInitOnce);
+    taosThreadSetSpecific(transBufKey, pCache);
+    pCache->inited = 1;
+  }
+  return pCache;
+}
+
+static void transBufFlushStat(STransBufCache* pCache) {
+  SRpcBufStat* pStat = &pCache->stat;
+  atomic_add_fetch_64(&transBufStat.numOfAllocs, pStat->numOfAllocs);
+  atomic_add_fetch_64(&transBufStat.numOfPoolHits, pStat->numOfPoolHits);
+  atomic_add_fetch_64(&transBufStat.memInUse, pStat->memInUse);
+  atomic_add_fetch_64(&transBufStat.memInPool, pStat->memInPool);
+  memset(pStat, 0, sizeof(SRpcBufStat));
+  pCache->ops = 0;
+}
+
+static FORCE_INLINE void transBufCountOp(STransBufCache* pCache) {
+  if (++pCache->ops >= TRANS_BUF_STAT_OPS) transBufFlushStat(pCache);
+}
+
+// take up to num buffers from the shared pool
+static void transBufRefill(STransBufCache* pCache, int32_t cls, int32_t num) {
+  STransBufPool* pPool = &transBufPools[cls];
+  STransBufList* pList = &pCache->lists[cls];
+
+  taosThreadMutexLock(&pPool->mutex);
+  while (num-- > 0 && pPool->list.head != NULL) {
+    STransBufNode* pNode = pPool->list.head;
+    pPool->list.head = pNode->next;
+    pPool->list.num--;
+    pNode->next = pList->head;
+    pList->head = pNode;
+    pList->num++;
+  }
+  taosThreadMutexUnlock(&pPool->mutex);
+}
+
+// move num buffers to the shared pool, the ones it has no room for are freed
+static void transBufSpill(STransBufCache* pCache, int32_t cls, int32_t num) {
+  STransBufPool* pPool = &transBufPools[cls];
+  STransBufList* pList = &pCache->lists[cls];
+  int32_t        poolCap = (int32_t)(TRANS_BUF_POOL_CACHE / TRANS_BUF_CLASS_SIZE(cls));
+  STransBufNode* pFree = NULL;
+
+  taosThreadMutexLock(&pPool->mutex);
+  while (num-- > 0 && pList->head != NULL) {
+    STransBufNode* pNode = pList->head;
+    pList->head = pNode->next;
+    pList->num--;
+    if (pPool->list.num < poolCap) {
+      pNode->next = pPool->list.head;
+      pPool->list.head = pNode;
+      pPool->list.num++;
+    } else {
+      pNode->next = pFree;
+      pFree = pNode;
+    }
+  }
+  taosThreadMutexUnlock(&pPool->mutex);
+
+  while (pFree != NULL) {
+    STransBufNode* pNode = pFree;
+    pFree = pNode->next;
+    pCache->stat.memInPool -= TRANS_BUF_CLASS_SIZE(cls);
+    taosMemoryFree((STransBufHead*)pNode - 1);
+  }
+}
+
+static void transBufFreeRefs(STransBufHead* pHead) {
+  for (int32_t i = 0; i < pHead->numOfRefs; ++i) {
+    STransBufRef* pRef = &pHead->pRefs[i];
+    if (pRef->freeFp != NULL) pRef->freeFp(pRef->pOwner);
+  }
+  taosMemoryFreeClear(pHead->pRefs);
+  pHead->numOfRefs = 0;
+  pHead->refLen = 0;
+}
+
+// hand the buffers cached by an exiting thread to the shared pools
+static void transBufCacheDestroy(void* param) {
+  STransBufCache* pCache = param;
+  for (int32_t cls = 0; cls < TRANS_BUF_CLASSES; ++cls) {
+    transBufSpill(pCache, cls, pCache->lists[cls].num);
+  }
+  transBufFlushStat(pCache);
+  pCache->inited = 0;
+}
+
+static void* transBufAlloc(int64_t size, bool zero) {
+  int32_t        cls = transBufClass(size);
+  STransBufHead* pHead = NULL;
+
+  if (cls == TRANS_BUF_BIG_CLASS) {
+    int64_t memSize = sizeof(STransBufHead) + size;
+    pHead = zero ? taosMemoryCalloc(1, memSize) : taosMemoryMalloc(memSize);
+    if (pHead == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return NULL;
+    }
+    pHead->cls = TRANS_BUF_BIG_CLASS;
+    pHead->size = size;
+    pHead->numOfRefs = 0;
+    pHead->pRefs = NULL;
+    pHead->refLen = 0;
+    atomic_add_fetch_64(&transBufStat.numOfAllocs, 1);
+    atomic_add_fetch_64(&transBufStat.numOfBigAllocs, 1);
+    atomic_add_fetch_64(&transBufStat.memInUse, size);
+    return pHead + 1;
+  }
+
+  STransBufCache* pCache = transBufGetCache();
+  STransBufList*  pList = &pCache->lists[cls];
+  int64_t         clsSize = TRANS_BUF_CLASS_SIZE(cls);
+
+  if (pList->head == NULL) {
+    transBufRefill(pCache, cls, transBufThreadCap(cls) / 2);
+  }
+
+  if (pList->head != NULL) {
+    STransBufNode* pNode = pList->head;
+    pList->head = pNode->next;
+    pList->num--;
+    pHead = (STransBufHead*)pNode - 1;
+    if (zero) memset(pNode, 0, size);
+    pCache->stat.numOfPoolHits++;
+    pCache->stat.memInPool -= clsSize;
+  } else {
+    int64_t memSize = sizeof(STransBufHead) + clsSize;
+    pHead = zero ? taosMemoryCalloc(1, memSize) : taosMemoryMalloc(memSize);
+    if (pHead == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return NULL;
+    }
+    pHead->cls = cls;
+    pHead->size = clsSize;
+    pHead->numOfRefs = 0;
+    pHead->pRefs = NULL;
+    pHead->refLen = 0;
+  }
+
+  pCache->stat.numOfAllocs++;
+  pCache->stat.memInUse += clsSize;
+  transBufCountOp(pCache);
+  return pHead + 1;
+}
+
+void* transBufMalloc(int64_t size) { return transBufAlloc(size, false); }
+void* transBufCalloc(int64_t size) { return transBufAlloc(size, true); }
+
+void transBufFree(void* buf) {
+  if (buf == NULL) return;
+
+  STransBufHead* pHead = (STransBufHead*)buf - 1;
+  if (pHead->pRefs != NULL) {
+    transBufFreeRefs(pHead);
+  }
+  if (pHead->cls == TRANS_BUF_BIG_CLASS) {
+    atomic_sub_fetch_64(&transBufStat.memInUse, pHead->size);
+    taosMemoryFree(pHead);
+    return;
+  }
+
+  int32_t         cls = pHead->cls;
+  STransBufCache* pCache = transBufGetCache();
+  STransBufList*  pList = &pCache->lists[cls];
+  STransBufNode*  pNode = buf;
+
+  pNode->next = pList->head;
+  pList->head = pNode;
+  pList->num++;
+  pCache->stat.memInUse -= pHead->size;
+  pCache->stat.memInPool += pHead->size;
+
+  if (pList->num > transBufThreadCap(cls)) {
+    transBufSpill(pCache, cls, pList->num / 2);
+  }
+  transBufCountOp(pCache);
+}
+
+void* transBufRealloc(void* buf, int64_t size) {
+  if (buf == NULL) return transBufMalloc(size);
+
+  STransBufHead* pHead = (STransBufHead*)buf - 1;
+  if (pHead->cls != TRANS_BUF_BIG_CLASS && size <= pHead->size) {
+    return buf;
+  }
+
+  if (pHead->cls == TRANS_BUF_BIG_CLASS && transBufClass(size) == TRANS_BUF_BIG_CLASS) {
+    int64_t        oldSize = pHead->size;
+    STransBufHead* pNewHead = taosMemoryRealloc(pHead, sizeof(STransBufHead) + size);
+    if (pNewHead == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return NULL;
+    }
+    pNewHead->size = size;
+    atomic_add_fetch_64(&transBufStat.memInUse, size - oldSize);
+    return pNewHead + 1;
+  }
+
+  void* pNew = transBufMalloc(size);
+  if (pNew == NULL) return NULL;
+
+  memcpy(pNew, buf, TMIN(size, pHead->size));
+
+  // the buffers attached move to the new one
+  STransBufHead* pNewHead = (STransBufHead*)pNew - 1;
+  pNewHead->numOfRefs = pHead->numOfRefs;
+  pNewHead->pRefs = pHead->pRefs;
+  pNewHead->refLen = pHead->refLen;
+  pHead->numOfRefs = 0;
+  pHead->pRefs = NULL;
+  pHead->refLen = 0;
+
+  transBufFree(buf);
+  return pNew;
+}
+
+int32_t transBufAddRef(void* buf, void* pData, int32_t len, void* pOwner, void (*freeFp)(void*)) {
+  STransBufHead* pHead = (STransBufHead*)buf - 1;
+  int32_t        num = pHead->numOfRefs;
+
+  // the ref array grows to the next power of two
+  if (num == 0 || (num >= 4 && (num & (num - 1)) == 0)) {
+    int32_t       cap = num == 0 ? 4 : num * 2;
+    STransBufRef* pRefs = taosMemoryRealloc(pHead->pRefs, cap * sizeof(STransBufRef));
+    if (pRefs == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return -1;
+    }
+    pHead->pRefs = pRefs;
+  }
+
+  STransBufRef* pRef = &pHead->pRefs[num];
+  pRef->pData = pData;
+  pRef->len = len;
+  pRef->pOwner = pOwner;
+  pRef->freeFp = freeFp;
+  pHead->numOfRefs++;
+  pHead->refLen += len;
+  return 0;
+}
+
+int32_t transBufGetRefNum(void* buf) { return ((STransBufHead*)buf - 1)->numOfRefs; }
+int64_t transBufGetRefLen(void* buf) { return ((STransBufHead*)buf - 1)->refLen; }
+
+void transBufGetRefs(void* buf, uv_buf_t* pBufs) {
+  STransBufHead* pHead = (STransBufHead*)buf - 1;
+  for (int32_t i = 0; i < pHead->numOfRefs; ++i) {
+    pBufs[i] = uv_buf_init(pHead->pRefs[i].pData, pHead->pRefs[i].len);
+  }
+}
+
+void transBufGetStat(SRpcBufStat* pStat) {
+  pStat->numOfAllocs = atomic_load_64(&transBufStat.numOfAllocs);
+  pStat->numOfPoolHits = atomic_load_64(&transBufStat.numOfPoolHits);
+  pStat->numOfBigAllocs = atomic_load_64(&transBufStat.numOfBigAllocs);
+  pStat->memInUse = atomic_load_64(&transBufStat.memInUse);
+  pStat->memInPool = atomic_load_64(&transBufStat.memInPool);
+}
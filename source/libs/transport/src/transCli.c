@@ -120,6 +120,9 @@ typedef struct SCliThrd {
   SHashObj* failFastCache;
   SHashObj* batchCache;
 
+  uint32_t  localIp;         // ip of this host, a server on it is reached through its local socket
+  SHashObj* localFailCache;  // dst -> time of the last failure to connect its local socket
+
   SCliMsg* stopMsg;
 
   bool quit;
@@ -180,7 +183,8 @@ static int32_t allocConnRef(SCliConn* conn, bool update);
 
 static int cliAppCb(SCliConn* pConn, STransMsg* pResp, SCliMsg* pMsg);
 
-static SCliConn* cliCreateConn(SCliThrd* thrd);
+static SCliConn* cliCreateConn(SCliThrd* thrd, bool local);
+static bool      cliGetLocalSockPath(SCliThrd* pThrd, char* dst, char* fqdn, uint16_t port, char* path, int32_t len);
 static void      cliDestroyConn(SCliConn* pConn, bool clear /*clear tcp handle or not*/);
 static void      cliDestroy(uv_handle_t* handle);
 static void      cliSend(SCliConn* pConn);
@@ -360,7 +364,7 @@ void cliHandleResp(SCliConn* conn) {
 
   int32_t msgLen = transDumpFromBuffer(&conn->readBuf, (char**)&pHead);
   if (msgLen <= 0) {
-    taosMemoryFree(pHead);
+    transBufFree(pHead);
     tDebug("%s conn %p recv invalid packet ", CONN_GET_INST_LABEL(conn), conn);
     return;
   }
@@ -824,11 +828,16 @@ static void cliRecvCb(uv_stream_t* handle, ssize_t nread, const uv_buf_t* buf) {
   }
 }
 
-static SCliConn* cliCreateConn(SCliThrd* pThrd) {
+static SCliConn* cliCreateConn(SCliThrd* pThrd, bool local) {
   SCliConn* conn = taosMemoryCalloc(1, sizeof(SCliConn));
   // read/write stream handle
-  conn->stream = (uv_stream_t*)taosMemoryMalloc(sizeof(uv_tcp_t));
-  uv_tcp_init(pThrd->loop, (uv_tcp_t*)(conn->stream));
+  if (local) {
+    conn->stream = (uv_stream_t*)taosMemoryMalloc(sizeof(uv_pipe_t));
+    uv_pipe_init(pThrd->loop, (uv_pipe_t*)(conn->stream), 0);
+  } else {
+    conn->stream = (uv_stream_t*)taosMemoryMalloc(sizeof(uv_tcp_t));
+    uv_tcp_init(pThrd->loop, (uv_tcp_t*)(conn->stream));
+  }
   conn->stream->data = conn;
 
   uv_timer_t* timer = taosArrayGetSize(pThrd->timerList) > 0 ? *(uv_timer_t**)taosArrayPop(pThrd->timerList) : NULL;
@@ -1021,7 +1030,8 @@ void cliSendBatch(SCliConn* pConn) {
 
     if (pHead->comp == 0) {
       if (pTransInst->compressSize != -1 && pTransInst->compressSize < pMsg->contLen) {
-        msgLen = transCompressMsg(pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+        msgLen = transCompressMsg((char**)&pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+        pHead = transHeadFromCont(pMsg->pCont);
         pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
       }
     } else {
@@ -1099,7 +1109,8 @@ void cliSend(SCliConn* pConn) {
 
   if (pHead->comp == 0) {
     if (pTransInst->compressSize != -1 && pTransInst->compressSize < pMsg->contLen) {
-      msgLen = transCompressMsg(pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+      msgLen = transCompressMsg((char**)&pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+      pHead = transHeadFromCont(pMsg->pCont);
       pHead->msgLen = (int32_t)htonl((uint32_t)msgLen);
     }
   } else {
@@ -1161,7 +1172,10 @@ static void cliHandleBatchReq(SCliBatch* pBatch, SCliThrd* pThrd) {
     return;
   }
   if (conn == NULL) {
-    conn = cliCreateConn(pThrd);
+    char sockPath[PATH_MAX] = {0};
+    bool local = cliGetLocalSockPath(pThrd, pList->dst, pList->ip, pList->port, sockPath, sizeof(sockPath));
+
+    conn = cliCreateConn(pThrd, local);
     conn->pBatch = pBatch;
     conn->dstAddr = taosStrdup(pList->dst);
 
@@ -1180,6 +1194,14 @@ static void cliHandleBatchReq(SCliBatch* pBatch, SCliThrd* pThrd) {
     addr.sin_addr.s_addr = ipaddr;
     addr.sin_port = (uint16_t)htons(pList->port);
 
+    if (local) {
+      tTrace("%s conn %p try to connect to %s through %s", pTransInst->label, conn, pList->dst, sockPath);
+      pThrd->newConnCount++;
+      uv_pipe_connect(&conn->connReq, (uv_pipe_t*)(conn->stream), sockPath, cliConnCb);
+      uv_timer_start(conn->timer, cliConnTimeout, TRANS_CONN_TIMEOUT, 0);
+      return;
+    }
+
     tTrace("%s conn %p try to connect to %s", pTransInst->label, conn, pList->dst);
     pThrd->newConnCount++;
     int32_t fd = taosCreateSocketWithTimeout(TRANS_CONN_TIMEOUT * 10);
@@ -1263,6 +1285,30 @@ static void cliHandleFastFail(SCliConn* pConn, int status) {
 
   if (status == -1) status = UV_EADDRNOTAVAIL;
 
+  if (pConn->stream->type == UV_NAMED_PIPE) {
+    // the next conns to this dst go through tcp for a while
+    int64_t cTimestamp = taosGetTimestampMs();
+    taosHashPut(pThrd->localFailCache, pConn->dstAddr, strlen(pConn->dstAddr) + 1, &cTimestamp, sizeof(cTimestamp));
+
+    // nothing is sent on the conn yet, so its msgs are sent again through tcp instead of failing
+    if (CONN_NO_PERSIST_BY_APP(pConn)) {
+      tWarn("%s conn %p failed to connect to %s through local socket, reason: %s, retry through tcp",
+            CONN_GET_INST_LABEL(pConn), pConn, pConn->dstAddr, uv_strerror(status));
+      if (pConn->pBatch != NULL) {
+        SCliBatch* pBatch = pConn->pBatch;
+        pConn->pBatch = NULL;
+        cliHandleBatchReq(pBatch, pThrd);
+      } else {
+        SCliMsg* pMsg = NULL;
+        while ((pMsg = transQueuePop(&pConn->cliMsgs)) != NULL) {
+          cliHandleReq(pMsg, pThrd);
+        }
+      }
+      cliHandleExcept(pConn);
+      return;
+    }
+  }
+
   if (pConn->pBatch == NULL) {
     SCliMsg* pMsg = transQueueGet(&pConn->cliMsgs, 0);
 
@@ -1320,14 +1366,19 @@ void cliConnCb(uv_connect_t* req, int status) {
     return;
   }
 
-  struct sockaddr peername, sockname;
-  int             addrlen = sizeof(peername);
-  uv_tcp_getpeername((uv_tcp_t*)pConn->stream, &peername, &addrlen);
-  transSockInfo2Str(&peername, pConn->dst);
+  if (pConn->stream->type == UV_NAMED_PIPE) {
+    tstrncpy(pConn->dst, pConn->dstAddr, sizeof(pConn->dst));
+    tstrncpy(pConn->src, "local", sizeof(pConn->src));
+  } else {
+    struct sockaddr peername, sockname;
+    int             addrlen = sizeof(peername);
+    uv_tcp_getpeername((uv_tcp_t*)pConn->stream, &peername, &addrlen);
+    transSockInfo2Str(&peername, pConn->dst);
 
-  addrlen = sizeof(sockname);
-  uv_tcp_getsockname((uv_tcp_t*)pConn->stream, &sockname, &addrlen);
-  transSockInfo2Str(&sockname, pConn->src);
+    addrlen = sizeof(sockname);
+    uv_tcp_getsockname((uv_tcp_t*)pConn->stream, &sockname, &addrlen);
+    transSockInfo2Str(&sockname, pConn->src);
+  }
 
   tTrace("%s conn %p connect to server successfully", CONN_GET_INST_LABEL(pConn), pConn);
   if (pConn->pBatch != NULL) {
@@ -1479,6 +1530,26 @@ static FORCE_INLINE uint32_t cliGetIpFromFqdnCache(SHashObj* cache, char* fqdn)
   }
   return addr;
 }
+// a server on this host listens on a local socket too, return false if dst is to be connected through tcp
+static bool cliGetLocalSockPath(SCliThrd* pThrd, char* dst, char* fqdn, uint16_t port, char* path, int32_t len) {
+  if (!tsRpcLocalSock) return false;
+
+  int64_t* failTs = taosHashGet(pThrd->localFailCache, dst, strlen(dst) + 1);
+  if (failTs != NULL && taosGetTimestampMs() - *failTs < TRANS_LOCAL_SOCK_RETRY_INTERVAL) return false;
+
+  uint32_t ip = cliGetIpFromFqdnCache(pThrd->fqdn2ipCache, fqdn);
+  if (ip == 0xffffffff) return false;
+  bool loopback = (ntohl(ip) >> 24) == 127;
+  if (!loopback && ip != pThrd->localIp) return false;
+
+  if (transLocalSockPath(ip, port, path, len) == 0 && taosCheckExistFile(path)) return true;
+  // a loopback dst also reaches the server of this port bound to the ip of this host
+  if (loopback && ip != pThrd->localIp && transLocalSockPath(pThrd->localIp, port, path, len) == 0 &&
+      taosCheckExistFile(path)) {
+    return true;
+  }
+  return false;
+}
 static FORCE_INLINE void cliUpdateFqdnCache(SHashObj* cache, char* fqdn) {
   // impl later
   uint32_t addr = taosGetIpv4FromFqdn(fqdn);
@@ -1575,7 +1646,10 @@ void cliHandleReq(SCliMsg* pMsg, SCliThrd* pThrd) {
     transQueuePush(&conn->cliMsgs, pMsg);
     cliSend(conn);
   } else {
-    conn = cliCreateConn(pThrd);
+    char sockPath[PATH_MAX] = {0};
+    bool local = cliGetLocalSockPath(pThrd, addr, fqdn, port, sockPath, sizeof(sockPath));
+
+    conn = cliCreateConn(pThrd, local);
 
     int64_t refId = (int64_t)pMsg->msg.info.handle;
     if (refId != 0) specifyConnRef(conn, true, refId);
@@ -1601,6 +1675,14 @@ void cliHandleReq(SCliMsg* pMsg, SCliThrd* pThrd) {
     addr.sin_addr.s_addr = ipaddr;
     addr.sin_port = (uint16_t)htons(port);
 
+    if (local) {
+      tGTrace("%s conn %p try to connect to %s through %s", pTransInst->label, conn, conn->dstAddr, sockPath);
+      pThrd->newConnCount++;
+      uv_pipe_connect(&conn->connReq, (uv_pipe_t*)(conn->stream), sockPath, cliConnCb);
+      uv_timer_start(conn->timer, cliConnTimeout, TRANS_CONN_TIMEOUT, 0);
+      return;
+    }
+
     tGTrace("%s conn %p try to connect to %s", pTransInst->label, conn, conn->dstAddr);
     pThrd->newConnCount++;
     int32_t fd = taosCreateSocketWithTimeout(TRANS_CONN_TIMEOUT * 10);
@@ -2040,6 +2122,9 @@ static SCliThrd* createThrdObj(void* trans) {
   pThrd->fqdn2ipCache = taosHashInit(4, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
   pThrd->failFastCache = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
 
+  pThrd->localIp = taosGetIpv4FromFqdn(tsLocalFqdn);
+  pThrd->localFailCache = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
+
   pThrd->batchCache = taosHashInit(8, taosGetDefaultHashFunction(TSDB_DATA_TYPE_BINARY), true, HASH_NO_LOCK);
 
   pThrd->quit = false;
@@ -2073,6 +2158,7 @@ static void destroyThrdObj(SCliThrd* pThrd) {
   taosMemoryFree(pThrd->loop);
   taosHashCleanup(pThrd->fqdn2ipCache);
   taosHashCleanup(pThrd->failFastCache);
+  taosHashCleanup(pThrd->localFailCache);
 
   void** pIter = taosHashIterate(pThrd->batchCache, NULL);
   while (pIter != NULL) {
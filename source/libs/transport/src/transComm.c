@@ -22,38 +22,44 @@ static TdThreadOnce transModuleInit = PTHREAD_ONCE_INIT;
 static int32_t refMgt;
 static int32_t instMgt;
 
-int32_t transCompressMsg(char* msg, int32_t len) {
-  int32_t        ret = 0;
+int32_t transCompressMsg(char** msg, int32_t len) {
   int            compHdr = sizeof(STransCompMsg);
-  STransMsgHead* pHead = transHeadFromCont(msg);
+  STransMsgHead* pHead = transHeadFromCont(*msg);
+  if (len <= compHdr + 1) {
+    pHead->comp = 0;
+    return len;
+  }
 
-  char* buf = taosMemoryMalloc(len + compHdr + 8);  // 8 extra bytes
-  if (buf == NULL) {
+  // compress into a new msg buffer, it takes the place of the msg when the compression pays
+  STransMsgHead* pNewHead = transBufMalloc(len + sizeof(STransMsgHead));
+  if (pNewHead == NULL) {
     tError("failed to allocate memory for rpc msg compression, contLen:%d", len);
-    ret = len;
-    return ret;
+    return len;
   }
 
-  int32_t clen = LZ4_compress_default(msg, buf, len, len + compHdr);
+  char* pNewCont = transContFromHead(pNewHead);
   /*
    * only the compressed size is less than the value of contLen - overhead, the compression is applied
    * The first four bytes is set to 0, the second four bytes are utilized to keep the original length of message
    */
+  int32_t clen = LZ4_compress_default(*msg, pNewCont + compHdr, len, len - compHdr - 1);
   if (clen > 0 && clen < len - compHdr) {
-    STransCompMsg* pComp = (STransCompMsg*)msg;
+    memcpy(pNewHead, pHead, sizeof(STransMsgHead));
+    pNewHead->comp = 1;
+
+    STransCompMsg* pComp = (STransCompMsg*)pNewCont;
     pComp->reserved = 0;
     pComp->contLen = htonl(len);
-    memcpy(msg + compHdr, buf, clen);
 
     tDebug("compress rpc msg, before:%d, after:%d", len, clen);
-    ret = clen + compHdr;
-    pHead->comp = 1;
-  } else {
-    ret = len;
-    pHead->comp = 0;
+    transBufFree(pHead);
+    *msg = pNewCont;
+    return clen + compHdr;
   }
-  taosMemoryFree(buf);
-  return ret;
+
+  transBufFree(pNewHead);
+  pHead->comp = 0;
+  return len;
 }
 int32_t transDecompressMsg(char** msg, int32_t len) {
   STransMsgHead* pHead = (STransMsgHead*)(*msg);
@@ -64,7 +70,7 @@ int32_t transDecompressMsg(char** msg, int32_t len) {
   STransCompMsg* pComp = (STransCompMsg*)pCont;
   int32_t        oriLen = htonl(pComp->contLen);
 
-  char*          buf = taosMemoryCalloc(1, oriLen + sizeof(STransMsgHead));
+  char*          buf = transBufMalloc(oriLen + sizeof(STransMsgHead));
   STransMsgHead* pNewHead = (STransMsgHead*)buf;
   int32_t        decompLen = LZ4_decompress_safe(pCont + sizeof(STransCompMsg), (char*)pNewHead->content,
                                                  len - sizeof(STransMsgHead) - sizeof(STransCompMsg), oriLen);
@@ -72,7 +78,7 @@ int32_t transDecompressMsg(char** msg, int32_t len) {
 
   pNewHead->msgLen = htonl(oriLen + sizeof(STransMsgHead));
 
-  taosMemoryFree(pHead);
+  transBufFree(pHead);
   *msg = buf;
   if (decompLen != oriLen) {
     return -1;
@@ -84,7 +90,7 @@ void transFreeMsg(void* msg) {
   if (msg == NULL) {
     return;
   }
-  taosMemoryFree((char*)msg - sizeof(STransMsgHead));
+  transBufFree((char*)msg - sizeof(STransMsgHead));
 }
 int transSockInfo2Str(struct sockaddr* sockname, char* dst) {
   struct sockaddr_in addr = *(struct sockaddr_in*)sockname;
@@ -94,6 +100,17 @@ int transSockInfo2Str(struct sockaddr* sockname, char* dst) {
   sprintf(dst, "%s:%d", buf, ntohs(addr.sin_port));
   return r;
 }
+int transLocalSockPath(uint32_t ip, uint16_t port, char* path, int32_t len) {
+#if defined(WINDOWS)
+  return -1;
+#else
+  char ipStr[64] = {0};
+  tinet_ntoa(ipStr, ip);
+  int32_t n = snprintf(path, len, "%s%staosrpc.%s.%u.sock", tsTempDir, TD_DIRSEP, ipStr, port);
+  if (n < 0 || n >= len || n >= TRANS_LOCAL_SOCK_PATH_LEN) return -1;
+  return 0;
+#endif
+}
 int transInitBuffer(SConnBuffer* buf) {
   buf->cap = BUFFER_CAP;
   buf->buf = taosMemoryCalloc(1, BUFFER_CAP);
@@ -131,7 +148,7 @@ int transDumpFromBuffer(SConnBuffer* connBuf, char** buf) {
   }
   int total = p->total;
   if (total >= HEADSIZE && !p->invalid) {
-    *buf = taosMemoryCalloc(1, total);
+    *buf = transBufMalloc(total);
     memcpy(*buf, p->buf, total);
     if (transResetBuffer(connBuf) < 0) {
       return -1;
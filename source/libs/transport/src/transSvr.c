@@ -26,9 +26,9 @@ typedef struct {
 
 typedef struct SSvrConn {
   T_REF_DECLARE()
-  uv_tcp_t*  pTcp;
-  queue      wreqQueue;
-  uv_timer_t pTimer;
+  uv_stream_t* pTcp;  // uv_tcp_t, or uv_pipe_t of a local conn
+  queue        wreqQueue;
+  uv_timer_t   pTimer;
 
   queue       queue;
   SConnBuffer readBuf;  // read buf,
@@ -91,9 +91,10 @@ typedef struct SWorkThrd {
   uv_prepare_t* prepare;
   queue         msg;
 
-  queue conn;
-  void* pTransInst;
-  bool  quit;
+  queue    conn;
+  void*    pTransInst;
+  bool     quit;
+  uint32_t ip;  // server ip, taken as both ends of a local conn
 
   SIpWhiteListTab* pWhiteList;
   int64_t          whiteListVer;
@@ -103,6 +104,8 @@ typedef struct SWorkThrd {
 typedef struct SServerObj {
   TdThread   thread;
   uv_tcp_t   server;
+  uv_pipe_t  localSock;  // unix domain socket for the clients on this host
+  bool       localListen;
   uv_loop_t* loop;
 
   // work thread info
@@ -613,10 +616,12 @@ static int uvPrepareSendData(SSvrMsg* smsg, uv_buf_t* wb) {
 
   char*   msg = (char*)pHead;
   int32_t len = transMsgLenFromCont(pMsg->contLen);
+  int64_t refLen = transBufGetRefLen(pHead);
 
   STrans* pTransInst = pConn->pTransInst;
-  if (pTransInst->compressSize != -1 && pTransInst->compressSize < pMsg->contLen) {
-    len = transCompressMsg(pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+  if (pTransInst->compressSize != -1 && pTransInst->compressSize < pMsg->contLen && refLen == 0) {
+    len = transCompressMsg((char**)&pMsg->pCont, pMsg->contLen) + sizeof(STransMsgHead);
+    pHead = transHeadFromCont(pMsg->pCont);
     pHead->msgLen = (int32_t)htonl((uint32_t)len);
   }
 
@@ -625,7 +630,7 @@ static int uvPrepareSendData(SSvrMsg* smsg, uv_buf_t* wb) {
           TMSG_INFO(pHead->msgType), pConn->dst, pConn->src, len);
 
   wb->base = (char*)pHead;
-  wb->len = len;
+  wb->len = len - refLen;
   return 0;
 }
 
@@ -635,14 +640,33 @@ static FORCE_INLINE void uvStartSendRespImpl(SSvrMsg* smsg) {
     return;
   }
 
-  uv_buf_t wb;
-  if (uvPrepareSendData(smsg, &wb) < 0) {
+  uv_buf_t  wb[4];
+  uv_buf_t* pWb = wb;
+  if (uvPrepareSendData(smsg, wb) < 0) {
     return;
   }
 
+  // the buffers attached to the msg are written behind it as they are
+  int32_t nRef = transBufGetRefNum(wb[0].base);
+  if (nRef > 0) {
+    if (nRef + 1 > tListLen(wb)) {
+      pWb = taosMemoryMalloc((nRef + 1) * sizeof(uv_buf_t));
+      if (pWb == NULL) {
+        tError("conn %p failed to send msg with %d buffers attached since out of memory", pConn, nRef);
+        transQueuePop(&pConn->srvMsgs);
+        destroySmsg(smsg);
+        pConn->broken = true;
+        return;
+      }
+      pWb[0] = wb[0];
+    }
+    transBufGetRefs(wb[0].base, pWb + 1);
+  }
+
   transRefSrvHandle(pConn);
   uv_write_t* req = transReqQueuePush(&pConn->wreqQueue);
-  uv_write(req, (uv_stream_t*)pConn->pTcp, &wb, 1, uvOnSendCb);
+  uv_write(req, (uv_stream_t*)pConn->pTcp, pWb, nRef + 1, uvOnSendCb);
+  if (pWb != wb) taosMemoryFree(pWb);
 }
 static void uvStartSendResp(SSvrMsg* smsg) {
   // impl
@@ -848,18 +872,26 @@ void uvOnAcceptCb(uv_stream_t* stream, int status) {
   if (status == -1) {
     return;
   }
-  SServerObj* pObj = container_of(stream, SServerObj, server);
+  bool        local = stream->type == UV_NAMED_PIPE;
+  SServerObj* pObj = local ? container_of(stream, SServerObj, localSock) : container_of(stream, SServerObj, server);
 
-  uv_tcp_t* cli = (uv_tcp_t*)taosMemoryMalloc(sizeof(uv_tcp_t));
-  if (cli == NULL) return;
-
-  int err = uv_tcp_init(pObj->loop, cli);
+  uv_stream_t* cli = NULL;
+  int          err = 0;
+  if (local) {
+    cli = (uv_stream_t*)taosMemoryMalloc(sizeof(uv_pipe_t));
+    if (cli == NULL) return;
+    err = uv_pipe_init(pObj->loop, (uv_pipe_t*)cli, 0);
+  } else {
+    cli = (uv_stream_t*)taosMemoryMalloc(sizeof(uv_tcp_t));
+    if (cli == NULL) return;
+    err = uv_tcp_init(pObj->loop, (uv_tcp_t*)cli);
+  }
   if (err != 0) {
-    tError("failed to create tcp: %s", uv_err_name(err));
+    tError("failed to create %s: %s", local ? "pipe" : "tcp", uv_err_name(err));
     taosMemoryFree(cli);
     return;
   }
-  err = uv_accept(stream, (uv_stream_t*)cli);
+  err = uv_accept(stream, cli);
   if (err == 0) {
 #if defined(WINDOWS) || defined(DARWIN)
     if (pObj->numOfWorkerReady < pObj->numOfThreads) {
@@ -878,7 +910,7 @@ void uvOnAcceptCb(uv_stream_t* stream, int status) {
 
     tTrace("new connection accepted by main server, dispatch to %dth worker-thread", pObj->workerIdx);
 
-    uv_write2(wr, (uv_stream_t*)&(pObj->pipe[pObj->workerIdx][0]), &buf, 1, (uv_stream_t*)cli, uvOnPipeWriteCb);
+    uv_write2(wr, (uv_stream_t*)&(pObj->pipe[pObj->workerIdx][0]), &buf, 1, cli, uvOnPipeWriteCb);
   } else {
     if (!uv_is_closing((uv_handle_t*)cli)) {
       tError("failed to accept tcp: %s", uv_err_name(err));
@@ -920,7 +952,7 @@ void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf) {
     return;
   }
 
-  // uv_handle_type pending = uv_pipe_pending_type(pipe);
+  uv_handle_type pending = uv_pipe_pending_type(pipe);
 
   SSvrConn* pConn = createConn(pThrd);
 
@@ -932,20 +964,40 @@ void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf) {
   pConn->hostThrd = pThrd;
 
   // init client handle
-  pConn->pTcp = (uv_tcp_t*)taosMemoryMalloc(sizeof(uv_tcp_t));
-  uv_tcp_init(pThrd->loop, pConn->pTcp);
+  if (pending == UV_NAMED_PIPE) {
+    pConn->pTcp = (uv_stream_t*)taosMemoryMalloc(sizeof(uv_pipe_t));
+    uv_pipe_init(pThrd->loop, (uv_pipe_t*)pConn->pTcp, 0);
+  } else {
+    pConn->pTcp = (uv_stream_t*)taosMemoryMalloc(sizeof(uv_tcp_t));
+    uv_tcp_init(pThrd->loop, (uv_tcp_t*)pConn->pTcp);
+  }
   pConn->pTcp->data = pConn;
 
   // transSetConnOption((uv_tcp_t*)pConn->pTcp);
 
-  if (uv_accept(q, (uv_stream_t*)(pConn->pTcp)) == 0) {
+  if (uv_accept(q, pConn->pTcp) == 0) {
     uv_os_fd_t fd;
     uv_fileno((const uv_handle_t*)pConn->pTcp, &fd);
     tTrace("conn %p created, fd:%d", pConn, fd);
 
+    if (pending == UV_NAMED_PIPE) {
+      // a local client has no address, it is seen as connected from this host
+      struct sockaddr_in addr = {.sin_family = AF_INET, .sin_addr.s_addr = pThrd->ip};
+      transSockInfo2Str((struct sockaddr*)&addr, pConn->dst);
+      transSockInfo2Str((struct sockaddr*)&addr, pConn->src);
+
+      pConn->clientIp = pThrd->ip;
+      pConn->serverIp = pThrd->ip;
+      pConn->port = 0;
+
+      tTrace("conn %p is local", pConn);
+      uv_read_start(pConn->pTcp, uvAllocRecvBufferCb, uvOnRecvCb);
+      return;
+    }
+
     struct sockaddr peername, sockname;
     int             addrlen = sizeof(peername);
-    if (0 != uv_tcp_getpeername(pConn->pTcp, (struct sockaddr*)&peername, &addrlen)) {
+    if (0 != uv_tcp_getpeername((uv_tcp_t*)pConn->pTcp, (struct sockaddr*)&peername, &addrlen)) {
       tError("conn %p failed to get peer info", pConn);
       transUnrefSrvHandle(pConn);
       return;
@@ -953,7 +1005,7 @@ void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf) {
     transSockInfo2Str(&peername, pConn->dst);
 
     addrlen = sizeof(sockname);
-    if (0 != uv_tcp_getsockname(pConn->pTcp, (struct sockaddr*)&sockname, &addrlen)) {
+    if (0 != uv_tcp_getsockname((uv_tcp_t*)pConn->pTcp, (struct sockaddr*)&sockname, &addrlen)) {
       tError("conn %p failed to get local info", pConn);
       transUnrefSrvHandle(pConn);
       return;
@@ -967,7 +1019,7 @@ void uvOnConnectionCb(uv_stream_t* q, ssize_t nread, const uv_buf_t* buf) {
     pConn->serverIp = saddr.sin_addr.s_addr;
     pConn->port = ntohs(addr.sin_port);
 
-    uv_read_start((uv_stream_t*)(pConn->pTcp), uvAllocRecvBufferCb, uvOnRecvCb);
+    uv_read_start(pConn->pTcp, uvAllocRecvBufferCb, uvOnRecvCb);
 
   } else {
     tDebug("failed to create new connection");
@@ -1024,6 +1076,33 @@ static bool addHandleToWorkloop(SWorkThrd* pThrd, char* pipeName) {
   return true;
 }
 
+static void addLocalSockToAcceptloop(SServerObj* srv) {
+  char path[PATH_MAX] = {0};
+  if (transLocalSockPath(srv->ip, srv->port, path, sizeof(path)) != 0) {
+    return;
+  }
+  // the tcp port is already bound, so a socket left on this path belongs to a server gone
+  taosRemoveFile(path);
+  if (!tsRpcLocalSock) {
+    return;
+  }
+
+  int err = 0;
+  if ((err = uv_pipe_init(srv->loop, &srv->localSock, 0)) != 0) {
+    tWarn("failed to init local socket:%s", uv_err_name(err));
+    return;
+  }
+  srv->localListen = true;
+  if ((err = uv_pipe_bind(&srv->localSock, path)) != 0 ||
+      (err = uv_pipe_chmod(&srv->localSock, UV_READABLE | UV_WRITABLE)) != 0 ||
+      (err = uv_listen((uv_stream_t*)&srv->localSock, 4096 * 2, uvOnAcceptCb)) != 0) {
+    tWarn("failed to listen on local socket %s:%s, local clients use tcp", path, uv_err_name(err));
+    uv_close((uv_handle_t*)&srv->localSock, NULL);
+    return;
+  }
+  tDebug("listen on local socket %s", path);
+}
+
 static bool addHandleToAcceptloop(void* arg) {
   // impl later
   SServerObj* srv = arg;
@@ -1050,6 +1129,7 @@ static bool addHandleToAcceptloop(void* arg) {
     terrno = TSDB_CODE_RPC_PORT_EADDRINUSE;
     return false;
   }
+  addLocalSockToAcceptloop(srv);
   return true;
 }
 void* transWorkerThread(void* arg) {
@@ -1235,6 +1315,7 @@ void* transInitServer(uint32_t ip, uint32_t port, char* label, int numOfThreads,
     thrd->pTransInst = shandle;
     thrd->quit = false;
     thrd->pTransInst = shandle;
+    thrd->ip = ip;
     thrd->pWhiteList = uvWhiteListCreate();
 
     srv->pThreadObj[i] = thrd;
@@ -1262,6 +1343,7 @@ void* transInitServer(uint32_t ip, uint32_t port, char* label, int numOfThreads,
     thrd->pTransInst = shandle;
     thrd->quit = false;
     thrd->pTransInst = shandle;
+    thrd->ip = ip;
     thrd->pWhiteList = uvWhiteListCreate();
 
     srv->pipe[i] = (uv_pipe_t*)taosMemoryCalloc(2, sizeof(uv_pipe_t));
@@ -1428,6 +1510,13 @@ void transCloseServer(void* arg) {
     uv_loop_close(srv->loop);
   }
 
+  if (srv->localListen) {
+    char path[PATH_MAX] = {0};
+    if (transLocalSockPath(srv->ip, srv->port, path, sizeof(path)) == 0) {
+      taosRemoveFile(path);
+    }
+  }
+
   taosMemoryFree(srv->pThreadObj);
   taosMemoryFree(srv->pAcceptAsync);
   taosMemoryFree(srv->loop);
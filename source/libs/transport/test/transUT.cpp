@@ -15,10 +15,12 @@
 #include <gtest/gtest.h>
 #include <cstdio>
 #include <cstring>
+#include <vector>
 #include "tdatablock.h"
 #include "tglobal.h"
 #include "tlog.h"
 #include "tmisce.h"
+#include "transComm.h"
 #include "transLog.h"
 #include "trpc.h"
 #include "tversion.h"
@@ -40,6 +42,8 @@ static void processContinueSend(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet);
 static void processReleaseHandleCb(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet);
 static void processRegisterFailure(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet);
 static void processReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet);
+static void processLocalSockReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet);
+static void processAttachRefsReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet);
 // client process;
 static void processResp(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet);
 class Client {
@@ -163,6 +167,35 @@ static void processReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
   rpcSendResponse(&rpcMsg);
 }
 
+// a conn through the local socket of the server has no client port
+static uint16_t localSockClientPort = 0;
+static void     processLocalSockReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  localSockClientPort = pMsg->info.conn.clientPort;
+  processReq(parent, pMsg, pEpSet);
+}
+
+// the resp to a req of n has a body of attachBodyLen bytes with n buffers attached, the ith of (i + 1) * 100 bytes
+static const int32_t attachBodyLen = 16;
+static int32_t       attachRespLen(int32_t nRefs) { return attachBodyLen + 100 * nRefs * (nRefs + 1) / 2; }
+static void          processAttachRefsReq(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
+  int32_t nRefs = *(int32_t *)pMsg->pCont;
+  rpcFreeCont(pMsg->pCont);
+
+  SRpcMsg rpcMsg = {0};
+  rpcMsg.pCont = rpcMallocCont(attachBodyLen);
+  memset(rpcMsg.pCont, 'A', attachBodyLen);
+  for (int32_t i = 0; i < nRefs; i++) {
+    int32_t len = (i + 1) * 100;
+    char   *pData = (char *)taosMemoryMalloc(len);
+    memset(pData, 'a' + i, len);
+    rpcAddContRef(rpcMsg.pCont, pData, len, pData, taosMemoryFree);
+  }
+  rpcMsg.contLen = attachRespLen(nRefs);
+  rpcMsg.info = pMsg->info;
+  rpcMsg.code = 0;
+  rpcSendResponse(&rpcMsg);
+}
+
 static void processContinueSend(void *parent, SRpcMsg *pMsg, SEpSet *pEpSet) {
   for (int i = 0; i < 10; i++) {
     SRpcMsg rpcMsg = {0};
@@ -466,6 +499,113 @@ TEST_F(TransEnv, cliPersistHandleExcept) {
   //
 }
 
+TEST_F(TransEnv, localSock) {
+  tr->SetSrvContinueSend(processLocalSockReq);
+
+  char path[PATH_MAX] = {0};
+  ASSERT_EQ(transLocalSockPath(taosGetIpv4FromFqdn("localhost"), port, path, sizeof(path)), 0);
+  ASSERT_TRUE(taosCheckExistFile(path));
+
+  for (int i = 0; i < 3; i++) {
+    SRpcMsg req = {0}, resp = {0};
+    req.msgType = 1;
+    req.pCont = rpcMallocCont(10);
+    req.contLen = 10;
+    localSockClientPort = 0xffff;
+    tr->cliSendAndRecv(&req, &resp);
+    EXPECT_EQ(resp.code, 0);
+    EXPECT_EQ(localSockClientPort, 0);
+  }
+
+  // the new conns go through tcp once the socket file is removed
+  taosRemoveFile(path);
+  tr->RestartCli(processResp);
+  for (int i = 0; i < 3; i++) {
+    SRpcMsg req = {0}, resp = {0};
+    req.msgType = 1;
+    req.pCont = rpcMallocCont(10);
+    req.contLen = 10;
+    localSockClientPort = 0;
+    tr->cliSendAndRecv(&req, &resp);
+    EXPECT_EQ(resp.code, 0);
+    EXPECT_NE(localSockClientPort, 0);
+  }
+}
+
+TEST_F(TransEnv, localSockConnectFail) {
+  tr->SetSrvContinueSend(processLocalSockReq);
+
+  char path[PATH_MAX] = {0};
+  ASSERT_EQ(transLocalSockPath(taosGetIpv4FromFqdn("localhost"), port, path, sizeof(path)), 0);
+
+  // a file on the path that is no socket fails the connect, like one left by a server gone
+  taosRemoveFile(path);
+  TdFilePtr pFile = taosOpenFile(path, TD_FILE_CREATE | TD_FILE_WRITE | TD_FILE_TRUNC);
+  ASSERT_NE(pFile, nullptr);
+  taosCloseFile(&pFile);
+  tr->RestartCli(processResp);
+
+  SRpcMsg req = {0}, resp = {0};
+  req.msgType = 1;
+  req.pCont = rpcMallocCont(10);
+  req.contLen = 10;
+  localSockClientPort = 0;
+  tr->cliSendAndRecv(&req, &resp);
+  EXPECT_EQ(resp.code, 0);
+  EXPECT_NE(localSockClientPort, 0);
+
+  // the client remembers the failure and keeps to tcp for TRANS_LOCAL_SOCK_RETRY_INTERVAL, the file still there.
+  // every request holds its conn, so the next one creates a new conn
+  ASSERT_TRUE(taosCheckExistFile(path));
+  vector<void *> handles;
+  for (int i = 0; i < 3; i++) {
+    memset(&req, 0, sizeof(req));
+    req.info.persistHandle = 1;
+    req.msgType = 1;
+    req.pCont = rpcMallocCont(10);
+    req.contLen = 10;
+    localSockClientPort = 0;
+    tr->cliSendAndRecv(&req, &resp);
+    EXPECT_EQ(resp.code, 0);
+    EXPECT_NE(localSockClientPort, 0);
+    handles.push_back(resp.info.handle);
+  }
+  for (void *handle : handles) {
+    rpcReleaseHandle(handle, TAOS_CONN_CLIENT);
+  }
+  taosRemoveFile(path);
+}
+
+TEST_F(TransEnv, srvAttachRefs) {
+  tr->SetSrvContinueSend(processAttachRefsReq);
+
+  // the body and the buffers attached are received in order, with more buffers than fit the write on stack
+  int32_t nRefs[] = {0, 1, 3, 4, 20, 3};
+  for (int32_t n : nRefs) {
+    SRpcMsg req = {0}, resp = {0};
+    req.msgType = 1;
+    req.pCont = rpcMallocCont(sizeof(int32_t));
+    req.contLen = sizeof(int32_t);
+    *(int32_t *)req.pCont = n;
+    tr->cliSendAndRecv(&req, &resp);
+    ASSERT_EQ(resp.code, 0);
+    ASSERT_EQ(resp.contLen, attachRespLen(n));
+
+    char *p = (char *)resp.pCont;
+    for (int32_t j = 0; j < attachBodyLen; j++) {
+      ASSERT_EQ(p[j], 'A');
+    }
+    p += attachBodyLen;
+    for (int32_t i = 0; i < n; i++) {
+      for (int32_t j = 0; j < (i + 1) * 100; j++) {
+        ASSERT_EQ(p[j], 'a' + i);
+      }
+      p += (i + 1) * 100;
+    }
+    rpcFreeCont(resp.pCont);
+  }
+}
+
 TEST_F(TransEnv, multiCliPersistHandleExcept) {
   // conn broken
 }
@@ -136,6 +136,87 @@ TEST_F(QueueEnv, testIter) {
   assert(result.size() == vals.size());
 }
 
+TEST(TransBufTest, allocAndReuse) {
+  SRpcBufStat st1 = {0}, st2 = {0};
+  transBufGetStat(&st1);
+
+  std::vector<int64_t> sizes = {1, 255, 256, 257, 4000, TRANS_BUF_MAX_SIZE, TRANS_BUF_MAX_SIZE + 1, 1024 * 1024};
+  for (int64_t size : sizes) {
+    char *buf = (char *)transBufCalloc(size);
+    ASSERT_TRUE(buf != NULL);
+    for (int64_t i = 0; i < size; ++i) ASSERT_EQ(buf[i], 0);
+    memset(buf, 'a', size);
+    transBufFree(buf);
+
+    // the freed buffer is taken again, and zeroed again
+    buf = (char *)transBufCalloc(size);
+    ASSERT_TRUE(buf != NULL);
+    for (int64_t i = 0; i < size; ++i) ASSERT_EQ(buf[i], 0);
+    transBufFree(buf);
+  }
+
+  char *buf = (char *)transBufMalloc(100);
+  memset(buf, 'b', 100);
+  for (int64_t size : sizes) {
+    buf = (char *)transBufRealloc(buf, size + 100);
+    ASSERT_TRUE(buf != NULL);
+    for (int32_t i = 0; i < 100; ++i) ASSERT_EQ(buf[i], 'b');
+  }
+  transBufFree(buf);
+
+  // buffers freed by another thread are reused too
+  std::vector<void *> bufs;
+  for (int32_t i = 0; i < 1000; ++i) bufs.push_back(transBufMalloc(1000));
+  std::thread th([&bufs]() {
+    for (void *p : bufs) transBufFree(p);
+  });
+  th.join();
+  for (int32_t i = 0; i < 1000; ++i) bufs[i] = transBufMalloc(1000);
+  for (void *p : bufs) transBufFree(p);
+
+  transBufGetStat(&st2);
+  EXPECT_GT(st2.numOfPoolHits, st1.numOfPoolHits);
+  EXPECT_GE(st2.numOfBigAllocs - st1.numOfBigAllocs, 4);
+}
+
+static int32_t transBufRefFreed = 0;
+static void    transBufRefFree(void *p) {
+  transBufRefFreed++;
+  taosMemoryFree(p);
+}
+
+TEST(TransBufTest, attachRefs) {
+  char   *buf = (char *)transBufMalloc(100);
+  int32_t num = 20;
+  for (int32_t i = 0; i < num; ++i) {
+    char *pData = (char *)taosMemoryMalloc(i + 1);
+    memset(pData, 'a' + i, i + 1);
+    ASSERT_EQ(transBufAddRef(buf, pData, i + 1, pData, transBufRefFree), 0);
+  }
+  EXPECT_EQ(transBufGetRefNum(buf), num);
+  EXPECT_EQ(transBufGetRefLen(buf), num * (num + 1) / 2);
+
+  // the refs move along with a buffer growing out of its size class
+  buf = (char *)transBufRealloc(buf, 10000);
+  ASSERT_EQ(transBufGetRefNum(buf), num);
+
+  std::vector<uv_buf_t> bufs(num);
+  transBufGetRefs(buf, bufs.data());
+  for (int32_t i = 0; i < num; ++i) {
+    ASSERT_EQ(bufs[i].len, i + 1);
+    ASSERT_EQ(bufs[i].base[i], 'a' + i);
+  }
+
+  transBufRefFreed = 0;
+  transBufFree(buf);
+  EXPECT_EQ(transBufRefFreed, num);
+
+  // a reused buffer carries no refs
+  buf = (char *)transBufMalloc(10000);
+  EXPECT_EQ(transBufGetRefNum(buf), 0);
+  transBufFree(buf);
+}
+
 class TransCtxEnv : public ::testing::Test {
  protected:
   virtual void SetUp() {
@@ -136,6 +136,12 @@ static inline int64_t walGetVerIdxOffset(SWal* pWal, int64_t ver) {
   return (ver - walGetCurFileFirstVer(pWal)) * sizeof(SWalIdxEntry);
 }
 
+// wait for the group fsync in flight on pLogFile before closing or switching it, the caller holds pWal->mutex
+static inline void walWaitGroupFsync(SWal* pWal) {
+  taosThreadMutexLock(&pWal->fsyncMutex);
+  taosThreadMutexUnlock(&pWal->fsyncMutex);
+}
+
 static inline void walResetVer(SWalVer* pVer) {
   pVer->firstVer = -1;
   pVer->verInSnapshotting = -1;
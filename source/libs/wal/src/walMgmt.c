@@ -86,6 +86,9 @@ SWal *walOpen(const char *path, SWalCfg *pCfg) {
     taosMemoryFree(pWal);
     return NULL;
   }
+  taosThreadMutexInit(&pWal->fsyncMutex, NULL);
+  taosThreadMutexInit(&pWal->groupMutex, NULL);
+  taosThreadCondInit(&pWal->groupCond, NULL);
 
   // set config
   memcpy(&pWal->cfg, pCfg, sizeof(SWalCfg));
@@ -171,6 +174,9 @@ _err:
   taosArrayDestroy(pWal->fileInfoSet);
   taosHashCleanup(pWal->pRefHash);
   taosThreadMutexDestroy(&pWal->mutex);
+  taosThreadMutexDestroy(&pWal->fsyncMutex);
+  taosThreadMutexDestroy(&pWal->groupMutex);
+  taosThreadCondDestroy(&pWal->groupCond);
   taosMemoryFree(pWal);
   pWal = NULL;
   return NULL;
@@ -211,6 +217,7 @@ int32_t walPersist(SWal *pWal) {
 
 void walClose(SWal *pWal) {
   taosThreadMutexLock(&pWal->mutex);
+  walWaitGroupFsync(pWal);
   (void)walSaveMeta(pWal);
   taosCloseFile(&pWal->pLogFile);
   pWal->pLogFile = NULL;
@@ -240,6 +247,9 @@ static void walFreeObj(void *wal) {
   wDebug("vgId:%d, wal:%p is freed", pWal->cfg.vgId, pWal);
 
   taosThreadMutexDestroy(&pWal->mutex);
+  taosThreadMutexDestroy(&pWal->fsyncMutex);
+  taosThreadMutexDestroy(&pWal->groupMutex);
+  taosThreadCondDestroy(&pWal->groupCond);
   taosMemoryFreeClear(pWal);
 }
 
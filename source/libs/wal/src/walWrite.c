@@ -36,6 +36,7 @@ int32_t walRestoreFromSnapshot(SWal *pWal, int64_t ver) {
     }
   }
 
+  walWaitGroupFsync(pWal);
   taosCloseFile(&pWal->pLogFile);
   taosCloseFile(&pWal->pIdxFile);
 
@@ -387,6 +388,8 @@ END:
 int32_t walRollImpl(SWal *pWal) {
   int32_t code = 0;
 
+  walWaitGroupFsync(pWal);
+
   if (pWal->pIdxFile != NULL) {
     code = taosFsyncFile(pWal->pIdxFile);
     if (code != 0) {
@@ -506,15 +509,8 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
     goto END;
   }
 
-  if (taosWriteFile(pWal->pLogFile, &pWal->writeHead, sizeof(SWalCkHead)) != sizeof(SWalCkHead)) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
-           strerror(errno));
-    code = -1;
-    goto END;
-  }
-
-  if (taosWriteFile(pWal->pLogFile, (char *)body, bodyLen) != bodyLen) {
+  TdFileIoVec aVec[2] = {{.pBuf = &pWal->writeHead, .len = sizeof(SWalCkHead)}, {.pBuf = body, .len = bodyLen}};
+  if (taosWritevFile(pWal->pLogFile, aVec, bodyLen > 0 ? 2 : 1) != sizeof(SWalCkHead) + bodyLen) {
     terrno = TAOS_SYSTEM_ERROR(errno);
     wError("vgId:%d, file:%" PRId64 ".log, failed to write since %s", pWal->cfg.vgId, walGetLastFileFirstVer(pWal),
            strerror(errno));
@@ -527,6 +523,7 @@ static FORCE_INLINE int32_t walWriteImpl(SWal *pWal, int64_t index, tmsg_t msgTy
     pWal->vers.firstVer = 0;
   }
   pWal->vers.lastVer = index;
+  pWal->appendSeq++;
   pWal->totSize += sizeof(SWalCkHead) + bodyLen;
   pFileInfo->lastVer = index;
   pFileInfo->fileSize += sizeof(SWalCkHead) + bodyLen;
@@ -630,7 +627,62 @@ int32_t walWrite(SWal *pWal, int64_t index, tmsg_t msgType, const void *body, in
   return walWriteWithSyncInfo(pWal, index, msgType, syncMeta, body, bodyLen);
 }
 
+bool walGroupCommit(SWal *pWal) { return tsWalGroupCommitUs >= 0; }
+
+// the first caller finding no fsync in flight leads one for the appends of all callers so far, the others wait for it
+static void walGroupFsync(SWal *pWal) {
+  taosThreadMutexLock(&pWal->mutex);
+  int64_t seq = pWal->appendSeq;
+  taosThreadMutexUnlock(&pWal->mutex);
+
+  taosThreadMutexLock(&pWal->groupMutex);
+  while (pWal->fsyncedSeq < seq) {
+    if (pWal->fsyncing) {
+      taosThreadCondWait(&pWal->groupCond, &pWal->groupMutex);
+      continue;
+    }
+    pWal->fsyncing = 1;
+    int64_t fsyncedSeq = pWal->fsyncedSeq;
+    taosThreadMutexUnlock(&pWal->groupMutex);
+
+    // let the concurrent appends join this fsync
+    if (tsWalGroupCommitUs > 0) {
+      taosUsleep(tsWalGroupCommitUs);
+    }
+
+    taosThreadMutexLock(&pWal->mutex);
+    int64_t   syncSeq = pWal->appendSeq;
+    int64_t   fileFirstVer = walGetCurFileFirstVer(pWal);
+    TdFilePtr pFile = pWal->pLogFile;
+    taosThreadMutexLock(&pWal->fsyncMutex);
+    taosThreadMutexUnlock(&pWal->mutex);
+
+    wTrace("vgId:%d, fileId:%" PRId64 ".log, do group fsync, appends:%" PRId64, pWal->cfg.vgId, fileFirstVer,
+           syncSeq - fsyncedSeq);
+    int32_t code = taosFsyncFile(pFile);
+    taosThreadMutexUnlock(&pWal->fsyncMutex);
+    if (code < 0) {
+      wError("vgId:%d, file:%" PRId64 ".log, fsync failed since %s", pWal->cfg.vgId, fileFirstVer, strerror(errno));
+    }
+
+    taosThreadMutexLock(&pWal->groupMutex);
+    pWal->fsyncing = 0;
+    pWal->groupFsyncs++;
+    // a failed fsync is not retried by the waiters, as without group commit
+    pWal->fsyncedSeq = TMAX(pWal->fsyncedSeq, syncSeq);
+    taosThreadCondBroadcast(&pWal->groupCond);
+  }
+  taosThreadMutexUnlock(&pWal->groupMutex);
+}
+
 void walFsync(SWal *pWal, bool forceFsync) {
+  if (walGroupCommit(pWal)) {
+    if (forceFsync || (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0)) {
+      walGroupFsync(pWal);
+    }
+    return;
+  }
+
   taosThreadMutexLock(&pWal->mutex);
   if (forceFsync || (pWal->cfg.level == TAOS_WAL_FSYNC && pWal->cfg.fsyncPeriod == 0)) {
     wTrace("vgId:%d, fileId:%" PRId64 ".log, do fsync", pWal->cfg.vgId, walGetCurFileFirstVer(pWal));
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Append benchmark of the wal against its fsync policy.
+ *
+ * Writers append small logs to one wal the way syncLogBufferProceed does: versions are assigned and the logs appended
+ * under one mutex, standing for the log buffer lock, and the fsync is taken after it is released. Each writer waits
+ * for its own log to be durable before taking the next one. The policy is one of
+ *   write: walLevel 1, no fsync
+ *   fsync: walLevel 2 with fsyncPeriod 0, one fsync per append
+ *   group: as fsync, but the concurrent fsyncs are grouped, the leader waiting -g microseconds for more appends
+ *
+ * usage: walBench [-p write|fsync|group] [-w writers] [-n appends per writer] [-b body size] [-g group window us]
+ */
+
+#include "tglobal.h"
+#include "wal.h"
+
+typedef struct {
+  SWal         *pWal;
+  int32_t       nAppend;
+  int32_t       bodyLen;
+  TdThreadMutex mutex;
+  int64_t       nFail;
+} SBenchCtx;
+
+static void *benchAppendFn(void *param) {
+  SBenchCtx   *pCtx = param;
+  char        *body = taosMemoryCalloc(1, pCtx->bodyLen);
+  SWalSyncInfo syncMeta = {.isWeek = -1, .seqNum = UINT64_MAX, .term = UINT64_MAX};
+  int64_t      nFail = 0;
+
+  for (int32_t i = 0; i < pCtx->nAppend; i++) {
+    taosThreadMutexLock(&pCtx->mutex);
+    int64_t ver = walGetLastVer(pCtx->pWal) + 1;
+    if (walAppendLog(pCtx->pWal, ver, TDMT_VND_SUBMIT, syncMeta, body, pCtx->bodyLen) < 0) nFail++;
+    taosThreadMutexUnlock(&pCtx->mutex);
+
+    walFsync(pCtx->pWal, false);
+  }
+
+  atomic_add_fetch_64(&pCtx->nFail, nFail);
+  taosMemoryFree(body);
+  return NULL;
+}
+
+int main(int argc, char *argv[]) {
+  const char *policy = "group";
+  int32_t     nWriter = 8;
+  int32_t     groupUs = 0;
+  SBenchCtx   ctx = {.nAppend = 10000, .bodyLen = 128};
+
+  for (int32_t i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+      policy = argv[++i];
+    } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+      nWriter = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      ctx.nAppend = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+      ctx.bodyLen = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+      groupUs = atoi(argv[++i]);
+    } else {
+      printf("usage: %s [-p write|fsync|group] [-w writers] [-n appends per writer] [-b body size] [-g group window us]\n",
+             argv[0]);
+      return -1;
+    }
+  }
+  if (nWriter <= 0 || ctx.nAppend <= 0 || ctx.bodyLen <= 0 || groupUs < 0) {
+    printf("invalid arguments\n");
+    return -1;
+  }
+
+  SWalCfg cfg = {.vgId = 1, .fsyncPeriod = 0, .rollPeriod = -1, .segSize = -1, .level = TAOS_WAL_FSYNC};
+  if (strcmp(policy, "write") == 0) {
+    cfg.level = TAOS_WAL_WRITE;
+  } else if (strcmp(policy, "fsync") == 0) {
+    tsWalGroupCommitUs = -1;
+  } else if (strcmp(policy, "group") == 0) {
+    tsWalGroupCommitUs = groupUs;
+  } else {
+    printf("invalid policy %s\n", policy);
+    return -1;
+  }
+
+  char path[PATH_MAX] = {0};
+  snprintf(path, sizeof(path), "%swalBench", TD_TMP_DIR_PATH);
+  taosRemoveDir(path);
+
+  if (walInit() != 0) {
+    printf("failed to init wal since %s\n", terrstr());
+    return -1;
+  }
+  ctx.pWal = walOpen(path, &cfg);
+  if (ctx.pWal == NULL) {
+    printf("failed to open wal %s since %s\n", path, terrstr());
+    return -1;
+  }
+
+  TdThread *aThread = taosMemoryCalloc(nWriter, sizeof(TdThread));
+  taosThreadMutexInit(&ctx.mutex, NULL);
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 0; i < nWriter; i++) {
+    taosThreadCreate(&aThread[i], NULL, benchAppendFn, &ctx);
+  }
+  for (int32_t i = 0; i < nWriter; i++) {
+    taosThreadJoin(aThread[i], NULL);
+  }
+  int64_t et = taosGetTimestampUs();
+
+  int64_t nExpect = (int64_t)nWriter * ctx.nAppend;
+  int64_t lastVer = walGetLastVer(ctx.pWal);
+  double  elapsed = (et - st) / 1000000.0;
+  printf("policy:%s writers:%d body:%d group window:%dus appends:%" PRId64 " elapsed:%.3fs\n", policy, nWriter,
+         ctx.bodyLen, groupUs, nExpect, elapsed);
+  printf("append:%.0f logs/s %.2fMB/s last version:%" PRId64 " failed:%" PRId64 "\n", nExpect / elapsed,
+         nExpect * (sizeof(SWalCkHead) + ctx.bodyLen) / elapsed / 1024 / 1024, lastVer, ctx.nFail);
+
+  taosThreadMutexDestroy(&ctx.mutex);
+  taosMemoryFree(aThread);
+  walClose(ctx.pWal);
+  walCleanUp();
+  taosRemoveDir(path);
+  return (lastVer + 1 == nExpect && ctx.nFail == 0) ? 0 : -1;
+}
@@ -2,7 +2,10 @@
 #include <cstring>
 #include <iostream>
 #include <queue>
+#include <thread>
+#include <vector>
 
+#include "tglobal.h"
 #include "walInt.h"
 
 const char* ranStr = "tvapq02tcp";
@@ -442,3 +445,58 @@ TEST_F(WalRetentionEnv, repairMeta1) {
     }
   }
 }
+
+TEST_F(WalCleanEnv, groupFsync) {
+  const int     nThread = 8;
+  int32_t       groupCommitUs = tsWalGroupCommitUs;
+  TdThreadMutex mutex;
+
+  // a window long enough for all the appenders to join the fsync of the first one
+  tsWalGroupCommitUs = 500000;
+  taosThreadMutexInit(&mutex, NULL);
+
+  // versions are assigned and appended under one lock as the sync log buffer does, the fsync is out of it
+  auto f = [&]() {
+    SWalSyncInfo syncMeta = {.isWeek = -1, .seqNum = UINT64_MAX, .term = UINT64_MAX};
+
+    taosThreadMutexLock(&mutex);
+    int64_t ver = walGetLastVer(pWal) + 1;
+    EXPECT_EQ(walAppendLog(pWal, ver, 0, syncMeta, ranStr, ranStrLen), ver);
+    int64_t seq = pWal->appendSeq;
+    taosThreadMutexUnlock(&mutex);
+
+    walFsync(pWal, true);
+
+    // the append is durable once walFsync returns
+    taosThreadMutexLock(&pWal->groupMutex);
+    EXPECT_GE(pWal->fsyncedSeq, seq);
+    taosThreadMutexUnlock(&pWal->groupMutex);
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThread; i++) {
+    threads.push_back(std::thread(f));
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+
+  ASSERT_EQ(pWal->vers.lastVer, nThread - 1);
+  ASSERT_EQ(pWal->fsyncedSeq, pWal->appendSeq);
+  ASSERT_EQ(pWal->groupFsyncs, 1);
+
+  // an fsync with nothing appended since is skipped
+  walFsync(pWal, true);
+  ASSERT_EQ(pWal->groupFsyncs, 1);
+
+  // without a window, each caller finding no fsync in flight leads its own
+  tsWalGroupCommitUs = 0;
+  for (int i = 0; i < 3; i++) {
+    f();
+  }
+  ASSERT_EQ(pWal->vers.lastVer, nThread + 2);
+  ASSERT_EQ(pWal->groupFsyncs, 4);
+
+  tsWalGroupCommitUs = groupCommitUs;
+  taosThreadMutexDestroy(&mutex);
+}
@@ -34,7 +34,9 @@
 #if !defined(_TD_DARWIN_64)
 #include <sys/sendfile.h>
 #endif
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #define LINUX_FILE_NO_TEXT_OPTION 0
 #define O_TEXT                    LINUX_FILE_NO_TEXT_OPTION
@@ -516,6 +518,77 @@ int64_t taosWriteFile(TdFilePtr pFile, const void *buf, int64_t count) {
   return count;
 }
 
+int64_t taosWritevFile(TdFilePtr pFile, const TdFileIoVec *aVec, int32_t nVec) {
+  if (pFile == NULL) {
+    return 0;
+  }
+  if (nVec <= 0 || nVec > TD_FILE_IOV_MAX) {
+    errno = EINVAL;
+    return -1;
+  }
+#ifdef WINDOWS
+  int64_t count = 0;
+  for (int32_t i = 0; i < nVec; i++) {
+    if (taosWriteFile(pFile, aVec[i].pBuf, aVec[i].len) != aVec[i].len) {
+      return -1;
+    }
+    count += aVec[i].len;
+  }
+  return count;
+#else
+  struct iovec iov[TD_FILE_IOV_MAX];
+  int64_t      count = 0;
+  for (int32_t i = 0; i < nVec; i++) {
+    iov[i].iov_base = (void *)aVec[i].pBuf;
+    iov[i].iov_len = aVec[i].len;
+    count += aVec[i].len;
+  }
+
+#if FILE_WITH_LOCK
+  taosThreadRwlockWrlock(&(pFile->rwlock));
+#endif
+  if (pFile->fd < 0) {
+#if FILE_WITH_LOCK
+    taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+    return 0;
+  }
+
+  struct iovec *pIov = iov;
+  int32_t       nIov = nVec;
+  int64_t       nleft = count;
+  while (nleft > 0) {
+    int64_t nwritten = writev(pFile->fd, pIov, nIov);
+    if (nwritten < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+#if FILE_WITH_LOCK
+      taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+      return -1;
+    }
+    nleft -= nwritten;
+
+    // skip what has been written on a short write
+    while (nIov > 0 && nwritten >= (int64_t)pIov->iov_len) {
+      nwritten -= pIov->iov_len;
+      pIov++;
+      nIov--;
+    }
+    if (nIov > 0) {
+      pIov->iov_base = (char *)pIov->iov_base + nwritten;
+      pIov->iov_len -= nwritten;
+    }
+  }
+
+#if FILE_WITH_LOCK
+  taosThreadRwlockUnlock(&(pFile->rwlock));
+#endif
+  return count;
+#endif
+}
+
 int64_t taosPWriteFile(TdFilePtr pFile, const void *buf, int64_t count, int64_t offset) {
   if (pFile == NULL) {
     return 0;
@@ -602,6 +675,33 @@ int32_t taosFStatFile(TdFilePtr pFile, int64_t *size, int32_t *mtime) {
   return 0;
 }
 
+void *taosMmapReadOnlyFile(TdFilePtr pFile, int64_t length) {
+  if (pFile == NULL || pFile->fd < 0 || length <= 0) {
+    return NULL;
+  }
+#ifdef WINDOWS
+  return NULL;
+#else
+  void *ptr = mmap(NULL, length, PROT_READ, MAP_SHARED, pFile->fd, 0);
+  if (ptr == MAP_FAILED) {
+    terrno = TAOS_SYSTEM_ERROR(errno);
+    return NULL;
+  }
+  return ptr;
+#endif
+}
+
+int32_t taosMunmapFile(void *ptr, int64_t length) {
+  if (ptr == NULL) {
+    return 0;
+  }
+#ifdef WINDOWS
+  return 0;
+#else
+  return munmap(ptr, length);
+#endif
+}
+
 int32_t taosLockFile(TdFilePtr pFile) {
   ASSERT(pFile->fd >= 0);  // Please check if you have closed the file.
   if (pFile->fd < 0) {
@@ -51,6 +51,7 @@
 #include "tcompression.h"
 #include "lz4.h"
 #include "tRealloc.h"
+#include "tencode.h"
 #include "tlog.h"
 
 #ifdef TD_TSZ
@@ -86,6 +87,397 @@ void tsCompressExit() { tdszExit(); }
 
 #endif
 
+/*
+ * Adaptive codec selection.
+ *
+ * When tsCompressAdaptive is set, a few windows of each block are sampled before the fixed codec of the type runs.
+ * The size of the fixed codec and of the run length, dictionary and delta bit-packing codecs is estimated from the
+ * samples, and the block is encoded by the smallest one. The adaptive codecs save their id in the first byte, which
+ * the fixed codecs only set to 0 or 1, so the blocks written before are decoded as they were.
+ */
+bool tsCompressAdaptive = false;
+
+#define ADAPT_SAMPLE_WINDOWS 4
+#define ADAPT_SAMPLE_WINSIZE 64
+#define ADAPT_DICT_MAX       256
+#define ADAPT_BP_FRAME       128
+#define ADAPT_MIN_GAIN       0.8  // an adaptive codec is used only if it is estimated to save 20% at least
+
+typedef struct {
+  int32_t  nDict;
+  uint64_t aDict[ADAPT_DICT_MAX];
+  int16_t  aSlot[ADAPT_DICT_MAX * 2];  // index in aDict plus 1, 0 for empty slot
+} SAdaptDict;
+
+static FORCE_INLINE int32_t tAdaptWordBytes(int8_t type) {
+  switch (type) {
+    case TSDB_DATA_TYPE_TINYINT:
+      return CHAR_BYTES;
+    case TSDB_DATA_TYPE_SMALLINT:
+      return SHORT_BYTES;
+    case TSDB_DATA_TYPE_INT:
+    case TSDB_DATA_TYPE_FLOAT:
+      return INT_BYTES;
+    case TSDB_DATA_TYPE_BIGINT:
+    case TSDB_DATA_TYPE_TIMESTAMP:
+    case TSDB_DATA_TYPE_DOUBLE:
+      return LONG_BYTES;
+    default:
+      return 0;
+  }
+}
+
+static FORCE_INLINE uint64_t tAdaptGet(const char *input, int32_t i, int32_t width) {
+  switch (width) {
+    case CHAR_BYTES:
+      return (uint64_t)((int8_t *)input)[i];
+    case SHORT_BYTES:
+      return (uint64_t)((int16_t *)input)[i];
+    case INT_BYTES:
+      return (uint64_t)((int32_t *)input)[i];
+    default:
+      return ((uint64_t *)input)[i];
+  }
+}
+
+static FORCE_INLINE void tAdaptPut(char *output, int32_t i, uint64_t v, int32_t width) {
+  switch (width) {
+    case CHAR_BYTES:
+      ((int8_t *)output)[i] = (int8_t)v;
+      break;
+    case SHORT_BYTES:
+      ((int16_t *)output)[i] = (int16_t)v;
+      break;
+    case INT_BYTES:
+      ((int32_t *)output)[i] = (int32_t)v;
+      break;
+    default:
+      ((uint64_t *)output)[i] = v;
+      break;
+  }
+}
+
+static FORCE_INLINE int32_t tAdaptBits(uint64_t v) { return v ? LONG_BYTES * BITS_PER_BYTE - BUILDIN_CLZL(v) : 0; }
+
+// the buffer is zeroed before, and v has no bit set above w
+static FORCE_INLINE void tBitPackPut(uint8_t *p, int64_t bitPos, uint64_t v, int32_t w) {
+  int64_t off = bitPos >> 3;
+  for (int32_t b = -(int32_t)(bitPos & 7); b < w; b += BITS_PER_BYTE, off++) {
+    p[off] |= (uint8_t)(b >= 0 ? v >> b : v << -b);
+  }
+}
+
+static FORCE_INLINE uint64_t tBitPackGet(const uint8_t *p, int64_t bitPos, int32_t w, int32_t nBytes) {
+  int64_t  off = bitPos >> 3;
+  int32_t  shift = bitPos & 7;
+  uint64_t v = 0;
+
+  if (w == 0) return 0;
+
+  if (w + shift <= LONG_BYTES * BITS_PER_BYTE && off + LONG_BYTES <= nBytes) {
+    memcpy(&v, p + off, LONG_BYTES);
+    v >>= shift;
+  } else {
+    for (int32_t b = -shift; b < w; b += BITS_PER_BYTE, off++) {
+      v |= b >= 0 ? (uint64_t)p[off] << b : (uint64_t)p[off] >> -b;
+    }
+  }
+
+  return w == LONG_BYTES * BITS_PER_BYTE ? v : v & INT64MASK(w);
+}
+
+// return the index of v in the dictionary, or -1 if it is not in and can not be added
+static int32_t tAdaptDictIndex(SAdaptDict *pDict, uint64_t v, bool add) {
+  int32_t nSlot = sizeof(pDict->aSlot) / sizeof(pDict->aSlot[0]);
+  int32_t iSlot = (int32_t)((v * 0x9E3779B97F4A7C15ull) >> 55) & (nSlot - 1);
+
+  for (;; iSlot = (iSlot + 1) & (nSlot - 1)) {
+    int32_t idx = pDict->aSlot[iSlot] - 1;
+    if (idx < 0) break;
+    if (pDict->aDict[idx] == v) return idx;
+  }
+
+  if (!add || pDict->nDict >= ADAPT_DICT_MAX) return -1;
+
+  pDict->aDict[pDict->nDict] = v;
+  pDict->aSlot[iSlot] = ++pDict->nDict;
+  return pDict->nDict - 1;
+}
+
+static int8_t tAdaptChooseCodec(const char *const input, const int32_t nelements, int8_t type, int32_t width) {
+  bool       isFloat = (type == TSDB_DATA_TYPE_FLOAT || type == TSDB_DATA_TYPE_DOUBLE);
+  int32_t    nWin = TMIN(nelements / ADAPT_SAMPLE_WINSIZE, ADAPT_SAMPLE_WINDOWS);
+  int32_t    step = nelements / nWin;
+  int32_t    nSample = nWin * ADAPT_SAMPLE_WINSIZE;
+  int32_t    nRun = 0;
+  bool       dictFull = false;
+  double     costFixed = 0, costRle = 0, costBp = 0, costDict;
+  SAdaptDict dict = {0};
+
+  for (int32_t iWin = 0; iWin < nWin; iWin++) {
+    int32_t  start = iWin * step;
+    uint64_t prev = start > 0 ? tAdaptGet(input, start - 1, width) : 0;
+    uint64_t prevDelta = start > 1 ? prev - tAdaptGet(input, start - 2, width) : prev;
+    int64_t  minDelta = INT64_MAX, maxDelta = INT64_MIN;
+
+    for (int32_t i = start; i < start + ADAPT_SAMPLE_WINSIZE; i++) {
+      uint64_t v = tAdaptGet(input, i, width);
+      uint64_t delta = v - prev;
+
+      // fixed codec of the type
+      if (isFloat) {
+        uint64_t x = v ^ prev;
+        int32_t  nZero = 0;
+        if (x) {
+          nZero = TMAX(BUILDIN_CLZL(x) - (LONG_BYTES - width) * BITS_PER_BYTE, BUILDIN_CTZL(x)) / BITS_PER_BYTE;
+        }
+        costFixed += 4 + BITS_PER_BYTE * TMAX(width - nZero, 1);
+      } else if (type == TSDB_DATA_TYPE_TIMESTAMP) {
+        uint64_t dod = delta - prevDelta;
+        costFixed += 4 + BITS_PER_BYTE * ((tAdaptBits(ZIGZAG_ENCODE(int64_t, (int64_t)dod)) + 7) / BITS_PER_BYTE);
+      } else {
+        int32_t nBit = tAdaptBits(ZIGZAG_ENCODE(int64_t, (int64_t)delta));
+        costFixed += nBit ? nBit + 1 : 0.27;
+      }
+
+      // run length
+      if (i == 0 || v != prev) {
+        nRun++;
+        costRle += BITS_PER_BYTE * tPutU64v(NULL, ZIGZAG_ENCODE(int64_t, (int64_t)delta));
+      }
+
+      // dictionary
+      if (!dictFull && tAdaptDictIndex(&dict, v, true) < 0) dictFull = true;
+
+      // delta bit-packing, the first value is saved alone
+      if (i > 0) {
+        minDelta = TMIN(minDelta, (int64_t)delta);
+        maxDelta = TMAX(maxDelta, (int64_t)delta);
+      }
+
+      prevDelta = delta;
+      prev = v;
+    }
+
+    costBp += ADAPT_SAMPLE_WINSIZE * tAdaptBits((uint64_t)maxDelta - (uint64_t)minDelta) +
+              ADAPT_SAMPLE_WINSIZE * 16.0 / ADAPT_BP_FRAME;
+  }
+
+  double scale = (double)nelements / nSample;
+  double nRunBlock = nRun * scale;
+  costFixed *= scale;
+  costRle = costRle * scale + nRunBlock * BITS_PER_BYTE * tPutU64v(NULL, (uint64_t)(nelements / nRunBlock));
+  costBp = isFloat ? costFixed : costBp * scale;
+  costDict = dictFull ? costFixed
+                      : (double)nelements * tAdaptBits(dict.nDict - 1) + dict.nDict * BITS_PER_BYTE * (width + 1) + 16;
+
+  double  cost = costFixed * ADAPT_MIN_GAIN;
+  int8_t  codec = 0;
+  if (costBp < cost) {
+    cost = costBp;
+    codec = ADAPT_CODEC_BP;
+  }
+  if (costDict < cost) {
+    cost = costDict;
+    codec = ADAPT_CODEC_DICT;
+  }
+  if (costRle < cost) {
+    cost = costRle;
+    codec = ADAPT_CODEC_RLE;
+  }
+
+  return codec;
+}
+
+static int32_t tAdaptCompressRLE(const char *const input, const int32_t nelements, char *const output, int32_t width) {
+  uint8_t *p = (uint8_t *)output;
+  int32_t  byte_limit = nelements * width + 1;
+  int32_t  opos = 1;
+  uint64_t prev = 0;
+
+  for (int32_t i = 0; i < nelements;) {
+    uint64_t v = tAdaptGet(input, i, width);
+    int32_t  j = i + 1;
+    while (j < nelements && tAdaptGet(input, j, width) == v) j++;
+
+    // two varints are 15 bytes at most
+    if (opos + 15 > byte_limit) return 0;
+    opos += tPutU64v(p + opos, ZIGZAG_ENCODE(int64_t, (int64_t)(v - prev)));
+    opos += tPutU32v(p + opos, j - i);
+
+    prev = v;
+    i = j;
+  }
+
+  p[0] = ADAPT_CODEC_RLE;
+  return opos;
+}
+
+static int32_t tAdaptCompressDict(const char *const input, const int32_t nelements, char *const output,
+                                  int32_t width) {
+  uint8_t   *p = (uint8_t *)output;
+  int32_t    byte_limit = nelements * width + 1;
+  int32_t    opos = 1;
+  SAdaptDict dict = {0};
+
+  for (int32_t i = 0; i < nelements; i++) {
+    if (tAdaptDictIndex(&dict, tAdaptGet(input, i, width), true) < 0) return 0;
+  }
+
+  int32_t w = tAdaptBits(dict.nDict - 1);
+  int32_t nBytes = (int32_t)(((int64_t)nelements * w + 7) / BITS_PER_BYTE);
+  if (opos + 5 + dict.nDict * 10 + 1 + nBytes > byte_limit) return 0;
+
+  uint64_t prev = 0;
+  opos += tPutU32v(p + opos, dict.nDict);
+  for (int32_t iDict = 0; iDict < dict.nDict; iDict++) {
+    opos += tPutU64v(p + opos, ZIGZAG_ENCODE(int64_t, (int64_t)(dict.aDict[iDict] - prev)));
+    prev = dict.aDict[iDict];
+  }
+  p[opos++] = (uint8_t)w;
+
+  memset(p + opos, 0, nBytes);
+  if (w > 0) {
+    for (int32_t i = 0; i < nelements; i++) {
+      tBitPackPut(p + opos, (int64_t)i * w, tAdaptDictIndex(&dict, tAdaptGet(input, i, width), false), w);
+    }
+  }
+  opos += nBytes;
+
+  p[0] = ADAPT_CODEC_DICT;
+  return opos;
+}
+
+static int32_t tAdaptCompressBP(const char *const input, const int32_t nelements, char *const output, int32_t width) {
+  uint8_t *p = (uint8_t *)output;
+  int32_t  byte_limit = nelements * width + 1;
+  int32_t  opos = 1;
+  uint64_t prev = tAdaptGet(input, 0, width);
+  uint64_t aDelta[ADAPT_BP_FRAME];
+
+  // the first value is saved alone so that the deltas of the first frame are not widened by it
+  opos += tPutI64v(p + opos, (int64_t)prev);
+  for (int32_t i = 1; i < nelements; i += ADAPT_BP_FRAME) {
+    int32_t nVal = TMIN(ADAPT_BP_FRAME, nelements - i);
+    int64_t minDelta = INT64_MAX;
+
+    for (int32_t j = 0; j < nVal; j++) {
+      uint64_t v = tAdaptGet(input, i + j, width);
+      aDelta[j] = v - prev;
+      minDelta = TMIN(minDelta, (int64_t)aDelta[j]);
+      prev = v;
+    }
+
+    uint64_t bits = 0;
+    for (int32_t j = 0; j < nVal; j++) {
+      aDelta[j] -= (uint64_t)minDelta;
+      bits |= aDelta[j];
+    }
+
+    int32_t w = tAdaptBits(bits);
+    int32_t nBytes = (nVal * w + 7) / BITS_PER_BYTE;
+    if (opos + 11 + nBytes > byte_limit) return 0;
+
+    opos += tPutU64v(p + opos, ZIGZAG_ENCODE(int64_t, minDelta));
+    p[opos++] = (uint8_t)w;
+    memset(p + opos, 0, nBytes);
+    for (int32_t j = 0; w > 0 && j < nVal; j++) {
+      tBitPackPut(p + opos, (int64_t)j * w, aDelta[j], w);
+    }
+    opos += nBytes;
+  }
+
+  p[0] = ADAPT_CODEC_BP;
+  return opos;
+}
+
+// return 0 if the fixed codec of the type should be used
+static int32_t tsCompressAdaptImp(const char *const input, const int32_t nelements, char *const output, int8_t type) {
+  int32_t width = tAdaptWordBytes(type);
+  if (width == 0 || nelements < ADAPT_SAMPLE_WINSIZE) return 0;
+
+  switch (tAdaptChooseCodec(input, nelements, type, width)) {
+    case ADAPT_CODEC_RLE:
+      return tAdaptCompressRLE(input, nelements, output, width);
+    case ADAPT_CODEC_DICT:
+      return tAdaptCompressDict(input, nelements, output, width);
+    case ADAPT_CODEC_BP:
+      return tAdaptCompressBP(input, nelements, output, width);
+    default:
+      return 0;
+  }
+}
+
+static int32_t tsDecompressAdaptImp(const char *const input, const int32_t nelements, char *const output,
+                                    int32_t width) {
+  uint8_t *p = (uint8_t *)input;
+  int32_t  ipos = 1;
+  uint64_t v = 0;
+
+  switch (p[0]) {
+    case ADAPT_CODEC_RLE: {
+      for (int32_t i = 0; i < nelements;) {
+        uint64_t zigzag_value = 0;
+        uint32_t nRun = 0;
+        ipos += tGetU64v(p + ipos, &zigzag_value);
+        ipos += tGetU32v(p + ipos, &nRun);
+        if (nRun == 0 || nRun > nelements - i) return -1;
+
+        v += ZIGZAG_DECODE(int64_t, zigzag_value);
+        for (int32_t j = i + nRun; i < j; i++) {
+          tAdaptPut(output, i, v, width);
+        }
+      }
+    } break;
+    case ADAPT_CODEC_DICT: {
+      uint64_t aDict[ADAPT_DICT_MAX];
+      uint32_t nDict = 0;
+      ipos += tGetU32v(p + ipos, &nDict);
+      if (nDict == 0 || nDict > ADAPT_DICT_MAX) return -1;
+      for (int32_t iDict = 0; iDict < nDict; iDict++) {
+        uint64_t zigzag_value = 0;
+        ipos += tGetU64v(p + ipos, &zigzag_value);
+        v += ZIGZAG_DECODE(int64_t, zigzag_value);
+        aDict[iDict] = v;
+      }
+
+      int32_t w = p[ipos++];
+      int32_t nBytes = (int32_t)(((int64_t)nelements * w + 7) / BITS_PER_BYTE);
+      for (int32_t i = 0; i < nelements; i++) {
+        uint64_t idx = tBitPackGet(p + ipos, (int64_t)i * w, w, nBytes);
+        if (idx >= nDict) return -1;
+        tAdaptPut(output, i, aDict[idx], width);
+      }
+    } break;
+    case ADAPT_CODEC_BP: {
+      int64_t first = 0;
+      ipos += tGetI64v(p + ipos, &first);
+      v = (uint64_t)first;
+      tAdaptPut(output, 0, v, width);
+      for (int32_t i = 1; i < nelements; i += ADAPT_BP_FRAME) {
+        int32_t  nVal = TMIN(ADAPT_BP_FRAME, nelements - i);
+        uint64_t zigzag_value = 0;
+        ipos += tGetU64v(p + ipos, &zigzag_value);
+        uint64_t minDelta = ZIGZAG_DECODE(int64_t, zigzag_value);
+        int32_t  w = p[ipos++];
+        int32_t  nBytes = (nVal * w + 7) / BITS_PER_BYTE;
+        if (w > LONG_BYTES * BITS_PER_BYTE) return -1;
+
+        for (int32_t j = 0; j < nVal; j++) {
+          v += minDelta + tBitPackGet(p + ipos, (int64_t)j * w, w, nBytes);
+          tAdaptPut(output, i + j, v, width);
+        }
+        ipos += nBytes;
+      }
+    } break;
+    default:
+      uError("Invalid adaptive codec:%d", p[0]);
+      return -1;
+  }
+
+  return nelements * width;
+}
+
 /*
  * Compress Integer (Simple8B).
  */
@@ -118,6 +510,11 @@ int32_t tsCompressINTImp(const char *const input, const int32_t nelements, char
       return -1;
   }
 
+  if (tsCompressAdaptive) {
+    int32_t len = tsCompressAdaptImp(input, nelements, output, type);
+    if (len > 0) return len;
+  }
+
   int32_t byte_limit = nelements * word_length + 1;
   int32_t opos = 1;
   int64_t prev_value = 0;
@@ -241,6 +638,8 @@ int32_t tsDecompressINTImp(const char *const input, const int32_t nelements, cha
       return -1;
   }
 
+  if (IS_ADAPT_CODEC(input[0])) return tsDecompressAdaptImp(input, nelements, output, word_length);
+
   // If not compressed.
   if (input[0] == 1) {
     memcpy(output, input + 1, nelements * word_length);
@@ -648,6 +1047,11 @@ int32_t tsCompressTimestampImp(const char *const input, const int32_t nelements,
 
   if (nelements == 0) return 0;
 
+  if (tsCompressAdaptive) {
+    int32_t len = tsCompressAdaptImp(input, nelements, output, TSDB_DATA_TYPE_TIMESTAMP);
+    if (len > 0) return len;
+  }
+
   int64_t *istream = (int64_t *)input;
 
   int64_t prev_value = istream[0];
@@ -742,6 +1146,8 @@ int32_t tsDecompressTimestampImp(const char *const input, const int32_t nelement
   ASSERTS(nelements >= 0, "nelements is negative");
   if (nelements == 0) return 0;
 
+  if (IS_ADAPT_CODEC(input[0])) return tsDecompressAdaptImp(input, nelements, output, LONG_BYTES);
+
   if (input[0] == 0) {
     memcpy(output, input + 1, nelements * LONG_BYTES);
     return nelements * LONG_BYTES;
@@ -822,6 +1228,11 @@ void encodeDoubleValue(uint64_t diff, uint8_t flag, char *const output, int32_t
 }
 
 int32_t tsCompressDoubleImp(const char *const input, const int32_t nelements, char *const output) {
+  if (tsCompressAdaptive) {
+    int32_t len = tsCompressAdaptImp(input, nelements, output, TSDB_DATA_TYPE_DOUBLE);
+    if (len > 0) return len;
+  }
+
   int32_t byte_limit = nelements * DOUBLE_BYTES + 1;
   int32_t opos = 1;
 
@@ -921,6 +1332,8 @@ int32_t tsDecompressDoubleImp(const char *const input, const int32_t nelements,
   // output stream
   double *ostream = (double *)output;
 
+  if (IS_ADAPT_CODEC(input[0])) return tsDecompressAdaptImp(input, nelements, output, DOUBLE_BYTES);
+
   if (input[0] == 1) {
     memcpy(output, input + 1, nelements * DOUBLE_BYTES);
     return nelements * DOUBLE_BYTES;
@@ -967,6 +1380,11 @@ void encodeFloatValue(uint32_t diff, uint8_t flag, char *const output, int32_t *
 }
 
 int32_t tsCompressFloatImp(const char *const input, const int32_t nelements, char *const output) {
+  if (tsCompressAdaptive) {
+    int32_t len = tsCompressAdaptImp(input, nelements, output, TSDB_DATA_TYPE_FLOAT);
+    if (len > 0) return len;
+  }
+
   float  *istream = (float *)input;
   int32_t byte_limit = nelements * FLOAT_BYTES + 1;
   int32_t opos = 1;
@@ -1064,6 +1482,8 @@ uint32_t decodeFloatValue(const char *const input, int32_t *const ipos, uint8_t
 int32_t tsDecompressFloatImp(const char *const input, const int32_t nelements, char *const output) {
   float *ostream = (float *)output;
 
+  if (IS_ADAPT_CODEC(input[0])) return tsDecompressAdaptImp(input, nelements, output, FLOAT_BYTES);
+
   if (input[0] == 1) {
     memcpy(output, input + 1, nelements * FLOAT_BYTES);
     return nelements * FLOAT_BYTES;
@@ -1,7 +1,8 @@
 #define _DEFAULT_SOURCE
 #include "tpagedbuf.h"
+#include "lz4.h"
 #include "taoserror.h"
-#include "tcompression.h"
+#include "tsched.h"
 #include "tsimplehash.h"
 #include "tlog.h"
 
@@ -10,6 +11,22 @@
 #define CLEAR_BUF_PAGE_IN_MEM_FLAG(_p) ((_p)->pData = NULL)
 #define HAS_DATA_IN_DISK(_p)           ((_p)->offset >= 0)
 #define NO_IN_MEM_AVAILABLE_PAGES(_b)  (listNEles((_b)->lruList) >= (_b)->inMemPages)
+#define GET_DISK_PAGE_SIZE(_b)         ((_b)->pageSize + (int32_t)sizeof(SFilePage))
+
+#define DBUF_SPILL_THREADS      4
+#define DBUF_SPILL_QUEUE_SIZE   1024
+#define DBUF_MAX_PENDING_WRITES 8  // max number of in-flight page writes of each paged buffer
+
+typedef struct SPageSpillTask {
+  SDiskbasedBuf* pBuf;
+  SPageInfo*     pInfo;  // only for write task, the page that this task is flushing
+  int64_t        offset;
+  int32_t        length;
+  int32_t        pageId;
+  int32_t        code;
+  bool           done;
+  char           data[];
+} SPageSpillTask;
 
 typedef struct SPageDiskInfo {
   int64_t offset;
@@ -17,13 +34,15 @@ typedef struct SPageDiskInfo {
 } SPageDiskInfo, SFreeListItem;
 
 struct SPageInfo {
-  SListNode* pn;  // point to list node struct. it is NULL when the page is evicted from the in-memory buffer
-  void*      pData;
-  int64_t    offset;
-  int32_t    pageId;
-  int32_t    length : 29;
-  bool       used : 1;   // set current page is in used
-  bool       dirty : 1;  // set current buffer page is dirty or not
+  SListNode*      pn;  // point to list node struct. it is NULL when the page is evicted from the in-memory buffer
+  void*           pData;
+  int64_t         offset;
+  int32_t         pageId;
+  int32_t         length : 29;
+  bool            used : 1;        // set current page is in used
+  bool            dirty : 1;       // set current buffer page is dirty or not
+  bool            compressed : 1;  // the data on disk is compressed by lz4 or not
+  SPageSpillTask* pWrite;          // the in-flight write of this page, NULL if no data is being written
 };
 
 struct SDiskbasedBuf {
@@ -45,12 +64,38 @@ struct SDiskbasedBuf {
   SArray*   pFree;             // free area in file
   bool      comp;              // compressed before flushed to disk
   uint64_t  nextPos;           // next page flush position
+  int32_t   diskBufSize;       // max on disk size of one page, and the capacity of spill buffers
+
+  TdThreadMutex   spillLock;     // protect the write-behind/read-ahead states below and the statis
+  TdThreadCond    spillCond;
+  int32_t         numOfWrites;   // number of in-flight page writes
+  int32_t         spillCode;     // the first error of the background page writes
+  SPageSpillTask* pPrefetch;     // the read ahead buffer
 
   char*               id;           // for debug purpose
   bool                printStatis;  // Print statistics info when closing this buffer.
   SDiskbasedBufStatis statis;
 };
 
+// the spill threads are shared by all paged buffers, and created when the first buffer spills pages to disk.
+static void*        dBufSpillQhandle = NULL;
+static TdThreadOnce dBufSpillInit = PTHREAD_ONCE_INIT;
+
+static void dBufSpillEnvInit() {
+  dBufSpillQhandle = taosInitScheduler(DBUF_SPILL_QUEUE_SIZE, DBUF_SPILL_THREADS, "pagedbuf", NULL);
+  if (dBufSpillQhandle == NULL) {
+    uWarn("failed to init paged buffer spill threads, pages will be flushed synchronously");
+  }
+}
+
+void dBufStopSpillWorker() {
+  void* qhandle = atomic_exchange_ptr(&dBufSpillQhandle, NULL);
+  if (qhandle != NULL) {
+    taosCleanUpScheduler(qhandle);
+    taosMemoryFree(qhandle);
+  }
+}
+
 static int32_t createDiskFile(SDiskbasedBuf* pBuf) {
   if (pBuf->path == NULL) {  // prepare the file name when needed it
     char path[PATH_MAX] = {0};
@@ -67,32 +112,42 @@ static int32_t createDiskFile(SDiskbasedBuf* pBuf) {
     return TAOS_SYSTEM_ERROR(errno);
   }
 
+  taosThreadOnce(&dBufSpillInit, dBufSpillEnvInit);
   return TSDB_CODE_SUCCESS;
 }
 
-static char* doCompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
-  if (!pBuf->comp) {
-    *dst = srcSize;
-    return data;
+// compress the page into dst, the raw data is kept if it is not compressible.
+static int32_t doCompressPage(SDiskbasedBuf* pBuf, const char* payload, char* dst, bool* compressed) {
+  int32_t size = GET_DISK_PAGE_SIZE(pBuf);
+  if (pBuf->comp) {
+    int32_t len = LZ4_compress_default(payload, dst, size, pBuf->diskBufSize);
+    if (len > 0 && len < size) {
+      *compressed = true;
+      return len;
+    }
   }
 
-  *dst = tsCompressString(data, srcSize, 1, pBuf->assistBuf, srcSize, ONE_STAGE_COMP, NULL, 0);
-
-  memcpy(data, pBuf->assistBuf, *dst);
-  return data;
+  memcpy(dst, payload, size);
+  *compressed = false;
+  return size;
 }
 
-static char* doDecompressData(void* data, int32_t srcSize, int32_t* dst, SDiskbasedBuf* pBuf) {  // do nothing
-  if (!pBuf->comp) {
-    *dst = srcSize;
-    return data;
+static int32_t doDecompressPage(SDiskbasedBuf* pBuf, SPageInfo* pg, const char* src) {
+  char* payload = GET_PAYLOAD_DATA(pg);
+  if (!pg->compressed) {
+    if (src != payload) {
+      memcpy(payload, src, pg->length);
+    }
+    return TSDB_CODE_SUCCESS;
   }
 
-  *dst = tsDecompressString(data, srcSize, 1, pBuf->assistBuf, pBuf->pageSize, ONE_STAGE_COMP, NULL, 0);
-  if (*dst > 0) {
-    memcpy(data, pBuf->assistBuf, *dst);
+  int32_t len = LZ4_decompress_safe(src, payload, pg->length, GET_DISK_PAGE_SIZE(pBuf));
+  if (len != GET_DISK_PAGE_SIZE(pBuf)) {
+    uError("failed to decompress buf page:%d, length:%d, decompressed:%d, %s", pg->pageId, pg->length, len, pBuf->id);
+    return TSDB_CODE_COMPRESS_ERROR;
   }
-  return data;
+
+  return TSDB_CODE_SUCCESS;
 }
 
 static uint64_t allocateNewPositionInFile(SDiskbasedBuf* pBuf, size_t size) {
@@ -129,19 +184,139 @@ static uint64_t allocateNewPositionInFile(SDiskbasedBuf* pBuf, size_t size) {
 
 static FORCE_INLINE size_t getAllocPageSize(int32_t pageSize) { return pageSize + POINTER_BYTES + sizeof(SFilePage); }
 
-static int32_t doFlushBufPageImpl(SDiskbasedBuf* pBuf, int64_t offset, const char* pData, int32_t size) {
-  int32_t ret = taosLSeekFile(pBuf->pFile, offset, SEEK_SET);
-  if (ret == -1) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    return terrno;
+static void doWritePageTask(SSchedMsg* pMsg) {
+  SPageSpillTask* pTask = pMsg->ahandle;
+  SDiskbasedBuf*  pBuf = pTask->pBuf;
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  int64_t st = taosGetTimestampUs();
+  if (taosPWriteFile(pBuf->pFile, pTask->data, pTask->length, pTask->offset) != pTask->length) {
+    code = TAOS_SYSTEM_ERROR(errno);
+    uError("failed to flush buf page:%d to disk, offset:%" PRId64 ", length:%d, reason:%s, %s", pTask->pageId,
+           pTask->offset, pTask->length, tstrerror(code), pBuf->id);
+  }
+
+  int64_t el = taosGetTimestampUs() - st;
+
+  taosThreadMutexLock(&pBuf->spillLock);
+  if (pBuf->spillCode == TSDB_CODE_SUCCESS) {
+    pBuf->spillCode = code;
+  }
+
+  if (pTask->pInfo->pWrite == pTask) {
+    pTask->pInfo->pWrite = NULL;
+  }
+
+  pBuf->statis.flushElapsed += el;
+  pBuf->numOfWrites -= 1;
+  taosThreadCondBroadcast(&pBuf->spillCond);
+  taosThreadMutexUnlock(&pBuf->spillLock);
+
+  taosMemoryFree(pTask);
+}
+
+static void doReadPageTask(SSchedMsg* pMsg) {
+  SPageSpillTask* pTask = pMsg->ahandle;
+  SDiskbasedBuf*  pBuf = pTask->pBuf;
+
+  int32_t code = TSDB_CODE_SUCCESS;
+  if (taosPReadFile(pBuf->pFile, pTask->data, pTask->length, pTask->offset) != pTask->length) {
+    code = TAOS_SYSTEM_ERROR(errno);
+  }
+
+  taosThreadMutexLock(&pBuf->spillLock);
+  pTask->code = code;
+  pTask->done = true;
+  taosThreadCondBroadcast(&pBuf->spillCond);
+  taosThreadMutexUnlock(&pBuf->spillLock);
+}
+
+// wait for the in-flight write of the given page, until at most maxWrites writes of this buffer are in flight.
+static int32_t dBufWaitForWrites(SDiskbasedBuf* pBuf, const SPageInfo* pg, int32_t maxWrites) {
+  taosThreadMutexLock(&pBuf->spillLock);
+  while ((pg != NULL && pg->pWrite != NULL) || pBuf->numOfWrites > maxWrites) {
+    taosThreadCondWait(&pBuf->spillCond, &pBuf->spillLock);
+  }
+
+  int32_t code = pBuf->spillCode;
+  taosThreadMutexUnlock(&pBuf->spillLock);
+  return code;
+}
+
+// discard the read ahead data of the given page, or any page if pageId is -1.
+static void dBufDropPrefetch(SDiskbasedBuf* pBuf, int32_t pageId) {
+  SPageSpillTask* pTask = pBuf->pPrefetch;
+  if (pTask == NULL || (pageId != -1 && pTask->pageId != pageId)) {
+    return;
+  }
+
+  taosThreadMutexLock(&pBuf->spillLock);
+  while (!pTask->done) {
+    taosThreadCondWait(&pBuf->spillCond, &pBuf->spillLock);
   }
+  taosThreadMutexUnlock(&pBuf->spillLock);
 
-  ret = (int32_t)taosWriteFile(pBuf->pFile, pData, size);
-  if (ret != size) {
-    terrno = TAOS_SYSTEM_ERROR(errno);
-    return terrno;
+  pTask->pageId = -1;
+}
+
+// read ahead the page from disk in the spill threads, since it is likely to be touched soon when pages are
+// iterated in the order of page id.
+static void dBufPrefetchPage(SDiskbasedBuf* pBuf, int32_t pageId) {
+  if (dBufSpillQhandle == NULL || pageId > pBuf->allocateId) {
+    return;
+  }
+
+  SPageInfo** pi = tSimpleHashGet(pBuf->all, &pageId, sizeof(int32_t));
+  if (pi == NULL || *pi == NULL || BUF_PAGE_IN_MEM(*pi) || !HAS_DATA_IN_DISK(*pi) || (*pi)->length <= 0) {
+    return;
   }
 
+  SPageSpillTask* pTask = pBuf->pPrefetch;
+
+  taosThreadMutexLock(&pBuf->spillLock);
+  bool busy = ((*pi)->pWrite != NULL) || (pTask != NULL && ((!pTask->done) || pTask->pageId == pageId));
+  taosThreadMutexUnlock(&pBuf->spillLock);
+  if (busy) {
+    return;
+  }
+
+  if (pTask == NULL) {
+    pTask = taosMemoryMalloc(sizeof(SPageSpillTask) + pBuf->diskBufSize);
+    if (pTask == NULL) {
+      return;
+    }
+    pBuf->pPrefetch = pTask;
+  }
+
+  pTask->pBuf = pBuf;
+  pTask->pInfo = NULL;
+  pTask->offset = (*pi)->offset;
+  pTask->length = (*pi)->length;
+  pTask->pageId = pageId;
+  pTask->code = TSDB_CODE_SUCCESS;
+  pTask->done = false;
+
+  SSchedMsg schedMsg = {.fp = doReadPageTask, .ahandle = pTask};
+  if (taosScheduleTask(dBufSpillQhandle, &schedMsg) != 0) {
+    pTask->pageId = -1;
+    pTask->done = true;
+    return;
+  }
+
+  pBuf->statis.prefetchPages += 1;
+}
+
+// hand over the page data to the spill threads, and the page frame can be reused without waiting for the disk.
+static int32_t doFlushBufPageImpl(SDiskbasedBuf* pBuf, SPageInfo* pg, SPageSpillTask* pTask, int64_t offset,
+                                  int32_t size) {
+  pTask->pBuf = pBuf;
+  pTask->pInfo = pg;
+  pTask->offset = offset;
+  pTask->length = size;
+  pTask->pageId = pg->pageId;
+  pTask->code = TSDB_CODE_SUCCESS;
+  pTask->done = false;
+
   // extend the file
   if (pBuf->fileSize < offset + size) {
     pBuf->fileSize = offset + size;
@@ -150,6 +325,18 @@ static int32_t doFlushBufPageImpl(SDiskbasedBuf* pBuf, int64_t offset, const cha
   pBuf->statis.flushBytes += size;
   pBuf->statis.flushPages += 1;
 
+  taosThreadMutexLock(&pBuf->spillLock);
+  pg->pWrite = pTask;
+  pBuf->numOfWrites += 1;
+  taosThreadMutexUnlock(&pBuf->spillLock);
+
+  SSchedMsg schedMsg = {.fp = doWritePageTask, .ahandle = pTask};
+  if (dBufSpillQhandle == NULL || taosScheduleTask(dBufSpillQhandle, &schedMsg) != 0) {
+    // no spill threads available, flush it synchronously
+    doWritePageTask(&schedMsg);
+    return dBufWaitForWrites(pBuf, NULL, INT32_MAX);
+  }
+
   return TSDB_CODE_SUCCESS;
 }
 
@@ -160,49 +347,48 @@ static char* doFlushBufPage(SDiskbasedBuf* pBuf, SPageInfo* pg) {
     return NULL;
   }
 
-  int32_t size = pBuf->pageSize;
+  int32_t size = pg->length;  // NOTE: the size may be -1, the this recycle page has not been flushed to disk yet.
   int64_t offset = pg->offset;
 
-  char* t = NULL;
-  if ((!HAS_DATA_IN_DISK(pg)) || pg->dirty) {
-    void* payload = GET_PAYLOAD_DATA(pg);
-    t = doCompressData(payload, pBuf->pageSize + sizeof(SFilePage), &size, pBuf);
-    if (size < 0) {
-      uError("failed to compress data when flushing data to disk, %s", pBuf->id);
-      terrno = TSDB_CODE_INVALID_PARA;
+  if (pg->dirty) {
+    dBufDropPrefetch(pBuf, pg->pageId);
+
+    // the previous write of this page must be completed, since its disk space may be overwritten or recycled.
+    int32_t code = dBufWaitForWrites(pBuf, pg, DBUF_MAX_PENDING_WRITES - 1);
+    if (code != TSDB_CODE_SUCCESS) {
+      terrno = code;
       return NULL;
     }
-  }
 
-  // this page is flushed to disk for the first time
-  if (pg->dirty) {
-    if (!HAS_DATA_IN_DISK(pg)) {
+    SPageSpillTask* pTask = taosMemoryMalloc(sizeof(SPageSpillTask) + pBuf->diskBufSize);
+    if (pTask == NULL) {
+      terrno = TSDB_CODE_OUT_OF_MEMORY;
+      return NULL;
+    }
+
+    bool compressed = false;
+    size = doCompressPage(pBuf, GET_PAYLOAD_DATA(pg), pTask->data, &compressed);
+
+    if (!HAS_DATA_IN_DISK(pg)) {  // this page is flushed to disk for the first time
       offset = allocateNewPositionInFile(pBuf, size);
       pBuf->nextPos += size;
-
-      int32_t code = doFlushBufPageImpl(pBuf, offset, t, size);
-      if (code != TSDB_CODE_SUCCESS) {
-        return NULL;
-      }
-    } else {
+    } else if (pg->length < size) {
       // length becomes greater, current space is not enough, allocate new place, otherwise, do nothing
-      if (pg->length < size) {
-        // 1. add current space to free list
-        SPageDiskInfo dinfo = {.length = pg->length, .offset = offset};
-        taosArrayPush(pBuf->pFree, &dinfo);
-
-        // 2. allocate new position, and update the info
-        offset = allocateNewPositionInFile(pBuf, size);
-        pBuf->nextPos += size;
-      }
+      // 1. add current space to free list
+      SPageDiskInfo dinfo = {.length = pg->length, .offset = offset};
+      taosArrayPush(pBuf->pFree, &dinfo);
 
-      int32_t code = doFlushBufPageImpl(pBuf, offset, t, size);
-      if (code != TSDB_CODE_SUCCESS) {
-        return NULL;
-      }
+      // 2. allocate new position, and update the info
+      offset = allocateNewPositionInFile(pBuf, size);
+      pBuf->nextPos += size;
+    }
+
+    pg->compressed = compressed;
+    code = doFlushBufPageImpl(pBuf, pg, pTask, offset, size);
+    if (code != TSDB_CODE_SUCCESS) {
+      terrno = code;
+      return NULL;
     }
-  } else {  // NOTE: the size may be -1, the this recycle page has not been flushed to disk yet.
-    size = pg->length;
   }
 
   char* pDataBuf = pg->pData;
@@ -241,25 +427,54 @@ static int32_t loadPageFromDisk(SDiskbasedBuf* pBuf, SPageInfo* pg) {
     return TSDB_CODE_INVALID_PARA;
   }
 
-  int32_t ret = taosLSeekFile(pBuf->pFile, pg->offset, SEEK_SET);
-  if (ret == -1) {
-    ret = TAOS_SYSTEM_ERROR(errno);
-    return ret;
+  int64_t st = taosGetTimestampUs();
+  char*   pPage = GET_PAYLOAD_DATA(pg);
+  bool    loaded = false;
+
+  taosThreadMutexLock(&pBuf->spillLock);
+  int32_t code = pBuf->spillCode;
+  if (code == TSDB_CODE_SUCCESS && pg->pWrite != NULL) {
+    // the page is still being written, and the write buffer is not released until the lock is acquired by the writer.
+    code = doDecompressPage(pBuf, pg, pg->pWrite->data);
+    loaded = true;
+  } else if (code == TSDB_CODE_SUCCESS && pBuf->pPrefetch != NULL && pBuf->pPrefetch->pageId == pg->pageId) {
+    SPageSpillTask* pTask = pBuf->pPrefetch;
+    while (!pTask->done) {
+      taosThreadCondWait(&pBuf->spillCond, &pBuf->spillLock);
+    }
+
+    if (pTask->code == TSDB_CODE_SUCCESS && pTask->offset == pg->offset && pTask->length == pg->length) {
+      code = doDecompressPage(pBuf, pg, pTask->data);
+      loaded = true;
+      pBuf->statis.prefetchHits += 1;
+    }
+
+    pTask->pageId = -1;
   }
+  taosThreadMutexUnlock(&pBuf->spillLock);
 
-  void* pPage = (void*)GET_PAYLOAD_DATA(pg);
-  ret = (int32_t)taosReadFile(pBuf->pFile, pPage, pg->length);
-  if (ret != pg->length) {
-    ret = TAOS_SYSTEM_ERROR(errno);
-    return ret;
+  if (code != TSDB_CODE_SUCCESS) {
+    return code;
+  }
+
+  if (!loaded) {
+    char* pBuffer = pg->compressed ? pBuf->assistBuf : pPage;
+    if (taosPReadFile(pBuf->pFile, pBuffer, pg->length, pg->offset) != pg->length) {
+      return TAOS_SYSTEM_ERROR(errno);
+    }
+
+    code = doDecompressPage(pBuf, pg, pBuffer);
+    if (code != TSDB_CODE_SUCCESS) {
+      return code;
+    }
   }
 
   pBuf->statis.loadBytes += pg->length;
   pBuf->statis.loadPages += 1;
+  pBuf->statis.loadElapsed += taosGetTimestampUs() - st;
 
-  int32_t fullSize = 0;
-  doDecompressData(pPage, pg->length, &fullSize, pBuf);
-  return 0;
+  dBufPrefetchPage(pBuf, pg->pageId + 1);
+  return TSDB_CODE_SUCCESS;
 }
 
 static SPageInfo* registerNewPageInfo(SDiskbasedBuf* pBuf, int32_t pageId) {
@@ -278,6 +493,8 @@ static SPageInfo* registerNewPageInfo(SDiskbasedBuf* pBuf, int32_t pageId) {
   ppi->used = true;
   ppi->pn = NULL;
   ppi->dirty = false;
+  ppi->compressed = false;
+  ppi->pWrite = NULL;
 
   return *(SPageInfo**)taosArrayPush(pBuf->pIdList, &ppi);
 }
@@ -346,7 +563,11 @@ int32_t createDiskbasedBuf(SDiskbasedBuf** pBuf, int32_t pagesize, int32_t inMem
     goto _error;
   }
 
+  taosThreadMutexInit(&pPBuf->spillLock, NULL);
+  taosThreadCondInit(&pPBuf->spillCond, NULL);
+
   pPBuf->pageSize = pagesize;
+  pPBuf->diskBufSize = LZ4_compressBound(pagesize + sizeof(SFilePage));
   pPBuf->numOfPages = 0;  // all pages are in buffer in the first place
   pPBuf->totalBufSize = 0;
   pPBuf->allocateId = -1;
@@ -368,7 +589,7 @@ int32_t createDiskbasedBuf(SDiskbasedBuf** pBuf, int32_t pagesize, int32_t inMem
   }
 
   // init id hash table
-  _hash_fn_t fn = taosGetDefaultHashFunction(TSDB_DATA_TYPE_INT);
+  _hash_fn_t fn = taosIntHash_32;
   pPBuf->pIdList = taosArrayInit(4, POINTER_BYTES);
   if (pPBuf->pIdList == NULL) {
     goto _error;
@@ -567,6 +788,10 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
     return;
   }
 
+  // all pages must be written before closing the file and releasing the page info
+  dBufWaitForWrites(pBuf, NULL, 0);
+  dBufDropPrefetch(pBuf, -1);
+
   dBufPrintStatis(pBuf);
 
   bool needRemoveFile = false;
@@ -587,13 +812,16 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
   {
     SDiskbasedBufStatis* ps = &pBuf->statis;
     if (ps->loadPages == 0) {
-      uDebug("Get/Release pages:%d/%d, flushToDisk:%.2f Kb (%d Pages), loadFromDisk:%.2f Kb (%d Pages)", ps->getPages,
-             ps->releasePages, ps->flushBytes / 1024.0f, ps->flushPages, ps->loadBytes / 1024.0f, ps->loadPages);
+      uDebug("Get/Release pages:%d/%d, flushToDisk:%.2f Kb (%d Pages, %" PRId64
+             " us), loadFromDisk:%.2f Kb (%d Pages)",
+             ps->getPages, ps->releasePages, ps->flushBytes / 1024.0f, ps->flushPages, ps->flushElapsed,
+             ps->loadBytes / 1024.0f, ps->loadPages);
     } else {
-      uDebug(
-          "Get/Release pages:%d/%d, flushToDisk:%.2f Kb (%d Pages), loadFromDisk:%.2f Kb (%d Pages), avgPgSize:%.2f Kb",
-          ps->getPages, ps->releasePages, ps->flushBytes / 1024.0f, ps->flushPages, ps->loadBytes / 1024.0f,
-          ps->loadPages, ps->loadBytes / (1024.0 * ps->loadPages));
+      uDebug("Get/Release pages:%d/%d, flushToDisk:%.2f Kb (%d Pages, %" PRId64
+             " us), loadFromDisk:%.2f Kb (%d Pages, %" PRId64 " us), avgPgSize:%.2f Kb, prefetch/hit pages:%d/%d",
+             ps->getPages, ps->releasePages, ps->flushBytes / 1024.0f, ps->flushPages, ps->flushElapsed,
+             ps->loadBytes / 1024.0f, ps->loadPages, ps->loadElapsed, ps->loadBytes / (1024.0 * ps->loadPages),
+             ps->prefetchPages, ps->prefetchHits);
     }
   }
 
@@ -625,6 +853,10 @@ void destroyDiskbasedBuf(SDiskbasedBuf* pBuf) {
 
   taosMemoryFreeClear(pBuf->id);
   taosMemoryFreeClear(pBuf->assistBuf);
+  taosMemoryFreeClear(pBuf->pPrefetch);
+
+  taosThreadCondDestroy(&pBuf->spillCond);
+  taosThreadMutexDestroy(&pBuf->spillLock);
   taosMemoryFreeClear(pBuf);
 }
 
@@ -650,7 +882,7 @@ void setBufPageDirty(void* pPage, bool dirty) {
 void setBufPageCompressOnDisk(SDiskbasedBuf* pBuf, bool comp) {
   pBuf->comp = comp;
   if (comp  && (pBuf->assistBuf == NULL)) {
-    pBuf->assistBuf = taosMemoryMalloc(pBuf->pageSize + 2);  // EXTRA BYTES
+    pBuf->assistBuf = taosMemoryMalloc(pBuf->diskBufSize);
   }
 }
 
@@ -671,7 +903,13 @@ void dBufSetBufPageRecycled(SDiskbasedBuf* pBuf, void* pPage) {
 
 void dBufSetPrintInfo(SDiskbasedBuf* pBuf) { pBuf->printStatis = true; }
 
-SDiskbasedBufStatis getDBufStatis(const SDiskbasedBuf* pBuf) { return pBuf->statis; }
+SDiskbasedBufStatis getDBufStatis(const SDiskbasedBuf* pBuf) {
+  // the flush elapsed time is updated by the spill threads
+  taosThreadMutexLock((TdThreadMutex*)&pBuf->spillLock);
+  SDiskbasedBufStatis statis = pBuf->statis;
+  taosThreadMutexUnlock((TdThreadMutex*)&pBuf->spillLock);
+  return statis;
+}
 
 void dBufPrintStatis(const SDiskbasedBuf* pBuf) {
   if (!pBuf->printStatis) {
@@ -690,16 +928,20 @@ void dBufPrintStatis(const SDiskbasedBuf* pBuf) {
 
   if (ps->loadPages > 0) {
     printf(
-        "Get/Release pages:%d/%d, flushToDisk:%.2f Kb (%d Pages), loadFromDisk:%.2f Kb (%d Pages), avgPageSize:%.2f "
-        "Kb\n",
-        ps->getPages, ps->releasePages, ps->flushBytes / 1024.0f, ps->flushPages, ps->loadBytes / 1024.0f,
-        ps->loadPages, ps->loadBytes / (1024.0 * ps->loadPages));
+        "Get/Release pages:%d/%d, flushToDisk:%.2f Kb (%d Pages, %" PRId64
+        " us), loadFromDisk:%.2f Kb (%d Pages, %" PRId64 " us), avgPageSize:%.2f Kb, prefetch/hit pages:%d/%d\n",
+        ps->getPages, ps->releasePages, ps->flushBytes / 1024.0f, ps->flushPages, ps->flushElapsed,
+        ps->loadBytes / 1024.0f, ps->loadPages, ps->loadElapsed, ps->loadBytes / (1024.0 * ps->loadPages),
+        ps->prefetchPages, ps->prefetchHits);
   } else {
     // printf("no page loaded\n");
   }
 }
 
 void clearDiskbasedBuf(SDiskbasedBuf* pBuf) {
+  dBufWaitForWrites(pBuf, NULL, 0);
+  dBufDropPrefetch(pBuf, -1);
+
   size_t n = taosArrayGetSize(pBuf->pIdList);
   for (int32_t i = 0; i < n; ++i) {
     SPageInfo* pi = taosArrayGetP(pBuf->pIdList, i);
@@ -21,6 +21,46 @@
 int64_t tsRpcQueueMemoryAllowed = 0;
 int64_t tsRpcQueueMemoryUsed = 0;
 
+static FORCE_INLINE bool taosQueueHasItems(STaosQueue *queue) {
+  return queue->head != NULL || queue->lowHead != NULL;
+}
+
+// take the next item, a low priority one only when no other is there or too many others were read in a row
+static STaosQnode *taosQueuePopNode(STaosQueue *queue) {
+  STaosQnode *pNode = NULL;
+
+  if (queue->lowHead != NULL && (queue->head == NULL || queue->numOfHighRead >= QUEUE_LOW_PRI_INTERVAL)) {
+    pNode = queue->lowHead;
+    queue->lowHead = pNode->next;
+    if (queue->lowHead == NULL) queue->lowTail = NULL;
+    queue->numOfHighRead = 0;
+  } else if (queue->head != NULL) {
+    pNode = queue->head;
+    queue->head = pNode->next;
+    if (queue->head == NULL) queue->tail = NULL;
+    if (queue->lowHead != NULL) queue->numOfHighRead++;
+  }
+
+  return pNode;
+}
+
+// take all the items as one list, the low priority ones at the end
+static STaosQnode *taosQueueDetachAll(STaosQueue *queue) {
+  STaosQnode *pNode = queue->head;
+  if (pNode == NULL) {
+    pNode = queue->lowHead;
+  } else {
+    queue->tail->next = queue->lowHead;
+  }
+
+  queue->head = NULL;
+  queue->tail = NULL;
+  queue->lowHead = NULL;
+  queue->lowTail = NULL;
+  queue->numOfHighRead = 0;
+  return pNode;
+}
+
 void taosSetQueueMemoryCapacity(STaosQueue *queue, int64_t cap) { queue->memLimit = cap; }
 void taosSetQueueCapacity(STaosQueue *queue, int64_t size) { queue->itemLimit = size; }
 
@@ -52,8 +92,7 @@ void taosCloseQueue(STaosQueue *queue) {
   STaosQset  *qset;
 
   taosThreadMutexLock(&queue->mutex);
-  STaosQnode *pNode = queue->head;
-  queue->head = NULL;
+  STaosQnode *pNode = taosQueueDetachAll(queue);
   qset = queue->qset;
   taosThreadMutexUnlock(&queue->mutex);
 
@@ -78,7 +117,7 @@ bool taosQueueEmpty(STaosQueue *queue) {
 
   bool empty = false;
   taosThreadMutexLock(&queue->mutex);
-  if (queue->head == NULL && queue->tail == NULL && queue->numOfItems == 0 /*&& queue->memOfItems == 0*/) {
+  if (!taosQueueHasItems(queue) && queue->numOfItems == 0 /*&& queue->memOfItems == 0*/) {
     empty = true;
   }
   taosThreadMutexUnlock(&queue->mutex);
@@ -156,6 +195,24 @@ void taosFreeQitem(void *pItem) {
   taosMemoryFree(pNode);
 }
 
+void taosSetQitemLowPriority(void *pItem) {
+  STaosQnode *pNode = (STaosQnode *)((char *)pItem - sizeof(STaosQnode));
+  pNode->lowPri = 1;
+}
+
+static threadlocal int32_t tsQsetCursor = 0;  // slot where the reader of this thread goes on scanning
+
+static FORCE_INLINE void taosQsetSetReady(STaosQset *qset, int32_t slot) {
+  int64_t mask = (int64_t)1 << (slot % 64);
+  if ((atomic_load_64(&qset->readyMap[slot / 64]) & mask) == 0) {
+    atomic_fetch_or_64(&qset->readyMap[slot / 64], mask);
+  }
+}
+
+static FORCE_INLINE void taosQsetClearReady(STaosQset *qset, int32_t slot) {
+  atomic_fetch_and_64(&qset->readyMap[slot / 64], ~((int64_t)1 << (slot % 64)));
+}
+
 int32_t taosWriteQitem(STaosQueue *queue, void *pItem) {
   int32_t     code = 0;
   STaosQnode *pNode = (STaosQnode *)(((char *)pItem) - sizeof(STaosQnode));
@@ -177,7 +234,14 @@ int32_t taosWriteQitem(STaosQueue *queue, void *pItem) {
     return code;
   }
 
-  if (queue->tail) {
+  if (pNode->lowPri) {
+    if (queue->lowTail) {
+      queue->lowTail->next = pNode;
+    } else {
+      queue->lowHead = pNode;
+    }
+    queue->lowTail = pNode;
+  } else if (queue->tail) {
     queue->tail->next = pNode;
     queue->tail = pNode;
   } else {
@@ -186,7 +250,10 @@ int32_t taosWriteQitem(STaosQueue *queue, void *pItem) {
   }
   queue->numOfItems++;
   queue->memOfItems += (pNode->size + pNode->dataSize);
-  if (queue->qset) atomic_add_fetch_32(&queue->qset->numOfItems, 1);
+  if (queue->qset) {
+    atomic_add_fetch_32(&queue->qset->numOfItems, 1);
+    taosQsetSetReady(queue->qset, queue->slot);
+  }
 
   uTrace("item:%p is put into queue:%p, items:%d mem:%" PRId64, pItem, queue, queue->numOfItems, queue->memOfItems);
 
@@ -202,11 +269,9 @@ int32_t taosReadQitem(STaosQueue *queue, void **ppItem) {
 
   taosThreadMutexLock(&queue->mutex);
 
-  if (queue->head) {
-    pNode = queue->head;
+  pNode = taosQueuePopNode(queue);
+  if (pNode) {
     *ppItem = pNode->item;
-    queue->head = pNode->next;
-    if (queue->head == NULL) queue->tail = NULL;
     queue->numOfItems--;
     queue->memOfItems -= (pNode->size + pNode->dataSize);
     if (queue->qset) atomic_sub_fetch_32(&queue->qset->numOfItems, 1);
@@ -236,16 +301,14 @@ int32_t taosReadAllQitems(STaosQueue *queue, STaosQall *qall) {
 
   taosThreadMutexLock(&queue->mutex);
 
-  empty = queue->head == NULL;
+  empty = !taosQueueHasItems(queue);
   if (!empty) {
     memset(qall, 0, sizeof(STaosQall));
-    qall->current = queue->head;
-    qall->start = queue->head;
+    qall->start = taosQueueDetachAll(queue);
+    qall->current = qall->start;
     qall->numOfItems = queue->numOfItems;
     numOfItems = qall->numOfItems;
 
-    queue->head = NULL;
-    queue->tail = NULL;
     queue->numOfItems = 0;
     queue->memOfItems = 0;
     uTrace("read %d items from queue:%p, items:%d mem:%" PRId64, numOfItems, queue, queue->numOfItems,
@@ -289,6 +352,18 @@ STaosQset *taosOpenQset() {
     return NULL;
   }
 
+  qset->slots = taosMemoryCalloc(QSET_MAX_QUEUES, sizeof(STaosQueue *));
+  qset->readyMap = taosMemoryCalloc(QSET_MAX_QUEUES / 64, sizeof(int64_t));
+  qset->readers = taosMemoryCalloc(QSET_READER_GROUPS, sizeof(SQsetReaders));
+  if (qset->slots == NULL || qset->readyMap == NULL || qset->readers == NULL) {
+    taosMemoryFree(qset->slots);
+    taosMemoryFree(qset->readyMap);
+    taosMemoryFree(qset->readers);
+    taosMemoryFree(qset);
+    terrno = TSDB_CODE_OUT_OF_MEMORY;
+    return NULL;
+  }
+
   taosThreadMutexInit(&qset->mutex, NULL);
   tsem_init(&qset->sem, 0, 0);
 
@@ -312,6 +387,9 @@ void taosCloseQset(STaosQset *qset) {
 
   taosThreadMutexDestroy(&qset->mutex);
   tsem_destroy(&qset->sem);
+  taosMemoryFree(qset->slots);
+  taosMemoryFree(qset->readyMap);
+  taosMemoryFree(qset->readers);
   taosMemoryFree(qset);
   uDebug("qset:%p is closed", qset);
 }
@@ -329,6 +407,17 @@ int32_t taosAddIntoQset(STaosQset *qset, STaosQueue *queue, void *ahandle) {
 
   taosThreadMutexLock(&qset->mutex);
 
+  int32_t slot = 0;
+  while (slot < qset->numOfSlots && qset->slots[slot] != NULL) slot++;
+  if (slot >= QSET_MAX_QUEUES) {
+    taosThreadMutexUnlock(&qset->mutex);
+    uError("queue:%p failed to add into qset:%p since it has %d queues", queue, qset, qset->numOfQueues);
+    terrno = TSDB_CODE_OUT_OF_RANGE;
+    return -1;
+  }
+  if (slot == qset->numOfSlots) atomic_store_32(&qset->numOfSlots, slot + 1);
+  atomic_store_ptr(&qset->slots[slot], queue);
+
   queue->next = qset->head;
   queue->ahandle = ahandle;
   qset->head = queue;
@@ -336,12 +425,14 @@ int32_t taosAddIntoQset(STaosQset *qset, STaosQueue *queue, void *ahandle) {
 
   taosThreadMutexLock(&queue->mutex);
   atomic_add_fetch_32(&qset->numOfItems, queue->numOfItems);
+  queue->slot = slot;
   queue->qset = qset;
+  if (taosQueueHasItems(queue)) taosQsetSetReady(qset, slot);
   taosThreadMutexUnlock(&queue->mutex);
 
   taosThreadMutexUnlock(&qset->mutex);
 
-  uTrace("queue:%p is added into qset:%p", queue, qset);
+  uTrace("queue:%p is added into qset:%p, slot:%d", queue, qset, slot);
   return 0;
 }
 
@@ -369,11 +460,12 @@ void taosRemoveFromQset(STaosQset *qset, STaosQueue *queue) {
     }
 
     if (tqueue) {
-      if (qset->current == queue) qset->current = tqueue->next;
       qset->numOfQueues--;
 
       taosThreadMutexLock(&queue->mutex);
       atomic_sub_fetch_32(&qset->numOfItems, queue->numOfItems);
+      atomic_store_ptr(&qset->slots[queue->slot], NULL);
+      taosQsetClearReady(qset, queue->slot);
       queue->qset = NULL;
       queue->next = NULL;
       taosThreadMutexUnlock(&queue->mutex);
@@ -382,96 +474,137 @@ void taosRemoveFromQset(STaosQset *qset, STaosQueue *queue) {
 
   taosThreadMutexUnlock(&qset->mutex);
 
+  // the queue is unpublished, but the readers scanning now may have loaded it from its slot, wait for them to
+  // leave without the qset mutex, so that the other queues can still be added and removed
+  if (tqueue) {
+    for (int32_t i = 0; i < QSET_READER_GROUPS; ++i) {
+      while (atomic_load_32(&qset->readers[i].numOfReaders) > 0) sched_yield();
+    }
+  }
+
   uDebug("queue:%p is removed from qset:%p", queue, qset);
 }
 
+// find a queue having items, trying the next ready one while one is locked, the queue is returned locked
+static STaosQueue *taosQsetClaimQueue(STaosQset *qset) {
+  int32_t numOfSlots = atomic_load_32(&qset->numOfSlots);
+  if (numOfSlots <= 0) return NULL;
+
+  int32_t     numOfWords = (numOfSlots + 63) / 64;
+  int32_t     start = tsQsetCursor % numOfSlots;
+  STaosQueue *busy = NULL;
+  int32_t     busySlot = -1;
+
+  // the word of the start slot is visited again at the end for the slots before it
+  for (int32_t i = 0; i <= numOfWords; ++i) {
+    int32_t w = (start / 64 + i) % numOfWords;
+    int64_t bits = atomic_load_64(&qset->readyMap[w]);
+    if (i == 0) bits &= (int64_t)(UINT64_MAX << (start % 64));
+
+    while (bits) {
+      int32_t bit = BUILDIN_CTZL(bits);
+      bits &= ~((int64_t)1 << bit);
+
+      int32_t     slot = w * 64 + bit;
+      STaosQueue *queue = atomic_load_ptr(&qset->slots[slot]);
+      if (queue == NULL) continue;
+      if (taosThreadMutexTryLock(&queue->mutex) != 0) {
+        busy = queue;
+        busySlot = slot;
+        continue;
+      }
+      if (queue->qset == qset && queue->slot == slot && taosQueueHasItems(queue)) {
+        tsQsetCursor = slot + 1;
+        return queue;
+      }
+      taosThreadMutexUnlock(&queue->mutex);
+    }
+  }
+
+  // all the ready queues are locked by the others, wait for one
+  if (busy != NULL) {
+    taosThreadMutexLock(&busy->mutex);
+    if (busy->qset == qset && busy->slot == busySlot && taosQueueHasItems(busy)) {
+      tsQsetCursor = busySlot + 1;
+      return busy;
+    }
+    taosThreadMutexUnlock(&busy->mutex);
+  }
+
+  return NULL;
+}
+
+// a scan may miss the items moving under it, retry as long as items are there
+static STaosQueue *taosQsetClaimQueueWait(STaosQset *qset, SQueueInfo *qinfo) {
+  int32_t *pReaders = &qset->readers[(uint32_t)qinfo->workerId % QSET_READER_GROUPS].numOfReaders;
+
+  while (1) {
+    atomic_add_fetch_32(pReaders, 1);
+    STaosQueue *queue = taosQsetClaimQueue(qset);
+    atomic_sub_fetch_32(pReaders, 1);
+
+    if (queue != NULL || atomic_load_32(&qset->numOfItems) <= 0) return queue;
+    sched_yield();
+  }
+}
+
 int32_t taosReadQitemFromQset(STaosQset *qset, void **ppItem, SQueueInfo *qinfo) {
   STaosQnode *pNode = NULL;
   int32_t     code = 0;
 
   tsem_wait(&qset->sem);
 
-  taosThreadMutexLock(&qset->mutex);
+  STaosQueue *queue = taosQsetClaimQueueWait(qset, qinfo);
+  if (queue) {
+    pNode = taosQueuePopNode(queue);
+    *ppItem = pNode->item;
+    qinfo->ahandle = queue->ahandle;
+    qinfo->fp = queue->itemFp;
+    qinfo->queue = queue;
+    qinfo->timestamp = pNode->timestamp;
 
-  for (int32_t i = 0; i < qset->numOfQueues; ++i) {
-    if (qset->current == NULL) qset->current = qset->head;
-    STaosQueue *queue = qset->current;
-    if (queue) qset->current = queue->next;
-    if (queue == NULL) break;
-    if (queue->head == NULL) continue;
-
-    taosThreadMutexLock(&queue->mutex);
-
-    if (queue->head) {
-      pNode = queue->head;
-      *ppItem = pNode->item;
-      qinfo->ahandle = queue->ahandle;
-      qinfo->fp = queue->itemFp;
-      qinfo->queue = queue;
-      qinfo->timestamp = pNode->timestamp;
-
-      queue->head = pNode->next;
-      if (queue->head == NULL) queue->tail = NULL;
-      // queue->numOfItems--;
-      queue->memOfItems -= (pNode->size + pNode->dataSize);
-      atomic_sub_fetch_32(&qset->numOfItems, 1);
-      code = 1;
-      uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue, queue->numOfItems - 1,
-             queue->memOfItems);
-    }
+    // queue->numOfItems--;
+    queue->memOfItems -= (pNode->size + pNode->dataSize);
+    atomic_sub_fetch_32(&qset->numOfItems, 1);
+    code = 1;
+    uTrace("item:%p is read out from queue:%p, items:%d mem:%" PRId64, *ppItem, queue, queue->numOfItems - 1,
+           queue->memOfItems);
 
+    if (!taosQueueHasItems(queue)) taosQsetClearReady(qset, queue->slot);
     taosThreadMutexUnlock(&queue->mutex);
-    if (pNode) break;
   }
 
-  taosThreadMutexUnlock(&qset->mutex);
-
   return code;
 }
 
 int32_t taosReadAllQitemsFromQset(STaosQset *qset, STaosQall *qall, SQueueInfo *qinfo) {
-  STaosQueue *queue;
-  int32_t     code = 0;
+  int32_t code = 0;
 
   tsem_wait(&qset->sem);
-  taosThreadMutexLock(&qset->mutex);
 
-  for (int32_t i = 0; i < qset->numOfQueues; ++i) {
-    if (qset->current == NULL) qset->current = qset->head;
-    queue = qset->current;
-    if (queue) qset->current = queue->next;
-    if (queue == NULL) break;
-    if (queue->head == NULL) continue;
-
-    taosThreadMutexLock(&queue->mutex);
-
-    if (queue->head) {
-      qall->current = queue->head;
-      qall->start = queue->head;
-      qall->numOfItems = queue->numOfItems;
-      code = qall->numOfItems;
-      qinfo->ahandle = queue->ahandle;
-      qinfo->fp = queue->itemsFp;
-      qinfo->queue = queue;
-
-      queue->head = NULL;
-      queue->tail = NULL;
-      // queue->numOfItems = 0;
-      queue->memOfItems = 0;
-      uTrace("read %d items from queue:%p, items:0 mem:%" PRId64, code, queue, queue->memOfItems);
-
-      atomic_sub_fetch_32(&qset->numOfItems, qall->numOfItems);
-      for (int32_t j = 1; j < qall->numOfItems; ++j) {
-        tsem_wait(&qset->sem);
-      }
-    }
+  STaosQueue *queue = taosQsetClaimQueueWait(qset, qinfo);
+  if (queue) {
+    qall->start = taosQueueDetachAll(queue);
+    qall->current = qall->start;
+    qall->numOfItems = queue->numOfItems;
+    code = qall->numOfItems;
+    qinfo->ahandle = queue->ahandle;
+    qinfo->fp = queue->itemsFp;
+    qinfo->queue = queue;
+
+    // queue->numOfItems = 0;
+    queue->memOfItems = 0;
+    uTrace("read %d items from queue:%p, items:0 mem:%" PRId64, code, queue, queue->memOfItems);
 
+    atomic_sub_fetch_32(&qset->numOfItems, qall->numOfItems);
+    taosQsetClearReady(qset, queue->slot);
     taosThreadMutexUnlock(&queue->mutex);
 
-    if (code != 0) break;
+    for (int32_t j = 1; j < qall->numOfItems; ++j) {
+      tsem_wait(&qset->sem);
+    }
   }
 
-  taosThreadMutexUnlock(&qset->mutex);
   return code;
 }
 
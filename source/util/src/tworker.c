@@ -68,7 +68,7 @@ void tQWorkerCleanup(SQWorkerPool *pool) {
 
 static void *tQWorkerThreadFp(SQueueWorker *worker) {
   SQWorkerPool *pool = worker->pool;
-  SQueueInfo    qinfo = {0};
+  SQueueInfo    qinfo = {.workerId = worker->id};
   void         *msg = NULL;
   int32_t       code = 0;
 
@@ -104,7 +104,11 @@ STaosQueue *tQWorkerAllocQueue(SQWorkerPool *pool, void *ahandle, FItem fp) {
 
   taosThreadMutexLock(&pool->mutex);
   taosSetQueueFp(queue, fp, NULL);
-  taosAddIntoQset(pool->qset, queue, ahandle);
+  if (taosAddIntoQset(pool->qset, queue, ahandle) != 0) {
+    taosThreadMutexUnlock(&pool->mutex);
+    taosCloseQueue(queue);
+    return NULL;
+  }
 
   // spawn a thread to process queue
   if (pool->num < pool->max) {
@@ -182,7 +186,7 @@ void tAutoQWorkerCleanup(SAutoQWorkerPool *pool) {
 
 static void *tAutoQWorkerThreadFp(SQueueWorker *worker) {
   SAutoQWorkerPool *pool = worker->pool;
-  SQueueInfo        qinfo = {0};
+  SQueueInfo        qinfo = {.workerId = worker->id};
   void             *msg = NULL;
   int32_t           code = 0;
 
@@ -216,7 +220,11 @@ STaosQueue *tAutoQWorkerAllocQueue(SAutoQWorkerPool *pool, void *ahandle, FItem
 
   taosThreadMutexLock(&pool->mutex);
   taosSetQueueFp(queue, fp, NULL);
-  taosAddIntoQset(pool->qset, queue, ahandle);
+  if (taosAddIntoQset(pool->qset, queue, ahandle) != 0) {
+    taosThreadMutexUnlock(&pool->mutex);
+    taosCloseQueue(queue);
+    return NULL;
+  }
 
   int32_t queueNum = taosGetQueueNumber(pool->qset);
   int32_t curWorkerNum = taosArrayGetSize(pool->workers);
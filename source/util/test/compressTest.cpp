@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include "tcompression.h"
+
+namespace {
+
+typedef int32_t (*FCompress)(void *pIn, int32_t nIn, int32_t nEle, void *pOut, int32_t nOut, uint8_t cmprAlg,
+                             void *pBuf, int32_t nBuf);
+
+// compress data with the fixed and the adaptive codecs, check both decode back and return the adaptive size
+int32_t compressRoundTrip(FCompress cmprFn, FCompress decmprFn, void *pData, int32_t nEle, int32_t bytes,
+                          uint8_t cmprAlg, uint8_t *pHead) {
+  int32_t              size = nEle * bytes + COMP_OVERFLOW_BYTES;
+  std::vector<uint8_t> out(size), buf(size), dec(size);
+  int32_t              len = 0;
+
+  for (int32_t adaptive = 0; adaptive < 2; adaptive++) {
+    tsCompressAdaptive = adaptive;
+    len = cmprFn(pData, nEle * bytes, nEle, out.data(), size, cmprAlg, buf.data(), size);
+    EXPECT_GT(len, 0);
+    if (pHead) *pHead = out[0];
+    EXPECT_EQ(decmprFn(out.data(), len, nEle, dec.data(), nEle * bytes, cmprAlg, buf.data(), size), nEle * bytes);
+    EXPECT_EQ(memcmp(pData, dec.data(), nEle * bytes), 0);
+  }
+  tsCompressAdaptive = false;
+
+  return len;
+}
+
+}  // namespace
+
+TEST(TD_UTIL_COMPRESS_TEST, adaptive_timestamp) {
+  const int32_t        nEle = 4096;
+  std::vector<int64_t> data(nEle);
+  uint8_t              head = 0;
+
+  for (int32_t i = 0; i < nEle; i++) data[i] = 1700000000000 + i * 1000;
+  compressRoundTrip(tsCompressTimestamp, tsDecompressTimestamp, data.data(), nEle, sizeof(int64_t), ONE_STAGE_COMP,
+                    &head);
+  EXPECT_EQ(head, ADAPT_CODEC_BP);
+
+  for (int32_t i = 0; i < nEle; i++) data[i] = 1700000000000 + i * 1000 + taosRand() % 7;
+  compressRoundTrip(tsCompressTimestamp, tsDecompressTimestamp, data.data(), nEle, sizeof(int64_t), TWO_STAGE_COMP,
+                    NULL);
+}
+
+TEST(TD_UTIL_COMPRESS_TEST, adaptive_integer) {
+  const int32_t        nEle = 4096;
+  std::vector<int32_t> i32(nEle);
+  std::vector<int64_t> i64(nEle);
+  std::vector<int8_t>  i8(nEle);
+  uint8_t              head = 0;
+
+  // low cardinality
+  for (int32_t i = 0; i < nEle; i++) i32[i] = (taosRand() % 10) * 1000003 - 7;
+  compressRoundTrip(tsCompressInt, tsDecompressInt, i32.data(), nEle, sizeof(int32_t), ONE_STAGE_COMP, &head);
+  EXPECT_EQ(head, ADAPT_CODEC_DICT);
+
+  // long runs
+  for (int32_t i = 0; i < nEle; i++) i8[i] = i < nEle / 2 ? -3 : 100;
+  compressRoundTrip(tsCompressTinyint, tsDecompressTinyint, i8.data(), nEle, sizeof(int8_t), ONE_STAGE_COMP, &head);
+  EXPECT_EQ(head, ADAPT_CODEC_RLE);
+
+  // no pattern, the fixed codec is kept
+  for (int32_t i = 0; i < nEle; i++) i32[i] = taosRand();
+  compressRoundTrip(tsCompressInt, tsDecompressInt, i32.data(), nEle, sizeof(int32_t), ONE_STAGE_COMP, &head);
+  EXPECT_FALSE(IS_ADAPT_CODEC(head));
+
+  // deltas overflow
+  for (int32_t i = 0; i < nEle; i++) i64[i] = (i % 2) ? INT64_MAX : INT64_MIN;
+  compressRoundTrip(tsCompressBigint, tsDecompressBigint, i64.data(), nEle, sizeof(int64_t), ONE_STAGE_COMP, NULL);
+  for (int32_t i = 0; i < nEle; i++) i64[i] = (int64_t)i * 123456789 + taosRand() % 1000;
+  compressRoundTrip(tsCompressBigint, tsDecompressBigint, i64.data(), nEle, sizeof(int64_t), TWO_STAGE_COMP, NULL);
+
+  // blocks too small to sample
+  compressRoundTrip(tsCompressInt, tsDecompressInt, i32.data(), 63, sizeof(int32_t), ONE_STAGE_COMP, &head);
+  EXPECT_FALSE(IS_ADAPT_CODEC(head));
+}
+
+TEST(TD_UTIL_COMPRESS_TEST, adaptive_float) {
+  const int32_t       nEle = 4096;
+  std::vector<float>  f(nEle);
+  std::vector<double> d(nEle);
+  uint8_t             head = 0;
+
+  for (int32_t i = 0; i < nEle; i++) f[i] = (taosRand() % 4) * 0.5f + 20.1f;
+  compressRoundTrip(tsCompressFloat, tsDecompressFloat, f.data(), nEle, sizeof(float), ONE_STAGE_COMP, &head);
+  EXPECT_EQ(head, ADAPT_CODEC_DICT);
+
+  for (int32_t i = 0; i < nEle; i++) d[i] = (i / 1000) * 0.1 + 36.6;
+  compressRoundTrip(tsCompressDouble, tsDecompressDouble, d.data(), nEle, sizeof(double), ONE_STAGE_COMP, &head);
+  EXPECT_EQ(head, ADAPT_CODEC_RLE);
+
+  for (int32_t i = 0; i < nEle; i++) d[i] = taosRand() / 3.0;
+  compressRoundTrip(tsCompressDouble, tsDecompressDouble, d.data(), nEle, sizeof(double), TWO_STAGE_COMP, NULL);
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <cassert>
 #include <iostream>
+#include <vector>
 
 #include "taos.h"
 #include "tpagedbuf.h"
@@ -219,6 +220,67 @@ void testFlushAndReadBackBuffer() {
   destroyDiskbasedBuf(pBuf);
 }
 
+// pages are evicted, rewritten and loaded back from disk many times, with or without compression.
+void spillAndReloadTest(bool comp) {
+  SDiskbasedBuf* pBuf = NULL;
+  const int32_t  pageSize = 4096;
+  const int32_t  numOfPages = 64;
+  int32_t        code = createDiskbasedBuf(&pBuf, pageSize, pageSize * 4, "spill", TD_TMP_DIR_PATH);
+  ASSERT_EQ(code, 0);
+  setBufPageCompressOnDisk(pBuf, comp);
+
+  auto fillPage = [&](SFilePage* pPg, int32_t seed) {
+    int32_t* p = (int32_t*)pPg->data;
+    int32_t  n = (pageSize - (int32_t)sizeof(SFilePage)) / (int32_t)sizeof(int32_t);
+    for (int32_t j = 0; j < n; ++j) {
+      p[j] = (j % 16 == 0) ? taosRand() : seed;
+    }
+    pPg->num = seed;
+  };
+
+  std::vector<int32_t> ids(numOfPages);
+  std::vector<int32_t> seeds(numOfPages);
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    auto* pPg = (SFilePage*)getNewBufPage(pBuf, &ids[i]);
+    ASSERT_TRUE(pPg != nullptr);
+    seeds[i] = i * 7 + 1;
+    fillPage(pPg, seeds[i]);
+    setBufPageDirty(pPg, true);
+    releaseBufPage(pBuf, pPg);
+  }
+
+  // rewrite some pages, the compressed length is changed due to the random content
+  for (int32_t i = 0; i < numOfPages * 2; ++i) {
+    int32_t k = taosRand() % numOfPages;
+    auto*   pPg = (SFilePage*)getBufPage(pBuf, ids[k]);
+    ASSERT_TRUE(pPg != nullptr);
+    ASSERT_EQ(pPg->num, seeds[k]);
+    seeds[k] += 1;
+    fillPage(pPg, seeds[k]);
+    setBufPageDirty(pPg, true);
+    releaseBufPage(pBuf, pPg);
+  }
+
+  // load all pages back sequentially
+  for (int32_t i = 0; i < numOfPages; ++i) {
+    auto* pPg = (SFilePage*)getBufPage(pBuf, ids[i]);
+    ASSERT_TRUE(pPg != nullptr);
+    ASSERT_EQ(pPg->num, seeds[i]);
+    ASSERT_EQ(((int32_t*)pPg->data)[1], seeds[i]);
+    releaseBufPage(pBuf, pPg);
+  }
+
+  SDiskbasedBufStatis statis = getDBufStatis(pBuf);
+  ASSERT_GT(statis.flushPages, 0);
+  ASSERT_GT(statis.loadPages, 0);
+  ASSERT_GE(statis.prefetchPages, statis.prefetchHits);
+  if (comp) {
+    ASSERT_LT(statis.flushBytes, (int64_t)statis.flushPages * pageSize);
+  }
+
+  destroyDiskbasedBuf(pBuf);
+}
+
 }  // namespace
 
 TEST(testCase, resultBufferTest) {
@@ -229,4 +291,19 @@ TEST(testCase, resultBufferTest) {
   testFlushAndReadBackBuffer();
 }
 
+TEST(testCase, spillBufferTest) {
+  spillAndReloadTest(false);
+  spillAndReloadTest(true);
+}
+
+TEST(testCase, spillWorkerStopTest) {
+  spillAndReloadTest(true);
+
+  // the buffers created after the spill threads are stopped flush their pages synchronously
+  dBufStopSpillWorker();
+  dBufStopSpillWorker();
+  spillAndReloadTest(false);
+  spillAndReloadTest(true);
+}
+
 #pragma GCC diagnostic pop
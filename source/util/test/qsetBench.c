@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2019 TAOS Data, Inc. <jhtao@taosdata.com>
+ *
+ * This program is free software: you can use, redistribute, and/or modify
+ * it under the terms of the GNU Affero General Public License, version 3
+ * or later ("AGPL"), as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * You should have received a copy of the GNU Affero General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * Throughput benchmark of a queue set, as the vnode queues of a worker pool use it.
+ *
+ * Producers write small items into the queues of one qset in turn, consumers read them out of the qset one by one,
+ * as the threads of a query worker pool do. Every item carries a number, the sum of the numbers read tells whether
+ * an item was lost or read twice.
+ *
+ * usage: qsetBench [-p producers] [-c consumers] [-q queues] [-n items per producer]
+ */
+
+#include "tqueue.h"
+
+typedef struct {
+  STaosQset   *qset;
+  STaosQueue **aQueue;
+  int32_t      nQueue;
+  int32_t      nItem;
+  int64_t      nRead;
+  int64_t      sumRead;
+} SBenchCtx;
+
+typedef struct {
+  SBenchCtx *pCtx;
+  int32_t    idx;
+} SBenchArg;
+
+static void *benchProduceFn(void *param) {
+  SBenchArg *pArg = param;
+  SBenchCtx *pCtx = pArg->pCtx;
+
+  for (int32_t i = 0; i < pCtx->nItem; i++) {
+    int64_t *pItem = taosAllocateQitem(sizeof(int64_t), DEF_QITEM, 0);
+    *pItem = (int64_t)pArg->idx * pCtx->nItem + i;
+    if (taosWriteQitem(pCtx->aQueue[(pArg->idx + i) % pCtx->nQueue], pItem) != 0) {
+      taosFreeQitem(pItem);
+    }
+  }
+  return NULL;
+}
+
+static void *benchConsumeFn(void *param) {
+  SBenchArg *pArg = param;
+  SBenchCtx *pCtx = pArg->pCtx;
+  SQueueInfo qinfo = {.workerId = pArg->idx};
+  int64_t   *pItem = NULL;
+  int64_t    nRead = 0;
+  int64_t    sumRead = 0;
+
+  while (taosReadQitemFromQset(pCtx->qset, (void **)&pItem, &qinfo) != 0) {
+    nRead++;
+    sumRead += *pItem;
+    taosFreeQitem(pItem);
+    taosUpdateItemSize(qinfo.queue, 1);
+  }
+
+  atomic_add_fetch_64(&pCtx->nRead, nRead);
+  atomic_add_fetch_64(&pCtx->sumRead, sumRead);
+  return NULL;
+}
+
+int main(int argc, char *argv[]) {
+  int32_t   nProducer = 4;
+  int32_t   nConsumer = 4;
+  SBenchCtx ctx = {.nQueue = 200, .nItem = 1000000};
+
+  for (int32_t i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+      nProducer = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+      nConsumer = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-q") == 0 && i + 1 < argc) {
+      ctx.nQueue = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      ctx.nItem = atoi(argv[++i]);
+    } else {
+      printf("usage: %s [-p producers] [-c consumers] [-q queues] [-n items per producer]\n", argv[0]);
+      return -1;
+    }
+  }
+  if (nProducer <= 0 || nConsumer <= 0 || ctx.nQueue <= 0 || ctx.nQueue > QSET_MAX_QUEUES || ctx.nItem <= 0) {
+    printf("invalid arguments\n");
+    return -1;
+  }
+
+  ctx.qset = taosOpenQset();
+  ctx.aQueue = taosMemoryCalloc(ctx.nQueue, sizeof(STaosQueue *));
+  for (int32_t i = 0; i < ctx.nQueue; i++) {
+    ctx.aQueue[i] = taosOpenQueue();
+    taosAddIntoQset(ctx.qset, ctx.aQueue[i], NULL);
+  }
+
+  int32_t    nThread = nProducer + nConsumer;
+  TdThread  *aThread = taosMemoryCalloc(nThread, sizeof(TdThread));
+  SBenchArg *aArg = taosMemoryCalloc(nThread, sizeof(SBenchArg));
+
+  int64_t st = taosGetTimestampUs();
+  for (int32_t i = 0; i < nThread; i++) {
+    aArg[i].pCtx = &ctx;
+    aArg[i].idx = i < nProducer ? i : i - nProducer;
+    taosThreadCreate(&aThread[i], NULL, i < nProducer ? benchProduceFn : benchConsumeFn, &aArg[i]);
+  }
+  for (int32_t i = 0; i < nProducer; i++) {
+    taosThreadJoin(aThread[i], NULL);
+  }
+
+  // the consumers exit once all the items are read
+  int64_t nExpect = (int64_t)nProducer * ctx.nItem;
+  while (taosQueueItemSize(ctx.aQueue[0]) > 0 || atomic_load_32(&ctx.qset->numOfItems) > 0) {
+    taosMsleep(1);
+  }
+  for (int32_t i = 0; i < nConsumer; i++) {
+    taosQsetThreadResume(ctx.qset);
+  }
+  for (int32_t i = nProducer; i < nThread; i++) {
+    taosThreadJoin(aThread[i], NULL);
+  }
+  int64_t et = taosGetTimestampUs();
+
+  int64_t sumExpect = nExpect * (nExpect - 1) / 2;
+  double  elapsed = (et - st) / 1000000.0;
+  printf("producers:%d consumers:%d queues:%d items:%" PRId64 " elapsed:%.3fs\n", nProducer, nConsumer, ctx.nQueue,
+         nExpect, elapsed);
+  printf("throughput:%.0f items/s read:%" PRId64 " %s\n", nExpect / elapsed, ctx.nRead,
+         ctx.sumRead == sumExpect ? "checked" : "MISMATCH");
+
+  for (int32_t i = 0; i < ctx.nQueue; i++) {
+    taosCloseQueue(ctx.aQueue[i]);
+  }
+  taosCloseQset(ctx.qset);
+  taosMemoryFree(aArg);
+  taosMemoryFree(aThread);
+  taosMemoryFree(ctx.aQueue);
+  return (ctx.nRead == nExpect && ctx.sumRead == sumExpect) ? 0 : -1;
+}
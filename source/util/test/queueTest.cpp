@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "tqueue.h"
+
+// items carry their write order, the low priority ones are numbered from 1000
+static void queueTestWrite(STaosQueue *queue, int32_t value, bool lowPri) {
+  int32_t *pItem = (int32_t *)taosAllocateQitem(sizeof(int32_t), DEF_QITEM, 0);
+  ASSERT_NE(pItem, nullptr);
+  *pItem = value;
+  if (lowPri) taosSetQitemLowPriority(pItem);
+  ASSERT_EQ(taosWriteQitem(queue, pItem), 0);
+}
+
+static std::vector<int32_t> queueTestReadAll(STaosQueue *queue) {
+  std::vector<int32_t> values;
+  void                *pItem = NULL;
+  while (taosReadQitem(queue, &pItem) > 0) {
+    values.push_back(*(int32_t *)pItem);
+    taosFreeQitem(pItem);
+  }
+  return values;
+}
+
+// the order low priority items are read in when nLow of them are queued before nHigh others
+static std::vector<int32_t> queueTestExpected(int32_t nHigh, int32_t nLow) {
+  std::vector<int32_t> values;
+  int32_t              iLow = 0;
+  int32_t              nHighRead = 0;
+  for (int32_t i = 0; i < nHigh; i++) {
+    if (iLow < nLow && nHighRead == QUEUE_LOW_PRI_INTERVAL) {
+      values.push_back(1000 + iLow++);
+      nHighRead = 0;
+    }
+    values.push_back(i);
+    if (iLow < nLow) nHighRead++;
+  }
+  while (iLow < nLow) {
+    values.push_back(1000 + iLow++);
+  }
+  return values;
+}
+
+TEST(queueTest, lowPriorityInterleave) {
+  STaosQueue *queue = taosOpenQueue();
+  ASSERT_NE(queue, nullptr);
+
+  const int32_t nHigh = 3 * QUEUE_LOW_PRI_INTERVAL + 4;
+  const int32_t nLow = 3;
+  for (int32_t i = 0; i < nLow; i++) {
+    queueTestWrite(queue, 1000 + i, true);
+  }
+  for (int32_t i = 0; i < nHigh; i++) {
+    queueTestWrite(queue, i, false);
+  }
+  EXPECT_EQ(taosQueueItemSize(queue), nHigh + nLow);
+
+  // one low priority item after every QUEUE_LOW_PRI_INTERVAL others, the rest once the others are read
+  std::vector<int32_t> values = queueTestReadAll(queue);
+  EXPECT_EQ(values, queueTestExpected(nHigh, nLow));
+  EXPECT_EQ(values[QUEUE_LOW_PRI_INTERVAL], 1000);
+  EXPECT_EQ(values[2 * QUEUE_LOW_PRI_INTERVAL + 1], 1001);
+  EXPECT_EQ(values[3 * QUEUE_LOW_PRI_INTERVAL + 2], 1002);
+  EXPECT_EQ(values.back(), nHigh - 1);
+  EXPECT_TRUE(taosQueueEmpty(queue));
+
+  taosCloseQueue(queue);
+}
+
+TEST(queueTest, lowPriorityNoStarve) {
+  STaosQueue *queue = taosOpenQueue();
+  ASSERT_NE(queue, nullptr);
+
+  // low priority items are read in order when nothing else is queued
+  queueTestWrite(queue, 1000, true);
+  queueTestWrite(queue, 1001, true);
+  void *pItem = NULL;
+  ASSERT_EQ(taosReadQitem(queue, &pItem), 1);
+  EXPECT_EQ(*(int32_t *)pItem, 1000);
+  taosFreeQitem(pItem);
+
+  // an item written later goes before the waiting low priority one
+  queueTestWrite(queue, 0, false);
+  EXPECT_EQ(queueTestReadAll(queue), std::vector<int32_t>({0, 1001}));
+
+  // the others read while no low priority item waits do not count, a low one written later waits a full interval
+  for (int32_t i = 0; i < QUEUE_LOW_PRI_INTERVAL; i++) {
+    queueTestWrite(queue, i, false);
+  }
+  ASSERT_EQ(taosReadQitem(queue, &pItem), 1);
+  taosFreeQitem(pItem);
+  queueTestWrite(queue, 1002, true);
+  for (int32_t i = QUEUE_LOW_PRI_INTERVAL; i < 2 * QUEUE_LOW_PRI_INTERVAL; i++) {
+    queueTestWrite(queue, i, false);
+  }
+  std::vector<int32_t> values = queueTestReadAll(queue);
+  ASSERT_EQ(values.size(), 2 * QUEUE_LOW_PRI_INTERVAL);
+  EXPECT_EQ(values[QUEUE_LOW_PRI_INTERVAL], 1002);
+
+  // the low priority items still queued are freed on close
+  queueTestWrite(queue, 1003, true);
+  queueTestWrite(queue, 1004, true);
+  taosCloseQueue(queue);
+}
+
+TEST(queueTest, lowPriorityReadAll) {
+  STaosQueue *queue = taosOpenQueue();
+  STaosQall  *qall = taosAllocateQall();
+  ASSERT_NE(queue, nullptr);
+  ASSERT_NE(qall, nullptr);
+
+  queueTestWrite(queue, 1000, true);
+  queueTestWrite(queue, 0, false);
+  queueTestWrite(queue, 1001, true);
+  queueTestWrite(queue, 1, false);
+
+  // the low priority items are put at the end of the list
+  ASSERT_EQ(taosReadAllQitems(queue, qall), 4);
+  std::vector<int32_t> values;
+  void                *pItem = NULL;
+  while (taosGetQitem(qall, &pItem) > 0) {
+    values.push_back(*(int32_t *)pItem);
+    taosFreeQitem(pItem);
+  }
+  EXPECT_EQ(values, std::vector<int32_t>({0, 1, 1000, 1001}));
+  EXPECT_TRUE(taosQueueEmpty(queue));
+
+  taosFreeQall(qall);
+  taosCloseQueue(queue);
+}
+
+TEST(queueTest, lowPriorityQset) {
+  STaosQset  *qset = taosOpenQset();
+  STaosQueue *queue = taosOpenQueue();
+  ASSERT_NE(qset, nullptr);
+  ASSERT_NE(queue, nullptr);
+  ASSERT_EQ(taosAddIntoQset(qset, queue, NULL), 0);
+
+  const int32_t nHigh = 2 * QUEUE_LOW_PRI_INTERVAL;
+  const int32_t nLow = 2;
+  for (int32_t i = 0; i < nLow; i++) {
+    queueTestWrite(queue, 1000 + i, true);
+  }
+  for (int32_t i = 0; i < nHigh; i++) {
+    queueTestWrite(queue, i, false);
+  }
+
+  // the reader of a queue set takes the items in the same order as the one of the queue
+  std::vector<int32_t> values;
+  void                *pItem = NULL;
+  SQueueInfo           qinfo = {0};
+  for (int32_t i = 0; i < nHigh + nLow; i++) {
+    ASSERT_EQ(taosReadQitemFromQset(qset, &pItem, &qinfo), 1);
+    EXPECT_EQ(qinfo.queue, queue);
+    values.push_back(*(int32_t *)pItem);
+    taosFreeQitem(pItem);
+  }
+  taosUpdateItemSize(queue, nHigh + nLow);
+  EXPECT_EQ(values, queueTestExpected(nHigh, nLow));
+
+  taosRemoveFromQset(qset, queue);
+  taosCloseQueue(queue);
+  taosCloseQset(qset);
+}
@@ -0,0 +1,103 @@
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    # file sets of a memtable are committed by four threads at once
+    updatecfgDict = {'commitFilesetParallel': 4}
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.dbname = "db"
+        self.tbnum = 5
+        self.days = 12
+        self.rowsPerDay = 240
+        self.ts = 1700006400000
+        self.dayMs = 86400000
+        self.step = self.dayMs // self.rowsPerDay
+        # the expected rows of every table, ts -> c1
+        self.rows = [dict() for t in range(self.tbnum)]
+
+    def insert(self, t, days, offset, value):
+        # rows of several file sets are written into one memtable, out of order across the file sets
+        dbname = self.dbname
+        values = []
+        for d in days:
+            for i in range(offset, self.rowsPerDay, 2):
+                ts = self.ts + d * self.dayMs + i * self.step
+                values.append(f"({ts}, {value + i}, 'd{d}')")
+                self.rows[t][ts] = value + i
+        for start in range(0, len(values), 1000):
+            tdSql.execute(f"insert into {dbname}.ct{t} values {' '.join(values[start:start + 1000])}")
+
+    def delete(self, t, start, end):
+        tdSql.execute(f"delete from {self.dbname}.ct{t} where ts >= {start} and ts <= {end}")
+        for ts in [ts for ts in self.rows[t] if start <= ts <= end]:
+            del self.rows[t][ts]
+
+    def check(self):
+        dbname = self.dbname
+        total = sum(len(r) for r in self.rows)
+        tdSql.query(f"select count(*), sum(c1) from {dbname}.stb")
+        tdSql.checkData(0, 0, total)
+        tdSql.checkData(0, 1, sum(sum(r.values()) for r in self.rows))
+        for t in range(self.tbnum):
+            expect = sorted(self.rows[t].items())
+            tdSql.query(f"select ts, c1 from {dbname}.ct{t}")
+            tdSql.checkRows(len(expect))
+            for n in range(0, len(expect), 37):
+                tdSql.checkData(n, 0, expect[n][0])
+                tdSql.checkData(n, 1, expect[n][1])
+
+    def run(self):
+        dbname = self.dbname
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} keep 3650 duration 1 replica {self.replicaVar}")
+        tdSql.execute(f"create stable {dbname}.stb(ts timestamp, c1 int, c2 binary(8)) tags(t1 int)")
+        for t in range(self.tbnum):
+            tdSql.execute(f"create table {dbname}.ct{t} using {dbname}.stb tags({t})")
+
+        # first commit creates every file set at once
+        order = [7, 2, 11, 0, 5, 9, 3, 10, 1, 8, 4, 6]
+        for t in range(self.tbnum):
+            self.insert(t, order[t:] + order[:t], 0, t * 1000)
+        tdSql.execute(f"flush database {dbname}")
+        self.check()
+
+        # second commit merges with some file sets on disk, creates none and leaves the rest untouched
+        for t in range(self.tbnum):
+            self.insert(t, [1, 6, 10], 1, 100000 + t)
+            self.insert(t, [3], 0, 200000 + t)
+        tdSql.execute(f"flush database {dbname}")
+        self.check()
+
+        # deletes only: file sets without memtable rows are committed for the tomb data
+        for t in range(self.tbnum):
+            self.delete(t, self.ts + 4 * self.dayMs + self.dayMs // 2, self.ts + 8 * self.dayMs)
+        self.delete(0, self.ts, self.ts + self.days * self.dayMs)
+        tdSql.execute(f"flush database {dbname}")
+        self.check()
+
+        # rows and deletes of the same file sets in one memtable
+        for t in range(self.tbnum):
+            self.insert(t, [5, 6], 0, 300000 + t)
+            self.delete(t, self.ts + 6 * self.dayMs, self.ts + 6 * self.dayMs + self.dayMs // 3)
+        tdSql.execute(f"flush database {dbname}")
+        self.check()
+
+        # the committed file sets are found again after a restart
+        tdDnodes.stop(1)
+        tdDnodes.start(1)
+        self.check()
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
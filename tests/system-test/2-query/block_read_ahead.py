@@ -0,0 +1,93 @@
+from util.log import *
+from util.cases import *
+from util.sql import *
+
+
+class TDTestCase:
+    # read adjacent data blocks ahead with coalesced reads, a single read covers at most 32KB
+    updatecfgDict = {'queryReadAheadSize': 64}
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.dbname = "db"
+        self.tbnum = 3
+        self.rowNum = 20000
+        self.ts = 1700006400000
+
+    def insert_data(self):
+        dbname = self.dbname
+        tdSql.execute(f"drop database if exists {dbname}")
+        # small blocks, so each table has a hundred adjacent blocks in the data file
+        tdSql.execute(f"create database {dbname} keep 3650 duration 100 maxrows 200 minrows 10 replica {self.replicaVar}")
+        tdSql.execute(f"create stable {dbname}.stb(ts timestamp, c1 int, c2 bigint, c3 binary(32)) tags(t1 int)")
+        for t in range(self.tbnum):
+            tdSql.execute(f"create table {dbname}.ct{t} using {dbname}.stb tags({t})")
+            for start in range(0, self.rowNum, 1000):
+                values = " ".join(f"({self.ts + i * 1000}, {i}, {i * t}, 'ct{t}_{i}')"
+                                  for i in range(start, min(start + 1000, self.rowNum)))
+                tdSql.execute(f"insert into {dbname}.ct{t} values {values}")
+        tdSql.execute(f"flush database {dbname}")
+
+    def check_table(self, t):
+        dbname = self.dbname
+        tdSql.query(f"select c1, c2, c3 from {dbname}.ct{t}")
+        tdSql.checkRows(self.rowNum)
+        for i in range(0, self.rowNum, 193):
+            tdSql.checkData(i, 0, i)
+            tdSql.checkData(i, 1, i * t)
+            tdSql.checkData(i, 2, f"ct{t}_{i}")
+
+        tdSql.query(f"select c1, c3 from {dbname}.ct{t} order by ts desc")
+        tdSql.checkRows(self.rowNum)
+        for i in range(0, self.rowNum, 193):
+            tdSql.checkData(i, 0, self.rowNum - 1 - i)
+            tdSql.checkData(i, 1, f"ct{t}_{self.rowNum - 1 - i}")
+
+    def check_query(self):
+        dbname = self.dbname
+        for t in range(self.tbnum):
+            self.check_table(t)
+
+        tdSql.query(f"select count(*), sum(c1), max(c2) from {dbname}.stb")
+        tdSql.checkData(0, 0, self.tbnum * self.rowNum)
+        tdSql.checkData(0, 1, self.tbnum * self.rowNum * (self.rowNum - 1) // 2)
+        tdSql.checkData(0, 2, (self.rowNum - 1) * (self.tbnum - 1))
+
+        # blocks skipped by the time range or the filter are not read, the rest are served by the read-ahead
+        start = self.ts + 5000 * 1000
+        end = self.ts + 12000 * 1000
+        tdSql.query(f"select count(*), sum(c1) from {dbname}.ct1 where ts >= {start} and ts < {end}")
+        tdSql.checkData(0, 0, 7000)
+        tdSql.checkData(0, 1, sum(range(5000, 12000)))
+        tdSql.query(f"select c3 from {dbname}.stb where c1 = 12345 and t1 = 2")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, "ct2_12345")
+
+    def run(self):
+        self.insert_data()
+        self.check_query()
+
+        # overwrite every third row of one table and commit again, the new blocks no longer follow each other
+        dbname = self.dbname
+        values = " ".join(f"({self.ts + i * 1000}, {-i}, 0, 'new_{i}')" for i in range(0, self.rowNum, 3))
+        tdSql.execute(f"insert into {dbname}.ct0 values {values}")
+        tdSql.execute(f"flush database {dbname}")
+        tdSql.query(f"select c1, c3 from {dbname}.ct0")
+        tdSql.checkRows(self.rowNum)
+        for i in range(0, self.rowNum, 101):
+            tdSql.checkData(i, 0, -i if i % 3 == 0 else i)
+            tdSql.checkData(i, 1, f"new_{i}" if i % 3 == 0 else f"ct0_{i}")
+
+        tdSql.execute(f"compact database {dbname}")
+        for t in range(1, self.tbnum):
+            self.check_table(t)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
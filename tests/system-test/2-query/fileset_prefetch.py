@@ -0,0 +1,100 @@
+from util.log import *
+from util.cases import *
+from util.sql import *
+
+
+class TDTestCase:
+    # load the following file sets ahead in the vnode read threads
+    updatecfgDict = {'queryFilesetPrefetch': 4}
+
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.dbname = "db"
+        self.tbnum = 4
+        self.days = 20
+        self.rowsPerDay = 144
+        self.rowNum = self.days * self.rowsPerDay
+        self.ts = 1700006400000
+        self.step = 600000
+
+    def insert_data(self):
+        dbname = self.dbname
+        tdSql.execute(f"drop database if exists {dbname}")
+        # one file set per day, so a scan of each table crosses twenty file sets
+        tdSql.execute(f"create database {dbname} keep 3650 duration 1 replica {self.replicaVar}")
+        tdSql.execute(f"create stable {dbname}.stb(ts timestamp, c1 int, c2 double, c3 binary(16)) tags(t1 int)")
+        for t in range(self.tbnum):
+            tdSql.execute(f"create table {dbname}.ct{t} using {dbname}.stb tags({t})")
+            for start in range(0, self.rowNum, 500):
+                values = " ".join(f"({self.ts + i * self.step}, {i}, {i * 0.5}, 'v{i % 10}')"
+                                  for i in range(start, min(start + 500, self.rowNum)))
+                tdSql.execute(f"insert into {dbname}.ct{t} values {values}")
+        tdSql.execute(f"flush database {dbname}")
+
+    def check_query(self):
+        dbname = self.dbname
+        total = self.tbnum * self.rowNum
+        sumc1 = self.tbnum * self.rowNum * (self.rowNum - 1) // 2
+
+        tdSql.query(f"select count(*), sum(c1), min(ts), max(ts) from {dbname}.stb")
+        tdSql.checkData(0, 0, total)
+        tdSql.checkData(0, 1, sumc1)
+        tdSql.checkData(0, 2, self.ts)
+        tdSql.checkData(0, 3, self.ts + (self.rowNum - 1) * self.step)
+
+        # filter on a data column, every file set loaded ahead is filtered
+        tdSql.query(f"select count(*) from {dbname}.stb where c1 % 7 = 0")
+        tdSql.checkData(0, 0, self.tbnum * ((self.rowNum + 6) // 7))
+
+        # a time range that starts and ends in the middle of the file sets
+        start = self.ts + 5 * self.rowsPerDay * self.step
+        end = self.ts + 15 * self.rowsPerDay * self.step
+        tdSql.query(f"select count(*) from {dbname}.stb where ts >= {start} and ts < {end}")
+        tdSql.checkData(0, 0, self.tbnum * 10 * self.rowsPerDay)
+
+        # file sets are returned in order for both directions
+        tdSql.query(f"select ts, c1 from {dbname}.ct1 order by ts asc")
+        tdSql.checkRows(self.rowNum)
+        for i in range(0, self.rowNum, 97):
+            tdSql.checkData(i, 1, i)
+        tdSql.query(f"select ts, c1 from {dbname}.ct2 order by ts desc")
+        tdSql.checkRows(self.rowNum)
+        for i in range(0, self.rowNum, 97):
+            tdSql.checkData(i, 1, self.rowNum - 1 - i)
+
+        tdSql.query(f"select _wstart, count(*) from {dbname}.stb interval(1h)")
+        tdSql.checkRows(self.days * 24)
+        for i in range(0, self.days * 24, 7):
+            tdSql.checkData(i, 1, self.tbnum * self.rowsPerDay // 24)
+
+        tdSql.query(f"select tbname, count(*), last(c1) from {dbname}.stb partition by tbname")
+        tdSql.checkRows(self.tbnum)
+        for i in range(self.tbnum):
+            tdSql.checkData(i, 1, self.rowNum)
+            tdSql.checkData(i, 2, self.rowNum - 1)
+
+        # a limit stops the scan while file sets are still being loaded ahead
+        tdSql.query(f"select c1 from {dbname}.ct3 limit 10")
+        tdSql.checkRows(10)
+        tdSql.checkData(9, 0, 9)
+
+    def run(self):
+        self.insert_data()
+        self.check_query()
+
+        # rows still in memory are merged with the file sets loaded ahead
+        tdSql.execute(f"insert into {self.dbname}.ct0 values({self.ts + self.step}, -1, 0, 'mem')")
+        tdSql.query(f"select c1 from {self.dbname}.ct0 where ts = {self.ts + self.step}")
+        tdSql.checkData(0, 0, -1)
+        tdSql.query(f"select count(*) from {self.dbname}.stb")
+        tdSql.checkData(0, 0, self.tbnum * self.rowNum)
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
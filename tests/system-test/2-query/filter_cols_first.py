@@ -0,0 +1,100 @@
+from util.log import *
+from util.cases import *
+from util.sql import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+
+        self.rowNum = 12000
+        self.ts = 1700006400000
+
+    def value(self, i):
+        # c1 is null for every 13th row, c2 grows with the row and c3/c4 are only projected
+        c1 = "null" if i % 13 == 0 else str(i % 1000)
+        return f"({self.ts + i * 1000}, {c1}, {i}, {i * 2.5}, 'r{i}')"
+
+    def insert_data(self, dbname, maxrows):
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} keep 3650 duration 100 maxrows {maxrows} minrows 10 replica {self.replicaVar}")
+        tdSql.execute(f"create stable {dbname}.stb(ts timestamp, c1 int, c2 bigint, c3 double, c4 binary(16)) tags(t1 int)")
+        tdSql.execute(f"create table {dbname}.ct0 using {dbname}.stb tags(0)")
+        tdSql.execute(f"create table {dbname}.ct1 using {dbname}.stb tags(1)")
+        tdSql.execute(f"create table {dbname}.ntb(ts timestamp, c1 int, c2 bigint, c3 double, c4 binary(16))")
+        for tb in ["ct0", "ct1", "ntb"]:
+            for start in range(0, self.rowNum, 1000):
+                values = " ".join(self.value(i) for i in range(start, min(start + 1000, self.rowNum)))
+                tdSql.execute(f"insert into {dbname}.{tb} values {values}")
+        tdSql.execute(f"flush database {dbname}")
+
+    def check_rows(self, sql, rows, desc=False):
+        # rows are the expected row indexes, every column of them is checked
+        tdSql.query(sql)
+        tdSql.checkRows(len(rows))
+        if desc:
+            rows = rows[::-1]
+        for n in range(0, len(rows), max(1, len(rows) // 50)):
+            i = rows[n]
+            tdSql.checkData(n, 0, self.ts + i * 1000)
+            tdSql.checkData(n, 1, None if i % 13 == 0 else i % 1000)
+            tdSql.checkData(n, 2, i)
+            tdSql.checkData(n, 3, i * 2.5)
+            tdSql.checkData(n, 4, f"r{i}")
+
+    def check_query(self, dbname):
+        allRows = range(self.rowNum)
+        for tb in ["ct0", "ntb"]:
+            cols = f"ts, c1, c2, c3, c4 from {dbname}.{tb}"
+            # no row of most blocks qualifies, those blocks never load c3/c4
+            self.check_rows(f"select {cols} where c2 > 11500", [i for i in allRows if i > 11500])
+            self.check_rows(f"select {cols} where c2 >= 3000 and c2 < 3010", list(range(3000, 3010)))
+            # rows scattered over every block
+            self.check_rows(f"select {cols} where c1 = 7", [i for i in allRows if i % 13 != 0 and i % 1000 == 7])
+            self.check_rows(f"select {cols} where c1 is null", [i for i in allRows if i % 13 == 0])
+            self.check_rows(f"select {cols} where c1 > 500 or c2 < 100",
+                            [i for i in allRows if (i % 13 != 0 and i % 1000 > 500) or i < 100])
+            self.check_rows(f"select {cols} where c1 = 7 order by ts desc",
+                            [i for i in allRows if i % 13 != 0 and i % 1000 == 7], desc=True)
+            # the filter uses a projected column, or every row qualifies
+            self.check_rows(f"select {cols} where c3 > 29000", [i for i in allRows if i * 2.5 > 29000])
+            self.check_rows(f"select {cols} where c2 >= 0", list(allRows))
+            # no row qualifies at all
+            tdSql.query(f"select {cols} where c2 < 0")
+            tdSql.checkRows(0)
+
+        # tag and column conditions on the super table
+        tdSql.query(f"select c4 from {dbname}.stb where t1 = 1 and c2 = 5555")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, "r5555")
+        tdSql.query(f"select count(*), sum(c2), count(c4) from {dbname}.stb where c1 between 10 and 19")
+        expect = [i for i in allRows if i % 13 != 0 and 10 <= i % 1000 <= 19]
+        tdSql.checkData(0, 0, 2 * len(expect))
+        tdSql.checkData(0, 1, 2 * sum(expect))
+        tdSql.checkData(0, 2, 2 * len(expect))
+
+    def run(self):
+        # blocks fit in a result block, so the filter columns are loaded first
+        self.insert_data("db1", 1000)
+        self.check_query("db1")
+
+        # blocks larger than a result block are loaded in full
+        self.insert_data("db2", 10000)
+        self.check_query("db2")
+
+        # rows in memory and stt overlapping the file blocks are not loaded by phase
+        tdSql.execute("insert into db1.ct0 values(%d, 7, -1, 0, 'mem')" % (self.ts + 3003 * 1000))
+        tdSql.query("select c2, c4 from db1.ct0 where c2 >= 3000 and c2 < 3010")
+        tdSql.checkRows(9)
+        tdSql.query("select c2, c4 from db1.ct0 where c1 = 7 and c2 < 0")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 1, "mem")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,117 @@
+from taos import *
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor())
+        self.conn = conn
+
+        self.dbname = "db"
+        self.ts = 1700006400000
+        self.cols = ["ts", "c1", "c2", "c3", "c4"]
+
+    def value(self, i):
+        # c1 is null for every 7th row, c2 for the rows over 150, c3 for the even rows and c4 is never set after row 20
+        c1 = None if i % 7 == 0 else i
+        c2 = None if i > 150 else f"v{i}"
+        c3 = None if i % 2 == 0 else i * 0.5
+        c4 = i if i < 20 else None
+        return [self.ts + i * 1000, c1, c2, c3, c4]
+
+    def sql_value(self, i):
+        v = self.value(i)
+        return "(" + ", ".join("null" if x is None else (f"'{x}'" if isinstance(x, str) else str(x)) for x in v) + ")"
+
+    def insert_rows(self, tb, rows):
+        # all rows of a table in one submit, in row format
+        tdSql.execute(f"insert into {self.dbname}.{tb} values {' '.join(self.sql_value(i) for i in rows)}")
+
+    def insert_cols(self, tb, rows):
+        # all rows of a table in one submit, in column format
+        values = [self.value(i) for i in rows]
+        stmt = self.conn.statement(f"insert into {self.dbname}.{tb} values(?, ?, ?, ?, ?)")
+        params = new_multi_binds(5)
+        params[0].timestamp([v[0] for v in values])
+        params[1].int([v[1] for v in values])
+        params[2].binary([v[2] for v in values])
+        params[3].double([v[3] for v in values])
+        params[4].bigint([v[4] for v in values])
+        stmt.bind_param_batch(params)
+        stmt.execute()
+        stmt.close()
+
+    def insert_each(self, tb, rows):
+        # one submit per row
+        for i in rows:
+            tdSql.execute(f"insert into {self.dbname}.{tb} values {self.sql_value(i)}")
+
+    def insert(self, rows):
+        self.insert_rows("t_row", rows)
+        self.insert_cols("t_col", rows)
+        self.insert_each("t_each", rows)
+
+    def query(self, sql):
+        tdSql.query(sql)
+        return tdSql.queryResult
+
+    def check(self):
+        dbname = self.dbname
+        for func in ["last", "last_row"]:
+            cols = ", ".join(f"{func}({c})" for c in self.cols)
+            expect = self.query(f"select {cols} from {dbname}.t_each")
+            for tb in ["t_row", "t_col"]:
+                if self.query(f"select {cols} from {dbname}.{tb}") != expect:
+                    tdLog.exit(f"{func} of {tb}: {tdSql.queryResult} differs from the per-row submits: {expect}")
+                # the columns asked one at a time are read from the cache by other keys
+                for n, c in enumerate(self.cols):
+                    tdSql.query(f"select {func}({c}) from {dbname}.{tb}")
+                    tdSql.checkData(0, 0, expect[0][n])
+            tdSql.query(f"select {func}(*) from {dbname}.stb group by tbname")
+            tdSql.checkRows(3)
+
+    def run(self):
+        dbname = self.dbname
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} keep 3650 cachemodel 'both' replica {self.replicaVar}")
+        tdSql.execute(f"create stable {dbname}.stb(ts timestamp, c1 int, c2 binary(16), c3 double, c4 bigint) tags(t1 int)")
+        for n, tb in enumerate(["t_row", "t_col", "t_each"]):
+            tdSql.execute(f"create table {dbname}.{tb} using {dbname}.stb tags({n})")
+        self.conn.select_db(dbname)
+
+        # the last row has nulls, the last values of those columns are earlier in the same submit
+        self.insert(range(0, 154))
+        self.check()
+
+        # a later submit whose last row is null in other columns
+        self.insert(range(154, 171))
+        self.check()
+
+        # an out of order submit older than the cached values leaves them as they are
+        self.insert(range(-30, -10))
+        self.check()
+
+        # a row in the middle is overwritten and the last row is updated
+        self.insert([100, 170])
+        self.check()
+
+        # the cached values are written back and read again after a restart
+        tdSql.execute(f"flush database {dbname}")
+        tdDnodes.stop(1)
+        tdDnodes.start(1)
+        self.check()
+
+        self.insert(range(171, 200))
+        self.check()
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())
@@ -0,0 +1,89 @@
+from util.log import *
+from util.cases import *
+from util.sql import *
+from util.dnodes import *
+
+
+class TDTestCase:
+    def init(self, conn, logSql, replicaVar=1):
+        self.replicaVar = int(replicaVar)
+        tdLog.debug("start to execute %s" % __file__)
+        tdSql.init(conn.cursor(), logSql)
+
+        self.dbname = "db"
+        self.ts = 1700006400000
+
+    def insert(self, tb, i, c2=None):
+        c2 = "null" if c2 is None else f"'{c2}'"
+        tdSql.execute(f"insert into {self.dbname}.{tb} values({self.ts + i * 1000}, {i}, {c2})")
+
+    def delete(self, tb, start, end):
+        tdSql.execute(f"delete from {self.dbname}.{tb} where ts >= {self.ts + start * 1000} and ts <= {self.ts + end * 1000}")
+
+    def check(self, tb, last_ts, last_c1, last_c2, last_row_c2):
+        dbname = self.dbname
+        tdSql.query(f"select last(ts), last(c1), last(c2) from {dbname}.{tb}")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, self.ts + last_ts * 1000)
+        tdSql.checkData(0, 1, last_c1)
+        tdSql.checkData(0, 2, last_c2)
+        tdSql.query(f"select last_row(ts), last_row(c1), last_row(c2) from {dbname}.{tb}")
+        tdSql.checkRows(1)
+        tdSql.checkData(0, 0, self.ts + last_ts * 1000)
+        tdSql.checkData(0, 1, last_c1)
+        tdSql.checkData(0, 2, last_row_c2)
+
+    def restart(self):
+        tdSql.execute(f"flush database {self.dbname}")
+        tdDnodes.stop(1)
+        tdDnodes.start(1)
+
+    def run(self):
+        dbname = self.dbname
+        tdSql.execute(f"drop database if exists {dbname}")
+        tdSql.execute(f"create database {dbname} keep 3650 cachemodel 'both' replica {self.replicaVar}")
+        tdSql.execute(f"create stable {dbname}.stb(ts timestamp, c1 int, c2 binary(16)) tags(t1 int)")
+        for n, tb in enumerate(["t_upd", "t_load"]):
+            tdSql.execute(f"create table {dbname}.{tb} using {dbname}.stb tags({n})")
+            for i in range(0, 10):
+                self.insert(tb, i, f"v{i}")
+
+        # the last values loaded into the cache by a query are written back lazily
+        self.restart()
+        self.check("t_load", 9, 9, "v9", "v9")
+
+        # a row written after the last query, its values are only in the cache
+        for tb in ["t_upd", "t_load"]:
+            self.check(tb, 9, 9, "v9", "v9")
+            self.insert(tb, 20)
+            self.check(tb, 20, 20, "v9", None)
+
+        # deleting an older range keeps the cached last values
+        for tb in ["t_upd", "t_load"]:
+            self.delete(tb, 0, 3)
+            self.check(tb, 20, 20, "v9", None)
+            self.delete(tb, 12, 15)
+            self.check(tb, 20, 20, "v9", None)
+
+        # and they are written back
+        self.restart()
+        for tb in ["t_upd", "t_load"]:
+            self.check(tb, 20, 20, "v9", None)
+
+        # deleting the last row and the last value reloads them from the remaining rows
+        for tb in ["t_upd", "t_load"]:
+            self.delete(tb, 20, 20)
+            self.check(tb, 9, 9, "v9", "v9")
+            self.delete(tb, 8, 9)
+            self.check(tb, 7, 7, "v7", "v7")
+
+        self.restart()
+        for tb in ["t_upd", "t_load"]:
+            self.check(tb, 7, 7, "v7", "v7")
+
+    def stop(self):
+        tdSql.close()
+        tdLog.success("%s successfully executed" % __file__)
+
+tdCases.addWindows(__file__, TDTestCase())
+tdCases.addLinux(__file__, TDTestCase())